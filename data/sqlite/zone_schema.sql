@@ -0,0 +1,341 @@
+-- ---------------------------------------------------------------------------------------
+-- This source file is part of swgANH (Star Wars Galaxies - A New Hope - Server Emulator)
+-- For more information, see http://www.swganh.org
+--
+-- Copyright (c) 2006 - 2010 The swgANH Team
+-- ---------------------------------------------------------------------------------------
+--
+-- schema of the embedded (sqlite) zone database, DBType = sqlite
+--
+-- covers the tables a zone reads while booting and loading its world, enough to run
+-- a zone without a database server for benchmarks and tests
+-- the mysql stored procedures are not available, sf_getZoneObjectCount is provided by
+-- the server and reads zone_object_count
+-- the mission tables are queried as swganh.mission_*, the server attaches the database
+-- file a second time as swganh for them
+--
+
+CREATE TABLE IF NOT EXISTS galaxy (
+  galaxy_id INTEGER PRIMARY KEY,
+  name TEXT NOT NULL DEFAULT '',
+  Global_Tick_Count INTEGER NOT NULL DEFAULT 0
+);
+
+CREATE TABLE IF NOT EXISTS planet (
+  planet_id INTEGER PRIMARY KEY,
+  name TEXT NOT NULL,
+  terrain_file TEXT NOT NULL DEFAULT ''
+);
+
+CREATE TABLE IF NOT EXISTS config_process_list (
+  id INTEGER PRIMARY KEY,
+  name TEXT NOT NULL,
+  address TEXT NOT NULL DEFAULT '',
+  port INTEGER NOT NULL DEFAULT 0,
+  status INTEGER NOT NULL DEFAULT 0,
+  active INTEGER NOT NULL DEFAULT 1,
+  serverstartID INTEGER NOT NULL DEFAULT 0
+);
+
+CREATE TABLE IF NOT EXISTS config_zone_scripts (
+  id INTEGER PRIMARY KEY,
+  planet_id INTEGER NOT NULL,
+  priority INTEGER NOT NULL DEFAULT 0,
+  file TEXT NOT NULL
+);
+
+-- number of objects the zone loads on startup, returned by sf_getZoneObjectCount
+CREATE TABLE IF NOT EXISTS zone_object_count (
+  planet_id INTEGER PRIMARY KEY,
+  object_count INTEGER NOT NULL DEFAULT 0
+);
+
+-- reference tables
+
+CREATE TABLE IF NOT EXISTS attributes (
+  id INTEGER PRIMARY KEY,
+  name TEXT NOT NULL
+);
+
+CREATE TABLE IF NOT EXISTS clienteffects (
+  id INTEGER PRIMARY KEY,
+  effect TEXT NOT NULL
+);
+
+CREATE TABLE IF NOT EXISTS sounds (
+  id INTEGER PRIMARY KEY,
+  name TEXT NOT NULL
+);
+
+CREATE TABLE IF NOT EXISTS moods (
+  id INTEGER PRIMARY KEY,
+  name TEXT NOT NULL
+);
+
+CREATE TABLE IF NOT EXISTS conversation_animations (
+  id INTEGER PRIMARY KEY,
+  name TEXT NOT NULL
+);
+
+CREATE TABLE IF NOT EXISTS npc_chatter (
+  id INTEGER PRIMARY KEY,
+  chatter TEXT NOT NULL,
+  animation INTEGER NOT NULL DEFAULT 0,
+  planetId INTEGER NOT NULL DEFAULT 99
+);
+
+-- world objects
+
+CREATE TABLE IF NOT EXISTS zone_regions (
+  id INTEGER PRIMARY KEY,
+  planet_id INTEGER NOT NULL
+);
+
+CREATE TABLE IF NOT EXISTS cities (
+  id INTEGER PRIMARY KEY,
+  planet_id INTEGER NOT NULL
+);
+
+CREATE TABLE IF NOT EXISTS badge_regions (
+  id INTEGER PRIMARY KEY,
+  planet_id INTEGER NOT NULL
+);
+
+CREATE TABLE IF NOT EXISTS spawn_regions (
+  id INTEGER PRIMARY KEY,
+  planet_id INTEGER NOT NULL
+);
+
+CREATE TABLE IF NOT EXISTS spawns (
+  id INTEGER PRIMARY KEY,
+  spawn_x REAL NOT NULL DEFAULT 0,
+  spawn_z REAL NOT NULL DEFAULT 0,
+  spawn_width REAL NOT NULL DEFAULT 0,
+  spawn_length REAL NOT NULL DEFAULT 0,
+  spawn_planet INTEGER NOT NULL
+);
+
+CREATE TABLE IF NOT EXISTS buildings (
+  id INTEGER PRIMARY KEY,
+  planet_id INTEGER NOT NULL
+);
+
+CREATE TABLE IF NOT EXISTS structures (
+  id INTEGER PRIMARY KEY,
+  zone INTEGER NOT NULL
+);
+
+CREATE TABLE IF NOT EXISTS harvesters (
+  id INTEGER PRIMARY KEY
+);
+
+CREATE TABLE IF NOT EXISTS factories (
+  id INTEGER PRIMARY KEY
+);
+
+CREATE TABLE IF NOT EXISTS houses (
+  id INTEGER PRIMARY KEY
+);
+
+-- resources
+
+CREATE TABLE IF NOT EXISTS resource_categories (
+  id INTEGER PRIMARY KEY,
+  name TEXT NOT NULL,
+  descriptor TEXT NOT NULL DEFAULT '',
+  parent_id INTEGER NOT NULL DEFAULT 1
+);
+
+CREATE TABLE IF NOT EXISTS resource_template (
+  id INTEGER PRIMARY KEY,
+  category_id INTEGER NOT NULL,
+  namefile_name TEXT NOT NULL DEFAULT '',
+  type_name TEXT NOT NULL DEFAULT '',
+  type_swg TEXT NOT NULL DEFAULT '',
+  tang TEXT NOT NULL DEFAULT '',
+  bazaar_catID INTEGER NOT NULL DEFAULT 0,
+  type TEXT NOT NULL DEFAULT ''
+);
+
+CREATE TABLE IF NOT EXISTS resources (
+  id INTEGER PRIMARY KEY,
+  name TEXT NOT NULL,
+  type_id INTEGER NOT NULL,
+  er INTEGER NOT NULL DEFAULT 0,
+  cr INTEGER NOT NULL DEFAULT 0,
+  cd INTEGER NOT NULL DEFAULT 0,
+  dr INTEGER NOT NULL DEFAULT 0,
+  fl INTEGER NOT NULL DEFAULT 0,
+  hr INTEGER NOT NULL DEFAULT 0,
+  ma INTEGER NOT NULL DEFAULT 0,
+  oq INTEGER NOT NULL DEFAULT 0,
+  sr INTEGER NOT NULL DEFAULT 0,
+  ut INTEGER NOT NULL DEFAULT 0,
+  pe INTEGER NOT NULL DEFAULT 0,
+  active INTEGER NOT NULL DEFAULT 1
+);
+
+CREATE TABLE IF NOT EXISTS resources_spawn_config (
+  resource_id INTEGER NOT NULL,
+  planet_id INTEGER NOT NULL,
+  noiseMapBoundsX1 REAL NOT NULL DEFAULT 0,
+  noiseMapBoundsX2 REAL NOT NULL DEFAULT 0,
+  noiseMapBoundsY1 REAL NOT NULL DEFAULT 0,
+  noiseMapBoundsY2 REAL NOT NULL DEFAULT 0,
+  noiseMapOctaves INTEGER NOT NULL DEFAULT 1,
+  noiseMapFrequency REAL NOT NULL DEFAULT 1,
+  noiseMapPersistence REAL NOT NULL DEFAULT 0.5,
+  noiseMapScale REAL NOT NULL DEFAULT 1,
+  noiseMapBias REAL NOT NULL DEFAULT 0,
+  unitsTotal INTEGER NOT NULL DEFAULT 0,
+  unitsLeft INTEGER NOT NULL DEFAULT 0,
+  PRIMARY KEY (resource_id, planet_id)
+);
+
+-- draft schematics, group ids have to run from 1 without gaps
+
+CREATE TABLE IF NOT EXISTS schematic_groups (
+  id INTEGER PRIMARY KEY,
+  name TEXT NOT NULL
+);
+
+CREATE TABLE IF NOT EXISTS draft_experiment_groups (
+  id INTEGER PRIMARY KEY,
+  name TEXT NOT NULL
+);
+
+CREATE TABLE IF NOT EXISTS draft_schematics (
+  id INTEGER PRIMARY KEY,
+  group_id INTEGER NOT NULL,
+  object_string TEXT NOT NULL,
+  weightsbatch_id INTEGER NOT NULL DEFAULT 0,
+  complexity INTEGER NOT NULL DEFAULT 0,
+  datasize INTEGER NOT NULL DEFAULT 0,
+  subCategory INTEGER NOT NULL DEFAULT 0,
+  craftEnabled INTEGER NOT NULL DEFAULT 1
+);
+
+CREATE TABLE IF NOT EXISTS draft_slots (
+  id INTEGER PRIMARY KEY,
+  component_file TEXT NOT NULL DEFAULT '',
+  component_name TEXT NOT NULL DEFAULT '',
+  resource_name TEXT NOT NULL DEFAULT '',
+  amount INTEGER NOT NULL DEFAULT 0,
+  optional INTEGER NOT NULL DEFAULT 0,
+  type INTEGER NOT NULL DEFAULT 0
+);
+
+-- schematic_id is the crc of the shared_ template name
+CREATE TABLE IF NOT EXISTS draft_schematics_slots (
+  schematic_id INTEGER NOT NULL,
+  draft_slot_id INTEGER NOT NULL
+);
+
+CREATE TABLE IF NOT EXISTS draft_weights (
+  id INTEGER PRIMARY KEY,
+  assembly_batch_id INTEGER NOT NULL DEFAULT 0,
+  experiment_batch_id INTEGER NOT NULL DEFAULT 0,
+  craft_batch_id INTEGER NOT NULL DEFAULT 0
+);
+
+CREATE TABLE IF NOT EXISTS draft_assembly_batches (
+  id INTEGER NOT NULL,
+  list_id INTEGER NOT NULL
+);
+
+CREATE TABLE IF NOT EXISTS draft_experiment_batches (
+  id INTEGER NOT NULL,
+  list_id INTEGER NOT NULL
+);
+
+CREATE TABLE IF NOT EXISTS draft_craft_batches (
+  id INTEGER NOT NULL,
+  list_id INTEGER NOT NULL,
+  expGroup INTEGER NOT NULL DEFAULT 0
+);
+
+-- the list tables hold several rows per id
+
+CREATE TABLE IF NOT EXISTS draft_assembly_lists (
+  id INTEGER NOT NULL,
+  datatype INTEGER NOT NULL DEFAULT 0,
+  distribution INTEGER NOT NULL DEFAULT 0
+);
+
+CREATE TABLE IF NOT EXISTS draft_experiment_lists (
+  id INTEGER NOT NULL,
+  datatype INTEGER NOT NULL DEFAULT 0,
+  distribution INTEGER NOT NULL DEFAULT 0
+);
+
+CREATE TABLE IF NOT EXISTS draft_craft_attribute_weights (
+  id INTEGER NOT NULL,
+  type INTEGER NOT NULL DEFAULT 0,
+  distribution REAL NOT NULL DEFAULT 0
+);
+
+CREATE TABLE IF NOT EXISTS draft_craft_item_attribute_link (
+  id INTEGER PRIMARY KEY,
+  list_id INTEGER NOT NULL,
+  item_attribute INTEGER NOT NULL,
+  attribute_min REAL NOT NULL DEFAULT 0,
+  attribute_max REAL NOT NULL DEFAULT 0,
+  attribute_type INTEGER NOT NULL DEFAULT 0
+);
+
+CREATE TABLE IF NOT EXISTS draft_schematic_attribute_manipulation (
+  id INTEGER PRIMARY KEY,
+  Draft_Schematic INTEGER NOT NULL,
+  Attribute INTEGER NOT NULL,
+  AffectedAttribute INTEGER NOT NULL,
+  Manipulation INTEGER NOT NULL DEFAULT 0
+);
+
+-- missions, name in mission_types is a flag: the mission comes with a name
+
+CREATE TABLE IF NOT EXISTS mission_types (
+  id INTEGER PRIMARY KEY,
+  type TEXT NOT NULL,
+  content INTEGER NOT NULL DEFAULT 0,
+  name INTEGER NOT NULL DEFAULT 0
+);
+
+CREATE TABLE IF NOT EXISTS mission_names (
+  id INTEGER PRIMARY KEY,
+  planet INTEGER NOT NULL,
+  name TEXT NOT NULL
+);
+
+CREATE TABLE IF NOT EXISTS mission_terminal_mission_types (
+  id INTEGER PRIMARY KEY,
+  terminal INTEGER NOT NULL,
+  mission_type INTEGER NOT NULL
+);
+
+CREATE TABLE IF NOT EXISTS mission_text (
+  id INTEGER PRIMARY KEY,
+  mission_type INTEGER NOT NULL,
+  mission_name TEXT NOT NULL,
+  mission_text TEXT NOT NULL DEFAULT ''
+);
+
+CREATE INDEX IF NOT EXISTS idx_config_zone_scripts_planet ON config_zone_scripts (planet_id);
+CREATE INDEX IF NOT EXISTS idx_zone_regions_planet ON zone_regions (planet_id);
+CREATE INDEX IF NOT EXISTS idx_cities_planet ON cities (planet_id);
+CREATE INDEX IF NOT EXISTS idx_badge_regions_planet ON badge_regions (planet_id);
+CREATE INDEX IF NOT EXISTS idx_spawn_regions_planet ON spawn_regions (planet_id);
+CREATE INDEX IF NOT EXISTS idx_spawns_planet ON spawns (spawn_planet);
+CREATE INDEX IF NOT EXISTS idx_buildings_planet ON buildings (planet_id);
+CREATE INDEX IF NOT EXISTS idx_structures_zone ON structures (zone);
+CREATE INDEX IF NOT EXISTS idx_resources_spawn_config_planet ON resources_spawn_config (planet_id);
+CREATE INDEX IF NOT EXISTS idx_draft_schematics_group ON draft_schematics (group_id);
+CREATE INDEX IF NOT EXISTS idx_draft_schematics_slots_schematic ON draft_schematics_slots (schematic_id);
+CREATE INDEX IF NOT EXISTS idx_draft_assembly_batches_id ON draft_assembly_batches (id);
+CREATE INDEX IF NOT EXISTS idx_draft_experiment_batches_id ON draft_experiment_batches (id);
+CREATE INDEX IF NOT EXISTS idx_draft_craft_batches_id ON draft_craft_batches (id);
+CREATE INDEX IF NOT EXISTS idx_draft_assembly_lists_id ON draft_assembly_lists (id);
+CREATE INDEX IF NOT EXISTS idx_draft_experiment_lists_id ON draft_experiment_lists (id);
+CREATE INDEX IF NOT EXISTS idx_draft_craft_attribute_weights_id ON draft_craft_attribute_weights (id);
+CREATE INDEX IF NOT EXISTS idx_draft_craft_item_attribute_link_list ON draft_craft_item_attribute_link (list_id);
+CREATE INDEX IF NOT EXISTS idx_draft_schematic_attribute_manipulation ON draft_schematic_attribute_manipulation (Draft_Schematic);
+CREATE INDEX IF NOT EXISTS idx_mission_names_planet ON mission_names (planet);
@@ -0,0 +1,48 @@
+-- ---------------------------------------------------------------------------------------
+-- This source file is part of swgANH (Star Wars Galaxies - A New Hope - Server Emulator)
+-- For more information, see http://www.swganh.org
+--
+-- Copyright (c) 2006 - 2010 The swgANH Team
+-- ---------------------------------------------------------------------------------------
+--
+-- minimal seed data of the embedded zone database, the planets and processes of an empty galaxy
+--
+
+INSERT OR IGNORE INTO galaxy (galaxy_id, name, Global_Tick_Count) VALUES (2, 'swganh', 0);
+
+INSERT OR IGNORE INTO planet (planet_id, name, terrain_file) VALUES
+  (0, 'corellia', 'terrain/corellia.trn'),
+  (1, 'dantooine', 'terrain/dantooine.trn'),
+  (2, 'dathomir', 'terrain/dathomir.trn'),
+  (3, 'endor', 'terrain/endor.trn'),
+  (4, 'lok', 'terrain/lok.trn'),
+  (5, 'naboo', 'terrain/naboo.trn'),
+  (6, 'rori', 'terrain/rori.trn'),
+  (7, 'talus', 'terrain/talus.trn'),
+  (8, 'tatooine', 'terrain/tatooine.trn'),
+  (9, 'yavin4', 'terrain/yavin4.trn'),
+  (41, 'tutorial', 'terrain/tutorial.trn');
+
+INSERT OR IGNORE INTO config_process_list (id, name, address, port, status, active, serverstartID) VALUES
+  (1, 'connection', '127.0.0.1', 5000, 0, 1, 0),
+  (2, 'chat', '', 0, 0, 1, 0),
+  (3, 'corellia', '', 0, 0, 1, 0),
+  (4, 'dantooine', '', 0, 0, 1, 0),
+  (5, 'dathomir', '', 0, 0, 1, 0),
+  (6, 'endor', '', 0, 0, 1, 0),
+  (7, 'lok', '', 0, 0, 1, 0),
+  (8, 'naboo', '', 0, 0, 1, 0),
+  (9, 'rori', '', 0, 0, 1, 0),
+  (10, 'talus', '', 0, 0, 1, 0),
+  (11, 'tatooine', '', 0, 0, 1, 0),
+  (12, 'yavin4', '', 0, 0, 1, 0),
+  (13, 'tutorial', '', 0, 0, 1, 0);
+
+INSERT OR IGNORE INTO zone_object_count (planet_id, object_count) VALUES
+  (0, 0), (1, 0), (2, 0), (3, 0), (4, 0), (5, 0), (6, 0), (7, 0), (8, 0), (9, 0), (41, 0);
+
+-- top of the resource class tree, the root (1, resource) is created by the server
+-- parents have to come before their children
+INSERT OR IGNORE INTO resource_categories (id, name, descriptor, parent_id) VALUES
+  (2, 'organic', 'organic', 1),
+  (3, 'inorganic', 'inorganic', 1);
@@ -1638,9 +1638,8 @@ void ChatManager::_processSendToRoom(Message* message,DispatchClient* client)
 
 //======================================================================================================================
 
-void ChatManager::_processAddModeratorToRoom(Message* message,DispatchClient* client)
+void ChatManager::_processRoomRequest(Message* message,DispatchClient* client,RoomRequestHandler handler)
 {
-	gLogger->logMsg("Add moderator to room");
 	string playerName;
 	string roompath;
 	string roomname;
@@ -1656,8 +1655,6 @@ void ChatManager::_processAddModeratorToRoom(Message* message,DispatchClient* cl
 	uint32 index = 5 + mGalaxyName.getLength();
 	roompath.substring(roomname, static_cast<uint16>(index), roompath.getLength());
 
-	gLogger->logMsgF("Channel is %s", MSG_NORMAL, roomname.getAnsi());
-
 	Channel* channel = getChannelByName(roomname);
 	if (channel == NULL)
 	{
@@ -1665,81 +1662,123 @@ void ChatManager::_processAddModeratorToRoom(Message* message,DispatchClient* cl
 		return;
 	}
 
-
 	// We use two versions of names, one with the real spelling and one with pure lowercase.
 	playerName.toLower();
-	string sender = BString(getPlayerByAccId(client->getAccountId())->getName().getAnsi());
-	string realSenderName = sender;
-	sender.toLower();
 
-	uint32 errorCode = 0;
+	// Well, the player don't have to be online, carry on once the db knows whether the name is valid.
+	ChatAsyncContainer* asyncContainer = new ChatAsyncContainer(ChatQuery_ValidName);
+	asyncContainer->mAccountId	= client->getAccountId();
+	asyncContainer->mChannelId	= channel->getId();
+	asyncContainer->mName		= playerName;
+	asyncContainer->mRequestId	= requestId;
+
+	_queryValidName(playerName,std::tr1::bind(&ChatManager::_handleRoomRequest,this,handler,asyncContainer,std::tr1::placeholders::_1));
+}
+
+//======================================================================================================================
+
+void ChatManager::_handleRoomRequest(RoomRequestHandler handler,ChatAsyncContainer* asyncContainer,DatabaseResult* result)
+{
+	ChatRoomRequest request;
+
+	Player*	player		= getPlayerByAccId(asyncContainer->mAccountId);
+	bool	validName	= (result->getRowCount() == 1);
+
+	request.mChannel	= getChannelById(asyncContainer->mChannelId);
+	request.mPlayerName	= asyncContainer->mName;
+	request.mRequestId	= asyncContainer->mRequestId;
+	request.mErrorCode	= 0;
+
+	SAFE_DELETE(asyncContainer);
+
+	// sender or channel may be gone while we waited on the db
+	if((player == NULL) || (request.mChannel == NULL))
+	{
+		return;
+	}
+
+	request.mClient			= player->getClient();
+	request.mSender			= BString(player->getName().getAnsi());
+	request.mRealSenderName	= request.mSender;
+	request.mSender.toLower();
 
 #ifdef DISP_REAL_FIRST_NAME
 	// Get real first name.
-	string* newName = getFirstName(playerName);
-	string realPlayerName;
+	string* newName = getFirstName(request.mPlayerName);
 
 	if (newName->getLength() == 0)
 	{
-		errorCode = 4;
-		realPlayerName = playerName;	// We have to stick with this name when error reporting.
-		gLogger->logMsgF("No player with name %s found\n", MSG_NORMAL, playerName.getAnsi());
+		request.mErrorCode = 4;
+		request.mRealPlayerName = request.mPlayerName;	// We have to stick with this name when error reporting.
+		gLogger->logMsgF("No player with name %s found\n", MSG_NORMAL, request.mPlayerName.getAnsi());
 	}
 	else
 	{
-		realPlayerName = *newName;
+		request.mRealPlayerName = *newName;
 	}
 	delete newName;
 #else
 	// Lowercase
-	string realPlayerName = playerName;
-	realSenderName.toLower();
+	request.mRealPlayerName = request.mPlayerName;
+	request.mRealSenderName.toLower();
 
-	// Well, the player don't have to be online.
-	if (!isValidName(playerName))
+	if (!validName)
 	{
-		errorCode = 4;
-		gLogger->logMsgF("No player with name %s found", MSG_NORMAL, playerName.getAnsi());
+		request.mErrorCode = 4;
+		gLogger->logMsgF("No player with name %s found", MSG_NORMAL, request.mPlayerName.getAnsi());
 	}
 #endif
+
+	(this->*handler)(request);
+}
+
+//======================================================================================================================
+
+void ChatManager::_processAddModeratorToRoom(Message* message,DispatchClient* client)
+{
+	gLogger->logMsg("Add moderator to room");
+	_processRoomRequest(message,client,&ChatManager::_handleAddModeratorToRoom);
+}
+
+//======================================================================================================================
+
+void ChatManager::_handleAddModeratorToRoom(ChatRoomRequest& request)
+{
 	// We check in logical order, even if we know that playername is not valid.
-	if (!channel->isModerated())
+	if (!request.mChannel->isModerated())
 	{
 		// Channel is not moderated.
 		gLogger->logMsg("Channel is not moderated", MSG_NORMAL);
-		errorCode = 9;
+		request.mErrorCode = 9;
 	}
-	else if ((!channel->isModerator(sender)) && (!channel->isOwner(sender)))
+	else if ((!request.mChannel->isModerator(request.mSender)) && (!request.mChannel->isOwner(request.mSender)))
 	{
-		errorCode = 16;
-		gLogger->logMsgF("%s is not owner or moderated in channel %s.", MSG_NORMAL,realSenderName.getAnsi(), roomname.getAnsi());
+		request.mErrorCode = 16;
+		gLogger->logMsgF("%s is not owner or moderated in channel %s.", MSG_NORMAL,request.mRealSenderName.getAnsi(), request.mChannel->getName().getAnsi());
 		// gChatMessageLib->sendChatFailedToAddMod(client, mGalaxyName, sender, playername, channel, 16, requestId);
 		// return;
 	}
 	// If we have invalid player name, we don't need the following checks.
-	else if ((errorCode == 0) && (channel->isModerator(playerName)))
+	else if ((request.mErrorCode == 0) && (request.mChannel->isModerator(request.mPlayerName)))
 	{
-		gLogger->logMsgF("%s is already a moderator in channel %s.", MSG_NORMAL, realPlayerName.getAnsi(), roomname.getAnsi());
+		gLogger->logMsgF("%s is already a moderator in channel %s.", MSG_NORMAL, request.mRealPlayerName.getAnsi(), request.mChannel->getName().getAnsi());
 		// gChatMessageLib->sendChatFailedToAddMod(client, mGalaxyName, sender, playername, channel, 1, requestId);
-		errorCode = 1;
+		request.mErrorCode = 1;
 		// return;
 	}
-	if (errorCode != 0)
+	if (request.mErrorCode != 0)
 	{
-		gChatMessageLib->sendChatFailedToAddMod(client, mGalaxyName, realSenderName, realPlayerName, channel, errorCode, requestId);
+		gChatMessageLib->sendChatFailedToAddMod(request.mClient, mGalaxyName, request.mRealSenderName, request.mRealPlayerName, request.mChannel, request.mErrorCode, request.mRequestId);
 	}
 	else
 	{
-		channel->addModerator(&playerName);
+		request.mChannel->addModerator(&request.mPlayerName);
 		int8 sql[128];
-		mDatabase->Escape_String(sql, realPlayerName.getAnsi(), realPlayerName.getLength());
+		mDatabase->Escape_String(sql, request.mRealPlayerName.getAnsi(), request.mRealPlayerName.getLength());
 
-		mDatabase->ExecuteSqlAsync(NULL, NULL, "INSERT INTO chat_channels_moderators VALUES (%u, '%s');", channel->getId(), sql /* realPlayerName.getAnsi() */);
-		gChatMessageLib->sendChatOnAddModeratorToRoom(client, mGalaxyName, realSenderName, realPlayerName, channel, requestId);
+		mDatabase->ExecuteSqlAsync(NULL, NULL, "INSERT INTO chat_channels_moderators VALUES (%u, '%s');", request.mChannel->getId(), sql /* request.mRealPlayerName.getAnsi() */);
+		gChatMessageLib->sendChatOnAddModeratorToRoom(request.mClient, mGalaxyName, request.mRealSenderName, request.mRealPlayerName, request.mChannel, request.mRequestId);
 	}
-#ifdef DISP_REAL_FIRST_NAME
-	// delete realPlayerName;
-#endif
 }
 
 //======================================================================================================================
@@ -1747,109 +1786,55 @@ void ChatManager::_processAddModeratorToRoom(Message* message,DispatchClient* cl
 void ChatManager::_processInviteAvatarToRoom(Message* message,DispatchClient* client)
 {
 	gLogger->logMsg("Invite avatar to room");
-	string nameOfInvitedPlayer;
-	string roompath;
-	string roomname;
-	string game;
-	string server;
-	string playerName;
-
-	message->getStringAnsi(game);
-	message->getStringAnsi(server);
-	message->getStringAnsi(playerName);
-	message->getStringAnsi(roompath);
-	uint32 requestId = message->getUint32();
-
-	uint32 index = 5 + mGalaxyName.getLength();
-	roompath.substring(roomname, static_cast<uint16>(index), roompath.getLength());
-
-	Channel* channel = getChannelByName(roomname);
-	if (channel == NULL)
-	{
-		gLogger->logMsgF("No channel for room %s", MSG_NORMAL, roomname.getAnsi());
-		return;
-	}
-
-	// We use two versions of names, one with the real spelling and one with pure lowercase.
-	playerName.toLower();
-	string sender = BString(getPlayerByAccId(client->getAccountId())->getName().getAnsi());
-	string realSenderName = sender;
-	sender.toLower();
-
-	uint32 errorCode = 0;
-
-#ifdef DISP_REAL_FIRST_NAME
-	string* newName = getFirstName(playerName);
-	string realPlayerName;
+	_processRoomRequest(message,client,&ChatManager::_handleInviteAvatarToRoom);
+}
 
-	if (newName->getLength() == 0)
-	{
-		errorCode = 4;
-		realPlayerName = playerName;	// We have to stick with this name when error reporting.
-		gLogger->logMsgF("No player with name %s found\n", MSG_NORMAL, playerName.getAnsi());
-	}
-	else
-	{
-		realPlayerName = *newName;
-	}
-	delete newName;
-#else
-	// Lowercase
-	string realPlayerName = playerName;
-	realSenderName.toLower();
+//======================================================================================================================
 
-	// Well, the player don't have to be online.
-	if (!isValidName(playerName))
-	{
-		errorCode = 4;
-		gLogger->logMsgF("No player with name %s found", MSG_NORMAL, playerName.getAnsi());
-	}
-#endif
+void ChatManager::_handleInviteAvatarToRoom(ChatRoomRequest& request)
+{
 	// We check in logical order, even if we know that playername is not valid.
 	// Private channel?
-	if (!channel->isPrivate())
+	if (!request.mChannel->isPrivate())
 	{
-		errorCode = 9;
+		request.mErrorCode = 9;
 	}
 	// Request by Moderator or Owner?
-	else if ((!channel->isModerator(sender)) && (!channel->isOwner(sender)))
+	else if ((!request.mChannel->isModerator(request.mSender)) && (!request.mChannel->isOwner(request.mSender)))
 	{
-		errorCode = 16;
+		request.mErrorCode = 16;
 	}
-	else if (errorCode == 0) // then playername is valid...
+	else if (request.mErrorCode == 0) // then playername is valid...
 	{
 		// Player banned?
-		if (channel->isBanned(playerName))
+		if (request.mChannel->isBanned(request.mPlayerName))
 		{
 			// General failure
-			errorCode = 1;
+			request.mErrorCode = 1;
 		}
-		else if (channel->isInvited(playerName))
+		else if (request.mChannel->isInvited(request.mPlayerName))
 		{
 			// General failure
-			errorCode = 1;
+			request.mErrorCode = 1;
 		}
 	}
-	if (errorCode != 0)
+	if (request.mErrorCode != 0)
 	{
-		gChatMessageLib->sendChatFailedToInvite(client, mGalaxyName, realSenderName, realPlayerName, channel, errorCode, requestId);
+		gChatMessageLib->sendChatFailedToInvite(request.mClient, mGalaxyName, request.mRealSenderName, request.mRealPlayerName, request.mChannel, request.mErrorCode, request.mRequestId);
 	}
 	else
 	{
-		gLogger->logMsgF("%s has invited %s to join channel %s",MSG_NORMAL,realSenderName.getAnsi(), realPlayerName.getAnsi(), roomname.getAnsi());
-		channel->addInvitedUser(&playerName);
+		gLogger->logMsgF("%s has invited %s to join channel %s",MSG_NORMAL,request.mRealSenderName.getAnsi(), request.mRealPlayerName.getAnsi(), request.mChannel->getName().getAnsi());
+		request.mChannel->addInvitedUser(&request.mPlayerName);
 		int8 sql[128];
-		mDatabase->Escape_String(sql, playerName.getAnsi(), playerName.getLength());
+		mDatabase->Escape_String(sql, request.mPlayerName.getAnsi(), request.mPlayerName.getLength());
 
-		mDatabase->ExecuteSqlAsync(NULL, NULL, "INSERT INTO chat_channels_invited VALUES (%u, '%s');", channel->getId(), sql /* playerName.getAnsi() */);
-		gLogger->logMsgF("Player %s is added to database for invited",MSG_NORMAL, playerName.getAnsi());
+		mDatabase->ExecuteSqlAsync(NULL, NULL, "INSERT INTO chat_channels_invited VALUES (%u, '%s');", request.mChannel->getId(), sql /* request.mPlayerName.getAnsi() */);
+		gLogger->logMsgF("Player %s is added to database for invited",MSG_NORMAL, request.mPlayerName.getAnsi());
 
-		gChatMessageLib->sendChatOnInviteToRoom(client, mGalaxyName, realSenderName, realPlayerName, channel, requestId);
-		gChatMessageLib->sendChatQueryRoomResults(client, channel, 0);
+		gChatMessageLib->sendChatOnInviteToRoom(request.mClient, mGalaxyName, request.mRealSenderName, request.mRealPlayerName, request.mChannel, request.mRequestId);
+		gChatMessageLib->sendChatQueryRoomResults(request.mClient, request.mChannel, 0);
 	}
-#ifdef DISP_REAL_FIRST_NAME
-	// delete realPlayerName;
-#endif
 }
 
 //======================================================================================================================
@@ -1857,108 +1842,52 @@ void ChatManager::_processInviteAvatarToRoom(Message* message,DispatchClient* cl
 void ChatManager::_processUninviteAvatarFromRoom(Message* message, DispatchClient* client)
 {
 	gLogger->logMsg("Uninvite avatar from room");
-	string nameOfInvitedPlayer;
-	string roompath;
-	string roomname;
-	string game;
-	string server;
-	string playerName;
-
-	message->getStringAnsi(game);
-	message->getStringAnsi(server);
-	message->getStringAnsi(playerName);
-	message->getStringAnsi(roompath);
-
-	uint32 requestId = message->getUint32();
-
-	uint32 index = 5 + mGalaxyName.getLength();
-	roompath.substring(roomname, static_cast<uint16>(index), roompath.getLength());
-
-	Channel* channel = getChannelByName(roomname);
-	if (channel == NULL)
-	{
-		gLogger->logMsgF("No channel for room %s", MSG_NORMAL, roomname.getAnsi());
-		return;
-	}
-
-	// We use two versions of names, one with the real spelling and one with pure lowercase.
-	playerName.toLower();
-	string sender = BString(getPlayerByAccId(client->getAccountId())->getName().getAnsi());
-	string realSenderName = sender;
-	sender.toLower();
-
-	uint32 errorCode = 0;
-
-#ifdef DISP_REAL_FIRST_NAME
-	// Get real first name.
-	string* newName = getFirstName(playerName);
-	string realPlayerName;
+	_processRoomRequest(message,client,&ChatManager::_handleUninviteAvatarFromRoom);
+}
 
-	if (newName->getLength() == 0)
-	{
-		errorCode = 4;
-		realPlayerName = playerName;	// We have to stick with this name when error reporting.
-		gLogger->logMsgF("No player with name %s found\n", MSG_NORMAL, playerName.getAnsi());
-	}
-	else
-	{
-		realPlayerName = *newName;
-	}
-	delete newName;
-#else
-	// Lowercase
-	string realPlayerName = playerName;
-	realSenderName.toLower();
+//======================================================================================================================
 
-	// Well, the player don't have to be online.
-	if (!isValidName(playerName))
-	{
-		errorCode = 4;
-		gLogger->logMsgF("No player with name %s found", MSG_NORMAL, playerName.getAnsi());
-	}
-#endif
+void ChatManager::_handleUninviteAvatarFromRoom(ChatRoomRequest& request)
+{
 	// We check in logical order, even if we know that playername is not valid.
 	// Private channel?
-	if (!channel->isPrivate())
+	if (!request.mChannel->isPrivate())
 	{
-		errorCode = 9;
+		request.mErrorCode = 9;
 	}
 	// Request by Moderator?
-	else if ((!channel->isModerator(sender)) && (!channel->isOwner(sender)))
+	else if ((!request.mChannel->isModerator(request.mSender)) && (!request.mChannel->isOwner(request.mSender)))
 	{
-		errorCode = 16;
+		request.mErrorCode = 16;
 	}
 	// We are not allowed to uninvite the owner.
-	else if (channel->isOwner(playerName))
+	else if (request.mChannel->isOwner(request.mPlayerName))
 	{
 		// General failure
-		errorCode = 1;
+		request.mErrorCode = 1;
 	}
-	else if ((errorCode == 0) && (!channel->isInvited(playerName)))
+	else if ((request.mErrorCode == 0) && (!request.mChannel->isInvited(request.mPlayerName)))
 	{
 		// Allready invited
-		errorCode = 13;
+		request.mErrorCode = 13;
 	}
 
-	if (errorCode != 0)
+	if (request.mErrorCode != 0)
 	{
-		gChatMessageLib->sendChatFailedToUninviteFromRoom(client, mGalaxyName, realSenderName, realPlayerName, channel, errorCode, requestId);
+		gChatMessageLib->sendChatFailedToUninviteFromRoom(request.mClient, mGalaxyName, request.mRealSenderName, request.mRealPlayerName, request.mChannel, request.mErrorCode, request.mRequestId);
 	}
 	else
 	{
-		gLogger->logMsgF("PLayer %s becomes un-invited", MSG_NORMAL, realPlayerName.getAnsi());
-		(void)channel->removeInvitedUser(playerName);
+		gLogger->logMsgF("PLayer %s becomes un-invited", MSG_NORMAL, request.mRealPlayerName.getAnsi());
+		(void)request.mChannel->removeInvitedUser(request.mPlayerName);
 
 		int8 sql[128];
-		mDatabase->Escape_String(sql, playerName.getAnsi(), playerName.getLength());
+		mDatabase->Escape_String(sql, request.mPlayerName.getAnsi(), request.mPlayerName.getLength());
 
-		mDatabase->ExecuteSqlAsync(NULL, NULL, "DELETE FROM chat_channels_invited WHERE char_name = '%s' AND channel_id = %u;", sql /* playerName.getAnsi() */, channel->getId());
-		gChatMessageLib->sendChatOnUninviteFromRoom(client, mGalaxyName, realSenderName, realPlayerName, channel, requestId);
-		gChatMessageLib->sendChatQueryRoomResults(client, channel, 0);
+		mDatabase->ExecuteSqlAsync(NULL, NULL, "DELETE FROM chat_channels_invited WHERE char_name = '%s' AND channel_id = %u;", sql /* request.mPlayerName.getAnsi() */, request.mChannel->getId());
+		gChatMessageLib->sendChatOnUninviteFromRoom(request.mClient, mGalaxyName, request.mRealSenderName, request.mRealPlayerName, request.mChannel, request.mRequestId);
+		gChatMessageLib->sendChatQueryRoomResults(request.mClient, request.mChannel, 0);
 	}
-#ifdef DISP_REAL_FIRST_NAME
-	// delete realPlayerName;
-#endif
 }
 
 
@@ -1967,114 +1896,60 @@ void ChatManager::_processUninviteAvatarFromRoom(Message* message, DispatchClien
 void ChatManager::_processRemoveModFromRoom(Message* message,DispatchClient* client)
 {
 	gLogger->logMsg("Remove Moderator from room");
-	string playerName;
-	string roompath;
-	string roomname;
-	string game;
-	string server;
-
-	message->getStringAnsi(game);
-	message->getStringAnsi(server);
-	message->getStringAnsi(playerName);
-	message->getStringAnsi(roompath);
-	uint32 requestId = message->getUint32();
-
-	uint32 index = 5 + mGalaxyName.getLength();
-	roompath.substring(roomname, static_cast<uint16>(index), roompath.getLength());
-
-	Channel* channel = getChannelByName(roomname);
-	if (channel == NULL)
-	{
-		gLogger->logMsgF("No channel for room %s", MSG_NORMAL, roomname.getAnsi());
-		return;
-	}
-
-	// We use two versions of names, one with the real spelling and one with pure lowercase.
-	playerName.toLower();
-	string sender = BString(getPlayerByAccId(client->getAccountId())->getName().getAnsi());
-	string realSenderName = sender;
-	sender.toLower();
-
-	uint32 errorCode = 0;
-
-#ifdef DISP_REAL_FIRST_NAME
-	// Get real first name.
-	string* newName = getFirstName(playerName);
-	string realPlayerName;
+	_processRoomRequest(message,client,&ChatManager::_handleRemoveModFromRoom);
+}
 
-	if (newName->getLength() == 0)
-	{
-		errorCode = 4;
-		realPlayerName = playerName;	// We have to stick with this name when error reporting.
-		gLogger->logMsgF("No player with name %s found\n", MSG_NORMAL, playerName.getAnsi());
-	}
-	else
-	{
-		realPlayerName = *newName;
-	}
-	delete newName;
-#else
-	// Lowercase
-	string realPlayerName = playerName;
-	realSenderName.toLower();
+//======================================================================================================================
 
-	// Well, the player don't have to be online.
-	if (!isValidName(playerName))
-	{
-		errorCode = 4;
-		gLogger->logMsgF("No player with name %s found", MSG_NORMAL, playerName.getAnsi());
-	}
-#endif
+void ChatManager::_handleRemoveModFromRoom(ChatRoomRequest& request)
+{
 	// We check in logical order, even if we know that playername is not valid.
-	if (!channel->isModerated())
+	if (!request.mChannel->isModerated())
 	{
 		// Channel is not moderated.
-		errorCode = 9;
+		request.mErrorCode = 9;
 		gLogger->logMsg("Channel is not moderated", MSG_NORMAL);
 		// gChatMessageLib->sendChatFailedToRemoveMod(client, mGalaxyName, sender, playername, channel, 9, requestId);
 		// return;
 	}
-	else if ((!channel->isModerator(sender)) && (!channel->isOwner(sender)))
+	else if ((!request.mChannel->isModerator(request.mSender)) && (!request.mChannel->isOwner(request.mSender)))
 	{
 		// Must be owner or moderator to operate the channel.
-		errorCode = 16;
+		request.mErrorCode = 16;
 		// gChatMessageLib->sendChatFailedToRemoveMod(client, mGalaxyName, sender, playername, channel, 16, requestId);
 		// return;
 	}
-	else if (errorCode == 0) // Target player has a valid name...
+	else if (request.mErrorCode == 0) // Target player has a valid name...
 	{
 		// We are not allowed to remove the owner.
-		if (channel->isOwner(playerName))
+		if (request.mChannel->isOwner(request.mPlayerName))
 		{
 			// General failure.
-			errorCode = 1;
+			request.mErrorCode = 1;
 			// gChatMessageLib->sendChatFailedToRemoveMod(client, mGalaxyName, sender, playername, channel, 1, requestId);
 			// return;
 		}
-		else if (!channel->isModerator(playerName)) // Player is not a moderator...
+		else if (!request.mChannel->isModerator(request.mPlayerName)) // Player is not a moderator...
 		{
 			// General failure.
-			errorCode = 1;
+			request.mErrorCode = 1;
 			// gChatMessageLib->sendChatFailedToRemoveMod(client, mGalaxyName, sender, playername, channel, 1, requestId);
 			// return;
 		}
 	}
-	if (errorCode != 0)
+	if (request.mErrorCode != 0)
 	{
-		gChatMessageLib->sendChatFailedToRemoveMod(client, mGalaxyName, realSenderName, realPlayerName, channel, errorCode, requestId);
+		gChatMessageLib->sendChatFailedToRemoveMod(request.mClient, mGalaxyName, request.mRealSenderName, request.mRealPlayerName, request.mChannel, request.mErrorCode, request.mRequestId);
 	}
 	else
 	{
-		(void)channel->removeModerator(playerName);
+		(void)request.mChannel->removeModerator(request.mPlayerName);
 		int8 sql[128];
-		mDatabase->Escape_String(sql, playerName.getAnsi(), playerName.getLength());
+		mDatabase->Escape_String(sql, request.mPlayerName.getAnsi(), request.mPlayerName.getLength());
 
-		mDatabase->ExecuteSqlAsync(NULL, NULL, "DELETE FROM chat_channels_moderators WHERE char_name = '%s' AND channel_id = %u;", sql /* playerName.getAnsi() */, channel->getId());
-		gChatMessageLib->sendChatOnRemoveModeratorFromRoom(client, mGalaxyName, realSenderName, realPlayerName, channel, requestId);
+		mDatabase->ExecuteSqlAsync(NULL, NULL, "DELETE FROM chat_channels_moderators WHERE char_name = '%s' AND channel_id = %u;", sql /* request.mPlayerName.getAnsi() */, request.mChannel->getId());
+		gChatMessageLib->sendChatOnRemoveModeratorFromRoom(request.mClient, mGalaxyName, request.mRealSenderName, request.mRealPlayerName, request.mChannel, request.mRequestId);
 	}
-#ifdef DISP_REAL_FIRST_NAME
-	// delete realPlayerName;
-#endif
 }
 
 //======================================================================================================================
@@ -2125,112 +2000,60 @@ void ChatManager::_processRemoveAvatarFromRoom(Message* message,DispatchClient*
 void ChatManager::_processBanAvatarFromRoom(Message* message,DispatchClient* client)
 {
 	gLogger->logMsg("Ban Avatar from room");
-	string playerName;
-	string roompath;
-	string roomname;
-	string game;
-	string server;
-
-	message->getStringAnsi(game);
-	message->getStringAnsi(server);
-	message->getStringAnsi(playerName);
-	message->getStringAnsi(roompath);
-	uint32 requestId = message->getUint32();
-
-	uint32 index = 5 + mGalaxyName.getLength();
-	roompath.substring(roomname, static_cast<uint16>(index), roompath.getLength());
-
-	Channel* channel = getChannelByName(roomname);
-	if (channel == NULL)
-	{
-		gLogger->logMsgF("No channel for room %s", MSG_NORMAL, roomname.getAnsi());
-		return;
-	}
-
-	// We use two versions of names, one with the real spelling and one with pure lowercase.
-	playerName.toLower();
-	string sender = BString(getPlayerByAccId(client->getAccountId())->getName().getAnsi());
-	string realSenderName = sender;
-	sender.toLower();
-
-	uint32 errorCode = 0;
-
-#ifdef DISP_REAL_FIRST_NAME
-	// Get real first name.
-	string* newName = getFirstName(playerName);
-	string realPlayerName;
+	_processRoomRequest(message,client,&ChatManager::_handleBanAvatarFromRoom);
+}
 
-	if (newName->getLength() == 0)
-	{
-		errorCode = 4;
-		realPlayerName = playerName;	// We have to stick with this name when error reporting.
-		gLogger->logMsgF("No player with name %s found\n", MSG_NORMAL, playerName.getAnsi());
-	}
-	else
-	{
-		realPlayerName = *newName;
-	}
-	delete newName;
-#else
-	// Lowercase
-	string realPlayerName = playerName;
-	realSenderName.toLower();
+//======================================================================================================================
 
-	// Well, the player don't have to be online.
-	if (!isValidName(playerName))
-	{
-		errorCode = 4;
-		gLogger->logMsgF("No player with name %s found", MSG_NORMAL, playerName.getAnsi());
-	}
-#endif
+void ChatManager::_handleBanAvatarFromRoom(ChatRoomRequest& request)
+{
 	// We check in logical order, even if we know that playername is not valid.
-
-	if ((!channel->isModerator(sender)) && (!channel->isOwner(sender)))
+	if ((!request.mChannel->isModerator(request.mSender)) && (!request.mChannel->isOwner(request.mSender)))
 	{
-		errorCode = 16;
+		request.mErrorCode = 16;
 	}
-	else if (errorCode == 0)
+	else if (request.mErrorCode == 0)
 	{
 		// Don't ban the owner.
-		if (channel->isOwner(playerName))
+		if (request.mChannel->isOwner(request.mPlayerName))
 		{
 			// General failure.
-			errorCode = 1;
+			request.mErrorCode = 1;
 		}
 		// Player banned?
-		else if (channel->isBanned(playerName))
+		else if (request.mChannel->isBanned(request.mPlayerName))
 		{
 			// General failure
-			errorCode = 1;
+			request.mErrorCode = 1;
 		}
 	}
 
-	if (errorCode != 0)
+	if (request.mErrorCode != 0)
 	{
-		gChatMessageLib->sendChatFailedToBan(client, mGalaxyName, realSenderName, realPlayerName, channel, errorCode, requestId);
+		gChatMessageLib->sendChatFailedToBan(request.mClient, mGalaxyName, request.mRealSenderName, request.mRealPlayerName, request.mChannel, request.mErrorCode, request.mRequestId);
 	}
 	else
 	{
-		gLogger->logMsgF("PLayer %s becomes kicked, banned and un-invited", MSG_NORMAL, playerName.getAnsi());
+		gLogger->logMsgF("PLayer %s becomes kicked, banned and un-invited", MSG_NORMAL, request.mPlayerName.getAnsi());
 
 		// Kick the player if present in channel.
-		ChatAvatarId* avatar = channel->findUser(playerName);
+		ChatAvatarId* avatar = request.mChannel->findUser(request.mPlayerName);
 		if (avatar)
 		{
-			mDatabase->ExecuteSqlAsync(NULL, NULL, "DELETE FROM chat_char_channels WHERE channel_id = %u AND character_id = %"PRIu64";", channel->getId(), avatar->getPlayer()->getCharId());
-			gChatMessageLib->sendChatOnLeaveRoom(client, avatar, channel, 0, errorCode);
+			mDatabase->ExecuteSqlAsync(NULL, NULL, "DELETE FROM chat_char_channels WHERE channel_id = %u AND character_id = %"PRIu64";", request.mChannel->getId(), avatar->getPlayer()->getCharId());
+			gChatMessageLib->sendChatOnLeaveRoom(request.mClient, avatar, request.mChannel, 0, request.mErrorCode);
 			// gChatMessageLib->sendChatQueryRoomResults(client, channel, 0);	// Update clients before we remove the poor banned one.
-			channel->removeUser(playerName);
+			request.mChannel->removeUser(request.mPlayerName);
 		}
 
 		int8 sql[128];
 		// Un-invite player if invited.
-		if (channel->isPrivate() && channel->isInvited(playerName))
+		if (request.mChannel->isPrivate() && request.mChannel->isInvited(request.mPlayerName))
 		{
-			(void)channel->removeInvitedUser(playerName);
-			mDatabase->Escape_String(sql, playerName.getAnsi(), playerName.getLength());
+			(void)request.mChannel->removeInvitedUser(request.mPlayerName);
+			mDatabase->Escape_String(sql, request.mPlayerName.getAnsi(), request.mPlayerName.getLength());
 
-			mDatabase->ExecuteSqlAsync(NULL, NULL, "DELETE FROM chat_channels_invited WHERE char_name = '%s' AND channel_id = %u;", sql /* playerName.getAnsi() */, channel->getId());
+			mDatabase->ExecuteSqlAsync(NULL, NULL, "DELETE FROM chat_channels_invited WHERE char_name = '%s' AND channel_id = %u;", sql /* request.mPlayerName.getAnsi() */, request.mChannel->getId());
 			// Removed since it gives un-wanted spam back to client.
 			// gChatMessageLib->sendChatOnUninviteFromRoom(client, mGalaxyName, realSenderName, realPlayerName, channel, 0);
 
@@ -2238,17 +2061,13 @@ void ChatManager::_processBanAvatarFromRoom(Message* message,DispatchClient* cli
 		}
 
 		// Get the ban-stick in ready position
-		channel->banUser(&playerName);
+		request.mChannel->banUser(&request.mPlayerName);
 		// int8 sql[128];
-		mDatabase->Escape_String(sql, playerName.getAnsi(), playerName.getLength());
-		mDatabase->ExecuteSqlAsync(NULL, NULL, "INSERT INTO chat_channels_banned VALUES (%u, '%s');", channel->getId(), sql /* playerName.getAnsi()*/);
-		gChatMessageLib->sendChatOnBanAvatarFromRoom(client, mGalaxyName, realSenderName, realPlayerName, channel, requestId);
-		gChatMessageLib->sendChatQueryRoomResults(client, channel, 0);
+		mDatabase->Escape_String(sql, request.mPlayerName.getAnsi(), request.mPlayerName.getLength());
+		mDatabase->ExecuteSqlAsync(NULL, NULL, "INSERT INTO chat_channels_banned VALUES (%u, '%s');", request.mChannel->getId(), sql /* request.mPlayerName.getAnsi()*/);
+		gChatMessageLib->sendChatOnBanAvatarFromRoom(request.mClient, mGalaxyName, request.mRealSenderName, request.mRealPlayerName, request.mChannel, request.mRequestId);
+		gChatMessageLib->sendChatQueryRoomResults(request.mClient, request.mChannel, 0);
 	}
-
-#ifdef DISP_REAL_FIRST_NAME
-	// delete realPlayerName;
-#endif
 }
 
 //======================================================================================================================
@@ -2256,95 +2075,41 @@ void ChatManager::_processBanAvatarFromRoom(Message* message,DispatchClient* cli
 void ChatManager::_processUnbanAvatarFromRoom(Message* message,DispatchClient* client)
 {
 	// gLogger->logMsg("Unban avatar from room");
-	string playerName;
-	string roompath;
-	string roomname;
-	string game;
-	string server;
-
-	message->getStringAnsi(game);
-	message->getStringAnsi(server);
-	message->getStringAnsi(playerName);
-	message->getStringAnsi(roompath);
-	uint32 requestId = message->getUint32();
-
-	uint32 index = 5 + mGalaxyName.getLength();
-	roompath.substring(roomname, static_cast<uint16>(index), roompath.getLength());
-
-	Channel* channel = getChannelByName(roomname);
-	if (channel == NULL)
-	{
-		gLogger->logMsgF("No channel for room %s", MSG_NORMAL, roomname.getAnsi());
-		return;
-	}
-
-	// We use two versions of names, one with the real spelling and one with pure lowercase.
-	playerName.toLower();
-	string sender = BString(getPlayerByAccId(client->getAccountId())->getName().getAnsi());
-	string realSenderName = sender;
-	sender.toLower();
-
-	uint32 errorCode = 0;
-
-#ifdef DISP_REAL_FIRST_NAME
-	// Get real first name.
-	string* newName = getFirstName(playerName);
-	string realPlayerName;
+	_processRoomRequest(message,client,&ChatManager::_handleUnbanAvatarFromRoom);
+}
 
-	if (newName->getLength() == 0)
-	{
-		errorCode = 4;
-		realPlayerName = playerName;	// We have to stick with this name when error reporting.
-		gLogger->logMsgF("No player with name %s found\n", MSG_NORMAL, playerName.getAnsi());
-	}
-	else
-	{
-		realPlayerName = *newName;
-	}
-	delete newName;
-#else
-	// Lowercase
-	string realPlayerName = playerName;
-	realSenderName.toLower();
+//======================================================================================================================
 
-	// Well, the player don't have to be online.
-	if (!isValidName(playerName))
-	{
-		errorCode = 4;
-		gLogger->logMsgF("No player with name %s found", MSG_NORMAL, playerName.getAnsi());
-	}
-#endif
+void ChatManager::_handleUnbanAvatarFromRoom(ChatRoomRequest& request)
+{
 	// We check in logical order, even if we know that playername is not valid.
-	if ((!channel->isModerator(sender)) && (!channel->isOwner(sender)))
+	if ((!request.mChannel->isModerator(request.mSender)) && (!request.mChannel->isOwner(request.mSender)))
 	{
-		errorCode = 16;
+		request.mErrorCode = 16;
 	}
-	else if (errorCode == 0)
+	else if (request.mErrorCode == 0)
 	{
 		// Player not banned?
-		if (!channel->isBanned(playerName))
+		if (!request.mChannel->isBanned(request.mPlayerName))
 		{
 			// General failure
-			errorCode = 1;
+			request.mErrorCode = 1;
 		}
 	}
-	if (errorCode != 0)
+	if (request.mErrorCode != 0)
 	{
-		gLogger->logMsgF("Can't un-ban player %s", MSG_NORMAL, realPlayerName.getAnsi());
-		gChatMessageLib->sendChatFailedToUnban(client, mGalaxyName, realSenderName, realPlayerName, channel, errorCode, requestId);
+		gLogger->logMsgF("Can't un-ban player %s", MSG_NORMAL, request.mRealPlayerName.getAnsi());
+		gChatMessageLib->sendChatFailedToUnban(request.mClient, mGalaxyName, request.mRealSenderName, request.mRealPlayerName, request.mChannel, request.mErrorCode, request.mRequestId);
 	}
 	else
 	{
-		(void)channel->unBanUser(playerName);
+		(void)request.mChannel->unBanUser(request.mPlayerName);
 		int8 sql[128];
-		mDatabase->Escape_String(sql, playerName.getAnsi(), playerName.getLength());
+		mDatabase->Escape_String(sql, request.mPlayerName.getAnsi(), request.mPlayerName.getLength());
 
-		mDatabase->ExecuteSqlAsync(NULL, NULL, "DELETE FROM chat_channels_banned WHERE char_name = '%s' AND channel_id = %u;", sql /* playerName.getAnsi() */, channel->getId());
-		gChatMessageLib->sendChatOnUnBanAvatarFromRoom(client, mGalaxyName, realSenderName, realPlayerName, channel, requestId);
+		mDatabase->ExecuteSqlAsync(NULL, NULL, "DELETE FROM chat_channels_banned WHERE char_name = '%s' AND channel_id = %u;", sql /* request.mPlayerName.getAnsi() */, request.mChannel->getId());
+		gChatMessageLib->sendChatOnUnBanAvatarFromRoom(request.mClient, mGalaxyName, request.mRealSenderName, request.mRealPlayerName, request.mChannel, request.mRequestId);
 	}
-#ifdef DISP_REAL_FIRST_NAME
-	// delete realPlayerName;
-#endif
 }
 
 //======================================================================================================================
@@ -3098,33 +2863,12 @@ void ChatManager::_handleFindFriendDBReply(Player* player,uint64 retCode,string
 
 //======================================================================================================================
 
-bool ChatManager::isValidName(string name)
-{
-	// DatabaseResult* result = mDatabase->ExecuteSql("SELECT id FROM characters WHERE LCASE(firstname) = '%s';", name.getAnsi());
-	int8 sql[128];
-	mDatabase->Escape_String(sql, name.getAnsi(), name.getLength());
-
-	DatabaseResult* result = mDatabase->ExecuteSynchSql("SELECT id FROM characters WHERE LCASE(firstname) = '%s';", sql);
-
-	bool valid = (result->getRowCount() == 1);
-	mDatabase->DestroyResult(result);
-
-	return valid;
-}
-
-
-//======================================================================================================================
-
-bool ChatManager::isValidExactName(string name)
+void ChatManager::_queryValidName(string name,const DatabaseContinuation& continuation)
 {
 	int8 sql[128];
 	mDatabase->Escape_String(sql, name.getAnsi(), name.getLength());
-	DatabaseResult* result = mDatabase->ExecuteSynchSql("SELECT id FROM characters WHERE BINARY firstname = '%s';", sql);
-
-	bool valid = (result->getRowCount() == 1);
-	mDatabase->DestroyResult(result);
 
-	return valid;
+	mDatabase->ExecuteSqlAsyncThen(continuation,"SELECT id FROM characters WHERE LCASE(firstname) = '%s';", sql);
 }
 
 //======================================================================================================================
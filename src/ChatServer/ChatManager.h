@@ -68,7 +68,8 @@ enum ChatQuery
 	ChatQuery_Banned			= 15,
 	ChatQuery_Invited			= 16,
 	ChatQuery_CharChannels		= 17,
-	ChatMailQuery_PlayerIgnores = 18
+	ChatMailQuery_PlayerIgnores = 18,
+	ChatQuery_ValidName			= 19
 };
 
 //======================================================================================================================
@@ -82,6 +83,8 @@ public:
 		, mSender(NULL)
 		, mReceiver(NULL)
 		, mMailCounter(0)
+		, mAccountId(0)
+		, mChannelId(0)
 	{}
 
 	~ChatAsyncContainer(){}
@@ -95,11 +98,28 @@ public:
 	uint64			mReceiverId;
 	uint32			mRequestId;
 	uint32			mMailCounter;
+	uint32			mAccountId;
+	uint32			mChannelId;
 	string			mName;
 };
 
 //======================================================================================================================
 
+class ChatRoomRequest
+{
+public:
+	DispatchClient*	mClient;
+	Channel*		mChannel;
+	string			mSender;
+	string			mRealSenderName;
+	string			mPlayerName;
+	string			mRealPlayerName;
+	uint32			mRequestId;
+	uint32			mErrorCode;
+};
+
+//======================================================================================================================
+
 class ChatManager : public MessageDispatchCallback, public DatabaseCallback
 {
 	public:
@@ -164,13 +184,23 @@ class ChatManager : public MessageDispatchCallback, public DatabaseCallback
 		void			_processRoomMessage(Message* message,DispatchClient* client);
 		void			_processSendToRoom(Message* message,DispatchClient* client);
 		void			_processEnterRoomById(Message* message,DispatchClient* client);
+		// moderation requests naming another player, the handler runs once the name has been checked
+		typedef void	(ChatManager::*RoomRequestHandler)(ChatRoomRequest& request);
+		void			_processRoomRequest(Message* message,DispatchClient* client,RoomRequestHandler handler);
+		void			_handleRoomRequest(RoomRequestHandler handler,ChatAsyncContainer* asyncContainer,DatabaseResult* result);
 		void			_processAddModeratorToRoom(Message* message,DispatchClient* client);
+		void			_handleAddModeratorToRoom(ChatRoomRequest& request);
 		void			_processInviteAvatarToRoom(Message* message,DispatchClient* client);
+		void			_handleInviteAvatarToRoom(ChatRoomRequest& request);
 		void			_processUninviteAvatarFromRoom(Message* message, DispatchClient* client);
+		void			_handleUninviteAvatarFromRoom(ChatRoomRequest& request);
 		void			_processRemoveModFromRoom(Message* message,DispatchClient* client);
+		void			_handleRemoveModFromRoom(ChatRoomRequest& request);
 		void			_processRemoveAvatarFromRoom(Message* message,DispatchClient* client);
 		void			_processBanAvatarFromRoom(Message* message,DispatchClient* client);
+		void			_handleBanAvatarFromRoom(ChatRoomRequest& request);
 		void			_processUnbanAvatarFromRoom(Message* message,DispatchClient* client);
+		void			_handleUnbanAvatarFromRoom(ChatRoomRequest& request);
 		void			_processAvatarId(Message* message,DispatchClient* client);
 		void			_processLeaveRoom(Message*message, DispatchClient* client);
 
@@ -209,8 +239,7 @@ class ChatManager : public MessageDispatchCallback, public DatabaseCallback
 		static bool				mInsFlag;
 		static ChatManager*		mSingleton;
 
-		bool					isValidName(string name);
-		bool					isValidExactName(string name);
+		void					_queryValidName(string name,const DatabaseContinuation& continuation);
 		string*					getFirstName(string& name);
 
 		Database*				mDatabase;
@@ -114,6 +114,7 @@ ChatServer::ChatServer() : mNetworkManager(0),mDatabaseManager(0),mRouterService
 	_updateDBServerList(2);
 
 	gLogger->logMsg("ChatServer::Startup Complete");
+	mDatabase->setStartupComplete();
 	//gLogger->printLogo();
 	// std::string BuildString(GetBuildString());
 
@@ -254,7 +254,36 @@ void ClientManager::_processSelectCharacter(ConnectionClient* client, Message* m
 {
   uint64 characterId = message->getUint64();
 
-  DatabaseResult* result = mDatabase->ExecuteSynchSql("SELECT planet_id FROM characters WHERE id=%I64u;", characterId);
+  // the message is gone once we return, keep a copy of the raw data for the zone
+  std::string selectData(message->getData(), message->getSize());
+
+  // look up the zone of the character and route the select once we know it
+  mDatabase->ExecuteSqlAsyncThen(std::tr1::bind(&ClientManager::_handleSelectCharacter, this, client->getAccountId(), characterId, selectData, std::tr1::placeholders::_1),
+                                 "SELECT planet_id FROM characters WHERE id=%"PRIu64";", characterId);
+}
+
+
+//======================================================================================================================
+void ClientManager::_handleSelectCharacter(uint32 accountId, uint64 characterId, const std::string& selectData, DatabaseResult* result)
+{
+  // the client may have disconnected while we were waiting on the db
+  boost::recursive_mutex::scoped_lock lk(mServiceMutex);
+  PlayerClientMap::iterator iter = mPlayerClientMap.find(accountId);
+
+  if(iter == mPlayerClientMap.end())
+  {
+    return;
+  }
+
+  ConnectionClient* client = (*iter).second;
+
+  // no such character, don't leave the client waiting for a zone that never answers
+  if(!result->getRowCount())
+  {
+    gLogger->logMsgF("ClientManager: account %u selected unknown character %"PRIu64", disconnecting", MSG_NORMAL, accountId, characterId);
+    client->Disconnect(0);
+    return;
+  }
 
   uint32 serverId;
   DataBinding* binding = mDatabase->CreateDataBinding(1);
@@ -264,7 +293,6 @@ void ClientManager::_processSelectCharacter(ConnectionClient* client, Message* m
   client->setServerId(serverId + 8);  // server ids for zones are planetId + 8;
 
   mDatabase->DestroyDataBinding(binding);
-  mDatabase->DestroyResult(result);
 
   // send an opClusterClientConnect message to zone server.
   gMessageFactory->StartMessage();
@@ -293,7 +321,7 @@ void ClientManager::_processSelectCharacter(ConnectionClient* client, Message* m
 
   // Now send the SelectCharacter message off to the zone server.
   gMessageFactory->StartMessage();
-  gMessageFactory->addData(message->getData(), message->getSize());
+  gMessageFactory->addData((int8*)selectData.data(), static_cast<uint16>(selectData.size()));
   Message* selectMessage = gMessageFactory->EndMessage();
 
   selectMessage->setAccountId(client->getAccountId());
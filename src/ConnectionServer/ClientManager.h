@@ -18,6 +18,7 @@ Copyright (c) 2006 - 2010 The swgANH Team
 
 #include <boost/thread/recursive_mutex.hpp>
 #include <map>
+#include <string>
 
 
 //======================================================================================================================
@@ -66,6 +67,7 @@ class ClientManager : public NetworkCallback, public ConnectionDispatchCallback,
 		void                        _processClusterZoneTransferCharacter(ConnectionClient* client, Message* message);
 
 		void                        _handleQueryAuth(ConnectionClient* client, DatabaseResult* result);
+		void                        _handleSelectCharacter(uint32 accountId, uint64 characterId, const std::string& selectData, DatabaseResult* result);
 
 
 		Service*                    mClientService;
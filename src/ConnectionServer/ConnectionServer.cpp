@@ -112,6 +112,7 @@ mLocked(false)
 	// We're done initiailizing.
 	_updateDBServerList(2);
 	gLogger->logMsg("ConnectionServer::Server Boot Complete", FOREGROUND_GREEN);
+	mDatabase->setStartupComplete();
 	//gLogger->printLogo();
 	// std::string BuildString(GetBuildString());	
 
@@ -186,11 +187,11 @@ void ConnectionServer::ToggleLock()
 	if(mLocked)
 	{
 		// Update our status for the LoginServer
-		mDatabase->DestroyResult(mDatabase->ExecuteSynchSql("UPDATE galaxy SET status=3,last_update=NOW() WHERE galaxy_id=%u;",mClusterId));
+		mDatabase->ExecuteSqlAsync(0,0,"UPDATE galaxy SET status=3,last_update=NOW() WHERE galaxy_id=%u;",mClusterId);
 		gLogger->logMsg("Locking server to normal users");
 	} else {
 		// Update our status for the LoginServer
-		mDatabase->DestroyResult(mDatabase->ExecuteSynchSql("UPDATE galaxy SET status=2,last_update=NOW() WHERE galaxy_id=%u;",mClusterId));
+		mDatabase->ExecuteSqlAsync(0,0,"UPDATE galaxy SET status=2,last_update=NOW() WHERE galaxy_id=%u;",mClusterId);
 		gLogger->logMsg("unlocking server to normal users");
 	}
 }
@@ -15,9 +15,12 @@ Copyright (c) 2006 - 2010 The swgANH Team
 #include "DatabaseCallback.h"
 #include "DatabaseImplementation.h"
 #include "DatabaseImplementationMySql.h"
+#include "DatabaseImplementationSqlite.h"
 #include "DatabaseJob.h"
 #include "DatabaseType.h"
 #include "DatabaseWorkerThread.h"
+#include "QueryStatistics.h"
+#include "ReferenceCache.h"
 #include "Transaction.h"
 
 #include "LogManager/LogManager.h"
@@ -27,12 +30,20 @@ Copyright (c) 2006 - 2010 The swgANH Team
 #include <cstdarg>
 #include <cstdlib>
 #include <cstdio>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
 
 //======================================================================================================================
 Database::Database(DBType type, char* host, uint16 port, char* user, char* pass, char* schema) :
 mDatabaseType(type),
 mDataBindingFactory(0),
 mDatabaseImplementation(0),
+mMainThreadId(boost::this_thread::get_id()),
+mStartupComplete(false),
+mQueryStatistics(NULL),
+mReferenceCache(NULL),
+mReferenceCacheChecked(false),
 mJobPool(sizeof(DatabaseJob)),
 mTransactionPool(sizeof(Transaction))
 {
@@ -49,12 +60,42 @@ mTransactionPool(sizeof(Transaction))
 		}
 		break;
 
+#if defined(ANH_WITH_SQLITE)
+		case DBTYPE_SQLITE:
+		{
+			DatabaseImplementationSqlite* sqlite = new DatabaseImplementationSqlite(host, port, user, pass, schema);
+
+			// a new database gets its schema and seed data, before any worker connects
+			if(sqlite->isEmpty())
+			{
+				_loadScripts(sqlite,gConfig->read<std::string>("DBScripts",""));
+			}
+
+			mDatabaseImplementation = sqlite;
+		}
+		break;
+#endif
+
 		default:break;
 	}
 
   // Create our worker threads and put them in the idle queue
   mMinThreads = gConfig->read<uint32>("DBMinThreads");
   mMaxThreads = gConfig->read<uint32>("DBMaxThreads");
+
+  // debug aid, reports every synchronous query that stalls the main thread once the server is up
+  mReportSynchSql = gConfig->read<bool>("DBReportSynchSql",false);
+
+  // max number of transactions sharing one commit
+  mTransactionGroupSize = gConfig->read<uint32>("DBTransactionGroupSize",32);
+  if(!mTransactionGroupSize)
+	  mTransactionGroupSize = 1;
+
+  // latency histograms per call site and the log of slow queries
+  if(gConfig->read<bool>("DBQueryStatistics",false))
+  {
+	  mQueryStatistics = new QueryStatistics(gConfig->read<uint32>("DBSlowQueryThreshold",100),gConfig->read<uint32>("DBSlowQueryLogSize",64));
+  }
   DatabaseWorkerThread* newWorker = 0;
   for (uint32 i = 0; i < mMinThreads; i++)
   {
@@ -65,6 +106,39 @@ mTransactionPool(sizeof(Transaction))
 }
 
 
+//======================================================================================================================
+//
+// runs the comma separated list of sql files, in order
+//
+
+void Database::_loadScripts(DatabaseImplementationSqlite* implementation,const std::string& scripts)
+{
+#if defined(ANH_WITH_SQLITE)
+	std::string::size_type start = 0;
+
+	while(start < scripts.length())
+	{
+		std::string::size_type end = scripts.find(',',start);
+
+		if(end == std::string::npos)
+			end = scripts.length();
+
+		std::string fileName = scripts.substr(start,end - start);
+
+		// trim
+		fileName.erase(0,fileName.find_first_not_of(" \t"));
+		fileName.erase(fileName.find_last_not_of(" \t") + 1);
+
+		if(!fileName.empty() && !implementation->ExecuteScript(fileName.c_str()))
+		{
+			gLogger->logMsgF("Database: %s failed",MSG_HIGH,fileName.c_str());
+		}
+
+		start = end + 1;
+	}
+#endif
+}
+
 //======================================================================================================================
 Database::~Database(void)
 {
@@ -79,6 +153,14 @@ Database::~Database(void)
 	//shutdown local implementation
 	delete(mDatabaseImplementation);
 
+	delete(mQueryStatistics);
+
+	if(mReferenceCache)
+	{
+		mReferenceCache->save();
+		delete(mReferenceCache);
+	}
+
 	// Shutdown our factories and destroy them.
 	delete(mDataBindingFactory);
 }
@@ -90,6 +172,12 @@ void Database::Process(void)
 	DatabaseWorkerThread* worker = 0;
 	DatabaseJob* job = 0;
 
+	// the transactions of the last tick go out together
+	if(mTransactionGroup.size())
+	{
+		_pushTransactionGroup();
+	}
+
 	// Check to see if we have an idle worker, and a job to give it.
 	if(mWorkerIdleQueue.size() && mJobPendingQueue.size())
 	{
@@ -97,6 +185,8 @@ void Database::Process(void)
 		worker	= mWorkerIdleQueue.pop();
 		job		= mJobPendingQueue.pop();
 
+		job->getTimes().mDispatch = QueryStatistics::getTime();
+
 		// Hand The job to the worker.
 		worker->ExecuteJob(job);
 	}
@@ -109,15 +199,54 @@ void Database::Process(void)
 		// pop a job
 		job = mJobCompleteQueue.pop();
 
-		// let our client handle the result, if theres a callback
-		if(job && job->getCallback())
+		job->getTimes().mCallback = QueryStatistics::getTime();
+
+		// transactions report their own results
+		if(job->isTransactionJob())
+		{
+			TransactionList& group = job->getTransactions();
+
+			for(uint32 t = 0; t < group.size(); t++)
+			{
+				group[t]->complete();
+				destroyTransaction(group[t]);
+			}
+
+			_recordJob(job);
+
+			job->~DatabaseJob();
+			mJobPool.ordered_free(job);
+			continue;
+		}
+
+		// a reference query seen for the first time, keep its rows before the callback moves the row index
+		if(job->isReferenceQuery() && !job->isCachedResult() && mReferenceCache && job->getDatabaseResult()->getResultSetReference())
+		{
+			std::vector<std::string> cells;
+			uint32 columnCount = mDatabaseImplementation->GetRawRows(job->getDatabaseResult(),cells);
+
+			mReferenceCache->store(job->getSql(),columnCount,cells);
+		}
+
+		// let our client handle the result, if theres a callback or a continuation
+		if(job->getContinuation())
+		{
+			job->getContinuation()(job->getDatabaseResult());
+		}
+		else if(job->getCallback())
 		{
 			job->getCallback()->handleDatabaseJobComplete(job->getClientReference(), job->getDatabaseResult());
 		}
 
+		_recordJob(job);
+
 		// Free the result and the job
-		this->DestroyResult(job->getDatabaseResult());
+		if(job->isCachedResult())
+			delete(job->getDatabaseResult());
+		else
+			this->DestroyResult(job->getDatabaseResult());
 
+		job->~DatabaseJob();
 		mJobPool.ordered_free(job);
 	}
 }
@@ -125,19 +254,37 @@ void Database::Process(void)
 //======================================================================================================================
 DatabaseResult* Database::ExecuteSynchSql(const int8* sql, ...)
 {
-	int8 message[8192];
-
-
 	// format our sql string
 	va_list args;
 	va_start(args, sql);
 	int8    localSql[8192];
 	/*int32 len = */vsnprintf(localSql, sizeof(localSql), sql, args);
 
-	sprintf(message, "WARNING: SYNCHRONOUS SQL STATEMENT: %s",localSql);
-	gLogger->logMsg(message, FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_BLUE | BACKGROUND_RED);
+	// startup queries are expected to block, after that the main loop should never wait on the db
+	if(mReportSynchSql && mStartupComplete && boost::this_thread::get_id() == mMainThreadId)
+	{
+		int8 message[8192];
+		snprintf(message, sizeof(message), "WARNING: SYNCHRONOUS SQL STATEMENT ON MAIN THREAD: %s",localSql);
+		gLogger->logMsg(message, FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_BLUE | BACKGROUND_RED);
+	}
 
 	va_end(args);
+
+	// synchronous queries only have an execution time
+	if(mQueryStatistics && boost::this_thread::get_id() == mMainThreadId)
+	{
+		QueryTimes times;
+		times.mEnqueue = times.mDispatch = times.mExecute = QueryStatistics::getTime();
+
+		DatabaseResult* result = ExecuteSql(localSql);
+
+		times.mComplete = times.mCallback = times.mDone = QueryStatistics::getTime();
+
+		mQueryStatistics->record(QueryStatistics::getTag(sql),localSql,times);
+
+		return result;
+	}
+
 	return ExecuteSql(localSql);
 }
 DatabaseResult* Database::ExecuteSql(const int8* sql, ...)
@@ -173,15 +320,128 @@ void Database::ExecuteSqlAsync(DatabaseCallback* callback, void* ref, const int8
 
 	//gLogger->logMsgF("SqlDump: len:%u - %s", MSG_LOW, len, localSql);
 
-	// Setup our job.
+	_pushJob(callback,ref,DatabaseContinuation(),localSql,false,sql);
+
+	va_end(args);
+}
+
+//======================================================================================================================
+//
+// a query served from the reference cache skips the workers, its callback runs with the next Process() like any other
+// on a miss the query runs as usual and its rows get cached on completion
+//
+
+void Database::ExecuteReferenceSqlAsync(DatabaseCallback* callback, void* ref, const int8* sql, ...)
+{
+	// format our sql string
+	va_list args;
+	va_start(args, sql);
+	int8    localSql[8192];
+	/*int32 len = */vsnprintf(localSql, sizeof(localSql), sql, args);
+	va_end(args);
+
+	if(!mReferenceCacheChecked)
+	{
+		_initReferenceCache();
+	}
+
+	if(!mReferenceCache)
+	{
+		_pushJob(callback,ref,DatabaseContinuation(),localSql,false,sql);
+		return;
+	}
+
+	const ReferenceTable* table = mReferenceCache->find(localSql);
+
+	if(!table)
+	{
+		_pushJob(callback,ref,DatabaseContinuation(),localSql,false,sql,true);
+		return;
+	}
+
 	DatabaseJob* job = new(mJobPool.ordered_malloc()) DatabaseJob();
 	job->setCallback(callback);
 	job->setClientReference(ref);
 	job->setSql(localSql);
-	job->setMultiJob(false);
+	job->setReferenceQuery(true);
+	job->setCachedResult(true);
+	job->setDatabaseResult(new ReferenceResult(table));
 
-	// Add the job to our processList;
-	mJobPendingQueue.push(job);
+	if(mQueryStatistics)
+	{
+		QueryTimes& times = job->getTimes();
+
+		job->setTag(QueryStatistics::getTag(sql));
+		times.mEnqueue = times.mDispatch = times.mExecute = times.mComplete = QueryStatistics::getTime();
+	}
+
+	mJobCompleteQueue.push(job);
+}
+
+//======================================================================================================================
+//
+// the snapshot is only valid for the contents of the reference tables it was taken from
+// mysql checksums them cheaply, without one theres no way to tell an outdated snapshot and the cache stays off
+//
+
+void Database::_initReferenceCache()
+{
+	mReferenceCacheChecked = true;
+
+	std::string fileName	= gConfig->read<std::string>("DBReferenceCache","");
+	std::string tables		= gConfig->read<std::string>("DBReferenceTables","");
+
+	if(fileName.empty() || tables.empty())
+		return;
+
+	int8 sql[4096];
+	snprintf(sql,sizeof(sql),"CHECKSUM TABLE %s",tables.c_str());
+
+	DatabaseResult*				result = mDatabaseImplementation->ExecuteSql(sql);
+	std::vector<std::string>	cells;
+
+	uint32 columnCount = mDatabaseImplementation->GetRawRows(result,cells);
+
+	mDatabaseImplementation->DestroyResult(result);
+
+	if(!columnCount || cells.empty())
+	{
+		gLogger->logMsg("Database: the reference tables can't be checksummed, reference cache disabled");
+		return;
+	}
+
+	mReferenceCache = new ReferenceCache(fileName);
+	mReferenceCache->load(ReferenceCache::getChecksum(cells));
+}
+
+//======================================================================================================================
+
+void Database::setStartupComplete()
+{
+	mStartupComplete = true;
+
+	if(mReferenceCache)
+	{
+		mReferenceCache->save();
+	}
+}
+
+//======================================================================================================================
+//
+// runs the query asynchronously and hands the result to the continuation on the main thread
+// a query issued from the continuation of another one runs after it, that is the only ordering there is
+// queries issued one after another from the same place go to different workers and may run in any order
+//
+
+void Database::ExecuteSqlAsyncThen(const DatabaseContinuation& continuation, const int8* sql, ...)
+{
+	// format our sql string
+	va_list args;
+	va_start(args, sql);
+	int8    localSql[20192];
+	/*int32 len = */vsnprintf(localSql, sizeof(localSql), sql, args);
+
+	_pushJob(NULL,NULL,continuation,localSql,false,sql);
 
 	va_end(args);
 }
@@ -200,15 +460,7 @@ void Database::ExecuteSqlAsyncNoArguments(DatabaseCallback* callback, void* ref,
 
 	sprintf(localSql,"%s", sql);
 
-	// Setup our job.
-	DatabaseJob* job = new(mJobPool.ordered_malloc()) DatabaseJob();
-	job->setCallback(callback);
-	job->setClientReference(ref);
-	job->setSql(localSql);
-	job->setMultiJob(false);
-
-	// Add the job to our processList;
-	mJobPendingQueue.push(job);
+	_pushJob(callback,ref,DatabaseContinuation(),localSql,false,sql);
 }
 //======================================================================================================================
 
@@ -245,17 +497,109 @@ void Database::ExecuteProcedureAsync(DatabaseCallback* callback, void* ref, cons
 
 	//gLogger->logMsgF("SqlDump: len:%u - %s", MSG_LOW, len, localSql);
 
+	_pushJob(callback,ref,DatabaseContinuation(),localSql,true,sql);
+
+	va_end(args);
+}
+
+//======================================================================================================================
+
+void Database::_pushJob(DatabaseCallback* callback, void* ref, const DatabaseContinuation& continuation, int8* sql, bool multiJob, const int8* format, bool referenceQuery)
+{
 	// Setup our job.
 	DatabaseJob* job = new(mJobPool.ordered_malloc()) DatabaseJob();
 	job->setCallback(callback);
 	job->setClientReference(ref);
-	job->setSql(localSql);
-	job->setMultiJob(true);
+	job->setContinuation(continuation);
+	job->setSql(sql);
+	job->setMultiJob(multiJob);
+	job->setReferenceQuery(referenceQuery);
+
+	// the format string identifies the call site
+	if(mQueryStatistics)
+	{
+		job->setTag(QueryStatistics::getTag(format));
+		job->getTimes().mEnqueue = QueryStatistics::getTime();
+	}
 
 	// Add the job to our processList
 	mJobPendingQueue.push(job);
+}
 
-	va_end(args);
+//======================================================================================================================
+//
+// packs the transactions committed since the last call into jobs of up to DBTransactionGroupSize transactions
+//
+
+void Database::_pushTransactionGroup()
+{
+	TransactionList::iterator it = mTransactionGroup.begin();
+
+	while(it != mTransactionGroup.end())
+	{
+		DatabaseJob* job = new(mJobPool.ordered_malloc()) DatabaseJob();
+
+		TransactionList::iterator end = it + std::min<size_t>(mTransactionGroupSize,mTransactionGroup.end() - it);
+
+		job->getTransactions().assign(it,end);
+
+		if(mQueryStatistics)
+		{
+			sprintf(job->getSql(),"TRANSACTION GROUP");
+			job->setTag(QueryStatistics::getTag(job->getSql()));
+			job->getTimes().mEnqueue = QueryStatistics::getTime();
+		}
+
+		mJobPendingQueue.push(job);
+
+		it = end;
+	}
+
+	mTransactionGroup.clear();
+}
+
+//======================================================================================================================
+
+void Database::_recordJob(DatabaseJob* job)
+{
+	if(!mQueryStatistics)
+		return;
+
+	job->getTimes().mDone = QueryStatistics::getTime();
+
+	mQueryStatistics->record(job->getTag(),job->getSql(),job->getTimes());
+}
+
+//======================================================================================================================
+
+void Database::dumpQueryStatistics(const int8* fileName)
+{
+	if(!mQueryStatistics)
+	{
+		gLogger->logMsg("Database: query statistics are disabled (DBQueryStatistics)\n");
+		return;
+	}
+
+	if(fileName)
+	{
+		std::ofstream file(fileName,std::ios::out | std::ios::trunc);
+
+		if(!file.is_open())
+		{
+			gLogger->logMsgF("Database: could not open %s for the query statistics",MSG_NORMAL,fileName);
+			return;
+		}
+
+		mQueryStatistics->dump(file);
+
+		gLogger->logMsgF("Database: query statistics written to %s",MSG_NORMAL,fileName);
+		return;
+	}
+
+	std::ostringstream ss;
+	mQueryStatistics->dump(ss);
+
+	gLogger->logMsg(ss.str());
 }
 
 //======================================================================================================================
@@ -298,10 +642,21 @@ Transaction* Database::startTransaction(DatabaseCallback* callback, void* ref)
 	return(new(mTransactionPool.ordered_malloc()) Transaction(this,callback,ref));
 }
 
+//======================================================================================================================
+//
+// transactions are only queued here, Process() commits everything queued during a tick as one group
+//
+
+void Database::commitTransaction(Transaction* t)
+{
+	mTransactionGroup.push_back(t);
+}
+
 //======================================================================================================================
 
 void Database::destroyTransaction(Transaction* t)
 {
+	t->~Transaction();
 	mTransactionPool.ordered_free(t);
 }
 
@@ -12,12 +12,16 @@ Copyright (c) 2006 - 2010 The swgANH Team
 #ifndef ANH_DATABASEMANAGER_DATABASE_H
 #define ANH_DATABASEMANAGER_DATABASE_H
 
+#include "DatabaseCallback.h"
 #include "DatabaseType.h"
 #include "Utils/typedefs.h"
 #include "Utils/concurrent_queue.h"
 #include <queue>
+#include <string>
 #include "DataBindingFactory.h"
+#include "Transaction.h"
 #include <boost/pool/pool.hpp>
+#include <boost/thread/thread.hpp>
 
 
 //======================================================================================================================
@@ -25,10 +29,12 @@ Copyright (c) 2006 - 2010 The swgANH Team
 class DataBinding;
 class DatabaseWorkerThread;
 class DatabaseImplementation;
-class DatabaseCallback;
+class DatabaseImplementationSqlite;
 class DatabaseResult;
 class DatabaseJob;
 class Transaction;
+class QueryStatistics;
+class ReferenceCache;
 
 typedef Anh_Utils::concurrent_queue<DatabaseJob*>				DatabaseJobQueue;
 typedef Anh_Utils::concurrent_queue<DatabaseWorkerThread*>		DatabaseWorkerThreadQueue;
@@ -47,6 +53,10 @@ class Database
   //DatabaseResult*                         ExecuteSql(int8* sql, ...);
   void                                    ExecuteSqlAsync(DatabaseCallback* callback, void* ref, const int8* sql, ...);
   void									  ExecuteSqlAsyncNoArguments(DatabaseCallback* callback, void* ref, const int8* sql);
+  void									  ExecuteSqlAsyncThen(const DatabaseContinuation& continuation, const int8* sql, ...);
+
+  // for queries on static reference tables, served from the reference cache (DBReferenceCache) when it holds the query
+  void									  ExecuteReferenceSqlAsync(DatabaseCallback* callback, void* ref, const int8* sql, ...);
 
   DatabaseResult*                         ExecuteProcedure(const int8* sql, ...);
   void                                    ExecuteProcedureAsync(DatabaseCallback* callback, void* ref, const int8* sql, ...);
@@ -64,15 +74,29 @@ class Database
   void									  pushDatabaseJobComplete(DatabaseJob* job);
 
   Transaction*							  startTransaction(DatabaseCallback* callback, void* ref);
+  void									  commitTransaction(Transaction* t);
   void									  destroyTransaction(Transaction* t);
 
   bool									  releaseResultPoolMemory();	
   bool									  releaseJobPoolMemory(){ return(mJobPool.release_memory()); }
   bool									  releaseTransactionPoolMemory(){ return(mTransactionPool.release_memory()); }
   bool									  releaseBindingPoolMemory(){ return(mDataBindingFactory->releasePoolMemory()); }
+
+  // writes the per call site latencies and the slow query log to the given file, or the log if theres none
+  void									  dumpQueryStatistics(const int8* fileName = NULL);
+
+  // from here on synchronous queries issued by the main thread are reported, if DBReportSynchSql is set
+  // the reference cache snapshot gets written, if startup loaded anything new
+  void									  setStartupComplete();
   
 private:
 
+  void									  _pushJob(DatabaseCallback* callback, void* ref, const DatabaseContinuation& continuation, int8* sql, bool multiJob, const int8* format, bool referenceQuery = false);
+  void									  _recordJob(DatabaseJob* job);
+  void									  _loadScripts(DatabaseImplementationSqlite* implementation,const std::string& scripts);
+  void									  _pushTransactionGroup();
+  void									  _initReferenceCache();
+
   DBType                                  mDatabaseType;      // This denotes which DB implementation we are connecting to. MySQL, Postgres, etc.
 
   DataBindingFactory*                     mDataBindingFactory;
@@ -86,6 +110,18 @@ private:
   uint32                                  mMinThreads;
   uint32                                  mMaxThreads;
 
+  TransactionList                         mTransactionGroup;		// transactions committed during the current tick
+  uint32                                  mTransactionGroupSize;
+
+  boost::thread::id                       mMainThreadId;
+  bool                                    mStartupComplete;
+  bool                                    mReportSynchSql;
+
+  QueryStatistics*                        mQueryStatistics;		// NULL if DBQueryStatistics is off
+
+  ReferenceCache*                         mReferenceCache;		// NULL if DBReferenceCache is off or the tables can't be checksummed
+  bool                                    mReferenceCacheChecked;
+
   boost::pool<boost::default_user_allocator_malloc_free>							  mJobPool;
   boost::pool<boost::default_user_allocator_malloc_free>							  mTransactionPool;
 protected:
@@ -12,6 +12,14 @@ Copyright (c) 2006 - 2010 The swgANH Team
 #ifndef ANH_DATABASEMANAGER_DATABASECALLBACK_H
 #define ANH_DATABASEMANAGER_DATABASECALLBACK_H
 
+#if defined(__GNUC__)
+// GCC implements tr1 in the <tr1/*> headers. This does not conform to the TR1
+// spec, which requires the header without the tr1/ prefix.
+#include <tr1/functional>
+#else
+#include <functional>
+#endif
+
 //======================================================================================================================
 
 class DatabaseResult;
@@ -23,6 +31,14 @@ public:
   virtual void                    handleDatabaseJobComplete(void* ref, DatabaseResult* result) {};
 };
 
+//======================================================================================================================
+//
+// Continuation style completion handler, invoked on the main thread with the result of the query.
+// Bind whatever state the follow up work needs, the next query of a chain can be issued from within.
+// Only a query issued from within the continuation is ordered after the previous one.
+//
+typedef std::tr1::function<void (DatabaseResult*)>	DatabaseContinuation;
+
 
 
 
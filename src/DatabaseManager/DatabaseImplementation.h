@@ -15,12 +15,16 @@ Copyright (c) 2006 - 2010 The swgANH Team
 #include "DatabaseResult.h"
 #include "Utils/typedefs.h"
 #include <boost/pool/singleton_pool.hpp>
+#include <string>
+#include <vector>
 
 
 //======================================================================================================================
 
 class DataBinding;
 class DatabaseWorkerThread;
+class TransactionStatement;
+struct StatementResult;
 
 typedef boost::singleton_pool<DatabaseResult,sizeof(DatabaseResult),boost::default_user_allocator_malloc_free> ResultPool;
 
@@ -38,12 +42,29 @@ public:
   virtual void						GetNextRow(DatabaseResult* result, DataBinding* binding, void* object) = 0;
   virtual void						ResetRowIndex(DatabaseResult* result, uint64 index = 0) = 0;
 
+  // copies all rows of the result as strings, row by row, returns the column count
+  // the row index of the result is left at 0
+  virtual uint32					GetRawRows(DatabaseResult* result, std::vector<std::string>& cells) = 0;
+
   virtual uint32					Escape_String(int8* target,const int8* source,uint32 length) = 0;
 
   bool								releaseResultPoolMemory(){ return(ResultPool::release_memory()); }
 
   virtual uint64					GetInsertId(void) = 0;
 
+  // transaction support, ExecuteCommand runs a statement without result set (SAVEPOINT ...)
+  // ExecuteStatement runs statements with bound parameters as prepared statements
+  virtual bool						ExecuteCommand(const int8* sql) = 0;
+  virtual void						ExecuteStatement(TransactionStatement& statement, StatementResult& result) = 0;
+  virtual uint32					GetLastError(void) = 0;
+
+  // true if the error rolled back the whole transaction instead of the failed statement only (deadlocks, lost connections)
+  virtual bool						EndedTransaction(uint32 error){ return(false); }
+
+  virtual bool						BeginTransaction(void){ return(ExecuteCommand("START TRANSACTION")); }
+  virtual bool						CommitTransaction(void){ return(ExecuteCommand("COMMIT")); }
+  virtual bool						RollbackTransaction(void){ return(ExecuteCommand("ROLLBACK")); }
+
 	protected:
 };
 
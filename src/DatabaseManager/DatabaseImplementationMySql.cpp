@@ -12,18 +12,24 @@ Copyright (c) 2006 - 2010 The swgANH Team
 #include "DatabaseImplementationMySql.h"
 #include "DatabaseResult.h"
 #include "DataBinding.h"
+#include "Transaction.h"
+#include "TransactionResult.h"
 
 #include "LogManager/LogManager.h"
 
 #include <boost/lexical_cast.hpp>
 #include <mysql.h>
+#include <errmsg.h>
+#include <mysqld_error.h>
 #include <cstdlib>
 #include <cstdio>
 #include <cstring>
+#include <vector>
 
 //======================================================================================================================
 DatabaseImplementationMySql::DatabaseImplementationMySql(char* host, uint16 port, char* user, char* pass, char* schema) :
-	DatabaseImplementation(host, port, user, pass, schema)
+	DatabaseImplementation(host, port, user, pass, schema),
+	mPreparedThreadId(0)
 {
   MYSQL*        connect = 0;
 
@@ -44,6 +50,8 @@ DatabaseImplementationMySql::DatabaseImplementationMySql(char* host, uint16 port
 //======================================================================================================================
 DatabaseImplementationMySql::~DatabaseImplementationMySql(void)
 {
+  _closePreparedStatements();
+
   // Close the connection and destroy our connection object.
   mysql_close(mConnection);
   mysql_thread_end();
@@ -223,6 +231,38 @@ void DatabaseImplementationMySql::ResetRowIndex(DatabaseResult* result, uint64 i
 }
 
 
+//======================================================================================================================
+
+uint32 DatabaseImplementationMySql::GetRawRows(DatabaseResult* result, std::vector<std::string>& cells)
+{
+	MYSQL_RES*	mySqlResult = (MYSQL_RES*)result->getResultSetReference();
+
+	if(!mySqlResult)
+		return(0);
+
+	uint32		columnCount = mysql_num_fields(mySqlResult);
+	MYSQL_ROW	row;
+
+	mysql_data_seek(mySqlResult,0);
+
+	cells.reserve(cells.size() + static_cast<size_t>(mySqlResult->row_count) * columnCount);
+
+	while((row = mysql_fetch_row(mySqlResult)))
+	{
+		unsigned long* lengths = mysql_fetch_lengths(mySqlResult);
+
+		for(uint32 i = 0; i < columnCount; i++)
+		{
+			// NULL is served as an empty string
+			cells.push_back(row[i] ? std::string(row[i],lengths[i]) : std::string());
+		}
+	}
+
+	mysql_data_seek(mySqlResult,0);
+
+	return(columnCount);
+}
+
 //======================================================================================================================
 uint64 DatabaseImplementationMySql::GetInsertId(void)
 {
@@ -238,3 +278,188 @@ uint32 DatabaseImplementationMySql::Escape_String(int8* target,const int8* sourc
 
 //======================================================================================================================
 
+bool DatabaseImplementationMySql::ExecuteCommand(const int8* sql)
+{
+	if(mysql_real_query(mConnection,sql,(unsigned long)strlen(sql)) != 0)
+	{
+		gLogger->logMsgF("DatabaseError: %s", MSG_HIGH, mysql_error(mConnection));
+		return(false);
+	}
+
+	// we don't expect rows, but don't leave them on the connection
+	mysql_free_result(mysql_store_result(mConnection));
+
+	return(true);
+}
+
+//======================================================================================================================
+
+void DatabaseImplementationMySql::ExecuteStatement(TransactionStatement& statement, StatementResult& result)
+{
+	// plain statement
+	if(!statement.isPrepared())
+	{
+		if(mysql_real_query(mConnection,statement.getSql().c_str(),(unsigned long)statement.getSql().length()) != 0)
+		{
+			result.mError = mysql_errno(mConnection);
+			gLogger->logMsgF("DatabaseError: %s", MSG_HIGH, mysql_error(mConnection));
+			return;
+		}
+
+		mysql_free_result(mysql_store_result(mConnection));
+
+		result.mAffectedRows	= mysql_affected_rows(mConnection);
+		result.mInsertId		= mysql_insert_id(mConnection);
+		return;
+	}
+
+	MYSQL_STMT* stmt = _getPreparedStatement(statement.getSql());
+
+	if(!stmt)
+	{
+		result.mError = CR_UNKNOWN_ERROR;
+		return;
+	}
+
+	TransactionStatement::ParamList& params = statement.getParams();
+
+	if(mysql_stmt_param_count(stmt) != params.size())
+	{
+		gLogger->logMsgF("DatabaseError: statement expects %lu parameters, %u bound: %s", MSG_HIGH, mysql_stmt_param_count(stmt), static_cast<uint32>(params.size()), statement.getSql().c_str());
+		result.mError = CR_UNKNOWN_ERROR;
+		return;
+	}
+
+	std::vector<MYSQL_BIND>		binds(params.size());
+	std::vector<unsigned long>	lengths(params.size());
+
+	memset(&binds[0],0,sizeof(MYSQL_BIND) * binds.size());
+
+	for(uint32 i = 0; i < params.size(); i++)
+	{
+		switch(params[i].mType)
+		{
+			case TransactionStatement::Param_Int:
+			{
+				binds[i].buffer_type	= MYSQL_TYPE_LONGLONG;
+				binds[i].buffer			= &params[i].mInt;
+			}
+			break;
+
+			case TransactionStatement::Param_UInt:
+			{
+				binds[i].buffer_type	= MYSQL_TYPE_LONGLONG;
+				binds[i].buffer			= &params[i].mUInt;
+				binds[i].is_unsigned	= 1;
+			}
+			break;
+
+			case TransactionStatement::Param_Double:
+			{
+				binds[i].buffer_type	= MYSQL_TYPE_DOUBLE;
+				binds[i].buffer			= &params[i].mDouble;
+			}
+			break;
+
+			case TransactionStatement::Param_String:
+			{
+				lengths[i]				= (unsigned long)params[i].mString.length();
+				binds[i].buffer_type	= MYSQL_TYPE_STRING;
+				binds[i].buffer			= (void*)params[i].mString.data();
+				binds[i].buffer_length	= lengths[i];
+				binds[i].length			= &lengths[i];
+			}
+			break;
+		}
+	}
+
+	if(mysql_stmt_bind_param(stmt,&binds[0]) || mysql_stmt_execute(stmt))
+	{
+		result.mError = mysql_stmt_errno(stmt);
+		gLogger->logMsgF("DatabaseError: %s", MSG_HIGH, mysql_stmt_error(stmt));
+
+		// the statements died with the connection, they get prepared again on the next one
+		if(result.mError == CR_SERVER_GONE_ERROR || result.mError == CR_SERVER_LOST || result.mError == ER_UNKNOWN_STMT_HANDLER)
+		{
+			_closePreparedStatements();
+		}
+		return;
+	}
+
+	result.mAffectedRows	= mysql_stmt_affected_rows(stmt);
+	result.mInsertId		= mysql_stmt_insert_id(stmt);
+
+	mysql_stmt_free_result(stmt);
+}
+
+//======================================================================================================================
+
+uint32 DatabaseImplementationMySql::GetLastError(void)
+{
+	return(mysql_errno(mConnection));
+}
+
+//======================================================================================================================
+
+bool DatabaseImplementationMySql::EndedTransaction(uint32 error)
+{
+	// a lock wait timeout only rolls back the statement, unless innodb_rollback_on_timeout is set
+	// the group cant tell which, so it is treated as lost like a deadlock
+	return(error == ER_LOCK_DEADLOCK || error == ER_LOCK_WAIT_TIMEOUT || error == CR_SERVER_GONE_ERROR || error == CR_SERVER_LOST);
+}
+
+//======================================================================================================================
+//
+// prepared statements belong to the connection, an automatic reconnect leaves them invalid
+//
+
+void DatabaseImplementationMySql::_closePreparedStatements()
+{
+	PreparedStatementMap::iterator it = mPreparedStatements.begin();
+	while(it != mPreparedStatements.end())
+	{
+		mysql_stmt_close((*it).second);
+		++it;
+	}
+
+	mPreparedStatements.clear();
+}
+
+//======================================================================================================================
+
+MYSQL_STMT* DatabaseImplementationMySql::_getPreparedStatement(const std::string& sql)
+{
+	if(mysql_thread_id(mConnection) != mPreparedThreadId)
+	{
+		_closePreparedStatements();
+		mPreparedThreadId = mysql_thread_id(mConnection);
+	}
+
+	PreparedStatementMap::iterator it = mPreparedStatements.find(sql);
+
+	if(it != mPreparedStatements.end())
+	{
+		return((*it).second);
+	}
+
+	MYSQL_STMT* stmt = mysql_stmt_init(mConnection);
+
+	if(!stmt)
+	{
+		gLogger->logMsgF("DatabaseError: %s", MSG_HIGH, mysql_error(mConnection));
+		return(NULL);
+	}
+
+	if(mysql_stmt_prepare(stmt,sql.c_str(),(unsigned long)sql.length()))
+	{
+		gLogger->logMsgF("DatabaseError: %s", MSG_HIGH, mysql_stmt_error(stmt));
+		mysql_stmt_close(stmt);
+		return(NULL);
+	}
+
+	mPreparedStatements.insert(std::make_pair(sql,stmt));
+
+	return(stmt);
+}
+
+//======================================================================================================================
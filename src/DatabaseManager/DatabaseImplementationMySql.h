@@ -14,6 +14,8 @@ Copyright (c) 2006 - 2010 The swgANH Team
 
 #include "DatabaseImplementation.h"
 #include "Utils/typedefs.h"
+#include <map>
+#include <string>
 
 //======================================================================================================================
 class DatabaseResult;
@@ -21,6 +23,9 @@ class DatabaseResult;
 typedef struct st_mysql MYSQL;
 typedef struct st_mysql_res MYSQL_RES;
 typedef struct st_mysql_rows MYSQL_ROWS;
+typedef struct st_mysql_stmt MYSQL_STMT;
+
+typedef std::map<std::string,MYSQL_STMT*>	PreparedStatementMap;
 
 
 //======================================================================================================================
@@ -36,13 +41,24 @@ public:
 
   virtual void						GetNextRow(DatabaseResult* result, DataBinding* binding, void* object);
   virtual void						ResetRowIndex(DatabaseResult* result, uint64 index = 0);
+  virtual uint32					GetRawRows(DatabaseResult* result, std::vector<std::string>& cells);
   virtual uint64					GetInsertId(void);
 
   virtual uint32					Escape_String(int8* target,const int8* source,uint32 length);
 
+  virtual bool						ExecuteCommand(const int8* sql);
+  virtual void						ExecuteStatement(TransactionStatement& statement, StatementResult& result);
+  virtual uint32					GetLastError(void);
+  virtual bool						EndedTransaction(uint32 error);
+
 private:
+  MYSQL_STMT*				  _getPreparedStatement(const std::string& sql);
+  void						  _closePreparedStatements();
+
   MYSQL*                      mConnection;
   MYSQL_RES*                  mResultSet;
+  PreparedStatementMap		  mPreparedStatements;	// prepared once per connection, keyed by their sql
+  unsigned long				  mPreparedThreadId;	// the connection they were prepared on, changes on a reconnect
 };
 
 
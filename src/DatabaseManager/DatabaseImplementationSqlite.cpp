@@ -0,0 +1,506 @@
+/*
+---------------------------------------------------------------------------------------
+This source file is part of swgANH (Star Wars Galaxies - A New Hope - Server Emulator)
+For more information, see http://www.swganh.org
+
+
+Copyright (c) 2006 - 2010 The swgANH Team
+
+---------------------------------------------------------------------------------------
+*/
+
+#if defined(ANH_WITH_SQLITE)
+
+#include "DatabaseImplementationSqlite.h"
+#include "DatabaseResult.h"
+#include "DataBinding.h"
+#include "Transaction.h"
+#include "TransactionResult.h"
+
+#include "LogManager/LogManager.h"
+
+#include <sqlite3.h>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+//======================================================================================================================
+//
+// rows of a query, copied out of sqlite since the statement is finalized right away
+//
+
+struct SqliteResultSet
+{
+	SqliteResultSet(uint32 columnCount) : mColumnCount(columnCount),mRowIndex(0){}
+
+	uint64	getRowCount(){ return mColumnCount ? mCells.size() / mColumnCount : 0; }
+
+	uint32						mColumnCount;
+	uint64						mRowIndex;
+	std::vector<std::string>	mCells;		// row major, NULL reads as empty
+};
+
+//======================================================================================================================
+//
+// the zone asks for the number of objects it is going to load through a stored function
+// we read it from the zone_object_count table, which has to be seeded along with the objects
+//
+
+static void sf_getZoneObjectCount(sqlite3_context* context,int argc,sqlite3_value** argv)
+{
+	sqlite3_stmt*	stmt;
+	sqlite3_int64	count = 0;
+
+	if(sqlite3_prepare_v2(sqlite3_context_db_handle(context),"SELECT object_count FROM zone_object_count WHERE planet_id=?;",-1,&stmt,NULL) == SQLITE_OK)
+	{
+		sqlite3_bind_value(stmt,1,argv[0]);
+
+		if(sqlite3_step(stmt) == SQLITE_ROW)
+			count = sqlite3_column_int64(stmt,0);
+
+		sqlite3_finalize(stmt);
+	}
+
+	sqlite3_result_int64(context,count);
+}
+
+//======================================================================================================================
+
+DatabaseImplementationSqlite::DatabaseImplementationSqlite(char* host, uint16 port, char* user, char* pass, char* schema) :
+	DatabaseImplementation(host, port, user, pass, schema),
+	mConnection(NULL)
+{
+	// every worker has its own connection, sqlite doesn't need to serialize them
+	if(sqlite3_open_v2(host,&mConnection,SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_URI | SQLITE_OPEN_NOMUTEX,NULL) != SQLITE_OK)
+	{
+		gLogger->logMsgF("DatabaseError: %s", MSG_HIGH, sqlite3_errmsg(mConnection));
+		return;
+	}
+
+	// workers share the file, wait for each others locks
+	sqlite3_busy_timeout(mConnection,10000);
+
+	ExecuteCommand("PRAGMA journal_mode=WAL;");
+	ExecuteCommand("PRAGMA synchronous=NORMAL;");
+	ExecuteCommand("PRAGMA foreign_keys=OFF;");
+
+	sqlite3_create_function(mConnection,"sf_getZoneObjectCount",1,SQLITE_UTF8,NULL,&sf_getZoneObjectCount,NULL,NULL);
+	sqlite3_create_function(mConnection,"sf_getZoneObjectCountDebug",1,SQLITE_UTF8,NULL,&sf_getZoneObjectCount,NULL,NULL);
+
+	_attachSchemaAlias("swganh");
+}
+
+//======================================================================================================================
+//
+// some queries name the mysql schema (swganh.mission_types), the file is attached a second time under that name
+// read only, a writable second attach would make BEGIN IMMEDIATE wait for its own write lock
+// in-memory and temporary databases have no file to attach, those queries fail there
+//
+
+void DatabaseImplementationSqlite::_attachSchemaAlias(const int8* alias)
+{
+	const int8* fileName = sqlite3_db_filename(mConnection,"main");
+
+	if(!fileName || !*fileName)
+	{
+		gLogger->logMsgF("DatabaseImplementationSqlite: no database file, schema %s is not available", MSG_HIGH, alias);
+		return;
+	}
+
+	std::string uri("file:");
+
+	for(const int8* c = fileName; *c; c++)
+	{
+		switch(*c)
+		{
+			case '%':	uri += "%25";	break;
+			case '?':	uri += "%3f";	break;
+			case '#':	uri += "%23";	break;
+			default:	uri += *c;		break;
+		}
+	}
+
+	uri += "?mode=ro";
+
+	int8 sql[64];
+	sprintf(sql,"ATTACH DATABASE ? AS %s;",alias);
+
+	sqlite3_stmt* stmt = NULL;
+
+	if(sqlite3_prepare_v2(mConnection,sql,-1,&stmt,NULL) == SQLITE_OK)
+	{
+		sqlite3_bind_text(stmt,1,uri.c_str(),-1,SQLITE_TRANSIENT);
+
+		if(sqlite3_step(stmt) == SQLITE_DONE)
+		{
+			sqlite3_finalize(stmt);
+			return;
+		}
+	}
+
+	gLogger->logMsgF("DatabaseError: %s", MSG_HIGH, sqlite3_errmsg(mConnection));
+
+	sqlite3_finalize(stmt);
+}
+
+//======================================================================================================================
+
+DatabaseImplementationSqlite::~DatabaseImplementationSqlite(void)
+{
+	SqliteStatementMap::iterator it = mPreparedStatements.begin();
+	while(it != mPreparedStatements.end())
+	{
+		sqlite3_finalize((*it).second);
+		++it;
+	}
+
+	sqlite3_close(mConnection);
+}
+
+//======================================================================================================================
+//
+// runs every statement of the sql, the rows of the first statement returning any columns make the result
+//
+
+DatabaseResult* DatabaseImplementationSqlite::ExecuteSql(int8* sql,bool procedure)
+{
+	DatabaseResult*		newResult = new(ResultPool::ordered_malloc()) DatabaseResult(procedure);
+	SqliteResultSet*	resultSet = NULL;
+	const int8*			next	  = sql;
+
+	newResult->setDatabaseImplementation(this);
+
+	while(next && *next)
+	{
+		sqlite3_stmt*	stmt = NULL;
+		const int8*		tail = NULL;
+
+		if(sqlite3_prepare_v2(mConnection,next,-1,&stmt,&tail) != SQLITE_OK)
+		{
+			gLogger->logMsgF("DatabaseError: %s", MSG_HIGH, sqlite3_errmsg(mConnection));
+			break;
+		}
+
+		next = tail;
+
+		// whitespace or a comment
+		if(!stmt)
+			continue;
+
+		uint32	columnCount = sqlite3_column_count(stmt);
+		bool	keepRows	= (columnCount && !resultSet);
+
+		if(keepRows)
+			resultSet = new SqliteResultSet(columnCount);
+
+		int32 status;
+
+		while((status = sqlite3_step(stmt)) == SQLITE_ROW)
+		{
+			if(!keepRows)
+				continue;
+
+			for(uint32 i = 0; i < columnCount; i++)
+			{
+				const void* data = sqlite3_column_blob(stmt,i);
+
+				resultSet->mCells.push_back(data ? std::string((const int8*)data,sqlite3_column_bytes(stmt,i)) : std::string());
+			}
+		}
+
+		if(status != SQLITE_DONE)
+		{
+			gLogger->logMsgF("DatabaseError: %s", MSG_HIGH, sqlite3_errmsg(mConnection));
+		}
+
+		sqlite3_finalize(stmt);
+	}
+
+	newResult->setConnectionReference((void*)mConnection);
+	newResult->setResultSetReference((void*)resultSet);
+
+	if(resultSet)
+	{
+		newResult->setRowCount(resultSet->getRowCount());
+	}
+
+	return newResult;
+}
+
+//======================================================================================================================
+
+DatabaseWorkerThread* DatabaseImplementationSqlite::DestroyResult(DatabaseResult* result)
+{
+	DatabaseWorkerThread* worker = NULL;
+
+	delete((SqliteResultSet*)result->getResultSetReference());
+
+	if(result->isMultiResult())
+	{
+		worker = result->getWorkerReference();
+	}
+
+	ResultPool::ordered_free(result);
+
+	return(worker);
+}
+
+//======================================================================================================================
+
+void DatabaseImplementationSqlite::GetNextRow(DatabaseResult* result, DataBinding* binding, void* object)
+{
+	SqliteResultSet* resultSet = (SqliteResultSet*)result->getResultSetReference();
+
+	if(!resultSet || resultSet->mRowIndex >= resultSet->getRowCount())
+		return;
+
+	uint64 rowStart = resultSet->mRowIndex * resultSet->mColumnCount;
+
+	++resultSet->mRowIndex;
+
+	for(uint32 i = 0; i < binding->getFieldCount(); i++)
+	{
+		DataField&		field	= binding->mDataFields[i];
+		int8*			target	= &((int8*)object)[field.mDataOffset];
+
+		if(field.mColumn >= resultSet->mColumnCount)
+			continue;
+
+		const std::string&	cell	= resultSet->mCells[rowStart + field.mColumn];
+		const int8*			value	= cell.c_str();
+
+		switch(field.mDataType)
+		{
+			case DFT_int8:		*((int8*)target)	= static_cast<int8>(atoi(value));				break;
+			case DFT_uint8:		*((uint8*)target)	= static_cast<uint8>(atoi(value));				break;
+			case DFT_int16:		*((int16*)target)	= static_cast<int16>(atoi(value));				break;
+			case DFT_uint16:	*((uint16*)target)	= static_cast<uint16>(atoi(value));				break;
+			case DFT_int32:		*((int32*)target)	= static_cast<int32>(strtol(value,NULL,10));	break;
+			case DFT_uint32:	*((uint32*)target)	= static_cast<uint32>(strtoul(value,NULL,10));	break;
+			case DFT_int64:		*((int64*)target)	= strtoll(value,NULL,10);						break;
+			case DFT_uint64:	*((uint64*)target)	= strtoull(value,NULL,10);						break;
+			case DFT_float:		*((float*)target)	= static_cast<float>(atof(value));				break;
+			case DFT_double:	*((double*)target)	= atof(value);									break;
+
+			case DFT_string:
+			{
+				memcpy(target,cell.data(),cell.length());
+				target[cell.length()] = 0;
+			}
+			break;
+
+			case DFT_bstring:
+			{
+				BString* bindingString = reinterpret_cast<BString*>(target);
+				*bindingString = value;
+			}
+			break;
+
+			case DFT_raw:
+			{
+				memcpy(target,cell.data(),cell.length());
+			}
+			break;
+
+			default:break;
+		}
+	}
+}
+
+//======================================================================================================================
+
+void DatabaseImplementationSqlite::ResetRowIndex(DatabaseResult* result, uint64 index)
+{
+	if(SqliteResultSet* resultSet = (SqliteResultSet*)result->getResultSetReference())
+	{
+		resultSet->mRowIndex = index;
+	}
+}
+
+//======================================================================================================================
+
+uint32 DatabaseImplementationSqlite::GetRawRows(DatabaseResult* result, std::vector<std::string>& cells)
+{
+	SqliteResultSet* resultSet = (SqliteResultSet*)result->getResultSetReference();
+
+	if(!resultSet)
+		return(0);
+
+	cells.insert(cells.end(),resultSet->mCells.begin(),resultSet->mCells.end());
+	resultSet->mRowIndex = 0;
+
+	return(resultSet->mColumnCount);
+}
+
+//======================================================================================================================
+
+uint64 DatabaseImplementationSqlite::GetInsertId(void)
+{
+	return(sqlite3_last_insert_rowid(mConnection));
+}
+
+//======================================================================================================================
+//
+// the queries quote their strings with ', which sqlite escapes by doubling it
+//
+
+uint32 DatabaseImplementationSqlite::Escape_String(int8* target,const int8* source,uint32 length)
+{
+	uint32 written = 0;
+
+	for(uint32 i = 0; i < length; i++)
+	{
+		if(source[i] == '\'')
+			target[written++] = '\'';
+
+		target[written++] = source[i];
+	}
+
+	target[written] = 0;
+
+	return(written);
+}
+
+//======================================================================================================================
+
+bool DatabaseImplementationSqlite::ExecuteCommand(const int8* sql)
+{
+	int8* error = NULL;
+
+	if(sqlite3_exec(mConnection,sql,NULL,NULL,&error) != SQLITE_OK)
+	{
+		gLogger->logMsgF("DatabaseError: %s", MSG_HIGH, error);
+		sqlite3_free(error);
+		return(false);
+	}
+
+	return(true);
+}
+
+//======================================================================================================================
+
+void DatabaseImplementationSqlite::ExecuteStatement(TransactionStatement& statement, StatementResult& result)
+{
+	sqlite3_stmt* stmt;
+	SqliteStatementMap::iterator it = mPreparedStatements.find(statement.getSql());
+
+	if(it != mPreparedStatements.end())
+	{
+		stmt = (*it).second;
+	}
+	else
+	{
+		if(sqlite3_prepare_v2(mConnection,statement.getSql().c_str(),-1,&stmt,NULL) != SQLITE_OK)
+		{
+			result.mError = sqlite3_errcode(mConnection);
+			gLogger->logMsgF("DatabaseError: %s", MSG_HIGH, sqlite3_errmsg(mConnection));
+			return;
+		}
+
+		mPreparedStatements.insert(std::make_pair(statement.getSql(),stmt));
+	}
+
+	TransactionStatement::ParamList& params = statement.getParams();
+
+	for(uint32 i = 0; i < params.size(); i++)
+	{
+		switch(params[i].mType)
+		{
+			case TransactionStatement::Param_Int:		sqlite3_bind_int64(stmt,i + 1,params[i].mInt);														break;
+			case TransactionStatement::Param_UInt:		sqlite3_bind_int64(stmt,i + 1,static_cast<sqlite3_int64>(params[i].mUInt));						break;
+			case TransactionStatement::Param_Double:	sqlite3_bind_double(stmt,i + 1,params[i].mDouble);													break;
+			case TransactionStatement::Param_String:	sqlite3_bind_text(stmt,i + 1,params[i].mString.data(),(int)params[i].mString.length(),SQLITE_TRANSIENT);	break;
+		}
+	}
+
+	int32 status;
+
+	while((status = sqlite3_step(stmt)) == SQLITE_ROW){}
+
+	if(status != SQLITE_DONE)
+	{
+		result.mError = sqlite3_errcode(mConnection);
+		gLogger->logMsgF("DatabaseError: %s", MSG_HIGH, sqlite3_errmsg(mConnection));
+	}
+	else
+	{
+		result.mAffectedRows	= sqlite3_changes(mConnection);
+		result.mInsertId		= sqlite3_last_insert_rowid(mConnection);
+	}
+
+	sqlite3_reset(stmt);
+	sqlite3_clear_bindings(stmt);
+}
+
+//======================================================================================================================
+
+uint32 DatabaseImplementationSqlite::GetLastError(void)
+{
+	return(sqlite3_errcode(mConnection));
+}
+
+//======================================================================================================================
+//
+// sqlite rolls the transaction back on its own on some errors (SQLITE_FULL, SQLITE_IOERR, SQLITE_NOMEM, ...), it is back in autocommit then
+//
+
+bool DatabaseImplementationSqlite::EndedTransaction(uint32 error)
+{
+	return(error != 0 && sqlite3_get_autocommit(mConnection) != 0);
+}
+
+//======================================================================================================================
+
+bool DatabaseImplementationSqlite::isEmpty(void)
+{
+	sqlite3_stmt*	stmt;
+	bool			empty = true;
+
+	if(sqlite3_prepare_v2(mConnection,"SELECT COUNT(*) FROM sqlite_master WHERE type='table';",-1,&stmt,NULL) == SQLITE_OK)
+	{
+		if(sqlite3_step(stmt) == SQLITE_ROW)
+			empty = (sqlite3_column_int(stmt,0) == 0);
+
+		sqlite3_finalize(stmt);
+	}
+
+	return(empty);
+}
+
+//======================================================================================================================
+
+bool DatabaseImplementationSqlite::ExecuteScript(const int8* fileName)
+{
+	std::ifstream file(fileName,std::ios::in | std::ios::binary);
+
+	if(!file.is_open())
+	{
+		gLogger->logMsgF("DatabaseError: could not open %s", MSG_HIGH, fileName);
+		return(false);
+	}
+
+	std::ostringstream script;
+	script << file.rdbuf();
+
+	gLogger->logMsgF("Database: running %s", MSG_NORMAL, fileName);
+
+	// one transaction, or sqlite syncs after every insert of the seed
+	if(!BeginTransaction())
+		return(false);
+
+	if(!ExecuteCommand(script.str().c_str()))
+	{
+		RollbackTransaction();
+		return(false);
+	}
+
+	return(CommitTransaction());
+}
+
+//======================================================================================================================
+
+#endif
+
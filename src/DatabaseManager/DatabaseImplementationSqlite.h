@@ -0,0 +1,76 @@
+/*
+---------------------------------------------------------------------------------------
+This source file is part of swgANH (Star Wars Galaxies - A New Hope - Server Emulator)
+For more information, see http://www.swganh.org
+
+
+Copyright (c) 2006 - 2010 The swgANH Team
+
+---------------------------------------------------------------------------------------
+*/
+
+#ifndef ANH_DATABASEMANAGER_DATABASEIMPLEMENTATIONSQLITE_H
+#define ANH_DATABASEMANAGER_DATABASEIMPLEMENTATIONSQLITE_H
+
+#include "DatabaseImplementation.h"
+#include "Utils/typedefs.h"
+#include <map>
+#include <string>
+
+//======================================================================================================================
+//
+// embedded database, for benchmarks and tests without a database server
+// host is the database file, a sqlite uri like file:zone?mode=memory&cache=shared works as well
+// user, password and schema are unused
+//
+// the sql is passed on as it is, mysql only syntax and stored procedures aren't available
+//
+
+class DatabaseResult;
+
+typedef struct sqlite3 sqlite3;
+typedef struct sqlite3_stmt sqlite3_stmt;
+
+typedef std::map<std::string,sqlite3_stmt*>	SqliteStatementMap;
+
+//======================================================================================================================
+
+class DatabaseImplementationSqlite : public DatabaseImplementation
+{
+public:
+									 DatabaseImplementationSqlite(char* host, uint16 port, char* user, char* pass, char* schema);
+  virtual							~DatabaseImplementationSqlite(void);
+
+  virtual DatabaseResult*			ExecuteSql(int8* sql,bool procedure = false);
+  virtual DatabaseWorkerThread*		DestroyResult(DatabaseResult* result);
+
+  virtual void						GetNextRow(DatabaseResult* result, DataBinding* binding, void* object);
+  virtual void						ResetRowIndex(DatabaseResult* result, uint64 index = 0);
+  virtual uint32					GetRawRows(DatabaseResult* result, std::vector<std::string>& cells);
+  virtual uint64					GetInsertId(void);
+
+  virtual uint32					Escape_String(int8* target,const int8* source,uint32 length);
+
+  virtual bool						ExecuteCommand(const int8* sql);
+  virtual void						ExecuteStatement(TransactionStatement& statement, StatementResult& result);
+  virtual uint32					GetLastError(void);
+  virtual bool						EndedTransaction(uint32 error);
+
+  virtual bool						BeginTransaction(void){ return(ExecuteCommand("BEGIN IMMEDIATE")); }
+
+  // runs all statements of a sql file, used to set up schema and seed data of a new database
+  bool								ExecuteScript(const int8* fileName);
+  bool								isEmpty(void);
+
+private:
+
+  void								_attachSchemaAlias(const int8* alias);
+
+  sqlite3*					  mConnection;
+  SqliteStatementMap		  mPreparedStatements;
+};
+
+//======================================================================================================================
+
+#endif // ANH_DATABASEMANAGER_DATABASEIMPLEMENTATIONSQLITE_H
+
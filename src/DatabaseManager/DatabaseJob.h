@@ -12,11 +12,14 @@ Copyright (c) 2006 - 2010 The swgANH Team
 #ifndef ANH_DATABASEMANAGER_DATABASEJOB_H
 #define ANH_DATABASEMANAGER_DATABASEJOB_H
 
+#include "DatabaseCallback.h"
+#include "QueryStatistics.h"
+#include "Transaction.h"
+
 #include <stdlib.h>
 #include <cstring>
 
 //======================================================================================================================
-class DatabaseCallback;
 class DatabaseResult;
 class DataBinding;
 
@@ -25,25 +28,48 @@ class DataBinding;
 class DatabaseJob
 {
 public:
-	DatabaseJob() : mDatabaseCallback(NULL),mDatabaseResult(NULL),mClientReference(NULL),mMultiJob(false){}
+	DatabaseJob() : mDatabaseCallback(NULL),mDatabaseResult(NULL),mClientReference(NULL),mTag(0),mMultiJob(false),mReferenceQuery(false),mCachedResult(false){}
   DatabaseCallback*           getCallback(void)                               { return mDatabaseCallback; }
   DatabaseResult*             getDatabaseResult(void)                         { return mDatabaseResult; };
   void*                       getClientReference(void)                        { return mClientReference; }
+  DatabaseContinuation&       getContinuation(void)                           { return mContinuation; }
   int8*                       getSql(void)                                    { return mSql; }
 
   void                        setCallback(DatabaseCallback* callback)         { mDatabaseCallback = callback; }
   void                        setDatabaseResult(DatabaseResult* result)       { mDatabaseResult = result; }
   void                        setClientReference(void* ref)                   { mClientReference = ref; }
+  void                        setContinuation(const DatabaseContinuation& continuation) { mContinuation = continuation; }
   void                        setSql(int8* sql)                               { strcpy(mSql, sql); }
   void						  setMultiJob(bool job){ mMultiJob = job; }
   bool						  isMultiJob(){ return mMultiJob; }
 
+  // a group of transactions to commit together, instead of the sql
+  TransactionList&            getTransactions(void)                           { return mTransactions; }
+  bool                        isTransactionJob(void)                          { return !mTransactions.empty(); }
+
+  // call site tag and timestamps, for the query statistics
+  uint32                      getTag(void)                                    { return mTag; }
+  void                        setTag(uint32 tag)                              { mTag = tag; }
+  QueryTimes&                 getTimes(void)                                  { return mTimes; }
+
+  // the result of a reference query goes into the reference cache, a cached result is owned by the job
+  void                        setReferenceQuery(bool reference)               { mReferenceQuery = reference; }
+  bool                        isReferenceQuery(void)                          { return mReferenceQuery; }
+  void                        setCachedResult(bool cached)                    { mCachedResult = cached; }
+  bool                        isCachedResult(void)                            { return mCachedResult; }
+
 private:
   DatabaseCallback*           mDatabaseCallback;
   DatabaseResult*             mDatabaseResult;
   void*                       mClientReference;
+  DatabaseContinuation        mContinuation;
+  TransactionList             mTransactions;
+  QueryTimes                  mTimes;
+  uint32                      mTag;
   int8                        mSql[8192];
   bool						  mMultiJob;
+  bool                        mReferenceQuery;
+  bool                        mCachedResult;
 };
 
 
@@ -27,10 +27,10 @@ class DatabaseResult
 public:
                               DatabaseResult(bool multiResult = false) 
 								  :mWorkerReference(0), mConnectionReference(0),mResultSetReference(0),mRowCount(0),mDatabaseImplementation(0),mMultiResult(multiResult) {};
-                              ~DatabaseResult(void) {};
+  virtual                     ~DatabaseResult(void) {};
 
   virtual void               GetNextRow(DataBinding* dataBinding, void* object);
-  void                        ResetRowIndex(int index = 0);
+  virtual void                ResetRowIndex(int index = 0);
 
   void*						  getConnectionReference(void){ return mConnectionReference; }
   void						  setConnectionReference(void* ref)	{ mConnectionReference =  ref; }
@@ -18,7 +18,8 @@ Copyright (c) 2006 - 2010 The swgANH Team
 enum DBType
 {
   DBTYPE_First = 0,
-  DBTYPE_MYSQL
+  DBTYPE_MYSQL,
+  DBTYPE_SQLITE		// embedded, host is the database file
 };
 
 
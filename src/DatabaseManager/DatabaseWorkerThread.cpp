@@ -13,8 +13,10 @@ Copyright (c) 2006 - 2010 The swgANH Team
 #include "Database.h"
 #include "DatabaseImplementation.h"
 #include "DatabaseImplementationMySql.h"
+#include "DatabaseImplementationSqlite.h"
 #include "DatabaseJob.h"
 #include "DatabaseType.h"
+#include "Transaction.h"
 #include "LogManager/LogManager.h"
 
 #include <boost/thread/thread.hpp>
@@ -72,6 +74,12 @@ void DatabaseWorkerThread::_startup(void)
 		mDatabaseImplementation = reinterpret_cast<DatabaseImplementation*>(new DatabaseImplementationMySql(mHostname, mPort, mUsername, mPassword, mSchema));
     break;
 
+#if defined(ANH_WITH_SQLITE)
+	case DBTYPE_SQLITE:
+		mDatabaseImplementation = new DatabaseImplementationSqlite(mHostname, mPort, mUsername, mPassword, mSchema);
+    break;
+#endif
+
 	default:
 		break;
   }
@@ -100,9 +108,28 @@ void DatabaseWorkerThread::run()
 		if(mCurrentJob)
 		{
             boost::mutex::scoped_lock lk(mWorkerThreadMutex);
+
+		  mCurrentJob->getTimes().mExecute = QueryStatistics::getTime();
+
+		  // a group of transactions, the results are reported by the transactions themselves
+		  if(mCurrentJob->isTransactionJob())
+		  {
+			  Transaction::executeGroup(mDatabaseImplementation,mCurrentJob->getTransactions());
+
+			  mCurrentJob->getTimes().mComplete = QueryStatistics::getTime();
+
+			  mDatabase->pushDatabaseJobComplete(mCurrentJob);
+			  mDatabase->pushIdleWorker(this);
+
+			  mCurrentJob = 0;
+			  continue;
+		  }
+
 		  // Execute our query
 		  DatabaseResult* result = mDatabaseImplementation->ExecuteSql(mCurrentJob->getSql(),mCurrentJob->isMultiJob());
 
+		  mCurrentJob->getTimes().mComplete = QueryStatistics::getTime();
+
 		  // Attach the result to our job and send it back.
 		  mCurrentJob->setDatabaseResult(result);
 
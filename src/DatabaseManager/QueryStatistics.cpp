@@ -0,0 +1,245 @@
+/*
+---------------------------------------------------------------------------------------
+This source file is part of swgANH (Star Wars Galaxies - A New Hope - Server Emulator)
+For more information, see http://www.swganh.org
+
+
+Copyright (c) 2006 - 2010 The swgANH Team
+
+---------------------------------------------------------------------------------------
+*/
+
+#include "QueryStatistics.h"
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+
+//======================================================================================================================
+
+LatencyHistogram::LatencyHistogram() :
+mCount(0),mTotal(0),mMax(0)
+{
+	memset(mBuckets,0,sizeof(mBuckets));
+}
+
+//======================================================================================================================
+
+uint32 LatencyHistogram::getBucket(uint64 value)
+{
+	if(value < SubBuckets)
+		return static_cast<uint32>(value);
+
+	uint32 bit = 0;
+	uint64 v   = value;
+
+	while(v >>= 1)
+		++bit;
+
+	if(bit > MaxBit)
+		return BucketCount - 1;
+
+	uint32 shift = bit - SubBucketBits;
+
+	return (shift + 1) * SubBuckets + static_cast<uint32>((value >> shift) & (SubBuckets - 1));
+}
+
+//======================================================================================================================
+
+uint64 LatencyHistogram::getBucketHigh(uint32 bucket)
+{
+	if(bucket < SubBuckets)
+		return bucket;
+
+	uint32 shift = bucket / SubBuckets - 1;
+	uint64 sub	 = bucket % SubBuckets;
+
+	return ((SubBuckets + sub + 1) << shift) - 1;
+}
+
+//======================================================================================================================
+
+void LatencyHistogram::record(uint64 value)
+{
+	++mBuckets[getBucket(value)];
+	++mCount;
+	mTotal += value;
+
+	if(value > mMax)
+		mMax = value;
+}
+
+//======================================================================================================================
+
+uint64 LatencyHistogram::getPercentile(double percentile) const
+{
+	if(!mCount)
+		return 0;
+
+	uint64 wanted	= static_cast<uint64>((percentile / 100.0) * mCount + 0.5);
+	uint64 seen		= 0;
+
+	if(!wanted)
+		wanted = 1;
+
+	for(uint32 i = 0; i < BucketCount; i++)
+	{
+		seen += mBuckets[i];
+
+		if(seen >= wanted)
+			return std::min(getBucketHigh(i),mMax);
+	}
+
+	return mMax;
+}
+
+//======================================================================================================================
+
+QueryStatistics::QueryStatistics(uint32 slowQueryThreshold,uint32 slowQueryLogSize) :
+mSlowQueries(slowQueryLogSize),
+mSlowQueryIndex(0),
+mSlowQueryCount(0),
+mSlowQueryThreshold(static_cast<uint64>(slowQueryThreshold) * 1000)
+{
+}
+
+//======================================================================================================================
+
+QueryStatistics::~QueryStatistics()
+{
+	QueryTagStatisticsMap::iterator it = mTagStatistics.begin();
+
+	while(it != mTagStatistics.end())
+	{
+		delete((*it).second);
+		++it;
+	}
+}
+
+//======================================================================================================================
+
+uint32 QueryStatistics::getTag(const int8* sql)
+{
+	// FNV-1a
+	uint32 hash = 2166136261u;
+
+	while(*sql && *sql != '\'' && *sql != '"')
+	{
+		hash ^= static_cast<uint8>(*sql++);
+		hash *= 16777619u;
+	}
+
+	return hash;
+}
+
+//======================================================================================================================
+
+uint64 QueryStatistics::getTime()
+{
+	static const boost::posix_time::ptime epoch(boost::gregorian::date(1970,1,1));
+
+	return (boost::posix_time::microsec_clock::universal_time() - epoch).total_microseconds();
+}
+
+//======================================================================================================================
+
+void QueryStatistics::record(uint32 tag,const int8* sql,const QueryTimes& times)
+{
+	QueryTagStatistics* stats;
+	QueryTagStatisticsMap::iterator it = mTagStatistics.find(tag);
+
+	if(it == mTagStatistics.end())
+	{
+		stats = new QueryTagStatistics();
+		stats->mSample.assign(sql,strnlen(sql,160));
+
+		mTagStatistics.insert(std::make_pair(tag,stats));
+	}
+	else
+	{
+		stats = (*it).second;
+	}
+
+	uint64 total = times.mDone - times.mEnqueue;
+
+	stats->mQueue.record(times.mExecute - times.mEnqueue);
+	stats->mExecute.record(times.mComplete - times.mExecute);
+	stats->mCallback.record(times.mDone - times.mCallback);
+	stats->mTotal.record(total);
+
+	if(total < mSlowQueryThreshold || mSlowQueries.empty())
+		return;
+
+	SlowQuery& slow = mSlowQueries[mSlowQueryIndex];
+
+	slow.mTag	= tag;
+	slow.mTimes = times;
+	slow.mSql.assign(sql,strnlen(sql,512));
+
+	mSlowQueryIndex = (mSlowQueryIndex + 1) % mSlowQueries.size();
+	++mSlowQueryCount;
+}
+
+//======================================================================================================================
+
+static bool compareTotalTime(const std::pair<uint32,QueryTagStatistics*>& a,const std::pair<uint32,QueryTagStatistics*>& b)
+{
+	return a.second->mTotal.getTotal() > b.second->mTotal.getTotal();
+}
+
+static void dumpHistogram(std::ostream& os,const int8* name,const LatencyHistogram& histogram)
+{
+	os << "    " << std::setw(9) << std::left << name << std::right
+	   << " mean " << std::setw(9) << histogram.getMean()
+	   << " p50 " << std::setw(9) << histogram.getPercentile(50.0)
+	   << " p90 " << std::setw(9) << histogram.getPercentile(90.0)
+	   << " p99 " << std::setw(9) << histogram.getPercentile(99.0)
+	   << " max " << std::setw(9) << histogram.getMax() << std::endl;
+}
+
+//======================================================================================================================
+//
+// call sites sorted by the total time they kept the server waiting, followed by the slow query log, times in us
+//
+
+void QueryStatistics::dump(std::ostream& os) const
+{
+	std::vector<std::pair<uint32,QueryTagStatistics*> > sorted(mTagStatistics.begin(),mTagStatistics.end());
+	std::sort(sorted.begin(),sorted.end(),compareTotalTime);
+
+	os << "Query statistics, " << sorted.size() << " call sites, times in microseconds" << std::endl;
+
+	for(uint32 i = 0; i < sorted.size(); i++)
+	{
+		const QueryTagStatistics* stats = sorted[i].second;
+
+		os << std::endl << "[" << std::hex << std::setw(8) << std::setfill('0') << sorted[i].first << std::dec << std::setfill(' ') << "] "
+		   << stats->mTotal.getCount() << " queries, " << stats->mTotal.getTotal() << " total: " << stats->mSample << std::endl;
+
+		dumpHistogram(os,"queue",stats->mQueue);
+		dumpHistogram(os,"execute",stats->mExecute);
+		dumpHistogram(os,"callback",stats->mCallback);
+		dumpHistogram(os,"total",stats->mTotal);
+	}
+
+	os << std::endl << "Slow queries (" << mSlowQueryCount << " above " << mSlowQueryThreshold << "), most recent first" << std::endl;
+
+	uint32 count = static_cast<uint32>(std::min<uint64>(mSlowQueryCount,mSlowQueries.size()));
+
+	for(uint32 i = 1; i <= count; i++)
+	{
+		const SlowQuery& slow = mSlowQueries[(mSlowQueryIndex + mSlowQueries.size() - i) % mSlowQueries.size()];
+
+		os << "[" << std::hex << std::setw(8) << std::setfill('0') << slow.mTag << std::dec << std::setfill(' ') << "]"
+		   << " queue " << (slow.mTimes.mExecute - slow.mTimes.mEnqueue)
+		   << " execute " << (slow.mTimes.mComplete - slow.mTimes.mExecute)
+		   << " callback " << (slow.mTimes.mDone - slow.mTimes.mCallback)
+		   << " total " << (slow.mTimes.mDone - slow.mTimes.mEnqueue)
+		   << ": " << slow.mSql << std::endl;
+	}
+}
+
+//======================================================================================================================
+
@@ -0,0 +1,134 @@
+/*
+---------------------------------------------------------------------------------------
+This source file is part of swgANH (Star Wars Galaxies - A New Hope - Server Emulator)
+For more information, see http://www.swganh.org
+
+
+Copyright (c) 2006 - 2010 The swgANH Team
+
+---------------------------------------------------------------------------------------
+*/
+
+#ifndef ANH_DATABASEMANAGER_QUERYSTATISTICS_H
+#define ANH_DATABASEMANAGER_QUERYSTATISTICS_H
+
+#include "Utils/typedefs.h"
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+//======================================================================================================================
+//
+// timestamps of a query in microseconds, set as it passes through the database
+//
+
+struct QueryTimes
+{
+	QueryTimes() : mEnqueue(0),mDispatch(0),mExecute(0),mComplete(0),mCallback(0),mDone(0){}
+
+	uint64	mEnqueue;		// handed to the database
+	uint64	mDispatch;		// handed to a worker
+	uint64	mExecute;		// worker started executing
+	uint64	mComplete;		// worker finished
+	uint64	mCallback;		// callback started on the main thread
+	uint64	mDone;			// callback returned
+};
+
+//======================================================================================================================
+//
+// log linear histogram of latencies in microseconds, 8 linear sub buckets per power of 2
+// precision is ~12% over the whole range, memory and recording cost are constant
+//
+
+class LatencyHistogram
+{
+	public:
+
+		static const uint32 SubBucketBits	= 3;
+		static const uint32 SubBuckets		= 1 << SubBucketBits;
+		static const uint32 MaxBit			= 35;	// ~9.5 hours
+		static const uint32 BucketCount		= (MaxBit - SubBucketBits + 2) * SubBuckets;
+
+		LatencyHistogram();
+
+		void		record(uint64 value);
+
+		uint64		getCount() const { return mCount; }
+		uint64		getMax() const { return mMax; }
+		uint64		getMean() const { return mCount ? mTotal / mCount : 0; }
+		uint64		getTotal() const { return mTotal; }
+
+		// upper bound of the bucket holding the given percentile (0.0 - 100.0)
+		uint64		getPercentile(double percentile) const;
+
+		static uint32	getBucket(uint64 value);
+		static uint64	getBucketHigh(uint32 bucket);
+
+	private:
+
+		uint32		mBuckets[BucketCount];
+		uint64		mCount;
+		uint64		mTotal;
+		uint64		mMax;
+};
+
+//======================================================================================================================
+//
+// statistics of all queries sharing a call site tag
+//
+
+struct QueryTagStatistics
+{
+	std::string			mSample;	// first query seen with this tag
+	LatencyHistogram	mQueue;		// enqueue to execution start
+	LatencyHistogram	mExecute;	// execution on the worker
+	LatencyHistogram	mCallback;	// time spent in the callback
+	LatencyHistogram	mTotal;		// enqueue to callback returned
+};
+
+struct SlowQuery
+{
+	uint32				mTag;
+	QueryTimes			mTimes;
+	std::string			mSql;
+};
+
+typedef std::map<uint32,QueryTagStatistics*>	QueryTagStatisticsMap;
+typedef std::vector<SlowQuery>					SlowQueryList;
+
+//======================================================================================================================
+//
+// gathers latencies per call site and keeps a ring of the last slow queries
+// only to be used from the main thread
+//
+
+class QueryStatistics
+{
+	public:
+
+		QueryStatistics(uint32 slowQueryThreshold,uint32 slowQueryLogSize);
+		~QueryStatistics();
+
+		void				record(uint32 tag,const int8* sql,const QueryTimes& times);
+		void				dump(std::ostream& os) const;
+
+		// the call site tag of a query, hashes the format string up to the first quote
+		// so queries passed with inlined string data still end up with their call site
+		static uint32		getTag(const int8* sql);
+
+		static uint64		getTime();
+
+	private:
+
+		QueryTagStatisticsMap	mTagStatistics;
+		SlowQueryList			mSlowQueries;
+		uint32					mSlowQueryIndex;
+		uint64					mSlowQueryCount;
+		uint64					mSlowQueryThreshold;	// microseconds
+};
+
+//======================================================================================================================
+
+#endif
+
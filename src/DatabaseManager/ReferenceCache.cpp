@@ -0,0 +1,465 @@
+/*
+---------------------------------------------------------------------------------------
+This source file is part of swgANH (Star Wars Galaxies - A New Hope - Server Emulator)
+For more information, see http://www.swganh.org
+
+
+Copyright (c) 2006 - 2010 The swgANH Team
+
+---------------------------------------------------------------------------------------
+*/
+
+#include "ReferenceCache.h"
+#include "DataBinding.h"
+
+#include "LogManager/LogManager.h"
+#include "Utils/bstring.h"
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+//======================================================================================================================
+//
+// snapshot layout, native byte order, everything 4 byte aligned
+//
+//   SnapshotHeader
+//   per table: SnapshotTableHeader, sql, offsets[rows * columns + 1], data
+//
+
+static const uint32 SnapshotMagic	= 0x52484e41;	// ANHR
+static const uint32 SnapshotVersion	= 1;
+
+struct SnapshotHeader
+{
+	uint32	mMagic;
+	uint32	mVersion;
+	uint64	mChecksum;
+	uint32	mTableCount;
+	uint32	mReserved;
+};
+
+struct SnapshotTableHeader
+{
+	uint32	mSqlLength;		// including the 0, padded
+	uint32	mColumnCount;
+	uint32	mRowCount;
+	uint32	mDataLength;	// padded
+};
+
+static uint32 padded(uint32 length)
+{
+	return (length + 3) & ~3;
+}
+
+//======================================================================================================================
+
+ReferenceResult::ReferenceResult(const ReferenceTable* table) :
+DatabaseResult(),mTable(table),mRowIndex(0)
+{
+	setRowCount(table->mRowCount);
+}
+
+//======================================================================================================================
+
+void ReferenceResult::GetNextRow(DataBinding* binding, void* object)
+{
+	if(mRowIndex >= mTable->mRowCount)
+		return;
+
+	uint32 rowStart = mRowIndex * mTable->mColumnCount;
+
+	++mRowIndex;
+
+	for(uint32 i = 0; i < binding->getFieldCount(); i++)
+	{
+		DataField&	field	= binding->mDataFields[i];
+		int8*		target	= &((int8*)object)[field.mDataOffset];
+
+		if(field.mColumn >= mTable->mColumnCount)
+			continue;
+
+		uint32		cell	= rowStart + field.mColumn;
+		const int8*	value	= mTable->mData + mTable->mOffsets[cell];
+		uint32		length	= mTable->mOffsets[cell + 1] - mTable->mOffsets[cell] - 1;
+
+		switch(field.mDataType)
+		{
+			case DFT_int8:		*((int8*)target)	= static_cast<int8>(atoi(value));				break;
+			case DFT_uint8:		*((uint8*)target)	= static_cast<uint8>(atoi(value));				break;
+			case DFT_int16:		*((int16*)target)	= static_cast<int16>(atoi(value));				break;
+			case DFT_uint16:	*((uint16*)target)	= static_cast<uint16>(atoi(value));				break;
+			case DFT_int32:		*((int32*)target)	= static_cast<int32>(strtol(value,NULL,10));	break;
+			case DFT_uint32:	*((uint32*)target)	= static_cast<uint32>(strtoul(value,NULL,10));	break;
+			case DFT_int64:		*((int64*)target)	= strtoll(value,NULL,10);						break;
+			case DFT_uint64:	*((uint64*)target)	= strtoull(value,NULL,10);						break;
+			case DFT_float:		*((float*)target)	= static_cast<float>(atof(value));				break;
+			case DFT_double:	*((double*)target)	= atof(value);									break;
+
+			case DFT_string:
+			{
+				memcpy(target,value,length);
+				target[length] = 0;
+			}
+			break;
+
+			case DFT_bstring:
+			{
+				BString* bindingString = reinterpret_cast<BString*>(target);
+				*bindingString = value;
+			}
+			break;
+
+			case DFT_raw:
+			{
+				memcpy(target,value,length);
+			}
+			break;
+
+			default:break;
+		}
+	}
+}
+
+//======================================================================================================================
+
+void ReferenceResult::ResetRowIndex(int index)
+{
+	mRowIndex = static_cast<uint32>(index);
+}
+
+//======================================================================================================================
+
+ReferenceCache::ReferenceCache(const std::string& fileName) :
+mFileName(fileName),
+mChecksum(0),
+mDirty(false),
+mFile(NULL),
+mRegion(NULL)
+{
+}
+
+//======================================================================================================================
+
+ReferenceCache::~ReferenceCache()
+{
+	_clear();
+}
+
+//======================================================================================================================
+
+void ReferenceCache::_clear()
+{
+	ReferenceTableMap::iterator it = mTables.begin();
+
+	while(it != mTables.end())
+	{
+		delete((*it).second);
+		++it;
+	}
+
+	mTables.clear();
+
+	delete(mRegion);
+	delete(mFile);
+
+	mRegion = NULL;
+	mFile	= NULL;
+}
+
+//======================================================================================================================
+//
+// copies the tables still pointing into the mapped snapshot into their own vectors and unmaps it
+//
+
+void ReferenceCache::_releaseSnapshot()
+{
+	if(!mRegion)
+		return;
+
+	ReferenceTableMap::iterator it = mTables.begin();
+
+	while(it != mTables.end())
+	{
+		ReferenceTable* table = (*it).second;
+
+		if(table->mOwnedOffsets.empty())
+		{
+			uint32 cellCount = table->mRowCount * table->mColumnCount;
+
+			table->mOwnedOffsets.assign(table->mOffsets,table->mOffsets + cellCount + 1);
+			table->mOwnedData.assign(table->mData,table->mData + table->mOffsets[cellCount]);
+
+			if(table->mOwnedData.empty())
+				table->mOwnedData.push_back(0);
+
+			table->mOffsets = &table->mOwnedOffsets[0];
+			table->mData	= &table->mOwnedData[0];
+		}
+
+		++it;
+	}
+
+	delete(mRegion);
+	delete(mFile);
+
+	mRegion = NULL;
+	mFile	= NULL;
+}
+
+//======================================================================================================================
+
+uint64 ReferenceCache::getChecksum(const std::vector<std::string>& cells)
+{
+	uint64 hash = 14695981039346656037ULL;
+
+	for(uint32 i = 0; i < cells.size(); i++)
+	{
+		const std::string& cell = cells[i];
+
+		for(uint32 c = 0; c <= cell.length(); c++)
+		{
+			hash ^= static_cast<uint8>(c < cell.length() ? cell[c] : 0);
+			hash *= 1099511628211ULL;
+		}
+	}
+
+	return hash;
+}
+
+//======================================================================================================================
+
+bool ReferenceCache::load(uint64 checksum)
+{
+	_clear();
+
+	mChecksum	= checksum;
+	mDirty		= false;
+
+	// no snapshot yet
+	if(!std::ifstream(mFileName.c_str()).is_open())
+		return(false);
+
+	try
+	{
+		mFile	= new boost::interprocess::file_mapping(mFileName.c_str(),boost::interprocess::read_only);
+		mRegion	= new boost::interprocess::mapped_region(*mFile,boost::interprocess::read_only);
+	}
+	catch(...)
+	{
+		gLogger->logMsgF("ReferenceCache: could not map %s",MSG_NORMAL,mFileName.c_str());
+		_clear();
+		return(false);
+	}
+
+	const int8*	data	= static_cast<const int8*>(mRegion->get_address());
+	uint64		size	= mRegion->get_size();
+
+	const SnapshotHeader* header = reinterpret_cast<const SnapshotHeader*>(data);
+
+	if(size < sizeof(SnapshotHeader) || header->mMagic != SnapshotMagic || header->mVersion != SnapshotVersion)
+	{
+		gLogger->logMsgF("ReferenceCache: %s is no snapshot of this version, ignoring it",MSG_NORMAL,mFileName.c_str());
+		_clear();
+		return(false);
+	}
+
+	if(header->mChecksum != checksum)
+	{
+		gLogger->logMsgF("ReferenceCache: reference tables changed since %s was taken",MSG_NORMAL,mFileName.c_str());
+		_clear();
+		return(false);
+	}
+
+	uint64 position = sizeof(SnapshotHeader);
+
+	for(uint32 i = 0; i < header->mTableCount; i++)
+	{
+		if(position + sizeof(SnapshotTableHeader) > size)
+			break;
+
+		const SnapshotTableHeader* tableHeader = reinterpret_cast<const SnapshotTableHeader*>(data + position);
+
+		uint64 cellCount	= static_cast<uint64>(tableHeader->mRowCount) * tableHeader->mColumnCount;
+		uint64 tableSize	= sizeof(SnapshotTableHeader) + tableHeader->mSqlLength + (cellCount + 1) * sizeof(uint32) + tableHeader->mDataLength;
+
+		if(position + tableSize > size)
+			break;
+
+		position += sizeof(SnapshotTableHeader);
+
+		const int8* sql = data + position;
+		position += tableHeader->mSqlLength;
+
+		ReferenceTable* table = new ReferenceTable();
+
+		table->mColumnCount = tableHeader->mColumnCount;
+		table->mRowCount	= tableHeader->mRowCount;
+		table->mOffsets		= reinterpret_cast<const uint32*>(data + position);
+		position += (cellCount + 1) * sizeof(uint32);
+
+		table->mData		= data + position;
+		position += tableHeader->mDataLength;
+
+		// a cell running past the data means the file got damaged
+		if(table->mOffsets[cellCount] > tableHeader->mDataLength)
+		{
+			delete(table);
+			break;
+		}
+
+		mTables.insert(std::make_pair(std::string(sql,strnlen(sql,tableHeader->mSqlLength)),table));
+	}
+
+	if(mTables.size() != header->mTableCount)
+	{
+		gLogger->logMsgF("ReferenceCache: %s is damaged, ignoring it",MSG_NORMAL,mFileName.c_str());
+		_clear();
+		return(false);
+	}
+
+	gLogger->logMsgF("ReferenceCache: mapped %u reference queries from %s",MSG_NORMAL,header->mTableCount,mFileName.c_str());
+
+	return(true);
+}
+
+//======================================================================================================================
+//
+// written to a temporary file first, so a zone starting meanwhile never maps half a snapshot
+//
+
+bool ReferenceCache::save()
+{
+	if(!mDirty)
+		return(true);
+
+	std::string		tempName = mFileName + ".tmp";
+	std::ofstream	file(tempName.c_str(),std::ios::out | std::ios::binary | std::ios::trunc);
+
+	if(!file.is_open())
+	{
+		gLogger->logMsgF("ReferenceCache: could not open %s",MSG_NORMAL,tempName.c_str());
+		return(false);
+	}
+
+	static const int8 zero[4] = {0,0,0,0};
+
+	SnapshotHeader header;
+	header.mMagic		= SnapshotMagic;
+	header.mVersion		= SnapshotVersion;
+	header.mChecksum	= mChecksum;
+	header.mTableCount	= static_cast<uint32>(mTables.size());
+	header.mReserved	= 0;
+
+	file.write(reinterpret_cast<const int8*>(&header),sizeof(header));
+
+	ReferenceTableMap::iterator it = mTables.begin();
+
+	while(it != mTables.end())
+	{
+		const std::string&		sql		= (*it).first;
+		const ReferenceTable*	table	= (*it).second;
+
+		uint32 cellCount	= table->mRowCount * table->mColumnCount;
+		uint32 sqlLength	= static_cast<uint32>(sql.length()) + 1;
+		uint32 dataLength	= table->mOffsets[cellCount];
+
+		SnapshotTableHeader tableHeader;
+		tableHeader.mSqlLength		= padded(sqlLength);
+		tableHeader.mColumnCount	= table->mColumnCount;
+		tableHeader.mRowCount		= table->mRowCount;
+		tableHeader.mDataLength		= padded(dataLength);
+
+		file.write(reinterpret_cast<const int8*>(&tableHeader),sizeof(tableHeader));
+
+		file.write(sql.c_str(),sqlLength);
+		file.write(zero,tableHeader.mSqlLength - sqlLength);
+
+		file.write(reinterpret_cast<const int8*>(table->mOffsets),(cellCount + 1) * sizeof(uint32));
+
+		file.write(table->mData,dataLength);
+		file.write(zero,tableHeader.mDataLength - dataLength);
+
+		++it;
+	}
+
+	file.close();
+
+	if(file.fail())
+	{
+		gLogger->logMsgF("ReferenceCache: could not write %s",MSG_NORMAL,tempName.c_str());
+		remove(tempName.c_str());
+		return(false);
+	}
+
+	// windows won't remove or rename a mapped file, nor rename onto an existing one
+	_releaseSnapshot();
+
+	remove(mFileName.c_str());
+
+	if(rename(tempName.c_str(),mFileName.c_str()) != 0)
+	{
+		gLogger->logMsgF("ReferenceCache: could not replace %s",MSG_NORMAL,mFileName.c_str());
+		return(false);
+	}
+
+	gLogger->logMsgF("ReferenceCache: wrote %u reference queries to %s",MSG_NORMAL,header.mTableCount,mFileName.c_str());
+
+	mDirty = false;
+
+	return(true);
+}
+
+//======================================================================================================================
+
+const ReferenceTable* ReferenceCache::find(const int8* sql) const
+{
+	ReferenceTableMap::const_iterator it = mTables.find(sql);
+
+	if(it == mTables.end())
+		return(NULL);
+
+	return((*it).second);
+}
+
+//======================================================================================================================
+
+void ReferenceCache::store(const int8* sql,uint32 columnCount,const std::vector<std::string>& cells)
+{
+	if(!columnCount || mTables.find(sql) != mTables.end())
+		return;
+
+	ReferenceTable* table = new ReferenceTable();
+
+	table->mColumnCount = columnCount;
+	table->mRowCount	= static_cast<uint32>(cells.size() / columnCount);
+
+	table->mOwnedOffsets.reserve(cells.size() + 1);
+
+	for(uint32 i = 0; i < cells.size(); i++)
+	{
+		table->mOwnedOffsets.push_back(static_cast<uint32>(table->mOwnedData.size()));
+		table->mOwnedData.insert(table->mOwnedData.end(),cells[i].begin(),cells[i].end());
+		table->mOwnedData.push_back(0);
+	}
+
+	table->mOwnedOffsets.push_back(static_cast<uint32>(table->mOwnedData.size()));
+
+	// an empty vector has no valid data pointer
+	if(table->mOwnedData.empty())
+		table->mOwnedData.push_back(0);
+
+	table->mOffsets = &table->mOwnedOffsets[0];
+	table->mData	= &table->mOwnedData[0];
+
+	mTables.insert(std::make_pair(std::string(sql),table));
+
+	mDirty = true;
+}
+
+//======================================================================================================================
+
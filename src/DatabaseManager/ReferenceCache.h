@@ -0,0 +1,120 @@
+/*
+---------------------------------------------------------------------------------------
+This source file is part of swgANH (Star Wars Galaxies - A New Hope - Server Emulator)
+For more information, see http://www.swganh.org
+
+
+Copyright (c) 2006 - 2010 The swgANH Team
+
+---------------------------------------------------------------------------------------
+*/
+
+#ifndef ANH_DATABASEMANAGER_REFERENCECACHE_H
+#define ANH_DATABASEMANAGER_REFERENCECACHE_H
+
+#include "DatabaseResult.h"
+#include "Utils/typedefs.h"
+#include <map>
+#include <string>
+#include <vector>
+
+namespace boost
+{
+	namespace interprocess
+	{
+		class file_mapping;
+		class mapped_region;
+	}
+}
+
+//======================================================================================================================
+//
+// the rows of one reference query, stored as strings
+// cell i spans mData[mOffsets[i]] to mData[mOffsets[i + 1] - 1], every cell is 0 terminated
+// the arrays either point into the mapped snapshot or into the owned vectors
+//
+
+struct ReferenceTable
+{
+	ReferenceTable() : mColumnCount(0),mRowCount(0),mOffsets(NULL),mData(NULL){}
+
+	uint32					mColumnCount;
+	uint32					mRowCount;
+	const uint32*			mOffsets;
+	const int8*				mData;
+
+	std::vector<uint32>		mOwnedOffsets;
+	std::vector<int8>		mOwnedData;
+};
+
+typedef std::map<std::string,ReferenceTable*>	ReferenceTableMap;
+
+//======================================================================================================================
+//
+// serves the cached rows through the usual data bindings
+//
+
+class ReferenceResult : public DatabaseResult
+{
+	public:
+
+		ReferenceResult(const ReferenceTable* table);
+
+		virtual void			GetNextRow(DataBinding* dataBinding, void* object);
+		virtual void			ResetRowIndex(int index = 0);
+
+	private:
+
+		const ReferenceTable*	mTable;
+		uint32					mRowIndex;
+};
+
+//======================================================================================================================
+//
+// read through cache of the static reference tables, keyed by the sql of the query
+//
+// the cached results are written to a binary snapshot, which gets mapped on the next start
+// as long as the checksum of the reference tables it was taken with still matches
+// only to be used from the main thread
+//
+
+class ReferenceCache
+{
+	public:
+
+		ReferenceCache(const std::string& fileName);
+		~ReferenceCache();
+
+		// maps the snapshot, if there is one taken with the given checksum
+		bool					load(uint64 checksum);
+
+		// writes all cached tables, if anything was added since the snapshot was loaded or saved
+		bool					save();
+
+		const ReferenceTable*	find(const int8* sql) const;
+		void					store(const int8* sql,uint32 columnCount,const std::vector<std::string>& cells);
+
+		uint32					getTableCount() const { return static_cast<uint32>(mTables.size()); }
+		bool					isDirty() const { return mDirty; }
+
+		// FNV-1a over the cells, used on the output of CHECKSUM TABLE
+		static uint64			getChecksum(const std::vector<std::string>& cells);
+
+	private:
+
+		void					_clear();
+		void					_releaseSnapshot();
+
+		std::string								mFileName;
+		uint64									mChecksum;
+		bool									mDirty;
+		ReferenceTableMap						mTables;
+
+		boost::interprocess::file_mapping*		mFile;
+		boost::interprocess::mapped_region*		mRegion;
+};
+
+//======================================================================================================================
+
+#endif // ANH_DATABASEMANAGER_REFERENCECACHE_H
+
@@ -14,26 +14,71 @@ Copyright (c) 2006 - 2010 The swgANH Team
 #include "Database.h"
 #include "DatabaseCallback.h"
 #include "DatabaseImplementation.h"
-#include "DatabaseImplementationMySql.h"
 
 #include "LogManager/LogManager.h"
 
 #include <cstdarg>
+#include <cstdio>
+
+//======================================================================================================================
+
+TransactionStatement& TransactionStatement::bindInt(int64 value)
+{
+	Param param;
+	param.mType = Param_Int;
+	param.mInt	= value;
+
+	mParams.push_back(param);
+	return(*this);
+}
+
+//======================================================================================================================
+
+TransactionStatement& TransactionStatement::bindUInt(uint64 value)
+{
+	Param param;
+	param.mType = Param_UInt;
+	param.mUInt	= value;
+
+	mParams.push_back(param);
+	return(*this);
+}
+
+//======================================================================================================================
+
+TransactionStatement& TransactionStatement::bindDouble(double value)
+{
+	Param param;
+	param.mType		= Param_Double;
+	param.mDouble	= value;
+
+	mParams.push_back(param);
+	return(*this);
+}
+
+//======================================================================================================================
+
+TransactionStatement& TransactionStatement::bindString(const int8* value,uint32 length)
+{
+	Param param;
+	param.mType = Param_String;
+
+	mParams.push_back(param);
+	mParams.back().mString.assign(value,length);
+	return(*this);
+}
 
 //======================================================================================================================
 
 Transaction::Transaction(Database* database,DatabaseCallback* callback,void* ref) :
 mDatabase(database),mCallback(callback),mReference(ref)
 {
-	mQueries.flush();
-	mQueries << "CALL sp_MultiTransaction(\"";
 }
 
 //======================================================================================================================
 
 Transaction::~Transaction()
 {
-	mQueries.flush();
 }
 
 //======================================================================================================================
@@ -42,28 +87,180 @@ void Transaction::addQuery(int8* query,...)
 {
 	va_list	args;
 	va_start(args,query);
-	int8	localSql[2048],escapedSql[2500];
-	int32	len = vsnprintf(localSql,sizeof(localSql),query,args);
-
-	gLogger->logMsgF("transaction add query",MSG_NORMAL);
-	// need to escape
-	mDatabase->Escape_String(escapedSql,localSql,len);
+	int8	localSql[2048];
+	vsnprintf(localSql,sizeof(localSql),query,args);
 
-	mQueries << escapedSql << "$$";
+	mStatements.push_back(TransactionStatement(localSql));
 
 	va_end(args);
 }
 
+//======================================================================================================================
+//
+// the returned statement is valid until the next statement gets added, bind its parameters right away
+// t->addStatement("UPDATE banks SET credits=credits+? WHERE id=?").bindInt(amount).bindUInt(bankId);
+//
+
+TransactionStatement& Transaction::addStatement(const int8* sql)
+{
+	mStatements.push_back(TransactionStatement(sql));
+
+	return(mStatements.back());
+}
+
 //======================================================================================================================
 
 void Transaction::execute()
 {
-	mQueries << "\")";
+	mDatabase->commitTransaction(this);
+}
+
+//======================================================================================================================
+
+void Transaction::complete()
+{
+	if(mCallback)
+	{
+		mCallback->handleDatabaseJobComplete(mReference,&mResult);
+	}
+}
+
+//======================================================================================================================
+//
+// runs the statements of this transaction, on failure everything done since the savepoint gets rolled back
+// returns false on a failing statement, if the failure ended the whole database transaction there is no savepoint left to go back to
+//
+
+bool Transaction::_execute(DatabaseImplementation* implementation,uint32 savePoint)
+{
+	int8 command[64];
+
+	mResult.setError(0,0);
+
+	StatementResultList& results = mResult.getStatementResults();
+	results.assign(mStatements.size(),StatementResult());
+
+	sprintf(command,"SAVEPOINT sp_%u",savePoint);
+
+	if(!implementation->ExecuteCommand(command))
+	{
+		mResult.setError(implementation->GetLastError(),0);
+		return(false);
+	}
 
-	mDatabase->ExecuteProcedureAsync(mCallback,mReference,(int8*)(mQueries.str().c_str()));
-	mDatabase->destroyTransaction(this);
+	for(uint32 i = 0; i < mStatements.size(); i++)
+	{
+		implementation->ExecuteStatement(mStatements[i],results[i]);
+
+		if(results[i].mError)
+		{
+			gLogger->logMsgF("Transaction: statement %u failed (%u): %s",MSG_HIGH,i,results[i].mError,mStatements[i].getSql().c_str());
+
+			mResult.setError(results[i].mError,i);
+
+			if(implementation->EndedTransaction(results[i].mError))
+			{
+				return(false);
+			}
+
+			sprintf(command,"ROLLBACK TO SAVEPOINT sp_%u",savePoint);
+			implementation->ExecuteCommand(command);
+
+			return(false);
+		}
+	}
+
+	sprintf(command,"RELEASE SAVEPOINT sp_%u",savePoint);
+	implementation->ExecuteCommand(command);
+
+	return(true);
 }
 
 //======================================================================================================================
+//
+// group commit, all transactions of the group share one commit and with it one log flush on the server
+// an error that ends the database transaction (deadlock, lost connection) takes the work of the whole group with it,
+// the group is run again from the start then, when it keeps failing every transaction of it reports the error
+//
+
+static const uint32 MaxGroupAttempts = 3;
+
+void Transaction::executeGroup(DatabaseImplementation* implementation,TransactionList& group)
+{
+	uint32 lostError = 0;
+
+	for(uint32 attempt = 0; attempt < MaxGroupAttempts; attempt++)
+	{
+		if(!implementation->BeginTransaction())
+		{
+			uint32 error = implementation->GetLastError();
+
+			for(uint32 i = 0; i < group.size(); i++)
+			{
+				group[i]->mResult.setError(error,0);
+			}
+
+			return;
+		}
+
+		lostError = 0;
+
+		// a transaction the lost attempt didnt get to must not report an older result
+		for(uint32 i = 0; i < group.size(); i++)
+		{
+			group[i]->mResult.setError(0,0);
+		}
+
+		for(uint32 i = 0; i < group.size(); i++)
+		{
+			if(!group[i]->_execute(implementation,i) && implementation->EndedTransaction(group[i]->mResult.getError()))
+			{
+				lostError = group[i]->mResult.getError();
+				break;
+			}
+		}
+
+		if(!lostError)
+		{
+			break;
+		}
+
+		gLogger->logMsgF("Transaction: group of %u transactions lost (%u), attempt %u of %u",MSG_HIGH,static_cast<uint32>(group.size()),lostError,attempt + 1,MaxGroupAttempts);
 
+		implementation->RollbackTransaction();
+	}
+
+	if(lostError)
+	{
+		for(uint32 i = 0; i < group.size(); i++)
+		{
+			if(group[i]->mResult.isSuccess())
+			{
+				group[i]->mResult.setError(lostError,static_cast<uint32>(group[i]->mStatements.size()));
+			}
+		}
+
+		return;
+	}
+
+	if(!implementation->CommitTransaction())
+	{
+		// nothing made it, report it to everyone who thinks he succeeded
+		uint32 error = implementation->GetLastError();
+
+		gLogger->logMsgF("Transaction: commit of %u transactions failed (%u)",MSG_HIGH,static_cast<uint32>(group.size()),error);
+
+		implementation->RollbackTransaction();
+
+		for(uint32 i = 0; i < group.size(); i++)
+		{
+			if(group[i]->mResult.isSuccess())
+			{
+				group[i]->mResult.setError(error,static_cast<uint32>(group[i]->mStatements.size()));
+			}
+		}
+	}
+}
+
+//======================================================================================================================
 
@@ -13,15 +13,75 @@ Copyright (c) 2006 - 2010 The swgANH Team
 #define ANH_DATABASEMANAGER_TRANSACTION_H
 
 
+#include "TransactionResult.h"
 #include "Utils/typedefs.h"
-#include <sstream>
+#include <string>
+#include <vector>
 
 class DatabaseImplementation;
 class DatabaseCallback;
 class DatabaseResult;
 class Database;
+class Transaction;
+
+typedef std::vector<Transaction*>	TransactionList;
 
 //======================================================================================================================
+//
+// a single statement of a transaction
+// statements with bound parameters are executed as prepared statements, the sql uses ? as placeholders
+//
+
+class TransactionStatement
+{
+	public:
+
+		enum ParamType
+		{
+			Param_Int		= 0,
+			Param_UInt		= 1,
+			Param_Double	= 2,
+			Param_String	= 3
+		};
+
+		struct Param
+		{
+			ParamType		mType;
+			int64			mInt;
+			uint64			mUInt;
+			double			mDouble;
+			std::string		mString;
+		};
+
+		typedef std::vector<Param>	ParamList;
+
+		TransactionStatement(const int8* sql) : mSql(sql){}
+
+		TransactionStatement&	bindInt(int64 value);
+		TransactionStatement&	bindUInt(uint64 value);
+		TransactionStatement&	bindDouble(double value);
+		TransactionStatement&	bindString(const int8* value,uint32 length);
+		TransactionStatement&	bindString(const std::string& value){ return(bindString(value.c_str(),static_cast<uint32>(value.length()))); }
+
+		const std::string&		getSql() const { return mSql; }
+		ParamList&				getParams(){ return mParams; }
+		bool					isPrepared() const { return !mParams.empty(); }
+
+	private:
+
+		std::string		mSql;
+		ParamList		mParams;
+};
+
+typedef std::vector<TransactionStatement>	TransactionStatementList;
+
+//======================================================================================================================
+//
+// Transactions don't run on their own, execute() queues them with the database which commits all transactions
+// queued during one Process() tick as a group, so they share a single commit on the server.
+// Every transaction of the group gets its own savepoint, a failing statement only rolls back its own transaction.
+// The callback receives a TransactionResult, holding the result of every statement.
+//
 
 class Transaction
 {
@@ -30,15 +90,25 @@ class Transaction
 		Transaction(Database* database,DatabaseCallback* callback,void* ref);
 		~Transaction();
 
-		void		execute();
-		void		addQuery(int8* query,...);
+		void					execute();
+		void					addQuery(int8* query,...);
+		TransactionStatement&	addStatement(const int8* sql);
+
+		// worker thread side, runs a group of transactions inside one database transaction
+		static void				executeGroup(DatabaseImplementation* implementation,TransactionList& group);
+
+		// main thread side, hands the result to the callback
+		void					complete();
 
 	private:
 
-		Database*				mDatabase;
-		DatabaseCallback*		mCallback;
-		void*					mReference;
-		std::ostringstream		mQueries;
+		bool					_execute(DatabaseImplementation* implementation,uint32 savePoint);
+
+		Database*					mDatabase;
+		DatabaseCallback*			mCallback;
+		void*						mReference;
+		TransactionStatementList	mStatements;
+		TransactionResult			mResult;
 };
 
 //======================================================================================================================
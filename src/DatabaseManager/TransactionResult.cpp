@@ -0,0 +1,54 @@
+/*
+---------------------------------------------------------------------------------------
+This source file is part of swgANH (Star Wars Galaxies - A New Hope - Server Emulator)
+For more information, see http://www.swganh.org
+
+
+Copyright (c) 2006 - 2010 The swgANH Team
+
+---------------------------------------------------------------------------------------
+*/
+
+#include "TransactionResult.h"
+#include "DataBinding.h"
+
+//======================================================================================================================
+
+void TransactionResult::GetNextRow(DataBinding* binding, void* object)
+{
+	// theres only a single row
+	if(mRowIndex > 0)
+		return;
+
+	++mRowIndex;
+
+	for(uint32 i = 0; i < binding->getFieldCount(); i++)
+	{
+		uint64	value;
+		int8*	target = ((int8*)object) + binding->mDataFields[i].mDataOffset;
+
+		switch(binding->mDataFields[i].mColumn)
+		{
+			case 0:		value = mError;				break;
+			case 1:		value = mFailedStatement;	break;
+			default:	continue;
+		}
+
+		switch(binding->mDataFields[i].mDataType)
+		{
+			case DFT_int8:
+			case DFT_uint8:		*((uint8*)target) = static_cast<uint8>(value);		break;
+			case DFT_int16:
+			case DFT_uint16:	*((uint16*)target) = static_cast<uint16>(value);	break;
+			case DFT_int32:
+			case DFT_uint32:	*((uint32*)target) = static_cast<uint32>(value);	break;
+			case DFT_int64:
+			case DFT_uint64:	*((uint64*)target) = value;							break;
+
+			default:break;
+		}
+	}
+}
+
+//======================================================================================================================
+
@@ -0,0 +1,70 @@
+/*
+---------------------------------------------------------------------------------------
+This source file is part of swgANH (Star Wars Galaxies - A New Hope - Server Emulator)
+For more information, see http://www.swganh.org
+
+
+Copyright (c) 2006 - 2010 The swgANH Team
+
+---------------------------------------------------------------------------------------
+*/
+
+#ifndef ANH_DATABASEMANAGER_TRANSACTIONRESULT_H
+#define ANH_DATABASEMANAGER_TRANSACTIONRESULT_H
+
+#include "DatabaseResult.h"
+#include "Utils/typedefs.h"
+#include <vector>
+
+//======================================================================================================================
+
+struct StatementResult
+{
+	StatementResult() : mError(0),mAffectedRows(0),mInsertId(0){}
+
+	uint32	mError;			// native error code, 0 on success
+	uint64	mAffectedRows;
+	uint64	mInsertId;
+};
+
+typedef std::vector<StatementResult>	StatementResultList;
+
+//======================================================================================================================
+//
+// result handed to the callback of a transaction
+// reads like the result of the former sp_MultiTransaction, one row with the columns
+// 0: error code (0 on success), 1: index of the failed statement
+// the results of the single statements are available through getStatementResult()
+//
+
+class TransactionResult : public DatabaseResult
+{
+	public:
+
+		TransactionResult() : DatabaseResult(false),mError(0),mFailedStatement(0),mRowIndex(0){ setRowCount(1); }
+
+		virtual void				GetNextRow(DataBinding* dataBinding, void* object);
+		virtual void				ResetRowIndex(int index = 0){ mRowIndex = index; }
+
+		bool						isSuccess() const { return mError == 0; }
+		uint32						getError() const { return mError; }
+		uint32						getFailedStatement() const { return mFailedStatement; }
+
+		uint32						getStatementCount() const { return static_cast<uint32>(mStatementResults.size()); }
+		const StatementResult&		getStatementResult(uint32 index) const { return mStatementResults[index]; }
+
+		void						setError(uint32 error,uint32 statement){ mError = error; mFailedStatement = statement; }
+		StatementResultList&		getStatementResults(){ return mStatementResults; }
+
+	private:
+
+		StatementResultList			mStatementResults;
+		uint32						mError;
+		uint32						mFailedStatement;
+		int							mRowIndex;
+};
+
+//======================================================================================================================
+
+#endif
+
@@ -91,6 +91,10 @@ Log* LogManager::createLog(const std::string& name,LogLevel level,bool fileOut,b
 
 void LogManager::connecttoDB(DatabaseManager* dbManager)
 {
+	// the logs are written through a stored procedure, not available on the embedded database
+	if(gConfig->read<std::string>("DBType","mysql") != "mysql")
+		return;
+
 	std::string server	= (char*)(gConfig->read<std::string>("DBServer")).c_str();
 	int port			= (int)(gConfig->read<int>("DBPort"));
 	std::string user	= (char*)(gConfig->read<std::string>("DBUser")).c_str();
@@ -65,7 +65,7 @@ void LoginManager::Process(void)
 	// Update our galaxy status list once in a while.
 	if (Anh_Utils::Clock::getSingleton()->getLocalTime() - mLastStatusQuery > 5000)
 	{
-		mLastStatusQuery = static_cast<uint32>(Anh_Utils::Clock::getSingleton()->getLocalTime());
+		mLastStatusQuery = Anh_Utils::Clock::getSingleton()->getLocalTime();
 		mDatabase->ExecuteSqlAsync(this, (void*)1, "SELECT galaxy_id, name, address, port, pingport, population, status, UNIX_TIMESTAMP(last_update) FROM galaxy;");
 	}
 }
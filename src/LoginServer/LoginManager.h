@@ -92,7 +92,7 @@ class LoginManager : public NetworkCallback, public DatabaseCallback
 		ServerDataList          mServerDataList;
 		bool                    mSendServerList;
 
-		uint32                  mLastStatusQuery;
+		uint64                  mLastStatusQuery;
 
 		boost::pool<boost::default_user_allocator_malloc_free>	mLoginClientPool;
 };
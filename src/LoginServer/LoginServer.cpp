@@ -87,6 +87,7 @@ mNetworkManager(0)
 	mDatabase->DestroyResult(mDatabase->ExecuteSynchSql("UPDATE config_process_list SET address='%s', port=%u, status=%u WHERE name='login';", mService->getLocalAddress(), mService->getLocalPort(), 2));
 
 	gLogger->logMsg("LoginServer Startup complete");
+	mDatabase->setStartupComplete();
 	//gLogger->printLogo();
 	// std::string BuildString(GetBuildString());	
 
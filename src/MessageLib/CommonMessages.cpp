@@ -313,7 +313,7 @@ void MessageLib::sendUpdateTransformMessage(MovingObject* object)
     mMessageFactory->addUint8(static_cast<uint8>(glm::length(object->mPosition) * 4.0f + 0.5f));
     mMessageFactory->addUint8(static_cast<uint8>(glm::gtx::quaternion::angle(object->mDirection) / 0.0625f)); 
 
-	_sendToInRangeUnreliable(mMessageFactory->EndMessage(),object,8,true);
+	_sendToInRangeTiered(mMessageFactory->EndMessage(),object,MovingObject::TransformKind_Update,object->getInMoveCount(),8,true);
 }
 
 //======================================================================================================================
@@ -339,7 +339,7 @@ void MessageLib::sendUpdateTransformMessageWithParent(MovingObject* object)
     mMessageFactory->addUint8(static_cast<uint8>(glm::length(object->mPosition) * 8.0f + 0.5f));
     mMessageFactory->addUint8(static_cast<uint8>(glm::gtx::quaternion::angle(object->mDirection) / 0.0625f)); 
 
-	_sendToInRangeUnreliable(mMessageFactory->EndMessage(),object,8,false);		
+	_sendToInRangeTiered(mMessageFactory->EndMessage(),object,MovingObject::TransformKind_Update,object->getInMoveCount(),8,false);
 }
 
 //======================================================================================================================
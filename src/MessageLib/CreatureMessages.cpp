@@ -1475,6 +1475,59 @@ void MessageLib::sendCurrentHitpointDeltasCreo6_Full(CreatureObject* creatureObj
 	_sendToInRange(mMessageFactory->EndMessage(),creatureObject,5);
 }
 
+//======================================================================================================================
+//
+// Creature Deltas Type 6
+// update: current hitpoints, the bars set in the mask
+//
+
+void MessageLib::sendCurrentHitpointDeltasCreo6_Bars(CreatureObject* creatureObject,uint16 barMask)
+{
+	Ham* ham = creatureObject->getHam();
+
+	if(ham == NULL)
+		return;
+
+	uint32 barCount = 0;
+
+	for(uint8 barIndex = HamBar_Health; barIndex <= HamBar_Willpower; barIndex++)
+	{
+		if(barMask & (1 << barIndex))
+			barCount++;
+	}
+
+	if(!barCount)
+		return;
+
+	mMessageFactory->StartMessage();
+	mMessageFactory->addUint32(opDeltasMessage);
+	mMessageFactory->addUint64(creatureObject->getId());
+	mMessageFactory->addUint32(opCREO);
+	mMessageFactory->addUint8(6);
+
+	mMessageFactory->addUint32(12 + barCount * 7);
+	mMessageFactory->addUint16(1);
+	mMessageFactory->addUint16(13);
+
+	mMessageFactory->addUint32(barCount);
+
+	ham->advanceCurrentHitpointsUpdateCounter(barCount);
+
+	mMessageFactory->addUint32(ham->getCurrentHitpointsUpdateCounter());
+
+	for(uint8 barIndex = HamBar_Health; barIndex <= HamBar_Willpower; barIndex++)
+	{
+		if(!(barMask & (1 << barIndex)))
+			continue;
+
+		mMessageFactory->addUint8(2);
+		mMessageFactory->addUint16(barIndex);
+		mMessageFactory->addInt32(ham->getPropertyValue(barIndex,HamProperty_CurrentHitpoints));
+	}
+
+	_sendToInRange(mMessageFactory->EndMessage(),creatureObject,5);
+}
+
 //======================================================================================================================
 //
 // Creature Deltas Type 3
@@ -27,6 +27,7 @@ Copyright (c) 2006 - 2010 The swgANH Team
 #include "ZoneServer/ManufacturingSchematic.h"
 #include "ZoneServer/MissionBag.h"
 #include "ZoneServer/MissionObject.h"
+#include "ZoneServer/MountObject.h"
 #include "ZoneServer/NPCObject.h"
 #include "ZoneServer/ObjectControllerOpcodes.h"
 #include "ZoneServer/ObjectFactory.h"
@@ -40,6 +41,7 @@ Copyright (c) 2006 - 2010 The swgANH Team
 #include "ZoneServer/ZoneOpcodes.h"
 
 #include "LogManager/LogManager.h"
+#include "Utils/clock.h"
 
 #include "Common/atMacroString.h"
 #include "Common/DispatchClient.h"
@@ -213,6 +215,127 @@ void MessageLib::_sendToInRangeUnreliable(Message* message, Object* const object
 	mMessageFactory->DestroyMessage(message);
 }
 
+//======================================================================================================================
+//
+// movement updates, thinned out with the distance to the observer
+// near observers get everything, mid range ones every n-th update (by the sequence of the message),
+// far ones only after the object moved or turned noticeably, stopping goes out to everyone
+//
+// before that, updates that the observers can extrapolate from the last one sent (dead reckoning)
+// are dropped altogether, a keyframe every KeyframeInterval bounds the drift
+//
+
+void MessageLib::_sendToInRangeTiered(Message* message, MovingObject* const object,uint8 kind,uint32 sequence,uint16 priority,bool toSelf)
+{
+	const TransformTier& tier = ((object->getType() == ObjType_Player) || dynamic_cast<MountObject*>(object))
+								? gWorldConfig->getPlayerTransformTier()
+								: gWorldConfig->getNpcTransformTier();
+
+	MovingObject::TransformTierState& state = object->getTransformTierState(static_cast<MovingObject::TransformKind>(kind));
+
+	float	angle		= glm::gtx::quaternion::angle(object->mDirection);
+	float	speed		= object->getCurrentSpeed();
+	bool	stopped		= (speed == 0.0f) && (state.mSpeed != 0.0f);
+	bool	broadcast	= true;
+
+	state.mSpeed = speed;
+
+	if(tier.mPredictionError > 0.0f)
+	{
+		uint64		now			= gClock->getLocalTime();
+		float		elapsed		= static_cast<float>(now - state.mSentTime) / 1000.0f;
+		glm::vec3	predicted	= state.mSentPosition + state.mSentVelocity * elapsed;
+		bool		keyframe	= (now - state.mKeyframeTime) >= tier.mKeyframeInterval;
+
+		if(!stopped && !keyframe && (glm::distance(predicted,object->mPosition) < tier.mPredictionError) && (fabs(angle - state.mSentAngle) < 0.1f))
+		{
+			broadcast = false;
+		}
+		else
+		{
+			// nothing to extrapolate when standing, and a long gap says nothing about the current movement
+			if((speed == 0.0f) || (elapsed <= 0.0f) || (elapsed > 1.0f))
+			{
+				state.mSentVelocity = glm::vec3();
+			}
+			else
+			{
+				state.mSentVelocity = (object->mPosition - state.mSentPosition) / elapsed;
+			}
+
+			state.mSentPosition	= object->mPosition;
+			state.mSentAngle	= angle;
+			state.mSentTime		= now;
+
+			if(keyframe || stopped)
+			{
+				state.mKeyframeTime = now;
+			}
+		}
+	}
+
+	if(broadcast)
+	{
+		bool midDue = !tier.mEnabled || stopped || ((sequence % tier.mMidInterval) == 0);
+		bool farDue = !tier.mEnabled || stopped || (glm::distance(object->mPosition,state.mPosition) >= tier.mFarDistance) || (fabs(angle - state.mAngle) >= 0.5f);
+
+		if(farDue)
+		{
+			state.mPosition	= object->mPosition;
+			state.mAngle	= angle;
+		}
+
+		float nearRange	= tier.mNearRange * tier.mNearRange;
+		float midRange	= tier.mMidRange * tier.mMidRange;
+
+		PlayerObjectSet*			inRangePlayers	= object->getKnownPlayers();
+		PlayerObjectSet::iterator	playerIt		= inRangePlayers->begin();
+
+		bool failed = false;
+		while(playerIt != inRangePlayers->end())
+		{
+			if(_checkPlayer((*playerIt)))
+			{
+				glm::vec3	offset		= (*playerIt)->mPosition - object->mPosition;
+				float		distance	= glm::dot(offset,offset);
+
+				if((distance <= nearRange) || ((distance <= midRange) ? midDue : farDue))
+				{
+					if(_checkDistance((*playerIt)->mPosition,object,mMessageFactory->HeapWarningLevel()))
+					{
+						// clone our message
+						mMessageFactory->StartMessage();
+						mMessageFactory->addData(message->getData(),message->getSize());
+
+						((*playerIt)->getClient())->SendChannelAUnreliable(mMessageFactory->EndMessage(),(*playerIt)->getAccountId(),CR_Client,static_cast<uint8>(priority));
+					}
+					else
+					{
+						failed = true;
+					}
+				}
+			}
+
+			++playerIt;
+		}
+		if(failed)
+			gLogger->logMsgF("MessageLib Heap Protection engaged Heap Warning Level %u Heap size %f",MSG_NORMAL,mMessageFactory->HeapWarningLevel(),mMessageFactory->getHeapsize());
+	}
+
+	if(toSelf)
+	{
+		const PlayerObject* const srcPlayer = dynamic_cast<const PlayerObject*>(object);
+
+		if(_checkPlayer(srcPlayer))
+		{
+			(srcPlayer->getClient())->SendChannelAUnreliable(message,srcPlayer->getAccountId(),CR_Client,static_cast<uint8>(priority));
+			return;
+		}
+	}
+
+	mMessageFactory->DestroyMessage(message);
+}
+
 //======================================================================================================================
 
 void MessageLib::_sendToInRange(Message* message, Object* const object,uint16 priority,bool toSelf)
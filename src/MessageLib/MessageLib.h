@@ -13,6 +13,7 @@ Copyright (c) 2006 - 2010 The swgANH Team
 #define ANH_ZONESERVER_MESSAGELIB_H
 
 #include "Utils/typedefs.h"
+#include "Utils/FlatSet.h"
 //#include "Utils/typedefs.h"
 //#include "ZoneServer/ObjectFactory.h"
 #include "ZoneServer/ObjectController.h"
@@ -58,7 +59,7 @@ class ActiveConversation;
 
 typedef struct tagResourceLocation ResourceLocation;
 
-typedef std::set<PlayerObject*>			PlayerObjectSetML;
+typedef Anh_Utils::flat_set<PlayerObject*>	PlayerObjectSetML;
 typedef std::list<PlayerObject*>		PlayerList;
 
 enum ObjectUpdate
@@ -266,6 +267,7 @@ public:
 
 	void				sendCurrentHitpointDeltasCreo6_Single(CreatureObject* creatureObject,uint8 barIndex);
 	void				sendCurrentHitpointDeltasCreo6_Full(CreatureObject* creatureObject);
+	void				sendCurrentHitpointDeltasCreo6_Bars(CreatureObject* creatureObject,uint16 barMask);
 	void				sendWoundUpdateCreo3(CreatureObject* creatureObject,uint8 barIndex);
 	void				sendBFUpdateCreo3(CreatureObject* playerObject);
 
@@ -499,6 +501,7 @@ private:
 	bool				_checkPlayer(uint64 playerId) const;
 
 	void				_sendToInRangeUnreliable(Message* message, Object* const object,uint16 priority,bool toSelf = true);
+	void				_sendToInRangeTiered(Message* message, MovingObject* const object,uint8 kind,uint32 sequence,uint16 priority,bool toSelf = true);
 	void				_sendToInRange(Message* message, Object* const object,uint16 priority,bool toSelf = true);
 
 	void				_sendToInstancedPlayersUnreliable(Message* message, uint16 priority, const PlayerObject* const player) const ;
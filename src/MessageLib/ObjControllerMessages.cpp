@@ -1149,7 +1149,8 @@ void MessageLib::sendDataTransform(Object* object)
 	mMessageFactory->addUint32(opDataTransform);
 	mMessageFactory->addUint64(object->getId());
 	mMessageFactory->addUint32(0);
-	mMessageFactory->addUint32(object->incDataTransformCounter());
+	uint32 sequence = object->incDataTransformCounter();
+	mMessageFactory->addUint32(sequence);
 
 	mMessageFactory->addFloat(object->mDirection.x);
 	mMessageFactory->addFloat(object->mDirection.y);
@@ -1160,6 +1161,12 @@ void MessageLib::sendDataTransform(Object* object)
 	mMessageFactory->addFloat(object->mPosition.z);
 	mMessageFactory->addUint32(0);
 
+	if(MovingObject* movingObject = dynamic_cast<MovingObject*>(object))
+	{
+		_sendToInRangeTiered(mMessageFactory->EndMessage(),movingObject,MovingObject::TransformKind_Data,sequence,5);
+		return;
+	}
+
 	_sendToInRangeUnreliable(mMessageFactory->EndMessage(),object,5);
 }
 
@@ -1190,6 +1197,12 @@ void MessageLib::sendDataTransformWithParent(Object* object)
 	mMessageFactory->addFloat(object->mPosition.z);
 	mMessageFactory->addUint32(0);
 
+	if(MovingObject* movingObject = dynamic_cast<MovingObject*>(object))
+	{
+		_sendToInRangeTiered(mMessageFactory->EndMessage(),movingObject,MovingObject::TransformKind_Data,u,5);
+		return;
+	}
+
 	//_sendToInRange(mMessageFactory->EndMessage(),object,5);
 	_sendToInRangeUnreliable(mMessageFactory->EndMessage(),object,5);
 }
@@ -0,0 +1,211 @@
+/*
+---------------------------------------------------------------------------------------
+This source file is part of swgANH (Star Wars Galaxies - A New Hope - Server Emulator)
+For more information, see http://www.swganh.org
+
+
+Copyright (c) 2006 - 2010 The swgANH Team
+
+---------------------------------------------------------------------------------------
+*/
+
+#include "DeadlineQueue.h"
+
+
+namespace Anh_Utils
+{
+	//======================================================================================================================
+
+	bool DeadlineQueue::insert(uint64 id,uint64 deadline)
+	{
+		if(contains(id))
+		{
+			return(false);
+		}
+
+		Entry entry;
+
+		entry.mDeadline	= deadline;
+		entry.mId		= id;
+
+		mHeap.push_back(entry);
+		mPositions[id] = static_cast<uint32>(mHeap.size() - 1);
+
+		_siftUp(static_cast<uint32>(mHeap.size() - 1));
+
+		return(true);
+	}
+
+	//======================================================================================================================
+
+	void DeadlineQueue::schedule(uint64 id,uint64 deadline)
+	{
+		PositionMap::iterator it = mPositions.find(id);
+
+		if(it == mPositions.end())
+		{
+			insert(id,deadline);
+			return;
+		}
+
+		uint32 position	= (*it).second;
+		uint64 old		= mHeap[position].mDeadline;
+
+		mHeap[position].mDeadline = deadline;
+
+		if(deadline < old)
+		{
+			_siftUp(position);
+		}
+		else
+		{
+			_siftDown(position);
+		}
+	}
+
+	//======================================================================================================================
+
+	bool DeadlineQueue::remove(uint64 id)
+	{
+		PositionMap::iterator it = mPositions.find(id);
+
+		if(it == mPositions.end())
+		{
+			return(false);
+		}
+
+		uint32 position = (*it).second;
+
+		mPositions.erase(it);
+		_removeAt(position);
+
+		return(true);
+	}
+
+	//======================================================================================================================
+
+	uint64 DeadlineQueue::getDeadline(uint64 id) const
+	{
+		PositionMap::const_iterator it = mPositions.find(id);
+
+		if(it == mPositions.end())
+		{
+			return(0);
+		}
+
+		return(mHeap[(*it).second].mDeadline);
+	}
+
+	//======================================================================================================================
+
+	bool DeadlineQueue::popExpired(uint64 now,uint64& id,uint64& deadline)
+	{
+		if(mHeap.empty() || mHeap[0].mDeadline > now)
+		{
+			return(false);
+		}
+
+		id			= mHeap[0].mId;
+		deadline	= mHeap[0].mDeadline;
+
+		mPositions.erase(id);
+		_removeAt(0);
+
+		return(true);
+	}
+
+	//======================================================================================================================
+
+	void DeadlineQueue::_place(uint32 position,const Entry& entry)
+	{
+		mHeap[position]			= entry;
+		mPositions[entry.mId]	= position;
+	}
+
+	//======================================================================================================================
+
+	void DeadlineQueue::_siftUp(uint32 position)
+	{
+		Entry entry = mHeap[position];
+
+		while(position)
+		{
+			uint32 parent = (position - 1) / 2;
+
+			if(mHeap[parent].mDeadline <= entry.mDeadline)
+			{
+				break;
+			}
+
+			_place(position,mHeap[parent]);
+			position = parent;
+		}
+
+		_place(position,entry);
+	}
+
+	//======================================================================================================================
+
+	void DeadlineQueue::_siftDown(uint32 position)
+	{
+		Entry	entry	= mHeap[position];
+		uint32	count	= static_cast<uint32>(mHeap.size());
+
+		while(true)
+		{
+			uint32 child = position * 2 + 1;
+
+			if(child >= count)
+			{
+				break;
+			}
+
+			if(child + 1 < count && mHeap[child + 1].mDeadline < mHeap[child].mDeadline)
+			{
+				child++;
+			}
+
+			if(entry.mDeadline <= mHeap[child].mDeadline)
+			{
+				break;
+			}
+
+			_place(position,mHeap[child]);
+			position = child;
+		}
+
+		_place(position,entry);
+	}
+
+	//======================================================================================================================
+	//
+	// the last entry fills the gap and is sifted whichever way it has to go, the id lookup is already gone
+	//
+
+	void DeadlineQueue::_removeAt(uint32 position)
+	{
+		uint32 last = static_cast<uint32>(mHeap.size() - 1);
+
+		if(position != last)
+		{
+			_place(position,mHeap[last]);
+			mHeap.pop_back();
+
+			if(position && mHeap[(position - 1) / 2].mDeadline > mHeap[position].mDeadline)
+			{
+				_siftUp(position);
+			}
+			else
+			{
+				_siftDown(position);
+			}
+		}
+		else
+		{
+			mHeap.pop_back();
+		}
+	}
+}
+
+//======================================================================================================================
+
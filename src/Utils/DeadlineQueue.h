@@ -0,0 +1,77 @@
+/*
+---------------------------------------------------------------------------------------
+This source file is part of swgANH (Star Wars Galaxies - A New Hope - Server Emulator)
+For more information, see http://www.swganh.org
+
+
+Copyright (c) 2006 - 2010 The swgANH Team
+
+---------------------------------------------------------------------------------------
+*/
+
+#ifndef ANH_UTILS_DEADLINEQUEUE_H
+#define ANH_UTILS_DEADLINEQUEUE_H
+
+#include "typedefs.h"
+#include <boost/unordered_map.hpp>
+#include <vector>
+
+
+namespace Anh_Utils
+{
+	//======================================================================================================================
+	//
+	// ids with a deadline each, kept in a min heap with an id lookup of the heap positions
+	// inserting, rescheduling and removing are O(log n), a handler only looks at the entries that expired
+	//
+
+	class DeadlineQueue
+	{
+		public:
+
+			// like a map insert, an id thats already queued keeps its deadline
+			bool	insert(uint64 id,uint64 deadline);
+
+			// queues the id or moves its deadline
+			void	schedule(uint64 id,uint64 deadline);
+
+			bool	remove(uint64 id);
+			bool	contains(uint64 id) const { return mPositions.find(id) != mPositions.end(); }
+
+			// 0 if the id is not queued
+			uint64	getDeadline(uint64 id) const;
+
+			// the earliest deadline, 0 if empty
+			uint64	getNextDeadline() const { return mHeap.empty() ? 0 : mHeap[0].mDeadline; }
+
+			// takes out the entry with the earliest deadline if that is no later than now
+			bool	popExpired(uint64 now,uint64& id,uint64& deadline);
+
+			uint32	size() const { return static_cast<uint32>(mHeap.size()); }
+			bool	empty() const { return mHeap.empty(); }
+			void	clear(){ mHeap.clear(); mPositions.clear(); }
+
+		private:
+
+			struct Entry
+			{
+				uint64	mDeadline;
+				uint64	mId;
+			};
+
+			typedef boost::unordered_map<uint64,uint32>	PositionMap;
+
+			void	_place(uint32 position,const Entry& entry);
+			void	_siftUp(uint32 position);
+			void	_siftDown(uint32 position);
+			void	_removeAt(uint32 position);
+
+			std::vector<Entry>	mHeap;
+			PositionMap			mPositions;
+	};
+}
+
+#endif
+
+//======================================================================================================================
+
@@ -0,0 +1,176 @@
+/*
+---------------------------------------------------------------------------------------
+This source file is part of swgANH (Star Wars Galaxies - A New Hope - Server Emulator)
+For more information, see http://www.swganh.org
+
+
+Copyright (c) 2006 - 2010 The swgANH Team
+
+---------------------------------------------------------------------------------------
+*/
+
+#ifndef ANH_UTILS_FLAT_SET_H
+#define ANH_UTILS_FLAT_SET_H
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <vector>
+
+
+namespace Anh_Utils
+{
+	//======================================================================================================================
+	//
+	// a set kept as a sorted vector, meant for the few hundred entries at most an objects known sets hold
+	// lookups are binary searches and iterating walks contiguous memory
+	//
+	// unlike std::set, inserting or erasing invalidates the iterators behind the position,
+	// so erase while iterating has to continue with the returned iterator
+	//
+
+	template<class T, class Compare = std::less<T> >
+	class flat_set
+	{
+		public:
+
+			typedef T													key_type;
+			typedef T													value_type;
+			typedef Compare												key_compare;
+			typedef typename std::vector<T>::size_type					size_type;
+			typedef typename std::vector<T>::const_iterator				iterator;
+			typedef typename std::vector<T>::const_iterator				const_iterator;
+			typedef typename std::vector<T>::const_reverse_iterator		reverse_iterator;
+			typedef typename std::vector<T>::const_reverse_iterator		const_reverse_iterator;
+
+			flat_set(const Compare& cmp = Compare()) : mCompare(cmp) {}
+
+			template<class InputIterator>
+			flat_set(InputIterator first, InputIterator last, const Compare& cmp = Compare()) : mCompare(cmp)
+			{
+				insert(first,last);
+			}
+
+	//======================================================================================================================
+
+			const_iterator			begin() const	{ return mData.begin(); }
+			const_iterator			end() const		{ return mData.end(); }
+			const_reverse_iterator	rbegin() const	{ return mData.rbegin(); }
+			const_reverse_iterator	rend() const	{ return mData.rend(); }
+
+			size_type	size() const		{ return mData.size(); }
+			bool		empty() const		{ return mData.empty(); }
+			size_type	capacity() const	{ return mData.capacity(); }
+
+			void		reserve(size_type count)	{ mData.reserve(count); }
+			void		clear()						{ mData.clear(); }
+			void		swap(flat_set& other)		{ mData.swap(other.mData); std::swap(mCompare,other.mCompare); }
+
+	//======================================================================================================================
+
+			const_iterator lower_bound(const T& value) const
+			{
+				return std::lower_bound(mData.begin(),mData.end(),value,mCompare);
+			}
+
+			const_iterator upper_bound(const T& value) const
+			{
+				return std::upper_bound(mData.begin(),mData.end(),value,mCompare);
+			}
+
+			const_iterator find(const T& value) const
+			{
+				const_iterator it = lower_bound(value);
+
+				if(it != mData.end() && !mCompare(value,*it))
+					return it;
+
+				return mData.end();
+			}
+
+			size_type count(const T& value) const
+			{
+				return (find(value) != mData.end()) ? 1 : 0;
+			}
+
+	//======================================================================================================================
+
+			std::pair<iterator,bool> insert(const T& value)
+			{
+				typename std::vector<T>::iterator it = std::lower_bound(mData.begin(),mData.end(),value,mCompare);
+
+				if(it != mData.end() && !mCompare(value,*it))
+					return std::make_pair(iterator(it),false);
+
+				return std::make_pair(iterator(mData.insert(it,value)),true);
+			}
+
+			// the hint is not needed, kept so code written against std::set still compiles
+			iterator insert(const_iterator, const T& value)
+			{
+				return insert(value).first;
+			}
+
+			// appends the whole range and sorts once, rather than shifting per element
+			template<class InputIterator>
+			void insert(InputIterator first, InputIterator last)
+			{
+				size_type oldSize = mData.size();
+
+				mData.insert(mData.end(),first,last);
+
+				typename std::vector<T>::iterator middle = mData.begin() + oldSize;
+
+				std::sort(middle,mData.end(),mCompare);
+				std::inplace_merge(mData.begin(),middle,mData.end(),mCompare);
+
+				mData.erase(std::unique(mData.begin(),mData.end(),Equivalent(mCompare)),mData.end());
+			}
+
+	//======================================================================================================================
+
+			iterator erase(const_iterator position)
+			{
+				return mData.erase(mData.begin() + (position - mData.begin()));
+			}
+
+			iterator erase(const_iterator first, const_iterator last)
+			{
+				return mData.erase(mData.begin() + (first - mData.begin()),mData.begin() + (last - mData.begin()));
+			}
+
+			size_type erase(const T& value)
+			{
+				const_iterator it = find(value);
+
+				if(it == mData.end())
+					return 0;
+
+				erase(it);
+
+				return 1;
+			}
+
+	//======================================================================================================================
+
+			bool operator==(const flat_set& other) const { return mData == other.mData; }
+			bool operator!=(const flat_set& other) const { return mData != other.mData; }
+
+		private:
+
+			struct Equivalent
+			{
+				Equivalent(const Compare& cmp) : mCompare(cmp) {}
+
+				bool operator()(const T& a, const T& b) const { return !mCompare(a,b) && !mCompare(b,a); }
+
+				Compare mCompare;
+			};
+
+			std::vector<T>	mData;
+			Compare			mCompare;
+	};
+}
+
+#endif
+
@@ -0,0 +1,241 @@
+/*
+---------------------------------------------------------------------------------------
+This source file is part of swgANH (Star Wars Galaxies - A New Hope - Server Emulator)
+For more information, see http://www.swganh.org
+
+
+Copyright (c) 2006 - 2010 The swgANH Team
+
+---------------------------------------------------------------------------------------
+*/
+
+#include "JobSystem.h"
+
+#include <boost/bind.hpp>
+
+
+namespace Anh_Utils
+{
+	//======================================================================================================================
+
+	JobSystem::JobSystem(uint32 threadCount) : mPending(0),mAdded(0),mPhase(0),mNextQueue(0),mRunning(false),mExit(false)
+	{
+		for(uint32 i = 0; i <= threadCount; i++)
+		{
+			mQueues.push_back(new JobQueue());
+		}
+
+		for(uint32 i = 1; i <= threadCount; i++)
+		{
+			mThreads.push_back(new boost::thread(boost::bind(&JobSystem::_workerLoop,this,i)));
+		}
+	}
+
+	//======================================================================================================================
+
+	JobSystem::~JobSystem()
+	{
+		{
+			boost::mutex::scoped_lock lock(mMutex);
+
+			mExit = true;
+			mWorkCondition.notify_all();
+		}
+
+		for(uint32 i = 0; i < mThreads.size(); i++)
+		{
+			mThreads[i]->join();
+			delete(mThreads[i]);
+		}
+
+		for(uint32 i = 0; i < mQueues.size(); i++)
+		{
+			delete(mQueues[i]);
+		}
+	}
+
+	//======================================================================================================================
+
+	void JobSystem::addJob(JobCallback callback)
+	{
+		boost::mutex::scoped_lock lock(mMutex);
+
+		uint32 queue;
+
+		// a job adding jobs keeps them on its own thread, anything else is spread over the queues
+		if(mRunning && mThreadQueue.get())
+		{
+			queue = *mThreadQueue;
+		}
+		else
+		{
+			queue		= mNextQueue;
+			mNextQueue	= (mNextQueue + 1) % mQueues.size();
+		}
+
+		{
+			boost::mutex::scoped_lock queueLock(mQueues[queue]->mMutex);
+
+			mQueues[queue]->mJobs.push_back(callback);
+		}
+
+		mPending++;
+		mAdded++;
+
+		if(mRunning)
+		{
+			mWorkCondition.notify_all();
+		}
+	}
+
+	//======================================================================================================================
+
+	void JobSystem::runPhase()
+	{
+		if(!mThreadQueue.get())
+		{
+			mThreadQueue.reset(new uint32(0));
+		}
+
+		uint32 phase;
+
+		{
+			boost::mutex::scoped_lock lock(mMutex);
+
+			if(!mPending)
+			{
+				return;
+			}
+
+			mRunning = true;
+			phase	 = ++mPhase;
+
+			mWorkCondition.notify_all();
+		}
+
+		_work(0,phase);
+
+		boost::mutex::scoped_lock lock(mMutex);
+
+		mRunning = false;
+	}
+
+	//======================================================================================================================
+
+	bool JobSystem::_pop(uint32 queue,JobCallback& job)
+	{
+		JobQueue* jobQueue = mQueues[queue];
+
+		boost::mutex::scoped_lock lock(jobQueue->mMutex);
+
+		if(jobQueue->mJobs.empty())
+		{
+			return(false);
+		}
+
+		job = jobQueue->mJobs.back();
+		jobQueue->mJobs.pop_back();
+
+		return(true);
+	}
+
+	//======================================================================================================================
+	//
+	// the oldest job of a queue is the one its owner is least likely to need soon
+	//
+
+	bool JobSystem::_steal(uint32 thief,JobCallback& job)
+	{
+		uint32 count = static_cast<uint32>(mQueues.size());
+
+		for(uint32 i = 1; i < count; i++)
+		{
+			JobQueue* jobQueue = mQueues[(thief + i) % count];
+
+			boost::mutex::scoped_lock lock(jobQueue->mMutex);
+
+			if(!jobQueue->mJobs.empty())
+			{
+				job = jobQueue->mJobs.front();
+				jobQueue->mJobs.pop_front();
+
+				return(true);
+			}
+		}
+
+		return(false);
+	}
+
+	//======================================================================================================================
+	//
+	// jobs are only taken under mMutex and while the phase is running, so a worker waking up late never takes the jobs
+	// the main thread already queued for the next phase
+	//
+
+	void JobSystem::_work(uint32 queue,uint32 phase)
+	{
+		boost::mutex::scoped_lock lock(mMutex);
+
+		while(mRunning && mPhase == phase && mPending)
+		{
+			JobCallback job;
+
+			if(_pop(queue,job) || _steal(queue,job))
+			{
+				lock.unlock();
+
+				job();
+
+				lock.lock();
+
+				if(--mPending == 0)
+				{
+					mWorkCondition.notify_all();
+				}
+
+				continue;
+			}
+
+			// nothing to take, but running jobs may still add some
+			uint32 added = mAdded;
+
+			while(mRunning && mPhase == phase && mPending && mAdded == added)
+			{
+				mWorkCondition.wait(lock);
+			}
+		}
+	}
+
+	//======================================================================================================================
+
+	void JobSystem::_workerLoop(uint32 queue)
+	{
+		mThreadQueue.reset(new uint32(queue));
+
+		uint32 lastPhase = 0;
+
+		while(true)
+		{
+			{
+				boost::mutex::scoped_lock lock(mMutex);
+
+				while(!mExit && mPhase == lastPhase)
+				{
+					mWorkCondition.wait(lock);
+				}
+
+				if(mExit)
+				{
+					return;
+				}
+
+				lastPhase = mPhase;
+			}
+
+			_work(queue,lastPhase);
+		}
+	}
+}
+
+//======================================================================================================================
+
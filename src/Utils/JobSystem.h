@@ -0,0 +1,90 @@
+/*
+---------------------------------------------------------------------------------------
+This source file is part of swgANH (Star Wars Galaxies - A New Hope - Server Emulator)
+For more information, see http://www.swganh.org
+
+
+Copyright (c) 2006 - 2010 The swgANH Team
+
+---------------------------------------------------------------------------------------
+*/
+
+#ifndef ANH_UTILS_JOBSYSTEM_H
+#define ANH_UTILS_JOBSYSTEM_H
+
+#include "typedefs.h"
+#include "FastDelegate.h"
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/tss.hpp>
+#include <deque>
+#include <vector>
+
+
+typedef fastdelegate::FastDelegate0<> JobCallback;
+
+
+namespace Anh_Utils
+{
+	//======================================================================================================================
+	//
+	// work stealing job system, the jobs of a phase run on the worker threads and the thread that runs the phase
+	//
+	// every thread has its own queue, it takes its newest job first and steals the oldest of another queue when
+	// its own is empty, jobs added while a phase runs go to the queue of the thread adding them
+	//
+	// a phase is a read phase by convention: its jobs may read the shared world but only write their own results,
+	// the caller applies the results after runPhase() returned, which is the write phase
+	// without worker threads the jobs simply run one after another on the calling thread
+	//
+
+	class JobSystem
+	{
+		public:
+
+			JobSystem(uint32 threadCount);
+			~JobSystem();
+
+			// queues a job for the next phase, or for the running one when called from a job
+			void	addJob(JobCallback callback);
+
+			// runs the queued jobs and the jobs they add, returns when all are done, the calling thread works along
+			void	runPhase();
+
+			uint32	getThreadCount() const { return static_cast<uint32>(mThreads.size()); }
+
+		private:
+
+			struct JobQueue
+			{
+				boost::mutex			mMutex;
+				std::deque<JobCallback>	mJobs;
+			};
+
+			bool	_pop(uint32 queue,JobCallback& job);
+			bool	_steal(uint32 thief,JobCallback& job);
+
+			// runs jobs of the given phase until it has none left or is over
+			void	_work(uint32 queue,uint32 phase);
+			void	_workerLoop(uint32 queue);
+
+			std::vector<JobQueue*>			mQueues;		// the caller of runPhase() owns the first
+			std::vector<boost::thread*>		mThreads;
+			boost::thread_specific_ptr<uint32>	mThreadQueue;
+
+			boost::mutex					mMutex;
+			boost::condition_variable		mWorkCondition;
+			uint32							mPending;		// queued and running jobs
+			uint32							mAdded;			// counts every job added, an idle thread waits for it to change
+			uint32							mPhase;
+			uint32							mNextQueue;
+			bool							mRunning;
+			bool							mExit;
+	};
+}
+
+#endif
+
+//======================================================================================================================
+
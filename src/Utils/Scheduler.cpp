@@ -17,7 +17,7 @@ namespace Anh_Utils
 {
 	//======================================================================================================================
 
-	Scheduler::Scheduler(uint64 processTimeLimit, uint64 throttleLimit) : mNextTask(0),mNextTaskId(1),mProcessTimeLimit(processTimeLimit),mThrottleLimit(throttleLimit)
+	Scheduler::Scheduler(uint64 processTimeLimit, uint64 throttleLimit) : mNextDueTask(0),mWheelStarted(false),mStats(NULL),mProcessTimeLimit(processTimeLimit),mThrottleLimit(throttleLimit)
 	{
 		mLastProcessTime = 0;
 		// We do have a global clock object, don't use seperate clock and times for every process.
@@ -29,14 +29,55 @@ namespace Anh_Utils
 	Scheduler::~Scheduler()
 	{
 		// delete(mClock);
+		delete(mStats);
 	}
 
 	//======================================================================================================================
 
-	uint64 Scheduler::addTask(FDCallback callback,uint8 priority,uint64 interval,void* async)
+	void Scheduler::enableStats(const std::string& name)
 	{
-		mTasks.push(Task(mNextTaskId,priority,gClock->getLocalTime(),interval,callback,async));
-		return(mNextTaskId++);
+		if(!mStats)
+		{
+			mStats = new SchedulerStats(name);
+		}
+	}
+
+	//======================================================================================================================
+
+	uint64 Scheduler::addTask(FDCallback callback,uint8 priority,uint64 interval,void* async,const char* label)
+	{
+		uint64 currentTime = gClock->getLocalTime();
+
+		// the clock may not be up yet when we get created, so the wheel starts with the first task
+		if(!mWheelStarted)
+		{
+			mWheel			= TimingWheel(currentTime);
+			mWheelStarted	= true;
+		}
+
+		uint32 slot;
+
+		if(mFreeSlots.empty())
+		{
+			slot = static_cast<uint32>(mTasks.size());
+
+			mTasks.push_back(Task(0,0,0,0,FDCallback(),NULL));
+			mSlotUses.push_back(0);
+		}
+		else
+		{
+			slot = mFreeSlots.back();
+			mFreeSlots.pop_back();
+		}
+
+		uint64 id = (static_cast<uint64>(++mSlotUses[slot]) << 32) | (slot + 1);
+
+		mTasks[slot] = Task(id,priority,currentTime,interval,callback,async,label);
+
+		// a task runs once more than its interval has passed
+		mWheel.insert(slot,currentTime + interval + 1);
+
+		return(id);
 	}
 
 	//======================================================================================================================
@@ -44,47 +85,39 @@ namespace Anh_Utils
 	void Scheduler::removeTask(uint64 id)
 	{
 		//printf("scheduler to do remove task : %I64u",id);
-		if(!id)
+		Task* task = _getTask(id);
+
+		if(!task)
 			return;
 
-		TaskContainer::iterator it = mTasks.begin();
+		uint32 slot = static_cast<uint32>(id & 0xffffffff) - 1;
 
-		while(it != mTasks.end())
-		{
-			if(it->mId == id)
-			{
-				mTasks.erase(it);
-		//		printf("scheduler removeD task : %I64u",id);
-				break;
-			}
-
-			++it;
-		}
+		// a task thats already due just doesnt match anymore when its turn comes
+		mWheel.remove(slot);
 
-		mTasks.assureHeap(true);
+		task->mId		= 0;
+		task->mCallback	= FDCallback();
+		task->mAsync	= NULL;
+		task->mLabel	= NULL;
+
+		mFreeSlots.push_back(slot);
 	}
 
 	bool Scheduler::checkTask(uint64 id)
 	{
-		//printf("scheduler to do remove task : %I64u",id);
-		if(!id)
-			return false;
+		return(_getTask(id) != NULL);
+	}
 
-		TaskContainer::iterator it = mTasks.begin();
+	//======================================================================================================================
 
-		while(it != mTasks.end())
-		{
-			if(it->mId == id)
-			{
-		//		printf("scheduler removeD task : %I64u",id);
-				return true;
-			}
+	Task* Scheduler::_getTask(uint64 id)
+	{
+		uint32 slot = static_cast<uint32>(id & 0xffffffff);
 
-			++it;
-		}
+		if(!slot || slot > mTasks.size() || mTasks[slot - 1].mId != id)
+			return(NULL);
 
-		//mTasks.assureHeap(true);
-		return false;
+		return(&mTasks[slot - 1]);
 	}
 
 	//======================================================================================================================
@@ -102,48 +135,102 @@ namespace Anh_Utils
 			return;
 		}
 
+		// tasks left over from a pass that ran out of time go first
+		_collectDueTasks(frameStartTime);
+
 		while(runTask() && ((Anh_Utils::Clock::getSingleton()->getLocalTime() - frameStartTime) < mProcessTimeLimit));
 
 		//Set internal Clock so we know when the last call was
 		mLastProcessTime = Anh_Utils::Clock::getSingleton()->getLocalTime();
+
+		// whatever is still due waits for the next pass
+		if(mStats)
+		{
+			mStats->recordPass(mLastProcessTime - frameStartTime,static_cast<uint32>(mDueTasks.size() - mNextDueTask));
+		}
 	}
 
 	//======================================================================================================================
 
-	bool Scheduler::runTask()
+	struct CompareTaskPriority
 	{
-		if(!(mTasks.empty()))
+		CompareTaskPriority(const TaskContainer& tasks) : mTasks(tasks){}
+
+		bool operator()(uint64 a,uint64 b) const
 		{
-			Task&	task(mTasks[mNextTask]);
-			uint64	currentTime = Anh_Utils::Clock::getSingleton()->getLocalTime();
-			if((currentTime - task.mLastCallTime) > task.mInterval)
-			{
-				if(task.mCallback(currentTime,task.mAsync) == false)
-				{
-					removeTask(task.mId);
-				}
-				else
-				{
-					task.mLastCallTime = currentTime;
-					++mNextTask;
-				}
-			}
-			else
-				++mNextTask;
-
-			if(mNextTask >= mTasks.size())
-			{
-				reset();
-				return(false);
-			}
-			else
-				return(true);
+			return(mTasks[(a & 0xffffffff) - 1].mPriority > mTasks[(b & 0xffffffff) - 1].mPriority);
 		}
-		else
+
+		const TaskContainer& mTasks;
+	};
+
+	void Scheduler::_collectDueTasks(uint64 currentTime)
+	{
+		if(!mWheelStarted)
+			return;
+
+		if(mNextDueTask >= mDueTasks.size())
+		{
+			mDueTasks.clear();
+			mNextDueTask = 0;
+		}
+
+		mExpired.clear();
+		mWheel.advance(currentTime,mExpired);
+
+		if(mExpired.empty())
+			return;
+
+		size_t first = mDueTasks.size();
+
+		for(uint32 i = 0; i < mExpired.size(); i++)
 		{
-			reset();
+			mDueTasks.push_back(mTasks[mExpired[i]].mId);
+		}
+
+		std::stable_sort(mDueTasks.begin() + first,mDueTasks.end(),CompareTaskPriority(mTasks));
+	}
+
+	//======================================================================================================================
+
+	bool Scheduler::runTask()
+	{
+		// the pass ends with the tasks that were due when it started
+		if(mNextDueTask >= mDueTasks.size())
 			return(false);
+
+		uint64	id		= mDueTasks[mNextDueTask++];
+		Task*	task	= _getTask(id);
+
+		// removed while it was waiting its turn
+		if(!task)
+			return(mNextDueTask < mDueTasks.size());
+
+		uint64		currentTime = Anh_Utils::Clock::getSingleton()->getLocalTime();
+		FDCallback	callback	= task->mCallback;
+		const char*	label		= task->mLabel;
+		uint64		dueTime		= task->mLastCallTime + task->mInterval + 1;
+		uint64		startTime	= mStats ? SchedulerStats::getMicroTime() : 0;
+
+		// the callback may add tasks and move the container, so the task is looked up again afterwards
+		bool		keep		= callback(currentTime,task->mAsync);
+
+		if(mStats)
+		{
+			mStats->recordCall(label,SchedulerStats::getMicroTime() - startTime,(currentTime > dueTime) ? currentTime - dueTime : 0);
+		}
+
+		if(keep == false)
+		{
+			removeTask(id);
+		}
+		else if((task = _getTask(id)) != NULL)
+		{
+			task->mLastCallTime = currentTime;
+			mWheel.insert(static_cast<uint32>(id & 0xffffffff) - 1,currentTime + task->mInterval + 1);
 		}
+
+		return(mNextDueTask < mDueTasks.size());
 	}
 }
 
@@ -14,9 +14,11 @@ Copyright (c) 2006 - 2010 The swgANH Team
 
 #include "typedefs.h"
 #include "FastDelegate.h"
-#include "PriorityVector.h"
+#include "SchedulerStats.h"
+#include "TimingWheel.h"
 #include "clock.h"
 #include <algorithm>
+#include <vector>
 
 
 typedef fastdelegate::FastDelegate2<uint64,void*,bool> FDCallback;
@@ -30,8 +32,8 @@ namespace Anh_Utils
 	{
 		public:
 
-			Task(uint64 id,uint8 priority,uint64 lastCallTime,uint64 interval,FDCallback callback,void* async)
-				: mId(id),mPriority(priority),mLastCallTime(lastCallTime),mInterval(interval),mCallback(callback),mAsync(async){}
+			Task(uint64 id,uint8 priority,uint64 lastCallTime,uint64 interval,FDCallback callback,void* async,const char* label = NULL)
+				: mId(id),mPriority(priority),mLastCallTime(lastCallTime),mInterval(interval),mCallback(callback),mAsync(async),mLabel(label){}
 			
 			~Task(){}
 
@@ -40,19 +42,26 @@ namespace Anh_Utils
 				return(mPriority < right.mPriority);
 			} 
 
-			uint64		mId;
+			uint64		mId;			// 0 while the slot is free
 			uint8		mPriority;
 			uint64		mLastCallTime;
 			uint64		mInterval;
 			FDCallback	mCallback;
 			void*		mAsync;
+			const char*	mLabel;			// what the task shows up as in the stats
 	};
 
 //======================================================================================================================
 
-typedef priority_vector<Task> TaskContainer;
+typedef std::vector<Task> TaskContainer;
 
 //======================================================================================================================
+//
+// tasks wait in a timing wheel until their interval has passed, so a pass only touches the tasks that are due
+// a task id carries the slot of the task in its low half, a count of the slots reuses in the high half,
+// so looking one up is an index and an id of a removed task never matches a new one
+// with stats enabled every callback is timed under the label its task was added with
+//
 
 	class Scheduler
 	{
@@ -61,18 +70,34 @@ typedef priority_vector<Task> TaskContainer;
 			Scheduler(uint64 processTimeLimit = 100, uint64 throttleLimit = 0);
 			~Scheduler();
 
-			uint64	addTask(FDCallback callback,uint8 priority,uint64 interval,void* async);
+			uint64	addTask(FDCallback callback,uint8 priority,uint64 interval,void* async,const char* label = NULL);
 			void	removeTask(uint64 id);
 			bool	checkTask(uint64 id);
-			void	reset(){ mNextTask = 0; }
 			void	process();
 			bool	runTask();
+
+			uint32	getTaskCount() const { return static_cast<uint32>(mTasks.size() - mFreeSlots.size()); }
+
+			// stats are off until enabled, the scheduler keeps them
+			void			enableStats(const std::string& name);
+			SchedulerStats*	getStats() const { return mStats; }
 		
 		protected:
 
+			Task*	_getTask(uint64 id);
+
+			// collects the tasks that came due, higher priorities first
+			void	_collectDueTasks(uint64 currentTime);
+
 			TaskContainer		mTasks;	
-			uint32				mNextTask;
-			uint64				mNextTaskId;
+			std::vector<uint32>	mFreeSlots;
+			std::vector<uint32>	mSlotUses;
+			TimingWheel			mWheel;
+			std::vector<uint32>	mExpired;
+			std::vector<uint64>	mDueTasks;
+			uint32				mNextDueTask;
+			bool				mWheelStarted;
+			SchedulerStats*		mStats;
 			// Anh_Utils::Clock*	mClock;
 			uint64				mProcessTimeLimit, mThrottleLimit, mLastProcessTime;
 	};
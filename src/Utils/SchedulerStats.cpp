@@ -0,0 +1,231 @@
+/*
+---------------------------------------------------------------------------------------
+This source file is part of swgANH (Star Wars Galaxies - A New Hope - Server Emulator)
+For more information, see http://www.swganh.org
+
+
+Copyright (c) 2006 - 2010 The swgANH Team
+
+---------------------------------------------------------------------------------------
+*/
+
+#include "SchedulerStats.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <vector>
+
+#if(ANH_PLATFORM == ANH_PLATFORM_WIN32)
+#include <windows.h>
+#else
+#include <sys/time.h>
+#endif
+
+
+namespace Anh_Utils
+{
+	//======================================================================================================================
+
+	static const char* UnnamedTask = "unnamed";
+
+	//======================================================================================================================
+
+	SchedulerStats::SchedulerStats(const std::string& name) : mName(name)
+	{
+		reset();
+	}
+
+	//======================================================================================================================
+
+	uint64 SchedulerStats::getMicroTime()
+	{
+#if(ANH_PLATFORM == ANH_PLATFORM_WIN32)
+		LARGE_INTEGER frequency,counter;
+
+		QueryPerformanceFrequency(&frequency);
+		QueryPerformanceCounter(&counter);
+
+		return(static_cast<uint64>(counter.QuadPart / frequency.QuadPart) * 1000000
+			 + static_cast<uint64>((counter.QuadPart % frequency.QuadPart) * 1000000 / frequency.QuadPart));
+#else
+		struct timeval tv;
+
+		gettimeofday(&tv,NULL);
+
+		return(static_cast<uint64>(tv.tv_sec) * 1000000 + tv.tv_usec);
+#endif
+	}
+
+	//======================================================================================================================
+
+	void SchedulerStats::recordCall(const char* label,uint64 runTime,uint64 lateness)
+	{
+		if(!label)
+		{
+			label = UnnamedTask;
+		}
+
+		EntryMap::iterator it = mEntries.find(label);
+
+		if(it == mEntries.end())
+		{
+			Entry entry;
+
+			entry.mCalls			= 0;
+			entry.mTotalTime		= 0;
+			entry.mMaxTime			= 0;
+			entry.mTotalLateness	= 0;
+			entry.mMaxLateness		= 0;
+
+			it = mEntries.insert(std::make_pair(label,entry)).first;
+		}
+
+		Entry& entry = (*it).second;
+
+		entry.mCalls++;
+		entry.mTotalTime		+= runTime;
+		entry.mTotalLateness	+= lateness;
+
+		if(runTime > entry.mMaxTime)
+		{
+			entry.mMaxTime = runTime;
+		}
+
+		if(lateness > entry.mMaxLateness)
+		{
+			entry.mMaxLateness = lateness;
+		}
+	}
+
+	//======================================================================================================================
+
+	void SchedulerStats::recordPass(uint64 passTime,uint32 backlog)
+	{
+		mPasses++;
+		mLastBacklog = backlog;
+
+		if(backlog)
+		{
+			mOverruns++;
+		}
+
+		if(backlog > mMaxBacklog)
+		{
+			mMaxBacklog = backlog;
+		}
+
+		if(passTime > mMaxPassTime)
+		{
+			mMaxPassTime = passTime;
+		}
+	}
+
+	//======================================================================================================================
+
+	void SchedulerStats::reset()
+	{
+		mEntries.clear();
+
+		mPasses			= 0;
+		mOverruns		= 0;
+		mMaxPassTime	= 0;
+		mLastBacklog	= 0;
+		mMaxBacklog		= 0;
+		mStartTime		= getMicroTime();
+	}
+
+	//======================================================================================================================
+
+	SchedulerStats::Entry SchedulerStats::getEntry(const std::string& label) const
+	{
+		Entry merged;
+
+		merged.mCalls			= 0;
+		merged.mTotalTime		= 0;
+		merged.mMaxTime			= 0;
+		merged.mTotalLateness	= 0;
+		merged.mMaxLateness		= 0;
+
+		for(EntryMap::const_iterator it = mEntries.begin(); it != mEntries.end(); ++it)
+		{
+			if(label != (*it).first)
+			{
+				continue;
+			}
+
+			const Entry& entry = (*it).second;
+
+			merged.mCalls			+= entry.mCalls;
+			merged.mTotalTime		+= entry.mTotalTime;
+			merged.mTotalLateness	+= entry.mTotalLateness;
+			merged.mMaxTime			= std::max(merged.mMaxTime,entry.mMaxTime);
+			merged.mMaxLateness		= std::max(merged.mMaxLateness,entry.mMaxLateness);
+		}
+
+		return(merged);
+	}
+
+	//======================================================================================================================
+
+	typedef std::pair<std::string,SchedulerStats::Entry> NamedEntry;
+
+	struct CompareTotalTime
+	{
+		bool operator()(const NamedEntry& a,const NamedEntry& b) const
+		{
+			return(a.second.mTotalTime > b.second.mTotalTime);
+		}
+	};
+
+	std::string SchedulerStats::getReport(uint32 worst) const
+	{
+		// the same label may have come in from different places, so merge by text
+		std::map<std::string,Entry> byName;
+
+		for(EntryMap::const_iterator it = mEntries.begin(); it != mEntries.end(); ++it)
+		{
+			if(byName.find((*it).first) == byName.end())
+			{
+				byName[(*it).first] = getEntry((*it).first);
+			}
+		}
+
+		std::vector<NamedEntry> sorted(byName.begin(),byName.end());
+
+		std::sort(sorted.begin(),sorted.end(),CompareTotalTime());
+
+		uint64	calls		= 0;
+		uint64	totalTime	= 0;
+
+		for(uint32 i = 0; i < sorted.size(); i++)
+		{
+			calls		+= sorted[i].second.mCalls;
+			totalTime	+= sorted[i].second.mTotalTime;
+		}
+
+		uint64 elapsed = getMicroTime() - mStartTime;
+
+		std::ostringstream report;
+
+		report << std::fixed << std::setprecision(2);
+		report << "Scheduler " << mName << ": " << calls << " calls in " << (elapsed / 1000000) << "s, "
+			   << (totalTime / 1000.0) << "ms busy, " << mOverruns << " of " << mPasses << " passes over budget, longest pass "
+			   << mMaxPassTime << "ms, backlog " << mLastBacklog << " (max " << mMaxBacklog << ")";
+
+		for(uint32 i = 0; i < sorted.size() && i < worst; i++)
+		{
+			const Entry& entry = sorted[i].second;
+
+			report << "\n    " << sorted[i].first << ": " << entry.mCalls << " calls, "
+				   << (entry.mTotalTime / 1000.0) << "ms total, " << (entry.mMaxTime / 1000.0) << "ms max, late "
+				   << (static_cast<double>(entry.mTotalLateness) / entry.mCalls) << "ms avg " << entry.mMaxLateness << "ms max";
+		}
+
+		return(report.str());
+	}
+}
+
+//======================================================================================================================
+
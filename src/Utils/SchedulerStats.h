@@ -0,0 +1,82 @@
+/*
+---------------------------------------------------------------------------------------
+This source file is part of swgANH (Star Wars Galaxies - A New Hope - Server Emulator)
+For more information, see http://www.swganh.org
+
+
+Copyright (c) 2006 - 2010 The swgANH Team
+
+---------------------------------------------------------------------------------------
+*/
+
+#ifndef ANH_UTILS_SCHEDULERSTATS_H
+#define ANH_UTILS_SCHEDULERSTATS_H
+
+#include "typedefs.h"
+#include <boost/unordered_map.hpp>
+#include <string>
+
+
+namespace Anh_Utils
+{
+	//======================================================================================================================
+	//
+	// runtime figures of a scheduler, kept per task label
+	// a label is the name the task was added with, tasks added without one are counted together
+	// runtimes are in microseconds, lateness is the time a task ran past its due time in milliseconds
+	// a pass that stopped on the process time limit counts as over budget, the due tasks it left are the backlog
+	//
+
+	class SchedulerStats
+	{
+		public:
+
+			SchedulerStats(const std::string& name);
+
+			// a monotonic enough microsecond count for timing callbacks
+			static uint64	getMicroTime();
+
+			void			recordCall(const char* label,uint64 runTime,uint64 lateness);
+			void			recordPass(uint64 passTime,uint32 backlog);
+
+			// the totals since the last reset and the worst tasks by total runtime
+			std::string		getReport(uint32 worst = 5) const;
+			void			reset();
+
+			const std::string&	getName() const { return mName; }
+			uint64				getPasses() const { return mPasses; }
+			uint64				getOverruns() const { return mOverruns; }
+			uint32				getMaxBacklog() const { return mMaxBacklog; }
+
+			struct Entry
+			{
+				uint64	mCalls;
+				uint64	mTotalTime;
+				uint64	mMaxTime;
+				uint64	mTotalLateness;
+				uint64	mMaxLateness;
+			};
+
+			// merged by label text, an empty entry if nothing ran under it
+			Entry				getEntry(const std::string& label) const;
+
+		private:
+
+			// labels are string literals, the pointer is a cheap key
+			typedef boost::unordered_map<const char*,Entry>	EntryMap;
+
+			std::string	mName;
+			EntryMap	mEntries;
+			uint64		mPasses;
+			uint64		mOverruns;
+			uint64		mMaxPassTime;
+			uint32		mLastBacklog;
+			uint32		mMaxBacklog;
+			uint64		mStartTime;
+	};
+}
+
+#endif
+
+//======================================================================================================================
+
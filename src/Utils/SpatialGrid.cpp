@@ -0,0 +1,295 @@
+/*
+---------------------------------------------------------------------------------------
+This source file is part of swgANH (Star Wars Galaxies - A New Hope - Server Emulator)
+For more information, see http://www.swganh.org
+
+
+Copyright (c) 2006 - 2010 The swgANH Team
+
+---------------------------------------------------------------------------------------
+*/
+
+#include "SpatialGrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define ANH_SPATIALGRID_SSE2
+#include <emmintrin.h>
+#endif
+
+using namespace Anh_Utils;
+
+//======================================================================================================================
+
+SpatialGrid::SpatialGrid(float cellSize,float extent) :
+mCellSize(cellSize),
+mInvCellSize(1.0f / cellSize),
+mExtent(extent)
+{
+	mCellsPerSide = std::max<uint32>(1,static_cast<uint32>(ceil((2.0f * extent) / cellSize)));
+
+	mCells.resize(mCellsPerSide * mCellsPerSide);
+}
+
+//======================================================================================================================
+
+SpatialGrid::~SpatialGrid()
+{
+}
+
+//======================================================================================================================
+
+uint32 SpatialGrid::_getColumn(float coordinate) const
+{
+	float column = (coordinate + mExtent) * mInvCellSize;
+
+	// written this way round nan ends up in the first column as well
+	if(!(column > 0.0f))
+		return 0;
+
+	if(column >= static_cast<float>(mCellsPerSide - 1))
+		return mCellsPerSide - 1;
+
+	return static_cast<uint32>(column);
+}
+
+//======================================================================================================================
+
+void SpatialGrid::_addToCell(uint32 cell,int64 id,float x,float z,uint32 type,void* data)
+{
+	Cell& target = mCells[cell];
+
+	target.mX.push_back(x);
+	target.mZ.push_back(z);
+	target.mTypes.push_back(type);
+	target.mIds.push_back(id);
+	target.mData.push_back(data);
+}
+
+//======================================================================================================================
+//
+// swaps the last entry of the cell into the free slot
+//
+
+void SpatialGrid::_removeFromCell(const Location& location)
+{
+	Cell&	cell	= mCells[location.mCell];
+	uint32	last	= static_cast<uint32>(cell.mIds.size() - 1);
+
+	if(location.mIndex != last)
+	{
+		cell.mX[location.mIndex]		= cell.mX[last];
+		cell.mZ[location.mIndex]		= cell.mZ[last];
+		cell.mTypes[location.mIndex]	= cell.mTypes[last];
+		cell.mIds[location.mIndex]		= cell.mIds[last];
+		cell.mData[location.mIndex]		= cell.mData[last];
+
+		mLocations[cell.mIds[location.mIndex]].mIndex = location.mIndex;
+	}
+
+	cell.mX.pop_back();
+	cell.mZ.pop_back();
+	cell.mTypes.pop_back();
+	cell.mIds.pop_back();
+	cell.mData.pop_back();
+}
+
+//======================================================================================================================
+
+void SpatialGrid::insert(int64 id,float x,float z,uint32 type,void* data)
+{
+	LocationMap::iterator it = mLocations.find(id);
+
+	if(it != mLocations.end())
+	{
+		// take the new type and data along
+		Cell& cell = mCells[(*it).second.mCell];
+
+		cell.mTypes[(*it).second.mIndex]	= type;
+		cell.mData[(*it).second.mIndex]		= data;
+
+		move(id,x,z);
+		return;
+	}
+
+	Location location;
+	location.mCell	= _getCell(x,z);
+	location.mIndex	= static_cast<uint32>(mCells[location.mCell].mIds.size());
+
+	_addToCell(location.mCell,id,x,z,type,data);
+	mLocations.insert(std::make_pair(id,location));
+}
+
+//======================================================================================================================
+
+bool SpatialGrid::remove(int64 id)
+{
+	LocationMap::iterator it = mLocations.find(id);
+
+	if(it == mLocations.end())
+		return false;
+
+	Location location = (*it).second;
+
+	mLocations.erase(it);
+	_removeFromCell(location);
+
+	return true;
+}
+
+//======================================================================================================================
+//
+// staying inside the cell only updates the coordinates
+//
+
+bool SpatialGrid::move(int64 id,float x,float z)
+{
+	LocationMap::iterator it = mLocations.find(id);
+
+	if(it == mLocations.end())
+		return false;
+
+	Location&	location	= (*it).second;
+	uint32		newCell		= _getCell(x,z);
+
+	if(newCell == location.mCell)
+	{
+		mCells[newCell].mX[location.mIndex] = x;
+		mCells[newCell].mZ[location.mIndex] = z;
+
+		return true;
+	}
+
+	Location	oldLocation	= location;
+	Cell&		oldCell		= mCells[oldLocation.mCell];
+	uint32		type		= oldCell.mTypes[oldLocation.mIndex];
+	void*		data		= oldCell.mData[oldLocation.mIndex];
+
+	location.mCell	= newCell;
+	location.mIndex	= static_cast<uint32>(mCells[newCell].mIds.size());
+
+	_addToCell(newCell,id,x,z,type,data);
+	_removeFromCell(oldLocation);
+
+	return true;
+}
+
+//======================================================================================================================
+
+void SpatialGrid::clear()
+{
+	for(uint32 i = 0; i < mCells.size(); i++)
+	{
+		mCells[i] = Cell();
+	}
+
+	mLocations.clear();
+}
+
+//======================================================================================================================
+//
+// appends the payload of every point inside the rectangle whose type passes the mask
+//
+
+template<typename T>
+void SpatialGrid::_query(float xLow,float zLow,float xHigh,float zHigh,uint32 typeMask,const std::vector<T> Cell::* payload,std::vector<T>& result) const
+{
+	uint32 columnLow	= _getColumn(xLow);
+	uint32 columnHigh	= _getColumn(xHigh);
+	uint32 rowLow		= _getColumn(zLow);
+	uint32 rowHigh		= _getColumn(zHigh);
+
+#if defined(ANH_SPATIALGRID_SSE2)
+	const __m128	xLow4		= _mm_set1_ps(xLow);
+	const __m128	xHigh4		= _mm_set1_ps(xHigh);
+	const __m128	zLow4		= _mm_set1_ps(zLow);
+	const __m128	zHigh4		= _mm_set1_ps(zHigh);
+	const __m128i	typeMask4	= _mm_set1_epi32(static_cast<int>(typeMask));
+#endif
+
+	for(uint32 row = rowLow; row <= rowHigh; row++)
+	{
+		const Cell* cell = &mCells[row * mCellsPerSide + columnLow];
+
+		for(uint32 column = columnLow; column <= columnHigh; column++,cell++)
+		{
+			const uint32		count	= static_cast<uint32>(cell->mIds.size());
+			const std::vector<T>&	values	= cell->*payload;
+			uint32				i		= 0;
+
+#if defined(ANH_SPATIALGRID_SSE2)
+			for(; i + 4 <= count; i += 4)
+			{
+				__m128	x		= _mm_loadu_ps(&cell->mX[i]);
+				__m128	z		= _mm_loadu_ps(&cell->mZ[i]);
+				__m128i	types	= _mm_loadu_si128(reinterpret_cast<const __m128i*>(&cell->mTypes[i]));
+
+				__m128	inside	= _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(x,xLow4),_mm_cmple_ps(x,xHigh4)),
+											 _mm_and_ps(_mm_cmpge_ps(z,zLow4),_mm_cmple_ps(z,zHigh4)));
+				__m128i	typeOk	= _mm_cmpeq_epi32(_mm_and_si128(types,typeMask4),types);
+
+				int hits = _mm_movemask_ps(_mm_and_ps(inside,_mm_castsi128_ps(typeOk)));
+
+				if(hits)
+				{
+					if(hits & 1) result.push_back(values[i]);
+					if(hits & 2) result.push_back(values[i + 1]);
+					if(hits & 4) result.push_back(values[i + 2]);
+					if(hits & 8) result.push_back(values[i + 3]);
+				}
+			}
+#endif
+
+			for(; i < count; i++)
+			{
+				float x = cell->mX[i];
+				float z = cell->mZ[i];
+
+				if(x >= xLow && x <= xHigh && z >= zLow && z <= zHigh && ((cell->mTypes[i] & typeMask) == cell->mTypes[i]))
+				{
+					result.push_back(values[i]);
+				}
+			}
+		}
+	}
+}
+
+//======================================================================================================================
+
+void SpatialGrid::query(float xLow,float zLow,float xHigh,float zHigh,std::vector<int64>& result) const
+{
+	_query(xLow,zLow,xHigh,zHigh,0xffffffff,&Cell::mIds,result);
+}
+
+//======================================================================================================================
+
+void SpatialGrid::query(float xLow,float zLow,float xHigh,float zHigh,uint32 typeMask,std::vector<int64>& result) const
+{
+	_query(xLow,zLow,xHigh,zHigh,typeMask,&Cell::mIds,result);
+}
+
+//======================================================================================================================
+
+void SpatialGrid::query(float xLow,float zLow,float xHigh,float zHigh,uint32 typeMask,std::vector<void*>& result) const
+{
+	_query(xLow,zLow,xHigh,zHigh,typeMask,&Cell::mData,result);
+}
+
+//======================================================================================================================
+
+uint32 SpatialGrid::getMaxCellLoad() const
+{
+	size_t load = 0;
+
+	for(uint32 i = 0; i < mCells.size(); i++)
+	{
+		load = std::max(load,mCells[i].mIds.size());
+	}
+
+	return static_cast<uint32>(load);
+}
+
+//======================================================================================================================
+
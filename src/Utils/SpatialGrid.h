@@ -0,0 +1,99 @@
+/*
+---------------------------------------------------------------------------------------
+This source file is part of swgANH (Star Wars Galaxies - A New Hope - Server Emulator)
+For more information, see http://www.swganh.org
+
+
+Copyright (c) 2006 - 2010 The swgANH Team
+
+---------------------------------------------------------------------------------------
+*/
+
+#ifndef ANH_UTILS_SPATIALGRID_H
+#define ANH_UTILS_SPATIALGRID_H
+
+#include "typedefs.h"
+#include <boost/unordered_map.hpp>
+#include <cstddef>
+#include <vector>
+
+
+namespace Anh_Utils
+{
+	//======================================================================================================================
+	//
+	// uniform grid of points over the square [-extent,extent]
+	// every cell keeps its points as packed arrays (x, z, type, id, data), an id lookup gives the cell and slot of a point,
+	// so inserts, removes and moves are O(1) and a range query only touches the cells it overlaps
+	// the bounds and type test of a query runs 4 points at a time with sse2 where available
+	// points outside the extent are kept in the border cells
+	//
+	// an id is in the grid at most once, inserting it again moves it
+	//
+
+	class SpatialGrid
+	{
+		public:
+
+			SpatialGrid(float cellSize,float extent);
+			~SpatialGrid();
+
+			// type and data are handed back by the typed query, data is not owned by the grid
+			void	insert(int64 id,float x,float z,uint32 type = 0,void* data = NULL);
+			bool	remove(int64 id);
+			bool	move(int64 id,float x,float z);
+			void	clear();
+
+			// appends the ids of all points inside the rectangle, bounds included
+			void	query(float xLow,float zLow,float xHigh,float zHigh,std::vector<int64>& result) const;
+
+			// same, for points whose type is fully inside the mask ((type & mask) == type)
+			void	query(float xLow,float zLow,float xHigh,float zHigh,uint32 typeMask,std::vector<int64>& result) const;
+			void	query(float xLow,float zLow,float xHigh,float zHigh,uint32 typeMask,std::vector<void*>& result) const;
+
+			uint32	getCount() const { return static_cast<uint32>(mLocations.size()); }
+			uint32	getCellCount() const { return static_cast<uint32>(mCells.size()); }
+			uint32	getCellsPerSide() const { return mCellsPerSide; }
+			float	getCellSize() const { return mCellSize; }
+			uint32	getMaxCellLoad() const;
+
+		private:
+
+			struct Location
+			{
+				uint32	mCell;
+				uint32	mIndex;
+			};
+
+			struct Cell
+			{
+				std::vector<float>	mX;
+				std::vector<float>	mZ;
+				std::vector<uint32>	mTypes;
+				std::vector<int64>	mIds;
+				std::vector<void*>	mData;
+			};
+
+			typedef boost::unordered_map<int64,Location>		LocationMap;
+
+			uint32	_getColumn(float coordinate) const;
+			uint32	_getCell(float x,float z) const { return _getColumn(z) * mCellsPerSide + _getColumn(x); }
+			void	_addToCell(uint32 cell,int64 id,float x,float z,uint32 type,void* data);
+			void	_removeFromCell(const Location& location);
+
+			template<typename T>
+			void	_query(float xLow,float zLow,float xHigh,float zHigh,uint32 typeMask,const std::vector<T> Cell::* payload,std::vector<T>& result) const;
+
+			float				mCellSize;
+			float				mInvCellSize;
+			float				mExtent;
+			uint32				mCellsPerSide;
+			std::vector<Cell>	mCells;
+			LocationMap			mLocations;
+	};
+}
+
+//======================================================================================================================
+
+#endif
+
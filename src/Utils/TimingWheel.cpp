@@ -0,0 +1,292 @@
+/*
+---------------------------------------------------------------------------------------
+This source file is part of swgANH (Star Wars Galaxies - A New Hope - Server Emulator)
+For more information, see http://www.swganh.org
+
+
+Copyright (c) 2006 - 2010 The swgANH Team
+
+---------------------------------------------------------------------------------------
+*/
+
+#include "TimingWheel.h"
+
+
+namespace Anh_Utils
+{
+	//======================================================================================================================
+
+	TimingWheel::TimingWheel(uint64 now) : mCount(0),mTime(now)
+	{
+		for(uint32 i = 0; i < Wheels * Slots; i++)
+		{
+			mHeads[i] = None;
+		}
+
+		for(uint32 i = 0; i < Wheels; i++)
+		{
+			mWheelCounts[i] = 0;
+		}
+	}
+
+	//======================================================================================================================
+
+	void TimingWheel::insert(uint32 handle,uint64 dueTime)
+	{
+		if(handle >= mEntries.size())
+		{
+			Entry unused;
+
+			unused.mDueTime	= 0;
+			unused.mPrev	= None;
+			unused.mNext	= None;
+			unused.mSlot	= None;
+
+			mEntries.resize(handle + 1,unused);
+		}
+
+		if(mEntries[handle].mSlot != None)
+		{
+			_unlink(handle);
+			mCount--;
+		}
+
+		mEntries[handle].mDueTime = (dueTime > mTime) ? dueTime : mTime + 1;
+
+		_link(handle);
+		mCount++;
+	}
+
+	//======================================================================================================================
+
+	bool TimingWheel::remove(uint32 handle)
+	{
+		if(!contains(handle))
+		{
+			return(false);
+		}
+
+		_unlink(handle);
+		mCount--;
+
+		return(true);
+	}
+
+	//======================================================================================================================
+
+	bool TimingWheel::contains(uint32 handle) const
+	{
+		return(handle < mEntries.size() && mEntries[handle].mSlot != None);
+	}
+
+	//======================================================================================================================
+
+	uint64 TimingWheel::getDueTime(uint32 handle) const
+	{
+		return(contains(handle) ? mEntries[handle].mDueTime : 0);
+	}
+
+	//======================================================================================================================
+
+	void TimingWheel::advance(uint64 now,std::vector<uint32>& expired)
+	{
+		if(now < mTime)
+		{
+			_rebase(now);
+			return;
+		}
+
+		while(mTime < now)
+		{
+			// nothing left to expire, no need to walk the ticks
+			if(!mCount)
+			{
+				mTime = now;
+				break;
+			}
+
+			// jump to the tick before the next slot of the innermost wheel holding anything comes around
+			uint32 wheel = 0;
+
+			while(!mWheelCounts[wheel])
+			{
+				wheel++;
+			}
+
+			if(wheel)
+			{
+				uint64 skipTo = mTime | ((static_cast<uint64>(1) << (wheel * SlotBits)) - 1);
+
+				if(skipTo >= now)
+				{
+					mTime = now;
+					break;
+				}
+
+				mTime = skipTo;
+			}
+
+			mTime++;
+
+			uint32 index = static_cast<uint32>(mTime & SlotMask);
+
+			// the first wheel went around, bring down the next slot of the outer ones
+			if(!index)
+			{
+				for(uint32 wheel = 1; wheel < Wheels; wheel++)
+				{
+					_cascade(wheel);
+
+					if((mTime >> (wheel * SlotBits)) & SlotMask)
+					{
+						break;
+					}
+				}
+			}
+
+			uint32 handle = mHeads[index];
+
+			mHeads[index] = None;
+
+			while(handle != None)
+			{
+				Entry& entry = mEntries[handle];
+
+				expired.push_back(handle);
+
+				handle			= entry.mNext;
+				entry.mPrev		= None;
+				entry.mNext		= None;
+				entry.mSlot		= None;
+
+				mWheelCounts[0]--;
+				mCount--;
+			}
+		}
+	}
+
+	//======================================================================================================================
+	//
+	// the wheel an entry goes in depends on how far out it is, the slot on its due time
+	//
+
+	void TimingWheel::_link(uint32 handle)
+	{
+		Entry&	entry	= mEntries[handle];
+		uint64	dueTime	= entry.mDueTime;
+		uint64	delta	= dueTime - mTime;
+		uint32	wheel	= 0;
+
+		while(wheel < Wheels - 1 && delta >= (static_cast<uint64>(1) << ((wheel + 1) * SlotBits)))
+		{
+			wheel++;
+		}
+
+		// too far out even for the last wheel, it gets filed again when that slot comes around
+		if(delta >= (static_cast<uint64>(1) << (Wheels * SlotBits)))
+		{
+			dueTime = mTime + (static_cast<uint64>(1) << (Wheels * SlotBits)) - 1;
+		}
+
+		uint32 slot = wheel * Slots + static_cast<uint32>((dueTime >> (wheel * SlotBits)) & SlotMask);
+
+		entry.mSlot	= slot;
+		entry.mPrev	= None;
+		entry.mNext	= mHeads[slot];
+
+		if(entry.mNext != None)
+		{
+			mEntries[entry.mNext].mPrev = handle;
+		}
+
+		mHeads[slot] = handle;
+		mWheelCounts[wheel]++;
+	}
+
+	//======================================================================================================================
+
+	void TimingWheel::_unlink(uint32 handle)
+	{
+		Entry& entry = mEntries[handle];
+
+		if(entry.mPrev != None)
+		{
+			mEntries[entry.mPrev].mNext = entry.mNext;
+		}
+		else
+		{
+			mHeads[entry.mSlot] = entry.mNext;
+		}
+
+		if(entry.mNext != None)
+		{
+			mEntries[entry.mNext].mPrev = entry.mPrev;
+		}
+
+		mWheelCounts[entry.mSlot / Slots]--;
+
+		entry.mPrev	= None;
+		entry.mNext	= None;
+		entry.mSlot	= None;
+	}
+
+	//======================================================================================================================
+	//
+	// files the entries of the current slot of a wheel again, they all land in an inner one
+	//
+
+	void TimingWheel::_cascade(uint32 wheel)
+	{
+		uint32 slot		= wheel * Slots + static_cast<uint32>((mTime >> (wheel * SlotBits)) & SlotMask);
+		uint32 handle	= mHeads[slot];
+
+		mHeads[slot] = None;
+
+		while(handle != None)
+		{
+			uint32 next = mEntries[handle].mNext;
+
+			mWheelCounts[wheel]--;
+			_link(handle);
+
+			handle = next;
+		}
+	}
+
+	//======================================================================================================================
+	//
+	// the clock went backwards, every entry keeps the time it had left
+	//
+
+	void TimingWheel::_rebase(uint64 now)
+	{
+		for(uint32 i = 0; i < Wheels * Slots; i++)
+		{
+			mHeads[i] = None;
+		}
+
+		for(uint32 i = 0; i < Wheels; i++)
+		{
+			mWheelCounts[i] = 0;
+		}
+
+		uint64 oldTime = mTime;
+
+		mTime = now;
+
+		for(uint32 handle = 0; handle < mEntries.size(); handle++)
+		{
+			Entry& entry = mEntries[handle];
+
+			if(entry.mSlot != None)
+			{
+				entry.mDueTime = now + (entry.mDueTime - oldTime);
+
+				_link(handle);
+			}
+		}
+	}
+}
+
+//======================================================================================================================
+
@@ -0,0 +1,85 @@
+/*
+---------------------------------------------------------------------------------------
+This source file is part of swgANH (Star Wars Galaxies - A New Hope - Server Emulator)
+For more information, see http://www.swganh.org
+
+
+Copyright (c) 2006 - 2010 The swgANH Team
+
+---------------------------------------------------------------------------------------
+*/
+
+#ifndef ANH_UTILS_TIMINGWHEEL_H
+#define ANH_UTILS_TIMINGWHEEL_H
+
+#include "typedefs.h"
+#include <vector>
+
+
+namespace Anh_Utils
+{
+	//======================================================================================================================
+	//
+	// hierarchical timing wheel, one tick per millisecond
+	//
+	// four wheels of 256 slots each, the first covers the next 256ms, the last 49 days,
+	// entries further out wait in the last wheel and are filed again when their slot comes around
+	// an entry is a handle the owner picks, usually an index into its own task array
+	// inserting and removing are O(1), advancing costs one step per tick plus the expired entries
+	// and the entries moved down from an outer wheel, ticks where the inner wheels are empty are skipped
+	//
+
+	class TimingWheel
+	{
+		public:
+
+			TimingWheel(uint64 now = 0);
+
+			// the time the wheel has been advanced to, due times up to it have expired
+			uint64	getTime() const { return mTime; }
+			uint32	size() const { return mCount; }
+			bool	empty() const { return mCount == 0; }
+
+			// due times that already passed expire on the next advance
+			void	insert(uint32 handle,uint64 dueTime);
+			bool	remove(uint32 handle);
+			bool	contains(uint32 handle) const;
+			uint64	getDueTime(uint32 handle) const;
+
+			// appends the handles whose time has come in due order, they are no longer in the wheel
+			// a clock going backwards keeps what was left of every delay
+			void	advance(uint64 now,std::vector<uint32>& expired);
+
+		private:
+
+			static const uint32	SlotBits	= 8;
+			static const uint32	Slots		= 1 << SlotBits;
+			static const uint32	SlotMask	= Slots - 1;
+			static const uint32	Wheels		= 4;
+			static const uint32	None		= 0xffffffff;
+
+			struct Entry
+			{
+				uint64	mDueTime;
+				uint32	mPrev;
+				uint32	mNext;
+				uint32	mSlot;		// None if not in the wheel
+			};
+
+			void	_link(uint32 handle);
+			void	_unlink(uint32 handle);
+			void	_cascade(uint32 wheel);
+			void	_rebase(uint64 now);
+
+			std::vector<Entry>	mEntries;
+			uint32				mHeads[Wheels * Slots];
+			uint32				mWheelCounts[Wheels];
+			uint32				mCount;
+			uint64				mTime;
+	};
+}
+
+#endif
+
+//======================================================================================================================
+
@@ -14,7 +14,7 @@ namespace Anh_Utils
 {
 	//======================================================================================================================
 
-	VariableTimeScheduler::VariableTimeScheduler(uint64 processTimeLimit, uint64 throttleLimit) : mNextTask(0),mNextTaskId(1),mProcessTimeLimit(processTimeLimit),mThrottleLimit(throttleLimit)
+	VariableTimeScheduler::VariableTimeScheduler(uint64 processTimeLimit, uint64 throttleLimit) : mNextTask(0),mNextTaskId(1),mStats(NULL),mProcessTimeLimit(processTimeLimit),mThrottleLimit(throttleLimit)
 	{
 		mLastProcessTime = 0;
 		// We do have a global clock object, don't use seperate clock and times for every process.
@@ -26,13 +26,24 @@ namespace Anh_Utils
 	VariableTimeScheduler::~VariableTimeScheduler()
 	{
 		// delete(mClock);
+		delete(mStats);
 	}
 
 	//======================================================================================================================
 
-	uint64 VariableTimeScheduler::addTask(VariableTimeCallback callback,uint8 priority,uint64 interval,void* async)
+	void VariableTimeScheduler::enableStats(const std::string& name)
 	{
-		mTasks.push(VariableTimeTask(mNextTaskId,priority,Anh_Utils::Clock::getSingleton()->getLocalTime(),interval,callback,async));
+		if(!mStats)
+		{
+			mStats = new SchedulerStats(name);
+		}
+	}
+
+	//======================================================================================================================
+
+	uint64 VariableTimeScheduler::addTask(VariableTimeCallback callback,uint8 priority,uint64 interval,void* async,const char* label)
+	{
+		mTasks.push(VariableTimeTask(mNextTaskId,priority,Anh_Utils::Clock::getSingleton()->getLocalTime(),interval,callback,async,label));
 		return(mNextTaskId++);
 	}
 
@@ -100,6 +111,12 @@ namespace Anh_Utils
 		
 		//Set internal Clock so we know when the last call was
 		mLastProcessTime = Anh_Utils::Clock::getSingleton()->getLocalTime();
+
+		// a pass that ran through starts over at the first task, otherwise the rest of the list waits
+		if(mStats)
+		{
+			mStats->recordPass(mLastProcessTime - frameStartTime,mNextTask ? static_cast<uint32>(mTasks.size() - mNextTask) : 0);
+		}
 	}
 
 	//======================================================================================================================
@@ -112,7 +129,16 @@ namespace Anh_Utils
 			uint64	currentTime = Anh_Utils::Clock::getSingleton()->getLocalTime();
 			if((currentTime - task.mLastCallTime) > task.mInterval)
 			{
-				uint64 nextTick = task.mCallback(currentTime,task.mAsync);
+				const char*	label		= task.mLabel;
+				uint64		lateness	= currentTime - task.mLastCallTime - task.mInterval - 1;
+				uint64		startTime	= mStats ? SchedulerStats::getMicroTime() : 0;
+				uint64		nextTick	= task.mCallback(currentTime,task.mAsync);
+
+				if(mStats)
+				{
+					mStats->recordCall(label,SchedulerStats::getMicroTime() - startTime,lateness);
+				}
+
 				if(nextTick == 0)
 				{
 					removeTask(task.mId);
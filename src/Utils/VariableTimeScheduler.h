@@ -15,6 +15,7 @@ Copyright (c) 2006 - 2010 The swgANH Team
 #include "typedefs.h"
 #include "FastDelegate.h"
 #include "PriorityVector.h"
+#include "SchedulerStats.h"
 #include "clock.h"
 #include <algorithm>
 
@@ -30,8 +31,8 @@ namespace Anh_Utils
 	{
 		public:
 
-			VariableTimeTask(uint64 id,uint8 priority,uint64 lastCallTime,uint64 interval,VariableTimeCallback callback,void* async)
-				: mId(id),mPriority(priority),mLastCallTime(lastCallTime),mInterval(interval),mCallback(callback),mAsync(async){}
+			VariableTimeTask(uint64 id,uint8 priority,uint64 lastCallTime,uint64 interval,VariableTimeCallback callback,void* async,const char* label = NULL)
+				: mId(id),mPriority(priority),mLastCallTime(lastCallTime),mInterval(interval),mCallback(callback),mAsync(async),mLabel(label){}
 			
 			~VariableTimeTask(){}
 
@@ -46,6 +47,7 @@ namespace Anh_Utils
 			uint64		mInterval;
 			VariableTimeCallback	mCallback;
 			void*		mAsync;
+			const char*	mLabel;
 	};
 
 //======================================================================================================================
@@ -61,18 +63,23 @@ typedef priority_vector<VariableTimeTask> VariableTaskContainer;
 			VariableTimeScheduler(uint64 processTimeLimit = 100, uint64 throttleLimit = 0);
 			~VariableTimeScheduler();
 
-			uint64	addTask(VariableTimeCallback callback,uint8 priority,uint64 interval,void* async);
+			uint64	addTask(VariableTimeCallback callback,uint8 priority,uint64 interval,void* async,const char* label = NULL);
 			void	removeTask(uint64 id);
 			bool	checkTask(uint64 id);
 			void	reset(){ mNextTask = 0; }
 			void	process();
 			bool	runTask();
+
+			// stats are off until enabled, the scheduler keeps them
+			void			enableStats(const std::string& name);
+			SchedulerStats*	getStats() const { return mStats; }
 		
 		protected:
 
 			VariableTaskContainer		mTasks;	
 			uint32				mNextTask;
 			uint64				mNextTaskId;
+			SchedulerStats*		mStats;
 			// Anh_Utils::Clock*	mClock;
 			uint64				mProcessTimeLimit, mThrottleLimit, mLastProcessTime;
 	};
@@ -100,7 +100,7 @@ uint64 Clock::getLocalTime() const
 #else
 	struct timeval tv;
 	gettimeofday(&tv, NULL);
-	return tv.tv_usec / 1000;
+	return static_cast<uint64>(tv.tv_sec) * 1000 + tv.tv_usec / 1000;
 #endif
 }
 
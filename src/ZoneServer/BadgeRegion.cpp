@@ -35,7 +35,7 @@ BadgeRegion::~BadgeRegion()
 //=============================================================================
 //every 2 secs were querying the si for players in our region
 
-void BadgeRegion::update()
+void BadgeRegion::queryRegion()
 {
 	if(!mSubZoneId)
 	{
@@ -44,19 +44,28 @@ void BadgeRegion::update()
 		mQueryRect	= Anh_Math::Rectangle(mPosition.x - mWidth,mPosition.z - mHeight,mWidth * 2,mHeight * 2);
 	}
 
-	Object*		object;
-	ObjectSet	objList;
+	mRegionObjects.clear();
 
 	if(mParentId)
 	{
-		mSI->getObjectsInRange(this,&objList,ObjType_Player,mWidth);
+		mSI->getObjectsInRange(this,&mRegionObjects,ObjType_Player,mWidth);
 	}
 
 	if(mQTRegion)
 	{
-		mQTRegion->mTree->getObjectsInRange(this,&objList,ObjType_Player,&mQueryRect);
+		mQTRegion->mTree->getObjectsInRange(this,&mRegionObjects,ObjType_Player,&mQueryRect);
 	}
 
+	mRegionQueried = true;
+}
+
+//=============================================================================
+
+void BadgeRegion::update()
+{
+	Object*		object;
+	ObjectSet&	objList = _getRegionObjects();
+
 	ObjectSet::iterator objIt = objList.begin();
 
 	while(objIt != objList.end())
@@ -36,6 +36,7 @@ class BadgeRegion : public RegionObject
 		uint32			getBadgeId(){ return mBadgeId; }
 		void			setBadgeId(uint32 id){ mBadgeId = id; }
 
+		virtual void	queryRegion();
 		virtual void	update();
 		virtual void	onObjectEnter(Object* object);
 		virtual void	onObjectLeave(Object* object);
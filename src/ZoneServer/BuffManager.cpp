@@ -269,29 +269,6 @@ bool BuffManager::SaveBuffsAsync(WMAsyncContainer* asyncContainer,DatabaseCallba
 
 	return(buffCount>0);
 
-}
-void BuffManager::SaveBuffs(PlayerObject* playerObject, uint64 currenttime)
-{
-	//RemovedDeleted Buffs
-	playerObject->CleanUpBuffs();
-
-	BuffList::iterator it = playerObject->GetBuffList()->begin();
-	while(it != playerObject->GetBuffList()->end())
-	{
-		Buff* temp = *it;
-		//Check if it is an active Buff
-		if(!temp->GetIsMarkedForDeletion())
-		{
-			//Save to DB, and remove from the Process Queue
-			AddBuffToDB(temp, currenttime);
-			gWorldManager->removeBuffToProcess(temp->GetID());
-		}
-
-		//Free up Memory
-		temp->EraseAttributes();
-		it = playerObject->GetBuffList()->erase(it);
-	}
-
 }
 
 //=============================================================================
@@ -441,103 +418,6 @@ bool BuffManager::AddBuffToDB(WMAsyncContainer* asyncContainer,DatabaseCallback*
 
 }
 
-//=============================================================================
-//saves the buff to db sync
-//
-
-void BuffManager::AddBuffToDB(Buff* buff, uint64 currenttime)
-{
-	//If we have been passed a null Buff
-	if(!buff)
-		return;
-
-	//Check for deletion of buff
-	if(buff->GetIsMarkedForDeletion())
-		return;
-
-
-	buffAsyncContainer* envelope	= new buffAsyncContainer();
-	envelope->mQueryType	= BMQuery_Null;
-
-	/*TODO Should I Reset the Stat here on the player so it doesn't get double buffed
-		For now, this is dealt with by removing hte modifiers when saving Player HAM to DB,
-		but this might not be the best long term solution
-	*/
-
-	//Get PlayerObjects from CreatureObjects
-	PlayerObject* Player = dynamic_cast<PlayerObject*>(buff->GetTarget());
-	PlayerObject* target = dynamic_cast<PlayerObject*>(buff->GetInstigator());
-
-	//If target is a player, not Creature/NPC
-	if(Player)
-	{
-		//Get ID for Instigator (if not Creature/NPC)
-		uint64 instigatorid = 0;
-		if(target)
-		{
-			instigatorid = target->getId();
-		}
-
-		uint32 bufficon = buff->GetIcon();
-		int8 sql[550];
-		sprintf(sql, "INSERT INTO character_buffs (character_id, buff_id, instigator_id, max_ticks, tick_length, current_tick, icon, current_global_tick, start_global_tick) values(");
-		sprintf(sql+strlen(sql), "%"PRIu64",", Player->getId());
-		sprintf(sql+strlen(sql), "%"PRIu64",", buff->GetID());
-		sprintf(sql+strlen(sql), "%"PRIu64",", instigatorid);
-		sprintf(sql+strlen(sql), "%u,", buff->GetNoOfTicks());
-		sprintf(sql+strlen(sql), "%"PRIu64",", buff->GetTickLength());
-		sprintf(sql+strlen(sql), "%u,", buff->GetCurrentTickNumber());
-		sprintf(sql+strlen(sql), "%u,", bufficon);
-		sprintf(sql+strlen(sql), "%"PRIu64",", currenttime);
-		sprintf(sql+strlen(sql), "%"PRIu64");", buff->GetStartGlobalTick());
-
-		//gLogger->logMsg(sql,FOREGROUND_BLUE | FOREGROUND_GREEN);
-
-		//Lloydyboy Changed Save SQL back to Sync, not ASync to ensure this is saved, before new zone loads
-		//mDatabase->ExecuteSqlAsync(this,envelope,sql);
-		mDatabase->DestroyResult(mDatabase->ExecuteSynchSql(sql));
-
-		int8 sql2[550];
-		sprintf(sql2, "INSERT INTO character_buff_attributes (buff_id,character_id,type,initial,tick,final) VALUES");
-		//Add Attributes
-		AttributeList::iterator it = buff->Attributes.begin();
-
-		//if we have no attributes
-		if(it == buff->Attributes.end())
-		{
-			return;
-		}
-
-		while(it != buff->Attributes.end())
-		{
-			BuffAttribute* batemp = *it;
-
-			//undo the attribute pre safe - we will reapply this on login
-			buff->ModifyAttribute(batemp->GetType(), batemp->GetFinalValue());
-
-			sprintf(sql2+strlen(sql2), "(%"PRIu64",", buff->GetID());
-			sprintf(sql2+strlen(sql2), "%"PRIu64",", Player->getId());
-			sprintf(sql2+strlen(sql2), "%d,", (int32)batemp->GetType());
-			sprintf(sql2+strlen(sql2), "%d,", batemp->GetInitialValue());
-			sprintf(sql2+strlen(sql2), "%d,", batemp->GetTickValue());
-			
-			AttributeList::iterator it2 = it; it2++;
-			if(it2 != buff->Attributes.end())
-			{
-				sprintf(sql2+strlen(sql2), "%d),", batemp->GetFinalValue());
-			} else {
-				sprintf(sql2+strlen(sql2), "%d);", batemp->GetFinalValue());
-			}
-			it++;
-		}
-		//gLogger->logMsg(sql2,FOREGROUND_BLUE | FOREGROUND_GREEN);
-
-		//Lloydyboy Changed Save SQL back to Sync, not ASync to ensure this is saved, before new zone loads
-		//mDatabase->ExecuteSqlAsync(this,envelope,sql2);
-		mDatabase->DestroyResult(mDatabase->ExecuteSynchSql(sql2));
-	}
-}
-
 //=============================================================================
 //
 //
@@ -52,7 +52,6 @@ public:
 	static		BuffManager*	getSingletonPtr() { return mSingleton; }
 
 	void		handleDatabaseJobComplete(void* ref,DatabaseResult* result);
-	void		SaveBuffs(PlayerObject* playerObject, uint64 currenttime);
 	bool		SaveBuffsAsync(WMAsyncContainer* asyncContainer,DatabaseCallback* callback, PlayerObject* playerObject, uint64 currenttime);
 	void		LoadBuffs(PlayerObject* playerObject, uint64 currenttime);
 	void		LoadBuffAttributes(buffAsyncContainer* envelope);
@@ -65,7 +64,6 @@ private:
 
 
 	bool		AddBuffToDB(WMAsyncContainer* asyncContainer,DatabaseCallback* callback, Buff* buff, uint64 currenttime);
-	void		AddBuffToDB(Buff* buff, uint64 currenttime);
 
 
 	static		BuffManager*	mSingleton;
@@ -42,6 +42,9 @@ BuildingObject::~BuildingObject()
 
 	while(cellIt != mCells.end())
 	{
+		// we are going, dont let the cell report its content back
+		(*cellIt)->setBuilding(NULL);
+
 		gWorldManager->destroyObject((*cellIt));
 		//cellIt++;
 		cellIt = mCells.erase(cellIt);
@@ -67,6 +70,29 @@ SpawnPoint* BuildingObject::getRandomSpawnPoint()
 
 //=============================================================================
 
+void BuildingObject::addCell(CellObject* cellObject)
+{
+	mCells.push_back(cellObject);
+
+	cellObject->setBuilding(this);
+
+	// anything the cell got before it was ours
+	ObjectIDList*			cellObjects	= cellObject->getObjects();
+	ObjectIDList::iterator	objIt		= cellObjects->begin();
+
+	while(objIt != cellObjects->end())
+	{
+		if(Object* object = gWorldManager->getObjectById(*objIt))
+		{
+			addInteriorObject(object);
+		}
+
+		++objIt;
+	}
+}
+
+//=============================================================================
+
 bool BuildingObject::removeCell(CellObject* cellObject)
 {
 	CellObjectList::iterator it = mCells.begin();
@@ -76,6 +102,18 @@ bool BuildingObject::removeCell(CellObject* cellObject)
 		if((*it) == cellObject)
 		{
 			mCells.erase(it);
+
+			ObjectIDList*			cellObjects	= cellObject->getObjects();
+			ObjectIDList::iterator	objIt		= cellObjects->begin();
+
+			while(objIt != cellObjects->end())
+			{
+				removeInteriorObject(*objIt);
+				++objIt;
+			}
+
+			cellObject->setBuilding(NULL);
+
 			return(true);
 		}
 		++it;
@@ -141,6 +179,66 @@ ObjectList BuildingObject::getAllCellChilds()
 	return(resultList);
 }
 
+//=============================================================================
+
+void BuildingObject::addInteriorObject(Object* object)
+{
+	InteriorSlotMap::iterator it = mInteriorSlots.find(object->getId());
+
+	if(it != mInteriorSlots.end())
+	{
+		mInteriorObjects[(*it).second]	= object;
+		mInteriorTypes[(*it).second]	= object->getType();
+		return;
+	}
+
+	mInteriorSlots.insert(std::make_pair(object->getId(),static_cast<uint32>(mInteriorObjects.size())));
+	mInteriorObjects.push_back(object);
+	mInteriorTypes.push_back(object->getType());
+}
+
+//=============================================================================
+//
+// the last entry takes the free slot
+//
+
+void BuildingObject::removeInteriorObject(uint64 id)
+{
+	InteriorSlotMap::iterator it = mInteriorSlots.find(id);
+
+	if(it == mInteriorSlots.end())
+		return;
+
+	uint32 slot = (*it).second;
+	uint32 last = static_cast<uint32>(mInteriorObjects.size() - 1);
+
+	mInteriorSlots.erase(it);
+
+	if(slot != last)
+	{
+		mInteriorObjects[slot]	= mInteriorObjects[last];
+		mInteriorTypes[slot]	= mInteriorTypes[last];
+
+		mInteriorSlots[mInteriorObjects[slot]->getId()] = slot;
+	}
+
+	mInteriorObjects.pop_back();
+	mInteriorTypes.pop_back();
+}
+
+//=============================================================================
+
+void BuildingObject::getInteriorObjects(ObjectSet* resultSet,uint32 typeMask,uint64 excludeId) const
+{
+	for(uint32 i = 0; i < mInteriorObjects.size(); i++)
+	{
+		if(((mInteriorTypes[i] & typeMask) == mInteriorTypes[i]) && mInteriorObjects[i]->getId() != excludeId)
+		{
+			resultSet->insert(mInteriorObjects[i]);
+		}
+	}
+}
+
 //================================================================================
 //
 //the cells send an updated permission  to the specified player
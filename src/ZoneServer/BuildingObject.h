@@ -14,6 +14,7 @@ Copyright (c) 2006 - 2010 The swgANH Team
 
 #include "PlayerStructure.h"
 #include "BuildingEnums.h"
+#include <map>
 #include <vector>
 
 class CellObject;
@@ -51,10 +52,17 @@ class BuildingObject :	public PlayerStructure
 		SpawnPoint*		getRandomSpawnPoint();
 
 		CellObjectList*	getCellList(){ return &mCells; }
-		void			addCell(CellObject* cellObject){ mCells.push_back(cellObject); }
+		void			addCell(CellObject* cellObject);
 		bool			removeCell(CellObject* cellObject);
 		bool			checkForCell(CellObject* cellObject);
 		ObjectList		getAllCellChilds();
+
+		// the content of all cells, the cells keep it up to date so interior queries need neither the
+		// spatial index nor a lookup per object
+		void			addInteriorObject(Object* object);
+		void			removeInteriorObject(uint64 id);
+		void			getInteriorObjects(ObjectSet* resultSet, uint32 typeMask, uint64 excludeId = 0) const;
+		uint32			getInteriorObjectCount() const { return static_cast<uint32>(mInteriorObjects.size()); }
 		
 		uint16			getCellContentCount();
 
@@ -69,7 +77,14 @@ class BuildingObject :	public PlayerStructure
 		bool			checkCapacity(uint8 amount){return ((int32)(mMaxStorage - getCellContentCount())> amount);}
 
 	private:
+
+		typedef std::map<uint64,uint32>	InteriorSlotMap;
+
 		CellObjectList	mCells;
+
+		std::vector<Object*>	mInteriorObjects;
+		std::vector<uint32>		mInteriorTypes;
+		InteriorSlotMap			mInteriorSlots;
 		bool			mPublic;
 
 		uint32			mTotalLoadCount;
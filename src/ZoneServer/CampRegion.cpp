@@ -52,6 +52,32 @@ CampRegion::~CampRegion()
 
 //=============================================================================
 
+void CampRegion::queryRegion()
+{
+	if(!mSubZoneId)
+	{
+		mQTRegion	= mSI->getQTRegion(mPosition.x,mPosition.z);
+		mSubZoneId	= (uint32)mQTRegion->getId();
+		mQueryRect	= Anh_Math::Rectangle(mPosition.x - mWidth,mPosition.z - mHeight,mWidth*2,mHeight*2);
+	}
+
+	mRegionObjects.clear();
+
+	if(mParentId)
+	{
+		mSI->getObjectsInRange(this,&mRegionObjects,ObjType_Player,mWidth);
+	}
+
+	if(mQTRegion)
+	{
+		mQTRegion->mTree->getObjectsInRangeContains(this,&mRegionObjects,ObjType_Player,&mQueryRect);
+	}
+
+	mRegionQueried = true;
+}
+
+//=============================================================================
+
 void CampRegion::update()
 {
 	//Camps have a max timer of 55 minutes
@@ -86,25 +112,8 @@ void CampRegion::update()
 		return;
 	}
 
-	if(!mSubZoneId)
-	{
-		mQTRegion	= mSI->getQTRegion(mPosition.x,mPosition.z);
-		mSubZoneId	= (uint32)mQTRegion->getId();
-		mQueryRect	= Anh_Math::Rectangle(mPosition.x - mWidth,mPosition.z - mHeight,mWidth*2,mHeight*2);
-	}
-
 	Object*		object;
-	ObjectSet	objList;
-
-	if(mParentId)
-	{
-		mSI->getObjectsInRange(this,&objList,ObjType_Player,mWidth);
-	}
-
-	if(mQTRegion)
-	{
-		mQTRegion->mTree->getObjectsInRangeContains(this,&objList,ObjType_Player,&mQueryRect);
-	}
+	ObjectSet&	objList = _getRegionObjects();
 
 	ObjectSet::iterator objIt = objList.begin();
 
@@ -36,6 +36,7 @@ class CampRegion : public RegionObject
 		virtual ~CampRegion();
 
 
+		virtual void	queryRegion();
 		virtual void	update();
 		virtual void	onObjectEnter(Object* object);
 		virtual void	onObjectLeave(Object* object);
@@ -9,6 +9,7 @@ Copyright (c) 2006 - 2010 The swgANH Team
 ---------------------------------------------------------------------------------------
 */
 #include "CellObject.h"
+#include "BuildingObject.h"
 #include "PlayerObject.h"
 #include "TangibleObject.h"
 #include "PlayerStructureTerminal.h"
@@ -19,7 +20,8 @@ Copyright (c) 2006 - 2010 The swgANH Team
 
 //=============================================================================
 
-CellObject::CellObject() : StaticObject()
+CellObject::CellObject() : StaticObject(),
+mBuilding(NULL)
 {
 	mType = ObjType_Cell;
 	mModel = "object/cell/shared_cell.iff";
@@ -27,7 +29,8 @@ CellObject::CellObject() : StaticObject()
 
 //=============================================================================
 
-CellObject::CellObject(uint64 id,uint64 parentId,string model) : StaticObject(id,parentId,model,ObjType_Cell)
+CellObject::CellObject(uint64 id,uint64 parentId,string model) : StaticObject(id,parentId,model,ObjType_Cell),
+mBuilding(NULL)
 {
 }
 
@@ -58,13 +61,13 @@ void CellObject::prepareDestruction()
 		{
 			//place the player in the world
 			player->setParentId(0,0xffffffff,player->getKnownPlayers(),true);
-			objIt = cellObjects->erase(objIt);
+			objIt = removeObject(objIt);
 		}
 		else
 		if(CreatureObject* pet = dynamic_cast<CreatureObject*>(object))
 		{
 			pet->setParentId(0,0xffffffff,pet->getKnownPlayers(),true);
-			objIt = cellObjects->erase(objIt);
+			objIt = removeObject(objIt);
 		}
 		else
 		{
@@ -80,6 +83,26 @@ void CellObject::prepareDestruction()
 }
 //=============================================================================
 
+void CellObject::onContentAdded(Object* object)
+{
+	if(mBuilding)
+	{
+		mBuilding->addInteriorObject(object);
+	}
+}
+
+//=============================================================================
+
+void CellObject::onContentRemoved(uint64 id)
+{
+	if(mBuilding)
+	{
+		mBuilding->removeInteriorObject(id);
+	}
+}
+
+//=============================================================================
+
 //=============================================================================
 
 
@@ -14,6 +14,8 @@ Copyright (c) 2006 - 2010 The swgANH Team
 
 #include "StaticObject.h"
 
+class BuildingObject;
+
 //=============================================================================
 
 /*
@@ -39,10 +41,19 @@ class CellObject :	public StaticObject
 
 		void		prepareDestruction();
 
+		BuildingObject*	getBuilding(){ return mBuilding; }
+		void			setBuilding(BuildingObject* building){ mBuilding = building; }
+
+	protected:
+
+		// keeps the buildings interior index up to date
+		void		onContentAdded(Object* object);
+		void		onContentRemoved(uint64 id);
 
 	private:
 
 		//ObjectList	mChildObjects;
+		BuildingObject*	mBuilding;
 		uint32		mTotalLoadCount;
 	
 };
@@ -456,17 +456,17 @@ void CharacterLoginHandler::_processClusterZoneTransferApprovedByPosition(Messag
 		playerObject->setPosture(CreaturePosture_Upright);
 		playerObject->updateMovementProperties();
 
-		// Save our player.
-		gWorldManager->savePlayerSync(playerObject->getAccountId(),false);
-
-		// Now update the DB with the new location/planetId
-		mDatabase->DestroyResult(mDatabase->ExecuteSynchSql("UPDATE characters SET parent_id=0,x='%f', y='0', z='%f', planet_id='%u' WHERE id='%I64u';",x,z,planetId,playerObject->getId()));
+		// Save our player, the worldmanager updates the DB with the new location/planetId once the save went through
+		// and hands back to us, so we can send the player off - same as the ticket based transfer
+		CharacterLoadingContainer* asyncContainer = new(CharacterLoadingContainer);
 
-		gMessageLib->sendClusterZoneTransferCharacter(playerObject,planetId);
+		asyncContainer->callBack	= CLHCallBack_Transfer_Position;
+		asyncContainer->destination	= glm::vec3(x,0.0f,z);
+		asyncContainer->planet		= static_cast<uint16>(planetId);
+		asyncContainer->player		= playerObject;
+		asyncContainer->dbCallback	= this;
 
-		playerObject->setConnectionState(PlayerConnState_LinkDead);
-		// playerObject->setClient(NULL);
-		gWorldManager->destroyObject(playerObject);
+		gWorldManager->savePlayer(playerObject->getAccountId(),false, WMLogOut_Zone_Transfer, asyncContainer);
 	}
 }
 
@@ -67,8 +67,8 @@ void City::update()
 		++objIt;
 	}
 
-	ObjectSet oldKnownObjects = mKnownObjects;
-	ObjectSet::iterator objSetIt = oldKnownObjects.begin();
+	KnownObjectSet oldKnownObjects = mKnownObjects;
+	KnownObjectSet::iterator objSetIt = oldKnownObjects.begin();
 
 	while(objSetIt != oldKnownObjects.end())
 	{
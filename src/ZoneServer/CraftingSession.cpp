@@ -812,21 +812,16 @@ void CraftingSession::createPrototype(uint32 noPractice,uint32 counter)
 {
 	if(noPractice)
 	{
-		int8 sql[1024],restStr[128],*sqlPointer;
-
 		Transaction* t = mDatabase->startTransaction(this,new CraftSessionQueryContainer(CraftSessionQuery_Prototype,static_cast<uint8>(counter)));
 
 		// we need to alter / add attributes affected by attributes of components
 
 
 		// update the custom name and parent
-		sprintf(sql,"UPDATE items SET parent_id=%"PRIu64", customName='",mOwner->getEquipManager()->getEquippedObject(CreatureEquipSlot_Inventory)->getId());
-		sqlPointer = sql + strlen(sql);
-		sqlPointer += mDatabase->Escape_String(sqlPointer,mItem->getCustomName().getAnsi(),mItem->getCustomName().getLength());
-		sprintf(restStr,"' WHERE id=%"PRIu64" ",mItem->getId());
-		strcat(sql,restStr);
-
-		t->addQuery(sql);
+		t->addStatement("UPDATE items SET parent_id=?, customName=? WHERE id=?")
+			.bindUInt(mOwner->getEquipManager()->getEquippedObject(CreatureEquipSlot_Inventory)->getId())
+			.bindString(mItem->getCustomName().getAnsi(),mItem->getCustomName().getLength())
+			.bindUInt(mItem->getId());
 		t->execute();
 
 		// add the crafter name attribute
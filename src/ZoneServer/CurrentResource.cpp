@@ -12,11 +12,51 @@ Copyright (c) 2006 - 2010 The swgANH Team
 #include "ResourceType.h"
 #include "LogManager/LogManager.h"
 #include "ConfigManager/ConfigManager.h"
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <set>
 
 
 //=============================================================================
 
-CurrentResource::CurrentResource() : Resource()
+// translates to 1:32
+static const int	DistributionMapSize		= 512;
+
+static const char	DistributionMagic[4]	= {'R','M','A','P'};
+static const uint32	DistributionVersion		= 1;
+
+struct DistributionHeader
+{
+	char	mMagic[4];
+	uint32	mVersion;
+	uint64	mKey;
+	uint32	mSize;
+	float	mMin;
+	float	mStep;
+	uint32	mReserved;
+};
+
+// the cached files are used as they are, so they are only written and read on little endian hosts
+static bool isLittleEndian()
+{
+	uint16 probe = 1;
+
+	return(*reinterpret_cast<uint8*>(&probe) == 1);
+}
+
+std::string CurrentResource::mDistributionCachePath;
+uint32		CurrentResource::mDistributionCacheZone = 0;
+
+//=============================================================================
+
+CurrentResource::CurrentResource() : Resource(),
+mDistribution(NULL),
+mDistributionMin(0.0f),
+mDistributionStep(0.0f),
+mDistributionRegion(NULL)
 {
 }
 
@@ -24,6 +64,9 @@ CurrentResource::CurrentResource() : Resource()
 
 CurrentResource::~CurrentResource()
 {
+	mDistribution = NULL;
+
+	delete(mDistributionRegion);
 }
 
 //=============================================================================
@@ -31,63 +74,331 @@ CurrentResource::~CurrentResource()
 float CurrentResource::getDistribution(int x,int z)
 {
 	// translates to 1:32
-	return mResourceDistributionMap.GetValue((x >> 6),(z >> 6));
+	x >>= 6;
+	z >>= 6;
+
+	if(!mDistribution || x < 0 || x >= DistributionMapSize || z < 0 || z >= DistributionMapSize)
+	{
+		return(0.0f);
+	}
+
+	return(mDistributionMin + mDistributionStep * mDistribution[z * DistributionMapSize + x]);
 }
 
 //=============================================================================
 
 void CurrentResource::buildDistributionMap()
 {
-	noise::utils::NoiseMapBuilderPlane	mapBuilder;
+	_verifyNoiseSettings();
+
+	uint64 key = _getDistributionKey();
+
+	if(_mapDistribution(key))
+	{
+		gLogger->logMsgF("Mapped DistributionMap for %s(%s)",MSG_LOW,mName.getAnsi(),mType->getName().getAnsi());
+		return;
+	}
+
+	noise::utils::NoiseMapBuilderPlanePerlin	mapBuilder;
+	noise::utils::NoiseMap				noiseMap;
 	noise::module::ScaleBias			flattenModule;
 
 	flattenModule.SetSourceModule(0,mNoiseModule);
 	flattenModule.SetScale(mNoiseMapScale);
 	flattenModule.SetBias(mNoiseMapBias);
 
-	_verifyNoiseSettings();
-
 	mNoiseModule.SetPersistence(mNoiseMapPersistence);
 	mNoiseModule.SetOctaveCount(mNoiseMapOctaves);
 	mNoiseModule.SetFrequency(mNoiseMapFrequency);
 
 	mapBuilder.SetSourceModule(flattenModule);
-	mapBuilder.SetDestNoiseMap(mResourceDistributionMap);
+	mapBuilder.SetDestNoiseMap(noiseMap);
 
-	// translates to 1:32
-	mapBuilder.SetDestSize(512,512); 
+	mapBuilder.SetDestSize(DistributionMapSize,DistributionMapSize);
 	mapBuilder.SetBounds(mNoiseMapBoundsX1,mNoiseMapBoundsX2,mNoiseMapBoundsY1,mNoiseMapBoundsY2);
 
 	gLogger->logMsgF("Building DistributionMap for %s(%s)",MSG_LOW,mName.getAnsi(),mType->getName().getAnsi());
 	mapBuilder.Build();
 
-	if(gConfig->read<int>("writeResourceMaps"))
+	_quantizeDistribution(noiseMap);
+	_saveDistribution(key);
+}
+
+//=============================================================================
+
+void CurrentResource::writeDistributionMap()
+{
+	if(!mDistribution)
+	{
+		return;
+	}
+
+	noise::utils::NoiseMap noiseMap;
+
+	noiseMap.SetSize(DistributionMapSize,DistributionMapSize);
+
+	for(int z = 0; z < DistributionMapSize; z++)
+	{
+		for(int x = 0; x < DistributionMapSize; x++)
+		{
+			noiseMap.SetValue(x,z,mDistributionMin + mDistributionStep * mDistribution[z * DistributionMapSize + x]);
+		}
+	}
+
+	string fileName = (int8*)(gConfig->read<std::string>("ZoneName")).c_str();
+	fileName << "_" << mName.getAnsi() << ".bmp";
+
+	gLogger->logMsgF("Writing File %s",MSG_LOW,fileName.getAnsi());
+
+	noise::utils::RendererImage renderer;
+	noise::utils::Image image;
+	renderer.SetSourceNoiseMap(noiseMap);
+	renderer.SetDestImage(image);
+
+	renderer.ClearGradient();
+	renderer.AddGradientPoint(-1.0000,noise::utils::Color(0,0,0,255)); 
+	renderer.AddGradientPoint(-0.9999,noise::utils::Color(0,0,0,255)); 
+	renderer.AddGradientPoint(0.0000,noise::utils::Color(255,255,0,255)); 
+	renderer.AddGradientPoint(1.0000,noise::utils::Color(255,0,0,255)); 
+
+	renderer.EnableLight();
+	renderer.SetLightContrast(1.5); 
+	renderer.SetLightBrightness(2.0);
+	renderer.Render();
+
+	noise::utils::WriterBMP writer;
+	writer.SetSourceImage(image);
+	writer.SetDestFilename(fileName.getAnsi());
+	writer.WriteDestFile();
+}
+
+//=============================================================================
+//
+// fnv-1a over everything the map is built from
+//
+
+uint64 CurrentResource::_getDistributionKey()
+{
+	double settings[9] =
 	{
-		string fileName = (int8*)(gConfig->read<std::string>("ZoneName")).c_str();
-		fileName << "_" << mName.getAnsi() << ".bmp";
+		(double)mNoiseModule.GetSeed(),(double)mNoiseMapOctaves,mNoiseMapFrequency,mNoiseMapPersistence,
+		mNoiseMapBoundsX1,mNoiseMapBoundsX2,mNoiseMapBoundsY1,mNoiseMapBoundsY2,mNoiseMapScale
+	};
 
-		gLogger->logMsgF("Writing File %s",MSG_LOW,fileName.getAnsi());
+	const uint8*	bytes	= reinterpret_cast<const uint8*>(settings);
+	uint64			key		= 14695981039346656037ULL;
 
-		noise::utils::RendererImage renderer;
-		noise::utils::Image image;
-		renderer.SetSourceNoiseMap(mResourceDistributionMap);
-		renderer.SetDestImage(image);
+	for(uint32 i = 0; i < sizeof(settings); i++)
+	{
+		key = (key ^ bytes[i]) * 1099511628211ULL;
+	}
 
-		renderer.ClearGradient();
-		renderer.AddGradientPoint(-1.0000,noise::utils::Color(0,0,0,255)); 
-		renderer.AddGradientPoint(-0.9999,noise::utils::Color(0,0,0,255)); 
-		renderer.AddGradientPoint(0.0000,noise::utils::Color(255,255,0,255)); 
-		renderer.AddGradientPoint(1.0000,noise::utils::Color(255,0,0,255)); 
+	bytes = reinterpret_cast<const uint8*>(&mNoiseMapBias);
 
-		renderer.EnableLight();
-		renderer.SetLightContrast(1.5); 
-		renderer.SetLightBrightness(2.0);
-		renderer.Render();
+	for(uint32 i = 0; i < sizeof(mNoiseMapBias); i++)
+	{
+		key = (key ^ bytes[i]) * 1099511628211ULL;
+	}
+
+	return(key);
+}
 
-		noise::utils::WriterBMP writer;
-		writer.SetSourceImage(image);
-		writer.SetDestFilename(fileName.getAnsi());
-		writer.WriteDestFile();
+//=============================================================================
+
+std::string CurrentResource::_getDistributionFileName(uint64 key) const
+{
+	char name[48];
+
+	sprintf(name,"resmap_%u_%08x%08x.rmap",mDistributionCacheZone,(uint32)(key >> 32),(uint32)(key & 0xffffffff));
+
+	return(mDistributionCachePath + name);
+}
+
+//=============================================================================
+//
+// a zone lists the maps it uses in resmap_<zone>.list, the maps listed on the last boot that arent used anymore
+// belonged to despawned resources and are deleted
+// only names are listed, nothing outside the cache path is ever touched
+//
+
+void CurrentResource::pruneDistributionCache(std::vector<CurrentResource*>& resources)
+{
+	std::set<std::string>	current;
+	std::string				line;
+	char					name[32];
+
+	for(uint32 i = 0; i < resources.size(); i++)
+	{
+		current.insert(resources[i]->_getDistributionFileName(resources[i]->_getDistributionKey()).substr(mDistributionCachePath.length()));
+	}
+
+	sprintf(name,"resmap_%u.list",mDistributionCacheZone);
+
+	std::string		listName = mDistributionCachePath + name;
+	std::ifstream	previous(listName.c_str());
+
+	while(std::getline(previous,line))
+	{
+		if(line.compare(0,7,"resmap_") != 0 || line.find_first_of("/\\") != std::string::npos || current.find(line) != current.end())
+		{
+			continue;
+		}
+
+		if(remove((mDistributionCachePath + line).c_str()) == 0)
+		{
+			gLogger->logMsgF("CurrentResource::pruneDistributionCache: removed %s",MSG_LOW,line.c_str());
+		}
+	}
+
+	previous.close();
+
+	std::ofstream list(listName.c_str(),std::ios::out | std::ios::trunc);
+
+	for(std::set<std::string>::iterator it = current.begin(); it != current.end(); ++it)
+	{
+		list << *it << "\n";
+	}
+
+	if(!list)
+	{
+		gLogger->logMsgF("CurrentResource::pruneDistributionCache: could not write %s",MSG_LOW,listName.c_str());
+	}
+}
+
+//=============================================================================
+
+bool CurrentResource::_mapDistribution(uint64 key)
+{
+	if(!isLittleEndian())
+	{
+		return(false);
+	}
+
+	std::string name = _getDistributionFileName(key);
+
+	// the region stays valid once the file is closed, so a zone doesnt keep a handle per resource
+	try
+	{
+		boost::interprocess::file_mapping file(name.c_str(),boost::interprocess::read_only);
+
+		mDistributionRegion = new boost::interprocess::mapped_region(file,boost::interprocess::read_only);
+	}
+	catch(...)
+	{
+		// not cached yet
+		return(false);
+	}
+
+	const DistributionHeader* header = static_cast<const DistributionHeader*>(mDistributionRegion->get_address());
+
+	if(mDistributionRegion->get_size() < sizeof(DistributionHeader) + 2 * DistributionMapSize * DistributionMapSize
+	|| memcmp(header->mMagic,DistributionMagic,sizeof(DistributionMagic)) != 0 || header->mVersion != DistributionVersion
+	|| header->mKey != key || header->mSize != (uint32)DistributionMapSize)
+	{
+		gLogger->logMsgF("CurrentResource::_mapDistribution: ignoring damaged %s",MSG_NORMAL,name.c_str());
+
+		delete(mDistributionRegion);
+		mDistributionRegion = NULL;
+
+		return(false);
+	}
+
+	mDistributionMin	= header->mMin;
+	mDistributionStep	= header->mStep;
+	mDistribution		= reinterpret_cast<const uint16*>(header + 1);
+
+	return(true);
+}
+
+//=============================================================================
+//
+// 16 bit steps between the lowest and the highest value of the map
+//
+
+void CurrentResource::_quantizeDistribution(const noise::utils::NoiseMap& noiseMap)
+{
+	float lowest	= noiseMap.GetValue(0,0);
+	float highest	= lowest;
+
+	for(int z = 0; z < DistributionMapSize; z++)
+	{
+		for(int x = 0; x < DistributionMapSize; x++)
+		{
+			float value = noiseMap.GetValue(x,z);
+
+			lowest	= (value < lowest) ? value : lowest;
+			highest	= (value > highest) ? value : highest;
+		}
+	}
+
+	mDistributionMin	= lowest;
+	mDistributionStep	= (highest - lowest) / 65535.0f;
+
+	mDistributionBuffer.resize(DistributionMapSize * DistributionMapSize);
+
+	for(int z = 0; z < DistributionMapSize; z++)
+	{
+		for(int x = 0; x < DistributionMapSize; x++)
+		{
+			float sample = (mDistributionStep > 0.0f) ? (noiseMap.GetValue(x,z) - lowest) / mDistributionStep : 0.0f;
+
+			mDistributionBuffer[z * DistributionMapSize + x] = (uint16)((sample < 65535.0f) ? sample + 0.5f : 65535.0f);
+		}
+	}
+
+	mDistribution = &mDistributionBuffer[0];
+}
+
+//=============================================================================
+//
+// written to a temporary file first, so a zone going down halfway leaves no partial map behind
+//
+
+void CurrentResource::_saveDistribution(uint64 key)
+{
+	if(!isLittleEndian())
+	{
+		return;
+	}
+
+	std::string			name	= _getDistributionFileName(key);
+	std::string			temp	= name + ".tmp";
+	DistributionHeader	header;
+
+	memset(&header,0,sizeof(header));
+	memcpy(header.mMagic,DistributionMagic,sizeof(DistributionMagic));
+	header.mVersion	= DistributionVersion;
+	header.mKey		= key;
+	header.mSize	= DistributionMapSize;
+	header.mMin		= mDistributionMin;
+	header.mStep	= mDistributionStep;
+
+	FILE* file = fopen(temp.c_str(),"wb");
+
+	if(!file)
+	{
+		gLogger->logMsgF("CurrentResource::_saveDistribution: could not create %s",MSG_LOW,temp.c_str());
+		return;
+	}
+
+	bool written = (fwrite(&header,sizeof(header),1,file) == 1)
+				&& (fwrite(&mDistributionBuffer[0],2,mDistributionBuffer.size(),file) == mDistributionBuffer.size());
+
+	if(fclose(file) != 0)
+	{
+		written = false;
+	}
+
+	if(written)
+	{
+		remove(name.c_str());
+		written = (rename(temp.c_str(),name.c_str()) == 0);
+	}
+
+	if(!written)
+	{
+		gLogger->logMsgF("CurrentResource::_saveDistribution: could not write %s",MSG_LOW,name.c_str());
+		remove(temp.c_str());
 	}
 }
 
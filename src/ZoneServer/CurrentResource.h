@@ -17,9 +17,22 @@ Copyright (c) 2006 - 2010 The swgANH Team
 #include "ZoneServer/noiseutils.h"
 #include <noise.h>
 #include <string>
+#include <vector>
 
+namespace boost
+{
+	namespace interprocess
+	{
+		class mapped_region;
+	}
+}
 
 //=============================================================================
+//
+// the distribution map is kept as a quantized grid, it is cached on disk under a hash of its noise settings,
+// so a later boot maps the file instead of building the noise again
+// buildDistributionMap only touches its own resource and may run as a job
+//
 
 class CurrentResource : public Resource
 {
@@ -32,12 +45,27 @@ class CurrentResource : public Resource
 
 		void	buildDistributionMap();
 
+		// renders the map into <ZoneName>_<resource>.bmp
+		void	writeDistributionMap();
+
 		float	getDistribution(int x,int z);
 
+		// where the cached maps are kept, a prefix for their file names, the zone id keeps zones sharing it apart
+		static void	setDistributionCachePath(const std::string& path,uint32 zoneId){ mDistributionCachePath = path; mDistributionCacheZone = zoneId; }
+
+		// deletes the cached maps of this zone none of its current resources uses anymore
+		static void	pruneDistributionCache(std::vector<CurrentResource*>& resources);
+
 	private:
 
 		void	_verifyNoiseSettings();
 
+		uint64	_getDistributionKey();
+		std::string	_getDistributionFileName(uint64 key) const;
+		bool	_mapDistribution(uint64 key);
+		void	_quantizeDistribution(const noise::utils::NoiseMap& noiseMap);
+		void	_saveDistribution(uint64 key);
+
 		double	mNoiseMapBoundsX1,mNoiseMapBoundsX2;
 		double	mNoiseMapBoundsY1,mNoiseMapBoundsY2;
 		uint8	mNoiseMapOctaves;
@@ -49,7 +77,16 @@ class CurrentResource : public Resource
 		uint64	mUnitsLeft;
 
 		noise::module::Perlin	mNoiseModule;
-		noise::utils::NoiseMap	mResourceDistributionMap;
+
+		// DistributionMapSize * DistributionMapSize values, a value is mDistributionMin + mDistributionStep * sample
+		const uint16*						mDistribution;
+		float								mDistributionMin;
+		float								mDistributionStep;
+		boost::interprocess::mapped_region*	mDistributionRegion;
+		std::vector<uint16>					mDistributionBuffer;	// holds the samples of a map that isnt mapped
+
+		static std::string					mDistributionCachePath;
+		static uint32						mDistributionCacheZone;
 };
 
 #endif
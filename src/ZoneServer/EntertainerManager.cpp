@@ -2692,7 +2692,7 @@ void EntertainerManager::flourish(PlayerObject* entertainer, uint32 mFlourishId)
 
 void EntertainerManager::entertainInRangeNPCs(PlayerObject* entertainer)
 {
-	ObjectSet::iterator it = entertainer->getKnownObjects()->begin();
+	KnownObjectSet::iterator it = entertainer->getKnownObjects()->begin();
 
 	while(it != entertainer->getKnownObjects()->end())
 	{
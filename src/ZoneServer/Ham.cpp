@@ -510,134 +510,6 @@ void Ham::updateSingleHam(int32 propertyDelta, bool damage)
 
 
 
-//===========================================================================
-
-bool Ham::regenerate(uint64 time,void*)
-{
-	bool healthRegened	= true;
-	bool actionRegened	= true;
-	bool mindRegened	= true;
-	bool forceRegened	= true;
-
-	if(mHealth.getCurrentHitPoints() < mHealth.getModifiedHitPoints())
-	{
-		healthRegened = _regenHealth();
-		gMessageLib->sendCurrentHitpointDeltasCreo6_Single(mParent,HamBar_Health);
-	}
-
-	if(mAction.getCurrentHitPoints() < mAction.getModifiedHitPoints())
-	{
-
-		//returns true if regeneration complete
-		actionRegened = _regenAction();
-
-		gMessageLib->sendCurrentHitpointDeltasCreo6_Single(mParent,HamBar_Action);
-	}
-
-	if(mMind.getCurrentHitPoints() < mMind.getModifiedHitPoints())
-	{
-		mindRegened = _regenMind();
-		gMessageLib->sendCurrentHitpointDeltasCreo6_Single(mParent,HamBar_Mind);
-	}
-
-	if(mCurrentForce < mMaxForce)
-	{
-		forceRegened = _regenForce();
-
-		if(PlayerObject* player = dynamic_cast<PlayerObject*>(mParent))
-		{
-			gMessageLib->sendUpdateCurrentForce(player);
-		}
-	}
-
-	if(!healthRegened || !actionRegened || !mindRegened || !forceRegened)
-	{
-		return(true);
-	}
-	else
-	{
-		mTaskId = 0;
-		return(false);
-	}
-}
-
-//===========================================================================
-//
-// checks whether the hambar is completely regenerated
-// returns true in case the regeneration is complete
-//
-
-bool Ham::_regenHealth()
-{
-	mHealth.updateCurrentHitpoints(mHealthRegenRate);
-
-	if(mHealth.getCurrentHitPoints() >= mHealth.getModifiedHitPoints())
-	{
-		mHealth.setCurrentHitPoints(mHealth.getModifiedHitPoints());
-
-		return(true);
-	}
-	return(false);
-}
-
-//===========================================================================
-//
-// checks whether the hambar is completely regenerated
-// returns true in case the regeneration is complete
-//
-
-bool Ham::_regenAction()
-{
-	mAction.updateCurrentHitpoints(mActionRegenRate);
-
-	if(mAction.getCurrentHitPoints() >= mAction.getModifiedHitPoints())
-	{
-		mAction.setCurrentHitPoints(mAction.getModifiedHitPoints());
-
-		return(true);
-	}
-	return(false);
-}
-
-//===========================================================================
-//
-// checks whether the hambar is ompletely regenerated
-// returns true in case the regeneration is complete
-//
-
-bool Ham::_regenMind()
-{
-	mMind.updateCurrentHitpoints(mMindRegenRate);
-
-	if(mMind.getCurrentHitPoints() >= mMind.getModifiedHitPoints())
-	{
-		mMind.setCurrentHitPoints(mMind.getModifiedHitPoints());
-
-		return(true);
-	}
-	return(false);
-}
-
-//===========================================================================
-//
-// regen force
-//
-
-bool Ham::_regenForce()
-{
-	mCurrentForce += mForceRegenRate;
-
-	if(mCurrentForce >= mMaxForce)
-	{
-		mCurrentForce = mMaxForce;
-
-		return(true);
-	}
-
-	return(false);
-}
-
-
 //===========================================================================
 //
 // FIXME
@@ -795,4 +667,9 @@ int32			Ham::getActionRegenRate()
 int32			Ham::getMindRegenRate()
 {
 	return mMindRegenRate;
+}
+
+int32			Ham::getForceRegenRate()
+{
+	return mForceRegenRate;
 }
\ No newline at end of file
@@ -97,7 +97,6 @@ class Ham
 
 		void			calcAllModifiedHitPoints();
 
-		bool			regenerate(uint64 time,void*);
 		uint64			getLastRegenTick(){ return mLastRegenTick; }
 		void			setLastRegenTick(uint64 time){ mLastRegenTick = time; }
 
@@ -106,7 +105,9 @@ class Ham
 		int32			getHealthRegenRate();
 		int32			getActionRegenRate();
 		int32			getMindRegenRate();
+		int32			getForceRegenRate();
 
+		// id in the ham regeneration engine, 0 while not regenerating
 		uint64			getTaskId(){ return mTaskId; }
 		void			setTaskId(uint64 id){ mTaskId = id; }
 
@@ -136,11 +137,6 @@ class Ham
 
 	private:
 
-		bool			_regenHealth();
-		bool			_regenAction();
-		bool			_regenMind();
-		bool			_regenForce();
-
 		CreatureObject*	mParent;
 
 		uint64			mLastRegenTick;
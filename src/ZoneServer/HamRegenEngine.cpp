@@ -0,0 +1,303 @@
+/*
+---------------------------------------------------------------------------------------
+This source file is part of swgANH (Star Wars Galaxies - A New Hope - Server Emulator)
+For more information, see http://www.swganh.org
+
+
+Copyright (c) 2006 - 2010 The swgANH Team
+
+---------------------------------------------------------------------------------------
+*/
+
+#include "HamRegenEngine.h"
+#include "CreatureObject.h"
+#include "Ham.h"
+#include "PlayerObject.h"
+#include "MessageLib/MessageLib.h"
+#include "Utils/SchedulerStats.h"
+
+//=============================================================================
+
+static const uint32 NoEntry = 0xffffffff;
+
+//=============================================================================
+
+HamRegenEngine::HamRegenEngine(uint64 tickInterval) :
+mStats(NULL),
+mTickInterval(tickInterval),
+mLastTick(0)
+{
+}
+
+//=============================================================================
+
+HamRegenEngine::~HamRegenEngine()
+{
+	delete(mStats);
+}
+
+//=============================================================================
+
+void HamRegenEngine::enableStats(const std::string& name)
+{
+	if(!mStats)
+	{
+		mStats = new Anh_Utils::SchedulerStats(name);
+	}
+}
+
+//=============================================================================
+
+uint64 HamRegenEngine::add(Ham* ham)
+{
+	uint32 slot;
+
+	if(mFreeSlots.empty())
+	{
+		slot = static_cast<uint32>(mSlotIndex.size());
+
+		mSlotIndex.push_back(NoEntry);
+		mSlotUses.push_back(0);
+	}
+	else
+	{
+		slot = mFreeSlots.back();
+		mFreeSlots.pop_back();
+	}
+
+	mSlotIndex[slot] = static_cast<uint32>(mHams.size());
+
+	mHams.push_back(ham);
+	mSlots.push_back(slot);
+
+	return((static_cast<uint64>(++mSlotUses[slot]) << 32) | (slot + 1));
+}
+
+//=============================================================================
+
+void HamRegenEngine::remove(uint64 id)
+{
+	if(!contains(id))
+	{
+		return;
+	}
+
+	_removeAt(mSlotIndex[static_cast<uint32>(id & 0xffffffff) - 1]);
+}
+
+//=============================================================================
+
+bool HamRegenEngine::contains(uint64 id) const
+{
+	uint32 slot = static_cast<uint32>(id & 0xffffffff);
+
+	return(slot && slot <= mSlotIndex.size() && mSlotIndex[slot - 1] != NoEntry && mSlotUses[slot - 1] == static_cast<uint32>(id >> 32));
+}
+
+//=============================================================================
+
+void HamRegenEngine::_removeAt(uint32 index)
+{
+	uint32 last = static_cast<uint32>(mHams.size() - 1);
+	uint32 slot = mSlots[index];
+
+	if(index != last)
+	{
+		mHams[index]	= mHams[last];
+		mSlots[index]	= mSlots[last];
+
+		mSlotIndex[mSlots[index]] = index;
+	}
+
+	mHams.pop_back();
+	mSlots.pop_back();
+
+	mSlotIndex[slot] = NoEntry;
+	mFreeSlots.push_back(slot);
+}
+
+//=============================================================================
+
+void HamRegenEngine::process(uint64 currentTime)
+{
+	if(!mLastTick)
+	{
+		mLastTick = currentTime;
+		return;
+	}
+
+	if(currentTime - mLastTick < mTickInterval)
+	{
+		return;
+	}
+
+	uint64 lateness		= currentTime - mLastTick - mTickInterval;
+	uint64 startTime	= mStats ? Anh_Utils::SchedulerStats::getMicroTime() : 0;
+
+	mLastTick = currentTime;
+
+	if(!mHams.empty())
+	{
+		_tick();
+	}
+
+	if(mStats)
+	{
+		uint64 runTime = Anh_Utils::SchedulerStats::getMicroTime() - startTime;
+
+		mStats->recordCall("HamRegenEngine::tick",runTime,lateness);
+		mStats->recordPass(runTime / 1000,0);
+	}
+}
+
+//=============================================================================
+
+void HamRegenEngine::_tick()
+{
+	uint32 count = static_cast<uint32>(mHams.size());
+
+	for(uint32 pool = 0; pool < Pools; pool++)
+	{
+		mCurrent[pool].resize(count);
+		mMax[pool].resize(count);
+		mRate[pool].resize(count);
+	}
+
+	mChanged.resize(count);
+	mFull.resize(count);
+
+	_gather();
+	_advance();
+	_scatter();
+
+	// backwards, so the entry swapped into a freed place was already looked at
+	for(uint32 i = count; i-- > 0;)
+	{
+		if(mFull[i])
+		{
+			Ham* ham = mHams[i];
+
+			_removeAt(i);
+			ham->setTaskId(0);
+		}
+	}
+}
+
+//=============================================================================
+
+void HamRegenEngine::_gather()
+{
+	for(uint32 i = 0; i < mHams.size(); i++)
+	{
+		Ham* ham = mHams[i];
+
+		mCurrent[Pool_Health][i]	= ham->mHealth.getCurrentHitPoints();
+		mMax[Pool_Health][i]		= ham->mHealth.getModifiedHitPoints();
+		mRate[Pool_Health][i]		= ham->getHealthRegenRate();
+
+		mCurrent[Pool_Action][i]	= ham->mAction.getCurrentHitPoints();
+		mMax[Pool_Action][i]		= ham->mAction.getModifiedHitPoints();
+		mRate[Pool_Action][i]		= ham->getActionRegenRate();
+
+		mCurrent[Pool_Mind][i]		= ham->mMind.getCurrentHitPoints();
+		mMax[Pool_Mind][i]			= ham->mMind.getModifiedHitPoints();
+		mRate[Pool_Mind][i]			= ham->getMindRegenRate();
+
+		mCurrent[Pool_Force][i]		= ham->getCurrentForce();
+		mMax[Pool_Force][i]			= ham->getMaxForce();
+		mRate[Pool_Force][i]		= ham->getForceRegenRate();
+	}
+}
+
+//=============================================================================
+//
+// a pool below its maximum gains its rate and stops at the maximum, a full one stays as it is
+//
+
+void HamRegenEngine::_advance()
+{
+	uint32 count = static_cast<uint32>(mHams.size());
+
+	for(uint32 i = 0; i < count; i++)
+	{
+		mChanged[i]	= 0;
+		mFull[i]	= 1;
+	}
+
+	for(uint32 pool = 0; pool < Pools; pool++)
+	{
+		int32*	current	= &mCurrent[pool][0];
+		int32*	maximum	= &mMax[pool][0];
+		int32*	rate	= &mRate[pool][0];
+		uint8*	changed	= &mChanged[0];
+		uint8*	full	= &mFull[0];
+		uint8	bit		= static_cast<uint8>(1 << pool);
+
+		for(uint32 i = 0; i < count; i++)
+		{
+			int32 room	= maximum[i] - current[i];
+			int32 step	= (rate[i] < room) ? rate[i] : room;
+
+			step		= (step > 0) ? step : 0;
+
+			changed[i]	|= step ? bit : 0;
+			current[i]	+= step;
+			full[i]		&= (current[i] >= maximum[i]) ? 1 : 0;
+		}
+	}
+}
+
+//=============================================================================
+
+void HamRegenEngine::_scatter()
+{
+	for(uint32 i = 0; i < mHams.size(); i++)
+	{
+		uint8 changed = mChanged[i];
+
+		if(!changed)
+		{
+			continue;
+		}
+
+		Ham*			ham		= mHams[i];
+		CreatureObject*	parent	= ham->getParent();
+		uint16			bars	= 0;
+
+		if(changed & (1 << Pool_Health))
+		{
+			ham->mHealth.setCurrentHitPoints(mCurrent[Pool_Health][i]);
+			bars |= 1 << HamBar_Health;
+		}
+
+		if(changed & (1 << Pool_Action))
+		{
+			ham->mAction.setCurrentHitPoints(mCurrent[Pool_Action][i]);
+			bars |= 1 << HamBar_Action;
+		}
+
+		if(changed & (1 << Pool_Mind))
+		{
+			ham->mMind.setCurrentHitPoints(mCurrent[Pool_Mind][i]);
+			bars |= 1 << HamBar_Mind;
+		}
+
+		if(bars)
+		{
+			gMessageLib->sendCurrentHitpointDeltasCreo6_Bars(parent,bars);
+		}
+
+		if(changed & (1 << Pool_Force))
+		{
+			ham->setCurrentForce(mCurrent[Pool_Force][i]);
+
+			if(PlayerObject* player = dynamic_cast<PlayerObject*>(parent))
+			{
+				gMessageLib->sendUpdateCurrentForce(player);
+			}
+		}
+	}
+}
+
+//=============================================================================
+
@@ -0,0 +1,98 @@
+/*
+---------------------------------------------------------------------------------------
+This source file is part of swgANH (Star Wars Galaxies - A New Hope - Server Emulator)
+For more information, see http://www.swganh.org
+
+
+Copyright (c) 2006 - 2010 The swgANH Team
+
+---------------------------------------------------------------------------------------
+*/
+
+#ifndef ANH_ZONESERVER_HAMREGENENGINE_H
+#define ANH_ZONESERVER_HAMREGENENGINE_H
+
+#include "Utils/typedefs.h"
+#include <string>
+#include <vector>
+
+//=============================================================================
+
+class Ham;
+
+namespace Anh_Utils
+{
+	class SchedulerStats;
+}
+
+//=============================================================================
+//
+// regenerates the hams of all creatures below their maximum in one pass per tick
+//
+// the pools of every regenerating ham are gathered into plain arrays, one per pool and value,
+// advanced together in a loop the compiler can vectorize and written back where they changed
+// combat, heals and buffs change the hams directly, so the pools are gathered again every tick
+// a creature gets one deltas message for the bars that changed, a ham leaves once all its pools are full
+// the ids follow the scheduler task ids, the ham keeps its id as task id
+//
+
+class HamRegenEngine
+{
+	public:
+
+		HamRegenEngine(uint64 tickInterval = 1000);
+		~HamRegenEngine();
+
+		uint64		add(Ham* ham);
+		void		remove(uint64 id);
+		bool		contains(uint64 id) const;
+
+		// runs a tick once the interval has passed since the last one
+		void		process(uint64 currentTime);
+
+		uint32		size() const { return static_cast<uint32>(mHams.size()); }
+
+		// optional runtime figures, reported like a schedulers
+		void						enableStats(const std::string& name);
+		Anh_Utils::SchedulerStats*	getStats() const { return mStats; }
+
+	private:
+
+		enum
+		{
+			Pool_Health	= 0,
+			Pool_Action	= 1,
+			Pool_Mind	= 2,
+			Pool_Force	= 3,
+			Pools		= 4
+		};
+
+		void		_tick();
+		void		_gather();
+		void		_advance();
+		void		_scatter();
+		void		_removeAt(uint32 index);
+
+		// one entry per regenerating ham, swapped with the last when removed
+		std::vector<Ham*>		mHams;
+		std::vector<uint32>		mSlots;
+		std::vector<int32>		mCurrent[Pools];
+		std::vector<int32>		mMax[Pools];
+		std::vector<int32>		mRate[Pools];
+		std::vector<uint8>		mChanged;			// a bit per pool
+		std::vector<uint8>		mFull;
+
+		// slot lookup of the ids, reuse counts keep stale ids from matching
+		std::vector<uint32>		mSlotIndex;
+		std::vector<uint32>		mSlotUses;
+		std::vector<uint32>		mFreeSlots;
+
+		Anh_Utils::SchedulerStats*	mStats;
+		uint64					mTickInterval;
+		uint64					mLastTick;
+};
+
+//=============================================================================
+
+#endif
+
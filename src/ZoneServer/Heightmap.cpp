@@ -12,26 +12,42 @@ Copyright (c) 2006 - 2010 The swgANH Team
 #include "ZoneServer/WorldManager.h"
 #include "LogManager/LogManager.h"
 #include "Utils/utils.h"
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <algorithm>
 #include <cassert>
 #include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <sys/stat.h>
+
+//=============================================================================
+
+static bool isLittleEndian()
+{
+	uint16 probe = 1;
+
+	return(*reinterpret_cast<uint8*>(&probe) == 1);
+}
 
 //=============================================================================
 Heightmap::Heightmap(const char* planet_name)
-: mHeightmapCache(NULL)
+: mCache(NULL)
 , mCacheHeight(0)
 , mCacheWidth(0)
 , mCacheResoulutionDivider(3)
+, mCacheFile(NULL)
+, mCacheRegion(NULL)
+, mFile(NULL)
+, mRegion(NULL)
+, mHeights(NULL)
+, hmp(NULL)
 , WIDTH(15361)
 , HEIGHT(15361)
 {
 	mFilename = planet_name;
 	mFilename += ".hmpw";
 	Connect();
-
-	boost::thread t(std::tr1::bind(&Heightmap::RunThread, this));
-	mThread = boost::move(t);
-
-	mExit = false;
 }
 
 // Never used
@@ -43,25 +59,20 @@ Heightmap::Heightmap()
 
 Heightmap::~Heightmap()
 {
+	mHeights = NULL;
 
-	mExit = true;
-
-	mThread.interrupt();
-    mThread.join();
+	delete(mRegion);
+	delete(mFile);
 
-	if(Open())
+	if(hmp)
 	{
 		fclose(hmp);
 	}
-	if (mHeightmapCache)
-	{
-		for (int i = 0; i < mCacheHeight; i++)
-		{
-			delete [] mHeightmapCache[i];
-		}
-		delete [] mHeightmapCache;
-		mHeightmapCache = NULL;
-	}
+
+	mCache = NULL;
+
+	delete(mCacheRegion);
+	delete(mCacheFile);
 
 	mInstance = NULL;
 }
@@ -90,20 +101,10 @@ Heightmap* Heightmap::Instance(void)
 
 void Heightmap::fillInIterator(HeightResultMap::iterator it)
 {
-	if(!Open())
-	{
-		Connect();
-		if(!Open())
-		{
-			gLogger->logMsg("Heightmap::ERROR: Unable to retrieve height. A connection to the zone heightmap was not established!",FOREGROUND_RED);
-			return;
-		}
-	}
+	uint16 height;
 
-	short height;
-	fseek(hmp,getOffset(it->first.first,it->first.second),SEEK_SET);
-	size_t result = fread(&height,2,1,hmp);
-	if (! result) {
+	if(!_getSample(it->first.first,it->first.second,height))
+	{
 		gLogger->logMsg("Heightmap::ERROR: Unable to read height!",FOREGROUND_RED);
 		return;
 	}
@@ -121,39 +122,27 @@ void Heightmap::fillInIterator(HeightResultMap::iterator it)
 	it->second = heightRes;
 }
 
+//=============================================================================
+//
+//	the heights are at hand, so the job is done before this returns
+//
 
-void Heightmap::RunThread()
+void Heightmap::addNewHeightMapJob(HeightmapAsyncContainer* container)
 {
-	while(!mExit)
-	{
-		mJobMutex.lock();
-
-		HeightmapAsyncContainer* job;
-		if(Jobs.size() != 0)
-		{
-			 job = Jobs.front();
-			Jobs.pop();
-		}
-		else
-			job = NULL;
-
-		mJobMutex.unlock();
+	HeightResultMap* map = container->getResults();
 
-		if(job)
-		{
-			HeightResultMap* map = job->getResults();
-			for(HeightResultMap::iterator it=map->begin(); it != map->end(); it++)
-				fillInIterator(it);
+	for(HeightResultMap::iterator it = map->begin(); it != map->end(); it++)
+	{
+		fillInIterator(it);
+	}
 
-			job->getCallback()->heightMapCallback(job);
-		}
-		else
-		{
-			//We sleep if there is no work!
-			boost::this_thread::sleep(boost::posix_time::milliseconds(20));
-		}
+	if(container->hasFootprint())
+	{
+		getFootprint(container->getFootprintX(),container->getFootprintZ(),container->getFootprintHalfWidth(),
+					 container->getFootprintHalfLength(),1.0f,*container->getFootprint());
 	}
-	gLogger->logMsg("HeightMap Thread Down!");
+
+	container->getCallback()->heightMapCallback(container);
 }
 
 
@@ -194,13 +183,9 @@ bool Heightmap::getRow(unsigned char* buffer, int32 x, int32 z, int32 length)
 
 	if(!Open())
 	{
-		Connect();
-		if(!Open())
-		{
-			gLogger->logMsg("Heightmap::ERROR: Unable to retrieve height data.",FOREGROUND_RED);
-			assert(false && "Heightmap::getRow Missing heightmap, download at http://www.swganh.com/!!planets!!/PLANET_NAME.rar");
-			return false;
-		}
+		gLogger->logMsg("Heightmap::ERROR: Unable to retrieve height data.",FOREGROUND_RED);
+		assert(false && "Heightmap::getRow Missing heightmap, download at http://www.swganh.com/!!planets!!/PLANET_NAME.rar");
+		return false;
 	}
 	int32 startOffset = 2 * (((HEIGHT/2 - z) * WIDTH) + (x + WIDTH/2));
 	// gLogger->logMsgF("startOffset = %d", MSG_NORMAL, startOffset);
@@ -220,19 +205,47 @@ bool Heightmap::getRow(unsigned char* buffer, int32 x, int32 z, int32 length)
 		assert(false);
 	}
 
-	if (fseek(hmp,startOffset,SEEK_SET) != 0)
+	if (mHeights)
+	{
+		memcpy(buffer,mHeights + startOffset/2,len);
+		return true;
+	}
+
+	boost::mutex::scoped_lock lock(mFileMutex);
+
+	if (!_readRaw(buffer,startOffset,len))
+	{
+		return false;
+	}
+
+	// the file is little endian
+	uint16* samples = reinterpret_cast<uint16*>(buffer);
+
+	for (int32 i = 0; i < length; i++)
+	{
+		samples[i] = static_cast<uint16>(buffer[2 * i] | (buffer[2 * i + 1] << 8));
+	}
+	return true;
+}
+
+//=============================================================================
+//
+//	reads bytes from the file as they are, the caller holds the file mutex
+//
+
+bool Heightmap::_readRaw(unsigned char* buffer, int32 offset, int32 length)
+{
+	if (fseek(hmp,offset,SEEK_SET) != 0)
 	{
 		gLogger->logMsg("Heightmap::ERROR: File seek error",FOREGROUND_RED);
-		assert(false);
 		return false;
 	}
 
-	int32 bytesRead = fread(buffer,1, len, hmp);
-	if (bytesRead != len)
+	int32 bytesRead = fread(buffer,1, length, hmp);
+	if (bytesRead != length)
 	{
 		gLogger->logMsg("Heightmap::ERROR: File read error",FOREGROUND_RED);
 		gLogger->logMsgF("bytesRead = %d", MSG_NORMAL, bytesRead);
-		assert(false);
 		return false;
 	}
 	return true;
@@ -243,7 +256,7 @@ bool Heightmap::getRow(unsigned char* buffer, int32 x, int32 z, int32 length)
 
 void Heightmap::Connect(void)
 {
-	hmp = fopen(mFilename.c_str(),"r+b");
+	hmp = fopen(mFilename.c_str(),"rb");
 	if(!hmp)
 	{
 		gLogger->logMsgLoadFailure("Heightmap::Heightmap not found [ %s ], exiting...",MSG_HIGH,mFilename.c_str());
@@ -252,18 +265,150 @@ void Heightmap::Connect(void)
 	else
 	{
 		gLogger->logMsgLoadSuccess("Heightmap::Heightmap succesfully opened...",MSG_NORMAL);
+
+		if(!_map())
+		{
+			gLogger->logMsgF("Heightmap::Connect: reading %s through a tile cache",MSG_NORMAL,mFilename.c_str());
+		}
 	}
   return;
 }
 
 //=============================================================================
 //
+//	the samples can be used right from the mapping on a little endian host
+//
+
+bool Heightmap::_map()
+{
+	if(!isLittleEndian())
+	{
+		return false;
+	}
+
+	try
+	{
+		mFile	= new boost::interprocess::file_mapping(mFilename.c_str(),boost::interprocess::read_only);
+		mRegion	= new boost::interprocess::mapped_region(*mFile,boost::interprocess::read_only);
+	}
+	catch(...)
+	{
+		gLogger->logMsgF("Heightmap::_map: could not map %s",MSG_NORMAL,mFilename.c_str());
+
+		delete(mRegion);
+		delete(mFile);
+		mRegion	= NULL;
+		mFile	= NULL;
+
+		return false;
+	}
+
+	if(mRegion->get_size() < static_cast<size_t>(2 * WIDTH) * HEIGHT)
+	{
+		gLogger->logMsgF("Heightmap::_map: %s is too small",MSG_NORMAL,mFilename.c_str());
+
+		delete(mRegion);
+		delete(mFile);
+		mRegion	= NULL;
+		mFile	= NULL;
+
+		return false;
+	}
+
+	mHeights = static_cast<const uint16*>(mRegion->get_address());
+
+	return true;
+}
+
+//=============================================================================
+//
+
+bool Heightmap::_getSample(float x, float y, uint16& sample)
+{
+	return _getRawSample(round_coord(x) + (WIDTH>>1),(HEIGHT>>1) - round_coord(y),sample);
+}
+
+//=============================================================================
+//
+
+bool Heightmap::_getRawSample(int32 column, int32 row, uint16& sample)
+{
+	if(column < 0 || column >= WIDTH || row < 0 || row >= HEIGHT)
+	{
+		return false;
+	}
+
+	if(mHeights)
+	{
+		sample = mHeights[row * WIDTH + column];
+		return true;
+	}
+
+	if(!hmp)
+	{
+		return false;
+	}
+
+	sample = _getTiledSample(column,row);
+	return true;
+}
+
+//=============================================================================
+//
+//	looks the sample up in its tile, a missing tile is read from the file and replaces the least recently used
+//
 
-unsigned long Heightmap::getOffset(float x, float y) const
+uint16 Heightmap::_getTiledSample(int32 column, int32 row)
 {
-	unsigned int x_trans = round_coord(x) + (WIDTH>>1);
-	unsigned int y_trans = (HEIGHT>>1) - round_coord(y);
-	return (y_trans*WIDTH + x_trans)<<1;
+	boost::mutex::scoped_lock lock(mFileMutex);
+
+	int32	tileX	= column / TileSize;
+	int32	tileZ	= row / TileSize;
+	uint32	key		= static_cast<uint32>(tileZ * ((WIDTH + TileSize - 1) / TileSize) + tileX);
+	int32	index	= (row % TileSize) * TileSize + (column % TileSize);
+
+	TileMap::iterator it = mTiles.find(key);
+
+	if(it != mTiles.end())
+	{
+		mTileOrder.splice(mTileOrder.begin(),mTileOrder,(*it).second.first);
+		return (*it).second.second[index];
+	}
+
+	if(mTiles.size() >= MaxTiles)
+	{
+		mTiles.erase(mTileOrder.back());
+		mTileOrder.pop_back();
+	}
+
+	mTileOrder.push_front(key);
+
+	Tile& tile = mTiles[key];
+
+	tile.first = mTileOrder.begin();
+	tile.second.assign(TileSize * TileSize,0);
+
+	int32 firstColumn	= tileX * TileSize;
+	int32 width			= (WIDTH - firstColumn < TileSize) ? WIDTH - firstColumn : TileSize;
+
+	for(int32 r = 0; r < TileSize && tileZ * TileSize + r < HEIGHT; r++)
+	{
+		uint16*			samples	= &tile.second[r * TileSize];
+		unsigned char*	bytes	= reinterpret_cast<unsigned char*>(samples);
+
+		if(!_readRaw(bytes,2 * ((tileZ * TileSize + r) * WIDTH + firstColumn),2 * width))
+		{
+			break;
+		}
+
+		// the file is little endian
+		for(int32 c = 0; c < width; c++)
+		{
+			samples[c] = static_cast<uint16>(bytes[2 * c] | (bytes[2 * c + 1] << 8));
+		}
+	}
+
+	return tile.second[index];
 }
 
 //=============================================================================
@@ -275,32 +420,52 @@ int32 Heightmap::round_coord(float coord) const
 }
 
 
+//=============================================================================
+//
+//	the cache keeps the samples as the 15 bit signed heights in 1/20 meter they are,
+//	every resolution divider is stored in a pyramid file next to the .hmpw,
+//	so a zone maps the level it needs instead of reading the whole heightmap on boot
+//
+
 static const int32 heightMapHeight = 15361;
 static const int32 heightMapWidth = 15361;
 
-bool Heightmap::setupCache(int16 cacheResoulutionDivider)
+static const char	PyramidMagic[4]	= {'H','M','P','C'};
+static const uint32	PyramidVersion	= 1;
+static const uint32	PyramidLevels	= 3;		// a level per resolution divider
+static const uint32	PyramidAlign	= 4096;
+
+struct PyramidHeader
 {
+	char	mMagic[4];
+	uint32	mVersion;
+	uint32	mWidth;
+	uint32	mHeight;
+	uint64	mSourceSize;		// the .hmpw it was built from
+	uint64	mSourceTime;
+	uint64	mOffsets[PyramidLevels];
+};
+
+static inline int32 levelWidth(int32 divider) { return ((heightMapWidth - 1)/divider) + 1; }
+static inline int32 levelHeight(int32 divider) { return ((heightMapHeight - 1)/divider) + 1; }
 
-	bool status = false;
+// drops the water bit and keeps the sign of the 15 bit height
+static inline int16 quantizeSample(uint16 sample) { return (int16)((sample & 0x7FFF) << 1); }
 
-	// for test
-	float min = FLT_MAX;
-	float max = FLT_MIN;
-	int32 xPosMin = 0;
-	int32 zPosMin = 0;
-	int32 xPosMax = 0;
-	int32 zPosMax = 0;
+//=============================================================================
 
+bool Heightmap::setupCache(int16 cacheResoulutionDivider)
+{
 	if (mCacheAvaliable)
 	{
 		assert (false && "Heightmap::setupCache cache already setup");		// Should only be initialized once
-		return status;
+		return false;
 	}
-	if ((cacheResoulutionDivider < 0) || (cacheResoulutionDivider > 3))
+	if ((cacheResoulutionDivider < 0) || (cacheResoulutionDivider > (int16)PyramidLevels))
 	{
 		// Invalid input.
 		assert(false && "Heightmap::setupCache invalid input");
-		return status;
+		return false;
 	}
 
 	if (cacheResoulutionDivider == 0)
@@ -309,140 +474,255 @@ bool Heightmap::setupCache(int16 cacheResoulutionDivider)
 		return true;
 	}
 
+	if (!Open())
+	{
+		// Not all zones support heightmaps
+		return false;
+	}
+
 	mCacheResoulutionDivider = cacheResoulutionDivider;
 
-	mCacheHeight = ((heightMapHeight - 1)/mCacheResoulutionDivider) + 1;
-	mCacheWidth = ((heightMapWidth -1)/mCacheResoulutionDivider) + 1;
+	mCacheHeight = levelHeight(mCacheResoulutionDivider);
+	mCacheWidth = levelWidth(mCacheResoulutionDivider);
+
+	if (_mapPyramid())
+	{
+		gLogger->logMsgF("Heightmap::setupCache mapped a %d * %d heightmap cache from %s", MSG_NORMAL, mCacheHeight, mCacheWidth, _getPyramidName().c_str());
+	}
+	else if (_buildPyramid() && _mapPyramid())
+	{
+		gLogger->logMsgF("Heightmap::setupCache built %s, mapped a %d * %d heightmap cache", MSG_NORMAL, _getPyramidName().c_str(), mCacheHeight, mCacheWidth);
+	}
+	else if (_buildCache())
+	{
+		gLogger->logMsgF("Heightmap::setupCache created a %d * %d heightmap cache in memory", MSG_NORMAL, mCacheHeight, mCacheWidth);
+	}
+	else
+	{
+		return false;
+	}
+
+	mCacheAvaliable = true;
+	return true;
+}
 
-	// static int32 cacheHeight = 7681;
-	// static int32 cacheWidth = 7681;
+//=============================================================================
 
-	// Allocate memory for the heightmap.
-	mHeightmapCache = new float*[mCacheHeight];
-	if (!mHeightmapCache)
+std::string Heightmap::_getPyramidName() const
+{
+	std::string name = mFilename;
+	std::string::size_type dot = name.rfind('.');
+
+	if (dot != std::string::npos)
+	{
+		name.erase(dot);
+	}
+
+	return name + ".hmpc";
+}
+
+//=============================================================================
+//
+//	a pyramid built from another .hmpw is stale
+//
+
+bool Heightmap::_getSourceStamp(uint64& size, uint64& time) const
+{
+	struct stat info;
+
+	if (stat(mFilename.c_str(),&info) != 0)
 	{
-		assert (mHeightmapCache != NULL && "Heightmap::setupCache unable to allocate memory for heightmap");
 		return false;
 	}
 
-	for (int i = 0; i < mCacheWidth; i++)
+	size = (uint64)info.st_size;
+	time = (uint64)info.st_mtime;
+	return true;
+}
+
+//=============================================================================
+
+bool Heightmap::_mapPyramid()
+{
+	if (!isLittleEndian())
 	{
-		mHeightmapCache[i] = new float[mCacheWidth];
-		if (!mHeightmapCache[i])
-		{
-			return false;
-		}
+		return false;
+	}
+
+	std::string		name = _getPyramidName();
+	PyramidHeader	header;
+	struct stat		info;
+	uint64			sourceSize;
+	uint64			sourceTime;
+
+	FILE* file = fopen(name.c_str(),"rb");
+	if (!file)
+	{
+		return false;
+	}
+
+	bool read = (fread(&header,sizeof(header),1,file) == 1);
+	fclose(file);
+
+	uint32	level	= mCacheResoulutionDivider - 1;
+	uint64	bytes	= 2 * (uint64)mCacheWidth * mCacheHeight;
+
+	if (!read || memcmp(header.mMagic,PyramidMagic,sizeof(PyramidMagic)) != 0 || header.mVersion != PyramidVersion
+	|| header.mWidth != (uint32)heightMapWidth || header.mHeight != (uint32)heightMapHeight
+	|| !_getSourceStamp(sourceSize,sourceTime) || header.mSourceSize != sourceSize || header.mSourceTime != sourceTime
+	|| stat(name.c_str(),&info) != 0 || (uint64)info.st_size < header.mOffsets[level] + bytes)
+	{
+		gLogger->logMsgF("Heightmap::_mapPyramid: %s is stale, rebuilding it", MSG_NORMAL, name.c_str());
+		return false;
+	}
+
+	try
+	{
+		mCacheFile		= new boost::interprocess::file_mapping(name.c_str(),boost::interprocess::read_only);
+		mCacheRegion	= new boost::interprocess::mapped_region(*mCacheFile,boost::interprocess::read_only,header.mOffsets[level],(std::size_t)bytes);
+	}
+	catch(...)
+	{
+		gLogger->logMsgF("Heightmap::_mapPyramid: could not map %s", MSG_NORMAL, name.c_str());
+
+		delete(mCacheRegion);
+		delete(mCacheFile);
+		mCacheRegion	= NULL;
+		mCacheFile		= NULL;
+
+		return false;
+	}
+
+	mCache = static_cast<const int16*>(mCacheRegion->get_address());
+	return true;
+}
+
+//=============================================================================
+//
+//	reads the heightmap once and writes every level, southern row first,
+//	into a temporary file that replaces the pyramid when it is complete
+//
+
+bool Heightmap::_buildPyramid()
+{
+	if (!isLittleEndian())
+	{
+		return false;
+	}
+
+	PyramidHeader header;
+
+	memset(&header,0,sizeof(header));
+	memcpy(header.mMagic,PyramidMagic,sizeof(PyramidMagic));
+	header.mVersion	= PyramidVersion;
+	header.mWidth	= heightMapWidth;
+	header.mHeight	= heightMapHeight;
+
+	if (!_getSourceStamp(header.mSourceSize,header.mSourceTime))
+	{
+		return false;
+	}
+
+	uint64 offset = PyramidAlign;
+
+	for (uint32 level = 0; level < PyramidLevels; level++)
+	{
+		header.mOffsets[level] = offset;
+
+		offset += 2 * (uint64)levelWidth(level + 1) * levelHeight(level + 1);
+		offset = ((offset + PyramidAlign - 1) / PyramidAlign) * PyramidAlign;
 	}
 
-	// Allocate array for the temporarily data contained in one line.
-	uint16 *heightMapRow = NULL;
-	heightMapRow = new uint16[heightMapWidth];
-	if (!heightMapRow)
+	std::string name	= _getPyramidName();
+	std::string temp	= name + ".tmp";
+
+	gLogger->logMsgF("Heightmap::_buildPyramid: building %s", MSG_NORMAL, name.c_str());
+
+	FILE* file = fopen(temp.c_str(),"wb");
+	if (!file)
 	{
-		assert (heightMapRow != NULL && "Heightmap::setupCache unable to allocate memory for heightmap row");
+		gLogger->logMsgF("Heightmap::_buildPyramid: could not create %s", MSG_NORMAL, temp.c_str());
 		return false;
 	}
 
-	int32 zPos = 0;
-	int32 xPos = 0;
+	std::vector<uint16>	row(heightMapWidth);
+	std::vector<int16>	levelRow(heightMapWidth);
 
-	// int64 noOfIgnored = 0;
+	bool status = (fwrite(&header,sizeof(header),1,file) == 1);
 
-	// Let's read all height map data from file, and store some of it in memory.
-	// for (int32 heightMapLine = -(heightMapHeight/2); heightMapLine <= (heightMapHeight/2); heightMapLine += 2)
-	for (int32 heightMapLine = -(heightMapHeight/2); heightMapLine <= (heightMapHeight/2); heightMapLine += mCacheResoulutionDivider)
+	for (int32 line = 0; status && line < heightMapHeight; line++)
 	{
-		status = getRow((unsigned char *)heightMapRow, -(heightMapWidth/2), heightMapLine, heightMapWidth);
-		if (status)
+		status = getRow((unsigned char*)&row[0], -(heightMapWidth/2), line - (heightMapHeight/2), heightMapWidth);
+
+		for (uint32 level = 0; status && level < PyramidLevels; level++)
 		{
-			xPos = 0;
-			for (int i = 0; i < heightMapWidth; i += mCacheResoulutionDivider)
+			int32 divider	= level + 1;
+			int32 width		= levelWidth(divider);
+
+			if (line % divider)
 			{
-				if (heightMapRow[i] & 0x80000)
-				{
-					gLogger->logMsgF("Found water, at position %d, %d", MSG_NORMAL, (-heightMapWidth/2) + i, heightMapLine);
-				}
-
-				// Let's do this the right way, shall we? Pretend that we have a 15 bits signed value...
-
-				// Remove the water bit.
-				uint16 unsignedFix = (heightMapRow[i] & 0x7FFF);
-
-				// Shift all bits to the left.
-				unsignedFix = unsignedFix << 1;
-
-				// Now make the data signed.
-				int16 signedFix = (int16)unsignedFix;
-
-				// Convert it to float.
-				float value = (float)(signedFix);
-
-				// Normalize data.
-				value = value/20;
-
-				// if ((x != 0) && (x != heightMapWidth - 1) && (z != 0) && (z != heightMapHeight - 1))
-				{
-
-					// float value = (float)(heightMapRow[x] & 0x7FFF)/10;
-					if (value < min)
-					{
-						min = value;
-						xPosMin = (-heightMapWidth/2) + i;
-						zPosMin = heightMapLine;
-					}
-
-					/*
-					if (value < -135)
-					{
-						noOfIgnored++;
-						// Print all starange ones...
-						gLogger->logMsgF("Height = %.2f at position %d, %d", MSG_NORMAL, value, (-heightMapWidth/2) + x, heightMapLine);
-					}
-
-					if (value > 431)
-					{
-						noOfIgnored++;
-						// Print all starange ones...
-						gLogger->logMsgF("Height = %.2f at position %d, %d", MSG_NORMAL, value, (-heightMapWidth/2) + x, heightMapLine);
-					}
-					*/
-
-					if (value > max)
-					{
-						max = value;
-						xPosMax = (-heightMapWidth/2) + i;
-						zPosMax = heightMapLine;
-					}
-				}
-
-				mHeightmapCache[zPos][xPos] = value;
-				xPos++;
-				// heightMapCache[z][x/2] = (float)(heightMapRow[x] &= 0x7FFF)/10;
+				continue;
 			}
-			zPos++;
-		}
-		else
-		{
-			// Not all zones support heightmaps
-			// assert(false);
+
+			for (int32 column = 0; column < width; column++)
+			{
+				levelRow[column] = quantizeSample(row[column * divider]);
+			}
+
+			status = (fseek(file,(long)(header.mOffsets[level] + 2 * (uint64)(line / divider) * width),SEEK_SET) == 0)
+				  && (fwrite(&levelRow[0],2,width,file) == (size_t)width);
 		}
 	}
-	gLogger->logMsgF("Have created a %d * %d heighmap cache.", MSG_NORMAL, zPos, xPos);
 
-	delete [] heightMapRow;
-
-	mCacheAvaliable = status;
+	if (fclose(file) != 0)
+	{
+		status = false;
+	}
 
 	if (status)
 	{
-		gLogger->logMsgF("Min height = %.2f at position %d, %d", MSG_NORMAL, min, xPosMin, zPosMin);
-		gLogger->logMsgF("Max height = %.2f at position %d, %d", MSG_NORMAL, max, xPosMax, zPosMax);
-		// gLogger->logMsgF("noOfIgnored values are = %"PRIu64"", MSG_NORMAL, noOfIgnored);
+		remove(name.c_str());
+		status = (rename(temp.c_str(),name.c_str()) == 0);
+	}
 
+	if (!status)
+	{
+		gLogger->logMsgF("Heightmap::_buildPyramid: could not write %s", MSG_NORMAL, name.c_str());
+		remove(temp.c_str());
 	}
+
 	return status;
 }
 
+//=============================================================================
+//
+//	when there is no pyramid to map the level is read into memory, like the cache used to be
+//
+
+bool Heightmap::_buildCache()
+{
+	std::vector<uint16> row(heightMapWidth);
+
+	mCacheBuffer.resize((size_t)mCacheWidth * mCacheHeight);
+
+	for (int32 z = 0; z < mCacheHeight; z++)
+	{
+		if (!getRow((unsigned char*)&row[0], -(heightMapWidth/2), (z * mCacheResoulutionDivider) - (heightMapHeight/2), heightMapWidth))
+		{
+			std::vector<int16>().swap(mCacheBuffer);
+			return false;
+		}
+
+		for (int32 x = 0; x < mCacheWidth; x++)
+		{
+			mCacheBuffer[(size_t)z * mCacheWidth + x] = quantizeSample(row[x * mCacheResoulutionDivider]);
+		}
+	}
+
+	mCache = &mCacheBuffer[0];
+	return true;
+}
+
 //=============================================================================
 //
 //	Retrieve the height from the cache for a given 2D x,z position.
@@ -456,30 +736,197 @@ float Heightmap::getCachedHeightAt2DPosition(float xPos, float zPos) const
 		int32 x = round_coord(xPos) + (heightMapHeight/2);
 		int32 z = round_coord(zPos) + (heightMapWidth/2);
 
-		yPos = mHeightmapCache[z/mCacheResoulutionDivider][x/mCacheResoulutionDivider];
+		yPos = ((float)mCache[(z/mCacheResoulutionDivider) * mCacheWidth + (x/mCacheResoulutionDivider)])/20;
 	}
 	return yPos;
 }
 
 float Heightmap::getHeight(float x, float y)
 {
-	if(!Open())
+	uint16 height;
+
+	if(!_getSample(x,y,height))
 	{
-		Connect();
-		if(!Open())
+		gLogger->logMsg("Heightmap::ERROR: Unable to retrieve height. A connection to the zone heightmap was not established!",FOREGROUND_RED);
+		return FLT_MIN;
+	}
+
+	height &= 0x7FFF;
+	return ((float)height)/10;
+}
+
+//=============================================================================
+//
+//	gridX runs east from the western edge of the map, gridZ north from its southern edge
+//
+
+bool Heightmap::_getGridHeight(int32 gridX, int32 gridZ, float& height)
+{
+	if(mCacheAvaliable)
+	{
+		if(gridX < 0 || gridX >= mCacheWidth || gridZ < 0 || gridZ >= mCacheHeight)
 		{
-			gLogger->logMsg("Heightmap::ERROR: Unable to retrieve height. A connection to the zone heightmap was not established!",FOREGROUND_RED);
-			return FLT_MIN;
+			return false;
 		}
+
+		height = ((float)mCache[gridZ * mCacheWidth + gridX])/20;
+		return true;
 	}
 
-	short height;
-	fseek(hmp,getOffset(x,y),SEEK_SET);
-	size_t result = fread(&height,2,1,hmp);
-	if (! result) {
-		gLogger->logMsg("Heightmap::ERROR: Unable to read height!",FOREGROUND_RED);
-		return FLT_MIN;
+	uint16 sample;
+
+	if(!_getRawSample(gridX,(HEIGHT - 1) - gridZ,sample))
+	{
+		return false;
 	}
-	height &= 0x7FFF;
-	return ((float)height)/10;
-}
\ No newline at end of file
+
+	height = ((float)(sample & 0x7FFF))/10;
+	return true;
+}
+
+//=============================================================================
+//
+//	the points are done in blocks: the corners of their cells are gathered first,
+//	then the whole block is blended in one loop the compiler can vectorize
+//
+
+static const uint32 HeightBlock = 64;
+
+bool Heightmap::getHeights(const float* x, const float* z, float* heights, uint32 count)
+{
+	float	spacing	= mCacheAvaliable ? (float)mCacheResoulutionDivider : 1.0f;
+	int32	columns	= mCacheAvaliable ? mCacheWidth : WIDTH;
+	int32	rows	= mCacheAvaliable ? mCacheHeight : HEIGHT;
+	bool	valid	= true;
+
+	float	h00[HeightBlock];
+	float	h10[HeightBlock];
+	float	h01[HeightBlock];
+	float	h11[HeightBlock];
+	float	fx[HeightBlock];
+	float	fz[HeightBlock];
+	uint8	found[HeightBlock];
+
+	for(uint32 first = 0; first < count; first += HeightBlock)
+	{
+		uint32 block = std::min(HeightBlock,count - first);
+
+		for(uint32 i = 0; i < block; i++)
+		{
+			float gridX = (x[first + i] + (WIDTH>>1)) / spacing;
+			float gridZ = (z[first + i] + (HEIGHT>>1)) / spacing;
+
+			h00[i] = h10[i] = h01[i] = h11[i] = 0.0f;
+			fx[i] = fz[i] = 0.0f;
+
+			if(gridX < 0.0f || gridZ < 0.0f || gridX > (float)(columns - 1) || gridZ > (float)(rows - 1))
+			{
+				found[i] = 0;
+				continue;
+			}
+
+			// the last column and row are blended from the cell before them
+			int32 cellX = std::min((int32)floor(gridX),columns - 2);
+			int32 cellZ = std::min((int32)floor(gridZ),rows - 2);
+
+			fx[i] = gridX - (float)cellX;
+			fz[i] = gridZ - (float)cellZ;
+
+			found[i] = (_getGridHeight(cellX,cellZ,h00[i])
+					 && _getGridHeight(cellX + 1,cellZ,h10[i])
+					 && _getGridHeight(cellX,cellZ + 1,h01[i])
+					 && _getGridHeight(cellX + 1,cellZ + 1,h11[i])) ? 1 : 0;
+		}
+
+		float* out = heights + first;
+
+		for(uint32 i = 0; i < block; i++)
+		{
+			float south	= h00[i] + (h10[i] - h00[i]) * fx[i];
+			float north	= h01[i] + (h11[i] - h01[i]) * fx[i];
+
+			out[i] = south + (north - south) * fz[i];
+		}
+
+		for(uint32 i = 0; i < block; i++)
+		{
+			if(!found[i])
+			{
+				out[i]	= FLT_MIN;
+				valid	= false;
+			}
+		}
+	}
+
+	return valid;
+}
+
+//=============================================================================
+//
+//	a side gets at most MaxFootprintSide samples, larger rectangles are sampled more sparsely
+//
+
+static const uint32 MaxFootprintSide = 64;
+
+bool Heightmap::getFootprint(float x, float z, float halfWidth, float halfLength, float spacing, heightFootprint& footprint)
+{
+	if(spacing <= 0.0f)
+	{
+		spacing = 1.0f;
+	}
+
+	uint32 columns	= std::min((uint32)ceil((2.0f * halfWidth) / spacing) + 1,MaxFootprintSide);
+	uint32 rows		= std::min((uint32)ceil((2.0f * halfLength) / spacing) + 1,MaxFootprintSide);
+	float  stepX	= (columns > 1) ? (2.0f * halfWidth) / (float)(columns - 1) : 0.0f;
+	float  stepZ	= (rows > 1) ? (2.0f * halfLength) / (float)(rows - 1) : 0.0f;
+	uint32 count	= columns * rows;
+
+	std::vector<float> pointsX(count);
+	std::vector<float> pointsZ(count);
+	std::vector<float> heights(count);
+
+	for(uint32 row = 0; row < rows; row++)
+	{
+		for(uint32 column = 0; column < columns; column++)
+		{
+			pointsX[row * columns + column] = x - halfWidth + stepX * (float)column;
+			pointsZ[row * columns + column] = z - halfLength + stepZ * (float)row;
+		}
+	}
+
+	bool valid = getHeights(&pointsX[0],&pointsZ[0],&heights[0],count);
+
+	footprint.minHeight	= FLT_MAX;
+	footprint.maxHeight	= -FLT_MAX;
+	footprint.maxSlope	= 0.0f;
+	footprint.samples	= 0;
+
+	for(uint32 row = 0; row < rows; row++)
+	{
+		for(uint32 column = 0; column < columns; column++)
+		{
+			float height = heights[row * columns + column];
+
+			if(height == FLT_MIN)
+			{
+				continue;
+			}
+
+			footprint.samples++;
+			footprint.minHeight = std::min(footprint.minHeight,height);
+			footprint.maxHeight = std::max(footprint.maxHeight,height);
+
+			if(column && heights[row * columns + column - 1] != FLT_MIN)
+			{
+				footprint.maxSlope = std::max(footprint.maxSlope,fabs(height - heights[row * columns + column - 1]) / stepX);
+			}
+
+			if(row && heights[(row - 1) * columns + column] != FLT_MIN)
+			{
+				footprint.maxSlope = std::max(footprint.maxSlope,fabs(height - heights[(row - 1) * columns + column]) / stepZ);
+			}
+		}
+	}
+
+	return valid;
+}
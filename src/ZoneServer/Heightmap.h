@@ -15,11 +15,28 @@ Copyright (c) 2006 - 2010 The swgANH Team
 // #define     gHeightmap    Heightmap::getSingletonPtr()
 
 #include "Utils/typedefs.h"
-#include "Utils/lockfree_queue.h"
-#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/unordered_map.hpp>
+#include <list>
 #include <string>
+#include <vector>
 #include "HeightmapAsyncContainer.h"
-#include <queue>
+
+namespace boost
+{
+	namespace interprocess
+	{
+		class file_mapping;
+		class mapped_region;
+	}
+}
+
+//=============================================================================
+//
+// the .hmpw file is mapped read only, so a height is one read of the mapping and needs no lock
+// if the file cant be mapped (32 bit address space) or its samples need converting (big endian host),
+// rows are read from the file into decoded tiles, the tiles are kept in a small lru behind a mutex
+//
 
 class Heightmap
 {
@@ -35,17 +52,25 @@ class Heightmap
 			}
 		}
 
-		void addNewHeightMapJob(HeightmapAsyncContainer* container) {mJobMutex.lock();Jobs.push(container);mJobMutex.unlock();}
-
-		void RunThread();
+		// fills in the heights and calls back right away
+		void addNewHeightMapJob(HeightmapAsyncContainer* container);
 
 		void Connect();
-		bool Open(void) { if(hmp) return true; else return false;  }
+		bool Open(void) { return (mHeights != NULL || hmp != NULL); }
 		bool setupCache(int16 cacheResoulutionDivider);
 		static inline bool isHeightmapCacheAvaliable(void) { return mCacheAvaliable;}
 		inline bool isHighResCache(void) { return (mCacheResoulutionDivider == 1);}
 		float getCachedHeightAt2DPosition(float xPos, float zPos) const;
-		float Heightmap::getHeight(float x, float y);
+		// safe to call from any thread
+		float getHeight(float x, float y);
+
+		// bilinear heights of count points, from the cache grid when there is one, from the samples otherwise
+		// points off the map get FLT_MIN, returns false if there were any
+		bool getHeights(const float* x, const float* z, float* heights, uint32 count);
+
+		// samples the rectangle of half extents around x,z about every spacing meters
+		// returns false if part of it is off the map
+		bool getFootprint(float x, float z, float halfWidth, float halfLength, float spacing, heightFootprint& footprint);
 	protected:
 		Heightmap(const char* planet_name);
 		~Heightmap();
@@ -73,19 +98,50 @@ class Heightmap
 
 		void setFilename(std::string filename) { mFilename = filename; }
 
-		unsigned long getOffset(float x, float y) const ;
-
 		int32 round_coord(float coord) const;
 
-		float	**mHeightmapCache;
+		// the raw sample at a position, false outside the map or without a heightmap
+		bool _getSample(float x, float y, uint16& sample);
+		bool _getRawSample(int32 column, int32 row, uint16& sample);
+		bool _getGridHeight(int32 gridX, int32 gridZ, float& height);
+		uint16 _getTiledSample(int32 column, int32 row);
+		bool _readRaw(unsigned char* buffer, int32 offset, int32 length);
+		bool _map();
+
+		// the .hmpc pyramid of cache levels
+		std::string _getPyramidName() const;
+		bool _getSourceStamp(uint64& size, uint64& time) const;
+		bool _mapPyramid();
+		bool _buildPyramid();
+		bool _buildCache();
+
+		const int16*	mCache;			// mCacheWidth * mCacheHeight heights in 1/20 meter, southern row first
 		int32	mCacheHeight;
 		int32	mCacheWidth;
 		int16	mCacheResoulutionDivider;
 
+		// the mapped pyramid level, or the buffer holding the level when it could not be mapped
+		boost::interprocess::file_mapping*	mCacheFile;
+		boost::interprocess::mapped_region*	mCacheRegion;
+		std::vector<int16>					mCacheBuffer;
+
 		static bool	mCacheAvaliable;
 
-		boost::thread			    mThread;
-		bool						  mExit;
+		boost::interprocess::file_mapping*	mFile;
+		boost::interprocess::mapped_region*	mRegion;
+		const uint16*						mHeights;		// the mapped samples, NULL when the tiles are used
+
+		// decoded tiles of TileSize * TileSize samples, the most recently used at the front
+		static const int32	TileSize	= 128;
+		static const uint32	MaxTiles	= 256;
+
+		typedef std::list<uint32>											TileOrder;
+		typedef std::pair<TileOrder::iterator,std::vector<uint16> >			Tile;
+		typedef boost::unordered_map<uint32,Tile>							TileMap;
+
+		TileOrder		mTileOrder;
+		TileMap			mTiles;
+		boost::mutex	mFileMutex;
 
 	protected:
 
@@ -96,9 +152,6 @@ class Heightmap
 
 		int32		WIDTH;
 		int32   HEIGHT;
-
-		std::queue<HeightmapAsyncContainer*> Jobs;
-		boost::mutex mJobMutex;
 };
 
 #endif
@@ -2,6 +2,7 @@
 #define HEIGHTMAPASYNCCONTAINER_H
 #include <map>
 #include "HeightMapCallback.h"
+#include "Utils/typedefs.h"
 
 class heightResult
 {
@@ -12,6 +13,16 @@ public:
 
 typedef std::map<std::pair<float, float>, heightResult*> HeightResultMap;
 
+// the heights over a rectangle, see Heightmap::getFootprint
+class heightFootprint
+{
+public:
+	float minHeight;
+	float maxHeight;
+	float maxSlope;		// height change per meter between neighbouring samples
+	uint32 samples;		// the samples that were on the map
+};
+
 enum HeightmapCallbackTypes
 {
 	HeightmapCallback_ArtisanSurvey,
@@ -24,8 +35,9 @@ class HeightmapAsyncContainer
 {
 public:
 	HeightmapAsyncContainer(HeightMapCallBack* backCall, HeightmapCallbackTypes Type)
-	: callback(backCall)
-	, type(Type)
+	: type(Type)
+	, callback(backCall)
+	, mHasFootprint(false)
 	{
 		mHeightResults = new HeightResultMap();
 	}
@@ -40,6 +52,22 @@ public:
 	
 	void addToBatch(float x, float y) { mHeightResults->insert(std::make_pair(std::make_pair(x,y), reinterpret_cast<heightResult*>(0)));}
 	HeightResultMap* getResults() {return mHeightResults;}
+
+	// asks for the heights over the rectangle of half extents around x,z as well
+	void setFootprint(float x, float z, float halfWidth, float halfLength)
+	{
+		mFootprintX = x;
+		mFootprintZ = z;
+		mFootprintHalfWidth = halfWidth;
+		mFootprintHalfLength = halfLength;
+		mHasFootprint = true;
+	}
+	bool hasFootprint() const { return mHasFootprint; }
+	float getFootprintX() const { return mFootprintX; }
+	float getFootprintZ() const { return mFootprintZ; }
+	float getFootprintHalfWidth() const { return mFootprintHalfWidth; }
+	float getFootprintHalfLength() const { return mFootprintHalfLength; }
+	heightFootprint* getFootprint() { return &mFootprint; }
 	HeightMapCallBack* getCallback() { return callback;}
 	HeightmapCallbackTypes type;
 
@@ -47,5 +75,12 @@ private:
 	HeightResultMap* mHeightResults;
 	HeightMapCallBack* callback;
 
+	heightFootprint mFootprint;
+	float mFootprintX;
+	float mFootprintZ;
+	float mFootprintHalfWidth;
+	float mFootprintHalfLength;
+	bool mHasFootprint;
+
 };
 #endif HEIGHTMAPASYNCCONTAINER_H
\ No newline at end of file
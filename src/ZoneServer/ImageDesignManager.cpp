@@ -602,7 +602,6 @@ void EntertainerManager::applyMoney(PlayerObject* customer,PlayerObject* designe
 {
 	int32 amountcash;
 	int32 amountbank;
-	int8 sql[1024];
 	amountcash = amount;
 	amountbank = 0;
 	Inventory* inventory = dynamic_cast<Inventory*>(customer->getEquipManager()->getEquippedObject(CreatureEquipSlot_Inventory));
@@ -623,12 +622,9 @@ void EntertainerManager::applyMoney(PlayerObject* customer,PlayerObject* designe
 	asyncContainer->amountbank = amountbank;
 
 
-	sprintf(sql,"UPDATE inventories SET credits=credits-%i WHERE id=%"PRIu64"",amountcash, customer->getId()+1);
-	mTransaction->addQuery(sql);
-	sprintf(sql,"UPDATE banks SET credits=credits-%i WHERE id=%"PRIu64"",amountbank, customer->getId()+4);
-	mTransaction->addQuery(sql);
-	sprintf(sql,"UPDATE banks SET credits=credits+%i WHERE id=%"PRIu64"",amount, designer->getId()+4);
-	mTransaction->addQuery(sql);
+	mTransaction->addStatement("UPDATE inventories SET credits=credits-? WHERE id=?").bindInt(amountcash).bindUInt(customer->getId()+1);
+	mTransaction->addStatement("UPDATE banks SET credits=credits-? WHERE id=?").bindInt(amountbank).bindUInt(customer->getId()+4);
+	mTransaction->addStatement("UPDATE banks SET credits=credits+? WHERE id=?").bindInt(amount).bindUInt(designer->getId()+4);
 
 	mTransaction->execute();
 }
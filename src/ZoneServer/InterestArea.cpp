@@ -0,0 +1,200 @@
+/*
+---------------------------------------------------------------------------------------
+This source file is part of swgANH (Star Wars Galaxies - A New Hope - Server Emulator)
+For more information, see http://www.swganh.org
+
+
+Copyright (c) 2006 - 2010 The swgANH Team
+
+---------------------------------------------------------------------------------------
+*/
+
+#include "InterestArea.h"
+#include "Object.h"
+#include "WorldManager.h"
+#include "ZoneTree.h"
+
+#include <cmath>
+
+//======================================================================================================================
+
+static inline uint64 cellKey(int32 column,int32 row)
+{
+	return (static_cast<uint64>(static_cast<uint32>(column)) << 32) | static_cast<uint32>(row);
+}
+
+static inline int32 cellKeyColumn(uint64 key)	{ return static_cast<int32>(static_cast<uint32>(key >> 32)); }
+static inline int32 cellKeyRow(uint64 key)		{ return static_cast<int32>(static_cast<uint32>(key)); }
+
+//======================================================================================================================
+
+InterestArea::InterestArea() :
+mCellSize(0.0f),
+mObjTypes(0),
+mGeneration(0),
+mColumnLow(0),
+mColumnHigh(0),
+mRowLow(0),
+mRowHigh(0),
+mValid(false)
+{
+}
+
+//======================================================================================================================
+
+InterestArea::~InterestArea()
+{
+}
+
+//======================================================================================================================
+
+void InterestArea::reset()
+{
+	mCells.clear();
+	mEnteredCells.clear();
+
+	mValid = false;
+}
+
+//======================================================================================================================
+
+bool InterestArea::update(ZoneTree* si,uint64 viewerId,float x,float z,float range,float cellSize,uint32 objTypes)
+{
+	if(mValid && (cellSize != mCellSize || objTypes != mObjTypes))
+	{
+		reset();
+	}
+
+	int32 columnLow		= static_cast<int32>(floor((x - range) / cellSize));
+	int32 columnHigh	= static_cast<int32>(floor((x + range) / cellSize));
+	int32 rowLow		= static_cast<int32>(floor((z - range) / cellSize));
+	int32 rowHigh		= static_cast<int32>(floor((z + range) / cellSize));
+
+	uint32	generation	= si->getGeneration();
+	bool	moved		= !mValid || columnLow != mColumnLow || columnHigh != mColumnHigh || rowLow != mRowLow || rowHigh != mRowHigh;
+
+	if(!moved && generation == mGeneration)
+	{
+		return false;
+	}
+
+	mEnteredCells.clear();
+	mCellSize	= cellSize;
+	mObjTypes	= objTypes;
+
+	// drop the cells gone out of view, query the ones still in view again if something was inserted or removed in them
+	CellMap::iterator it = mCells.begin();
+
+	while(it != mCells.end())
+	{
+		int32 column	= cellKeyColumn((*it).first);
+		int32 row		= cellKeyRow((*it).first);
+
+		if(column < columnLow || column > columnHigh || row < rowLow || row > rowHigh)
+		{
+			mCells.erase(it++);
+			continue;
+		}
+
+		if(generation != mGeneration && si->getGeneration(column * cellSize,row * cellSize,(column + 1) * cellSize,(row + 1) * cellSize) > (*it).second.mGeneration)
+		{
+			_query(si,viewerId,(*it).first,generation);
+		}
+
+		++it;
+	}
+
+	// query the ones come into view
+	for(int32 row = rowLow; row <= rowHigh; row++)
+	{
+		for(int32 column = columnLow; column <= columnHigh; column++)
+		{
+			if(mValid && column >= mColumnLow && column <= mColumnHigh && row >= mRowLow && row <= mRowHigh)
+			{
+				continue;
+			}
+
+			_query(si,viewerId,cellKey(column,row),generation);
+		}
+	}
+
+	mGeneration	= generation;
+	mColumnLow	= columnLow;
+	mColumnHigh	= columnHigh;
+	mRowLow		= rowLow;
+	mRowHigh	= rowHigh;
+	mValid		= true;
+
+	return(!mEnteredCells.empty() || moved);
+}
+
+//======================================================================================================================
+
+void InterestArea::_query(ZoneTree* si,uint64 viewerId,uint64 key,uint32 generation)
+{
+	int32	column	= cellKeyColumn(key);
+	int32	row		= cellKeyRow(key);
+	Cell&	cell	= mCells[key];
+
+	cell.mIds.clear();
+	cell.mGeneration = generation;
+
+	si->getObjectIdsInRect(viewerId,&cell.mIds,mObjTypes,column * mCellSize,row * mCellSize,(column + 1) * mCellSize,(row + 1) * mCellSize);
+
+	mEnteredCells.push_back(key);
+}
+
+//======================================================================================================================
+//
+// objects are looked up again, anything destroyed since the cell was queried just drops out
+//
+
+void InterestArea::_resolve(const ObjectIdList& ids,ObjectSet* resultSet) const
+{
+	ObjectIdList::const_iterator it = ids.begin();
+
+	while(it != ids.end())
+	{
+		if(Object* object = gWorldManager->getObjectById(static_cast<uint64>(*it)))
+		{
+			resultSet->insert(object);
+		}
+
+		++it;
+	}
+}
+
+//======================================================================================================================
+
+void InterestArea::getObjects(ObjectSet* resultSet) const
+{
+	CellMap::const_iterator it = mCells.begin();
+
+	while(it != mCells.end())
+	{
+		_resolve((*it).second.mIds,resultSet);
+		++it;
+	}
+}
+
+//======================================================================================================================
+
+void InterestArea::getEnteredObjects(ObjectSet* resultSet) const
+{
+	std::vector<uint64>::const_iterator it = mEnteredCells.begin();
+
+	while(it != mEnteredCells.end())
+	{
+		CellMap::const_iterator cellIt = mCells.find(*it);
+
+		if(cellIt != mCells.end())
+		{
+			_resolve((*cellIt).second.mIds,resultSet);
+		}
+
+		++it;
+	}
+}
+
+//======================================================================================================================
+
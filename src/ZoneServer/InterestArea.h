@@ -0,0 +1,89 @@
+/*
+---------------------------------------------------------------------------------------
+This source file is part of swgANH (Star Wars Galaxies - A New Hope - Server Emulator)
+For more information, see http://www.swganh.org
+
+
+Copyright (c) 2006 - 2010 The swgANH Team
+
+---------------------------------------------------------------------------------------
+*/
+
+#ifndef ANH_ZONESERVER_INTERESTAREA_H
+#define ANH_ZONESERVER_INTERESTAREA_H
+
+#include "Utils/typedefs.h"
+#include <map>
+#include <set>
+#include <vector>
+
+
+//======================================================================================================================
+
+class Object;
+class ZoneTree;
+
+typedef std::set<Object*>		ObjectSet;
+typedef std::vector<int64>		ObjectIdList;
+
+//======================================================================================================================
+//
+// the static part of a players area of interest, as a window of grid cells around him
+// every cell remembers the ids the spatial index returned for it, so when the window moves
+// only the cells coming into view are queried and the ones going out of view are dropped
+// cells the spatial index had inserts or removes in since they were queried are queried again
+//
+
+class InterestArea
+{
+	public:
+
+		InterestArea();
+		~InterestArea();
+
+		// forget all cells, the next update queries the whole window
+		void	reset();
+
+		// moves the window to cover [x - range,x + range] x [z - range,z + range] and requeries stale cells
+		// returns false if the window is still the same and none of its cells changed
+		bool	update(ZoneTree* si,uint64 viewerId,float x,float z,float range,float cellSize,uint32 objTypes);
+
+		// objects of all cells in the window
+		void	getObjects(ObjectSet* resultSet) const;
+
+		// objects of the cells that came into the window or were queried again with the last update
+		void	getEnteredObjects(ObjectSet* resultSet) const;
+
+		uint32	getCellCount() const { return static_cast<uint32>(mCells.size()); }
+
+	private:
+
+		struct Cell
+		{
+			Cell() : mGeneration(0){}
+
+			ObjectIdList	mIds;
+			uint32			mGeneration;	// of the spatial index, when the cell was queried
+		};
+
+		typedef std::map<uint64,Cell>	CellMap;
+
+		void	_query(ZoneTree* si,uint64 viewerId,uint64 key,uint32 generation);
+		void	_resolve(const ObjectIdList& ids,ObjectSet* resultSet) const;
+
+		CellMap				mCells;
+		std::vector<uint64>	mEnteredCells;
+		float				mCellSize;
+		uint32				mObjTypes;
+		uint32				mGeneration;
+		int32				mColumnLow;
+		int32				mColumnHigh;
+		int32				mRowLow;
+		int32				mRowHigh;
+		bool				mValid;
+};
+
+//======================================================================================================================
+
+#endif
+
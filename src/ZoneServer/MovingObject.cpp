@@ -27,6 +27,18 @@ MovingObject::MovingObject()
 , mCurrentSpeedMod(1.0f)
 , mBaseSpeedMod(1.0f)
 {
+	for(uint32 i = 0; i < TransformKind_Count; i++)
+	{
+		mTransformTierState[i].mPosition	= glm::vec3();
+		mTransformTierState[i].mAngle		= 0.0f;
+		mTransformTierState[i].mSpeed		= 0.0f;
+
+		mTransformTierState[i].mSentPosition	= glm::vec3();
+		mTransformTierState[i].mSentVelocity	= glm::vec3();
+		mTransformTierState[i].mSentAngle		= 0.0f;
+		mTransformTierState[i].mSentTime		= 0;
+		mTransformTierState[i].mKeyframeTime	= 0;
+	}
 }
 
 //=============================================================================
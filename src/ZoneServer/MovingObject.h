@@ -25,6 +25,30 @@ class MovingObject : public Object
 	friend class PlayerObjectFactory;
 
 	public:
+
+		// what the observers got last, per movement message kind
+		enum TransformKind
+		{
+			TransformKind_Update	= 0,
+			TransformKind_Data		= 1,
+			TransformKind_Count		= 2
+		};
+
+		struct TransformTierState
+		{
+			// last update beyond the mid range
+			glm::vec3	mPosition;
+			float		mAngle;
+			float		mSpeed;
+
+			// last update broadcast at all, observers extrapolate from it
+			glm::vec3	mSentPosition;
+			glm::vec3	mSentVelocity;
+			float		mSentAngle;
+			uint64		mSentTime;
+			uint64		mKeyframeTime;
+		};
+
 		MovingObject();
 		virtual ~MovingObject();
 		
@@ -74,6 +98,9 @@ class MovingObject : public Object
 		float		getCurrentTerrainNegotiation(){ return mCurrentTerrainNegotiation; }
 		void		setCurrentTerrainNegotiation(float tn){ mCurrentTerrainNegotiation = tn; }
 
+		// distance tiered movement broadcasts
+		TransformTierState&	getTransformTierState(TransformKind kind){ return mTransformTierState[kind]; }
+
 		// update current values
 		virtual void	updateMovementProperties() = 0;
 
@@ -93,6 +120,8 @@ class MovingObject : public Object
 		float		mCurrentTurnRate;
 		float		mCurrentSpeedMod;
 		float		mBaseSpeedMod;
+
+		TransformTierState	mTransformTierState[TransformKind_Count];
 };
 
 //=============================================================================
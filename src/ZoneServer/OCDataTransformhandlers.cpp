@@ -556,8 +556,8 @@ void ObjectController::_findInRangeObjectsOutside(bool updateAll)
 {
 	PlayerObject*	player			= dynamic_cast<PlayerObject*>(mObject);
 
-	//scale down viewing range when busy
-	float			viewingRange	= _GetMessageHeapLoadViewingRange();
+	//scale down viewing range when busy, taken in prepareWorldUpdate
+	float			viewingRange	= mWorldQueryRange;
 
 	// gLogger->logMsg("... _findInRangeObjectsOutside.");
 
@@ -592,9 +592,25 @@ void ObjectController::_findInRangeObjectsOutside(bool updateAll)
 		// Doing this because we need the players from inside buildings too.
 		mSI->getObjectsInRangeEx(player,&mInRangeObjects,(ObjType_Player | ObjType_NPC | ObjType_Creature), viewingRange);
 
-		// This may be good when we standstill.
-		mSI->getObjectsInRange(player,&mInRangeObjects,(ObjType_Tangible | ObjType_Building | ObjType_Lair | ObjType_Structure), viewingRange);
-
+		if (uint16 aoiCellSize = gWorldConfig->getPlayerAoiCellSize())
+		{
+			// Only the cells that came into view get queried, the rest we still have from earlier updates.
+			mInterestArea.update(mSI,player->getId(),player->mPosition.x,player->mPosition.z,viewingRange,aoiCellSize,(ObjType_Tangible | ObjType_Building | ObjType_Lair | ObjType_Structure));
+			mInterestArea.getObjects(&mInRangeObjects);
+		}
+		else
+		{
+			// This may be good when we standstill.
+			mSI->getObjectsInRange(player,&mInRangeObjects,(ObjType_Tangible | ObjType_Building | ObjType_Lair | ObjType_Structure), viewingRange);
+		}
+	}
+	else if (uint16 aoiCellSize = gWorldConfig->getPlayerAoiCellSize())
+	{
+		// Crossed a cell boundary, create what came into view. Whatever went out of view gets destroyed with the next full update.
+		if (mInterestArea.update(mSI,player->getId(),player->mPosition.x,player->mPosition.z,viewingRange,aoiCellSize,(ObjType_Tangible | ObjType_Building | ObjType_Lair | ObjType_Structure)))
+		{
+			mInterestArea.getEnteredObjects(&mInRangeObjects);
+		}
 	}
 	/*
 	{
@@ -695,7 +711,7 @@ bool ObjectController::_updateInRangeObjectsOutside()
 void ObjectController::_findInRangeObjectsInside(bool updateAll)
 {
 	PlayerObject*	player = dynamic_cast<PlayerObject*>(mObject);
-	float			viewingRange = _GetMessageHeapLoadViewingRange();
+	float			viewingRange = mWorldQueryRange;
 	CellObject*		playerCell = dynamic_cast<CellObject*>(gWorldManager->getObjectById(player->getParentId()));
 
 
@@ -748,7 +764,8 @@ void ObjectController::_findInRangeObjectsInside(bool updateAll)
 
 		// Added ObjType_Tangible because Tutorial spawns ObjType_Tangible in a way we don't normally do.
 		// If we need more speed in normal cases, just add a test for Tutorial and de-select ObjType_Tangible if not active.
-		mSI->getObjectsInRange(player,&mInRangeObjects,(ObjType_Tangible | ObjType_Player | ObjType_Creature | ObjType_NPC),viewingRange);
+		// The building keeps its own index of the cells content, the spatial index only gets asked on the full update.
+		building->getInteriorObjects(&mInRangeObjects,(ObjType_Tangible | ObjType_Player | ObjType_Creature | ObjType_NPC),player->getId());
 
 		// query the qtree based on the buildings world position
 		if (QTRegion* region = mSI->getQTRegion(building->mPosition.x,building->mPosition.z))
@@ -868,8 +885,7 @@ bool ObjectController::_destroyOutOfRangeObjects(ObjectSet *inRangeObjects)
 
 	// iterate our knowns
 	PlayerObject*				player			= dynamic_cast<PlayerObject*>(mObject);
-	ObjectSet*					knownObjects	= player->getKnownObjects();
-	ObjectSet::iterator			objIt			= knownObjects->begin();
+	KnownObjectSet*				knownObjects	= player->getKnownObjects();
 	PlayerObjectSet*			knownPlayers	= player->getKnownPlayers();
 	PlayerObjectSet::iterator	playerIt		= knownPlayers->begin();
 
@@ -909,7 +925,7 @@ bool ObjectController::_destroyOutOfRangeObjects(ObjectSet *inRangeObjects)
 			}
 
 			// we don't know each other anymore
-			knownPlayers->erase(playerIt++);
+			playerIt = knownPlayers->erase(playerIt);
 			playerObject->removeKnownObject(player);
 
 
@@ -921,6 +937,9 @@ bool ObjectController::_destroyOutOfRangeObjects(ObjectSet *inRangeObjects)
 	// We may want to limit the amount of messages sent in one session.
 	uint32 messageCount = 0;
 
+	// dismounting above may have taken mounts out of our known objects
+	KnownObjectSet::iterator objIt = knownObjects->begin();
+
 	// update objects
 	while(objIt != knownObjects->end())
 	{
@@ -994,7 +1013,8 @@ bool ObjectController::_destroyOutOfRangeObjects(ObjectSet *inRangeObjects)
 			gMessageLib->sendDestroyObject(object->getId(),player);
 
 			// we don't know each other anymore
-			knownObjects->erase(objIt++);
+			// the hopper contents may have gone out of our known objects already, so look it up again
+			objIt = knownObjects->erase(knownObjects->find(object));
 			object->removeKnownObject(player);
 
 			if (++messageCount >= objectDestroyLimit)
@@ -1027,9 +1047,27 @@ bool ObjectController::_destroyOutOfRangeObjects(ObjectSet *inRangeObjects)
 //	THIS IS AN EXAMPLE OF HOW NOT TO WRITE CODE, MIXING EVERYTHING ETC....
 
 uint64 ObjectController::playerWorldUpdate(bool forcedUpdate)
+{
+	prepareWorldUpdate(forcedUpdate);
+	runWorldQuery();
+
+	return finishWorldUpdate();
+}
+
+//=============================================================================
+//
+//	Decide on the query the world update needs.
+//
+
+void ObjectController::prepareWorldUpdate(bool forcedUpdate)
 {
 	PlayerObject* player = dynamic_cast<PlayerObject*>(mObject);
 
+	mWorldQuery = OCWorldQuery_None;
+
+	// the heap warning level updates the message factory, so it is read here rather than in the query
+	mWorldQueryRange = _GetMessageHeapLoadViewingRange();
+
 	// If we already are busy, don't start another update.
 	// ie if this is called by the worldmanager timer because we still have unupdated objects
 	// in our resultmap
@@ -1066,17 +1104,14 @@ uint64 ObjectController::playerWorldUpdate(bool forcedUpdate)
 			{
 				// Update all.
 				// gLogger->logMsg("ObjController::handleDataTransformWithParent: _findInRangeObjectsInside(true)");
-				_findInRangeObjectsInside(true);
+				mWorldQuery = OCWorldQuery_InsideAll;
 			}
 		}
 		else
 		{
-			// This is the faster update, stil based on SI though.
-			_findInRangeObjectsInside(false);
+			// This is the faster update, based on the buildings index.
+			mWorldQuery = OCWorldQuery_InsideFast;
 		}
-		// Update some of the objects we found.
-		mUpdatingObjects = !_updateInRangeObjectsInside();
-
 	}
 	else
 	{
@@ -1131,6 +1166,13 @@ uint64 ObjectController::playerWorldUpdate(bool forcedUpdate)
 				// gLogger->logMsg("forcedUpdate");
 
 				mDestroyOutOfRangeObjects = false;	// Stop the destroy-messages, in case we already have started to send them.
+
+				// Entered or left something, or stood still for a while, query all cells again.
+				if (forcedUpdate)
+				{
+					mInterestArea.reset();
+				}
+
 				if (OutOfUpdateRange)
 				{
 					// gLogger->logMsg("Out of 64m range");
@@ -1145,7 +1187,7 @@ uint64 ObjectController::playerWorldUpdate(bool forcedUpdate)
 					// We shall destroy out of range objects when we are done with the update of known objects.
 					mDestroyOutOfRangeObjects = true;
 				}
-				_findInRangeObjectsOutside(true);
+				mWorldQuery = OCWorldQuery_OutsideAll;
 			}
 		}
 		else if (!mDestroyOutOfRangeObjects)
@@ -1153,9 +1195,47 @@ uint64 ObjectController::playerWorldUpdate(bool forcedUpdate)
 			// This is the fast update, based on qt.
 			// gLogger->logMsg("_findInRangeObjectsOutside(false)");
 
-			_findInRangeObjectsOutside(false);
+			mWorldQuery = OCWorldQuery_OutsideFast;
 		}
+	}
+}
+
+//=============================================================================
+//
+//	Run the query decided on, this only reads the world and may run on a worker thread.
+//
+
+void ObjectController::runWorldQuery()
+{
+	switch(mWorldQuery)
+	{
+		case OCWorldQuery_InsideAll:	_findInRangeObjectsInside(true);	break;
+		case OCWorldQuery_InsideFast:	_findInRangeObjectsInside(false);	break;
+		case OCWorldQuery_OutsideAll:	_findInRangeObjectsOutside(true);	break;
+		case OCWorldQuery_OutsideFast:	_findInRangeObjectsOutside(false);	break;
+
+		default: break;
+	}
 
+	mWorldQuery = OCWorldQuery_None;
+}
+
+//=============================================================================
+//
+//	Create and destroy what the query found, on the main thread again.
+//
+
+uint64 ObjectController::finishWorldUpdate()
+{
+	PlayerObject* player = dynamic_cast<PlayerObject*>(mObject);
+
+	if (player->getParentId() != 0)
+	{
+		// Update some of the objects we found.
+		mUpdatingObjects = !_updateInRangeObjectsInside();
+	}
+	else
+	{
 		// Update some of the objects we found.
 		mUpdatingObjects = !_updateInRangeObjectsOutside();
 
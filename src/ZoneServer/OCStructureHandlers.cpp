@@ -296,35 +296,24 @@ void ObjectController::_handleStructurePlacement(uint64 targetId,Message* messag
 			container->customName = "";
 			container->player = player;
 
-			//We need to give the thing several points to grab (because we want the max height)
+			//We need the heights over the whole house (because we want the max height)
 			StructureDeedLink* deedLink;
 			deedLink = gStructureManager->getDeedData(deed->getItemType());
 
-			uint32 halfLength = (deedLink->length/2);
-			uint32 halfWidth = (deedLink->width/2);
+			float halfLength = (float)(deedLink->length/2);
+			float halfWidth = (float)(deedLink->width/2);
 
 			container->addToBatch(x, z);
 
 			if(dir == 0 || dir == 2)
 			{
 				//Orientation 1
-				container->addToBatch(x-halfLength, z-halfWidth);
-				gLogger->logMsgF("%f %f\n", MSG_NORMAL,x-halfLength, z-halfWidth);
-				container->addToBatch(x+halfLength, z-halfWidth);
-				gLogger->logMsgF("%f %f\n", MSG_NORMAL,x+halfLength, z-halfWidth);
-				container->addToBatch(x-halfLength, z+halfWidth);
-				gLogger->logMsgF("%f %f\n", MSG_NORMAL,x-halfLength, z+halfWidth);
-				container->addToBatch(x+halfLength, z+halfWidth);
-				gLogger->logMsgF("%f %f\n", MSG_NORMAL,x+halfLength, z+halfWidth);
+				container->setFootprint(x, z, halfLength, halfWidth);
 			}
-
-			if(dir == 1 || dir == 3)
+			else
 			{
 				//Orientation 2
-				container->addToBatch(x-halfWidth, z-halfLength);
-				container->addToBatch(x+halfWidth, z-halfLength);
-				container->addToBatch(x-halfWidth, z+halfLength);
-				container->addToBatch(x+halfWidth, z+halfLength);
+				container->setFootprint(x, z, halfWidth, halfLength);
 			}
 
 			Heightmap::Instance()->addNewHeightMapJob(container);
@@ -359,6 +348,12 @@ void ObjectController::HeightmapStructureHandler(HeightmapAsyncContainer* ref)
 			it++;
 		}
 
+		heightFootprint* footprint = container->getFootprint();
+		if(worked && container->hasFootprint() && footprint->samples && footprint->maxHeight > highest)
+		{
+			highest = footprint->maxHeight;
+		}
+
 		if(worked)
 		{
 			container->oCallback->requestnewHousebyDeed(container->ofCallback,container->deed,container->player->getClient(),
@@ -11,7 +11,9 @@ Copyright (c) 2006 - 2010 The swgANH Team
 
 #include "Object.h"
 #include "PlayerObject.h"
+#include "QuadTree.h"
 #include "WorldManager.h"
+#include "ZoneTree.h"
 #include "ZoneOpcodes.h"
 #include "MessageLib/MessageLib.h"
 #include "Common/Message.h"
@@ -35,6 +37,9 @@ Object::Object()
 , mTypeOptions(0)
 , mDataTransformCounter(0)
 , mMovementMessageToggle(true)
+, mQuadTree(NULL)
+, mQuadTreeLeaf(0)
+, mQuadTreeSlot(0)
 {
     mDirection = glm::quat();
     mPosition  = glm::vec3();
@@ -56,6 +61,9 @@ Object::Object(uint64 id,uint64 parentId,string model,ObjectType type)
 , mTypeOptions(0)
 , mDataTransformCounter(0)
 , mMovementMessageToggle(true)
+, mQuadTree(NULL)
+, mQuadTreeLeaf(0)
+, mQuadTreeSlot(0)
 {
 	mObjectController.setObject(this);
 
@@ -65,6 +73,17 @@ Object::Object(uint64 id,uint64 parentId,string model,ObjectType type)
 
 Object::~Object()
 {
+	if(mQuadTree)
+	{
+		mQuadTree->removeObject(this);
+	}
+
+	// the spatial grid hands out object pointers
+	if(gWorldManager && gWorldManager->getSI())
+	{
+		gWorldManager->getSI()->forgetPoint(mId);
+	}
+
 	mKnownObjects.clear();
 	mKnownPlayers.clear();
 
@@ -133,7 +152,7 @@ bool Object::removeKnownObject(Object* object)
 	}
 	else
 	{
-		ObjectSet::iterator it = mKnownObjects.find(object);
+		KnownObjectSet::iterator it = mKnownObjects.find(object);
 
 		if(it != mKnownObjects.end())
 		{
@@ -162,7 +181,7 @@ bool Object::checkKnownObjects(Object* object) const
 	}
 	else
 	{
-		ObjectSet::const_iterator it = mKnownObjects.find(object);
+		KnownObjectSet::const_iterator it = mKnownObjects.find(object);
 
 		if(it != mKnownObjects.end())
 		{
@@ -548,7 +567,7 @@ void Object::addKnownObject(Object* object)
 
 void Object::destroyKnownObjects()
 {
-	ObjectSet::iterator			objIt		= mKnownObjects.begin();
+	KnownObjectSet::iterator	objIt		= mKnownObjects.begin();
 	PlayerObjectSet::iterator	playerIt	= mKnownPlayers.begin();
 
 	/*
@@ -581,7 +600,7 @@ void Object::destroyKnownObjects()
 	while(objIt != mKnownObjects.end())
 	{
 		(*objIt)->removeKnownObject(this);
-		mKnownObjects.erase(objIt++);
+		objIt = mKnownObjects.erase(objIt);
 	}
 
 	// players
@@ -592,7 +611,7 @@ void Object::destroyKnownObjects()
 		gMessageLib->sendDestroyObject(mId,targetPlayer);
 
 		targetPlayer->removeKnownObject(this);
-		mKnownPlayers.erase(playerIt++);
+		playerIt = mKnownPlayers.erase(playerIt);
 
 		
 	}
@@ -18,6 +18,7 @@ Copyright (c) 2006 - 2010 The swgANH Team
 #include "Object_Enums.h"
 #include "LogManager/LogManager.h" // @todo: this needs to go.	  where does it need to go ?
 #include "Utils/EventHandler.h"
+#include "Utils/FlatSet.h"
 #include "Utils/typedefs.h"
 
 #include <boost/lexical_cast.hpp>
@@ -42,15 +43,19 @@ Copyright (c) 2006 - 2010 The swgANH Team
 class Object;
 class PlayerObject;
 class CreatureObject;
+class QuadTree;
 
 typedef std::map<uint32,std::string>	AttributeMap;
 typedef std::tr1::shared_ptr<RadialMenu>	RadialMenuPtr;
 // typedef std::vector<uint64>				ObjectIDList;
 typedef std::list<uint64>				ObjectIDList;
 typedef std::set<Object*>				ObjectSet;
-typedef std::set<uint64>				ObjectIDSet;
-typedef std::set<PlayerObject*>			PlayerObjectSet;
-typedef std::set<uint64>			PlayerObjectIDSet;
+
+// the known sets are small and walked on every broadcast, so they are kept as sorted vectors
+typedef Anh_Utils::flat_set<Object*>		KnownObjectSet;
+typedef Anh_Utils::flat_set<uint64>		ObjectIDSet;
+typedef Anh_Utils::flat_set<PlayerObject*>	PlayerObjectSet;
+typedef Anh_Utils::flat_set<uint64>		PlayerObjectIDSet;
 typedef std::list<uint32>				AttributeOrderList;
 
 //=============================================================================
@@ -64,6 +69,7 @@ class Object : public UICallback, public Anh_Utils::EventHandler
 	friend class PlayerObjectFactory;
 	friend class InventoryFactory;
 	friend class NonPersistentItemFactory;
+	friend class QuadTree;
 
 
 	public:
@@ -98,7 +104,7 @@ class Object : public UICallback, public Anh_Utils::EventHandler
 
 		// Object Observers
 		PlayerObjectSet*			getKnownPlayers() { return &mKnownPlayers; }
-		ObjectSet*					getKnownObjects() { return &mKnownObjects; }
+		KnownObjectSet*				getKnownObjects() { return &mKnownObjects; }
 		void						destroyKnownObjects();
 		bool						checkKnownPlayer(PlayerObject* player);
 		// Not used void						clearKnownObjects(){ mKnownObjects.clear(); mKnownPlayers.clear(); }
@@ -202,7 +208,7 @@ class Object : public UICallback, public Anh_Utils::EventHandler
 		AttributeMap				mAttributeMap;
 		AttributeOrderList			mAttributeOrderList;
 		AttributeMap 				mInternalAttributeMap;
-		ObjectSet					mKnownObjects;
+		KnownObjectSet				mKnownObjects;
 		PlayerObjectSet				mKnownPlayers;
 		ObjectIDSet					mKnownObjectsIDs;
 		ObjectController			mObjectController;
@@ -227,6 +233,11 @@ class Object : public UICallback, public Anh_Utils::EventHandler
 	private:
 		glm::vec3		        mLastUpdatePosition;	// Position where SI was updated.
 
+		// where the region quadtree keeps us
+		QuadTree*				mQuadTree;
+		uint32					mQuadTreeLeaf;
+		uint32					mQuadTreeSlot;
+
 };
 
 //=============================================================================
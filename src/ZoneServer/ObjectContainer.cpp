@@ -78,6 +78,7 @@ ObjectContainer::~ObjectContainer()
 bool ObjectContainer::addObjectSecure(Object* Data) 
 { 
 	mData.push_back(Data->getId()); 
+	onContentAdded(Data);
 	if(mCapacity)
 	{
 		return true;
@@ -97,6 +98,7 @@ bool ObjectContainer::addObject(Object* Data)
 	if(mCapacity)
 	{
 		mData.push_back(Data->getId()); 
+		onContentAdded(Data);
 		//PlayerObject* player = dynamic_cast<PlayerObject*>(gWorldManager->getObjectById(this->getParentId()));					
 		return true;
 	}
@@ -252,6 +254,7 @@ bool ObjectContainer::removeObject(Object* data)
 		if((*it) == data->getId())
 		{
 			it = mData.erase(it);
+			onContentRemoved(data->getId());
 			return true;
 		}
 		++it;
@@ -273,6 +276,7 @@ bool ObjectContainer::deleteObject(Object* data)
 		if((*it) == data->getId())
 		{
 			it = mData.erase(it);
+			onContentRemoved(data->getId());
 			gWorldManager->destroyObject(data);
 			return true;
 		}
@@ -293,6 +297,7 @@ bool ObjectContainer::removeObject(uint64 id)
 		if((*it) == id)
 		{
 			it = mData.erase(it);
+			onContentRemoved(id);
 			return true;
 		}
 		++it;
@@ -365,6 +370,7 @@ ObjectIDList::iterator ObjectContainer::removeObject(ObjectIDList::iterator it,
 		playerIt++;
 	}
 
+	onContentRemoved(*it);
 	it = mData.erase(it);
 
 	return it;
@@ -373,6 +379,7 @@ ObjectIDList::iterator ObjectContainer::removeObject(ObjectIDList::iterator it,
 ObjectIDList::iterator ObjectContainer::removeObject(ObjectIDList::iterator it, PlayerObject* player)
 {
 	gMessageLib->sendDestroyObject((*it),player);
+	onContentRemoved(*it);
 	it = mData.erase(it);
 	return it;
 }
@@ -382,6 +389,7 @@ ObjectIDList::iterator ObjectContainer::removeObject(ObjectIDList::iterator it,
 
 ObjectIDList::iterator ObjectContainer::removeObject(ObjectIDList::iterator it)
 {
+	onContentRemoved(*it);
 	it = mData.erase(it);
 return it;
 }
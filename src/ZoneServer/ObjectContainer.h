@@ -117,6 +117,11 @@ class ObjectContainer :	public Object, public ObjectFactoryCallback
 			return content;
 		}
 
+	protected:
+
+		// lets a derived container follow what goes in and out of it
+		virtual void		onContentAdded(Object* object){}
+		virtual void		onContentRemoved(uint64 id){}
 
 private:
 
@@ -55,6 +55,8 @@ ObjectController::ObjectController()
 , mUnderrunTime(0)
 , mMovementInactivityTrigger(5)
 , mFullUpdateTrigger(0)
+, mWorldQuery(OCWorldQuery_None)
+, mWorldQueryRange(0.0f)
 , mDestroyOutOfRangeObjects(false)
 , mInUseCommandQueue(false)
 , mRemoveCommandQueue(false)
@@ -83,6 +85,8 @@ ObjectController::ObjectController(Object* object)
 , mUnderrunTime(0)
 , mMovementInactivityTrigger(5)
 , mFullUpdateTrigger(0)
+, mWorldQuery(OCWorldQuery_None)
+, mWorldQueryRange(0.0f)
 , mDestroyOutOfRangeObjects(false)
 , mInUseCommandQueue(false)
 , mRemoveCommandQueue(false)
@@ -21,6 +21,7 @@ Copyright (c) 2006 - 2010 The swgANH Team
 #include "ObjectFactoryCallback.h"
 #include "HeightMapCallback.h"
 #include "ObjControllerEvent.h"
+#include "InterestArea.h"
 #include <boost/pool/pool.hpp>
 
 // maximum commands allowed to be queued
@@ -83,6 +84,18 @@ enum OCCmdGroup
 
 //=======================================================================
 
+// the in range query a player world update decided on
+enum OCWorldQuery
+{
+	OCWorldQuery_None			= 0,
+	OCWorldQuery_InsideAll		= 1,
+	OCWorldQuery_InsideFast		= 2,
+	OCWorldQuery_OutsideAll		= 3,
+	OCWorldQuery_OutsideFast	= 4
+};
+
+//=======================================================================
+
 struct StatTargets
 {
 	uint32 TargetHealth;
@@ -183,6 +196,12 @@ class ObjectController : public DatabaseCallback, public ObjectFactoryCallback,
 		void					handleDataTransformWithParent(Message* message,bool inRangeUpdate);
 		uint64					playerWorldUpdate(bool forcedUpdate);	// Is called from the two above AND from timer function. We need updates even when client are not moving the player.
 
+		// playerWorldUpdate in its three steps, the query in between only reads the world
+		// so the world manager can run the queries of many players on worker threads
+		void					prepareWorldUpdate(bool forcedUpdate);
+		void					runWorldQuery();
+		uint64					finishWorldUpdate();
+
 		// trade
 		void					handleSecureTradeInvitation(uint64 targetId,Message* message);
 
@@ -626,6 +645,7 @@ class ObjectController : public DatabaseCallback, public ObjectFactoryCallback,
 		EventQueue					mEventQueue;
 		ObjectSet						mInRangeObjects;
 		ObjectSet::iterator mObjectSetIt;
+		InterestArea					mInterestArea;
 
 		EnqueueValidators	mEnqueueValidators;
 		ProcessValidators	mProcessValidators;
@@ -641,6 +661,8 @@ class ObjectController : public DatabaseCallback, public ObjectFactoryCallback,
 		uint64				mUnderrunTime;			// time "missed" due to late arrival of command queue.
 		int32				mMovementInactivityTrigger;
 		uint32				mFullUpdateTrigger;
+		uint8				mWorldQuery;
+		float				mWorldQueryRange;
 
 		bool				mDestroyOutOfRangeObjects;
 		bool				mInUseCommandQueue;
@@ -183,7 +183,7 @@ void PlayerObject::onSample(const SampleEvent* event)
 	float					ratio			= (resource->getDistribution((int)mPosition.x + 8192,(int)mPosition.z + 8192));
 	int32					surveyMod		= getSkillModValue(SMod_surveying);
 	uint32					sampleAmount	= 0;
-	ObjectSet::iterator	it					= mKnownObjects.begin();
+	KnownObjectSet::iterator	it			= mKnownObjects.begin();
 	string					resName			= resource->getName().getAnsi();
 	uint32					resType			= resource->getType()->getCategoryId();
 	uint16					resPE			= resource->getAttribute(ResAttr_PE);
@@ -283,15 +283,9 @@ void PlayerStructure::handleUIEvent(string strCharacterCash, string strHarvester
 				return;
 			}
 
-			bank->setCredits(bankFunds);
-			inventory->setCredits(inventoryFunds);
-			
-			gWorldManager->getDatabase()->DestroyResult(gWorldManager->getDatabase()->ExecuteSynchSql("UPDATE banks SET credits=%u WHERE id=%"PRIu64"",bank->getCredits(),bank->getId()));
-			gWorldManager->getDatabase()->DestroyResult(gWorldManager->getDatabase()->ExecuteSynchSql("UPDATE inventories SET credits=%u WHERE id=%"PRIu64"",inventory->getCredits(),inventory->getId()));
-			
-			//send the appropriate deltas.
-			gMessageLib->sendInventoryCreditsUpdate(player);
-			gMessageLib->sendBankCreditsUpdate(player);
+			// the relative updates save async and send the appropriate deltas
+			bank->updateCredits(bankFunds - bank->getCredits());
+			inventory->updateCredits(inventoryFunds - inventory->getCredits());
 
 			//get the structures conditiondamage and see whether it needs repair
 			uint32 damage = this->getDamage();
@@ -10,6 +10,11 @@ Copyright (c) 2006 - 2010 The swgANH Team
 */
 
 #include "QuadTree.h"
+#include "Object.h"
+#include "LogManager/LogManager.h"
+#include "MathLib/Rectangle.h"
+
+#include <cassert>
 
 
 //======================================================================================================================
@@ -18,13 +23,26 @@ Copyright (c) 2006 - 2010 The swgANH Team
 //
 
 QuadTree::QuadTree(float lowX,float lowZ,float width,float height,uint8 depth) :
-QuadTreeNode(lowX,lowZ,width,height)
+mLowX(lowX),
+mLowZ(lowZ),
+mWidth(width),
+mHeight(height),
+mDepth((depth > MaxDepth) ? MaxDepth : depth)
 {
-	// lets grow a tree
-	for(uint8 i = 0;i < depth;i++)
+	mLeafsPerSide	= 1 << mDepth;
+	mLeafWidth		= mWidth / mLeafsPerSide;
+	mLeafHeight		= mHeight / mLeafsPerSide;
+
+	uint32 offset = 0;
+
+	for(uint8 level = 0;level <= mDepth;level++)
 	{
-		subDivide();
+		mLevelOffsets.push_back(offset);
+		offset += 1 << (level * 2);
 	}
+
+	mCounts.resize(offset,0);
+	mLeafs.resize(mLeafsPerSide * mLeafsPerSide);
 }
 
 //======================================================================================================================
@@ -34,9 +52,352 @@ QuadTreeNode(lowX,lowZ,width,height)
 
 QuadTree::~QuadTree()
 {
+	// the objects outlive us, they must not point here anymore
+	for(uint32 i = 0;i < mLeafs.size();i++)
+	{
+		const QuadTreeEntryList& entries = mLeafs[i].getEntries();
+
+		for(uint32 j = 0;j < entries.size();j++)
+		{
+			entries[j].mObject->mQuadTree = NULL;
+		}
+	}
+
+	const QuadTreeEntryList& outside = mOutside.getEntries();
+
+	for(uint32 j = 0;j < outside.size();j++)
+	{
+		outside[j].mObject->mQuadTree = NULL;
+	}
+}
+
+//======================================================================================================================
+//
+// an object can only be filed in one tree, its taken out of any other first
+//
+
+int32 QuadTree::addObject(Object* object)
+{
+	// Validate input. Should be interesting to see.
+	assert(object && "QuadTree::addObject this method does not accept NULL objects");
+	assert(object->getId() && "QuadTree::addObject this method requires an object with a valid id");
+
+	if(object->mQuadTree == this)
+	{
+		gLogger->logMsgF("QuadTree::addObject: INSERTED OBJECT already exist = %"PRIu64"", MSG_NORMAL, object->getId());
+		return(2);
+	}
+
+	if(object->mQuadTree)
+	{
+		object->mQuadTree->removeObject(object);
+	}
+
+	_file(object);
+
+	return(1);
+}
+
+//======================================================================================================================
+
+int32 QuadTree::removeObject(Object* object)
+{
+	// Validate input. Should be interesting to see.
+	assert(object && "QuadTree::removeObject this method does not accept NULL objects");
 
+	if(object->mQuadTree != this)
+	{
+		gLogger->logMsgF("QuadTree::removeObject ERROR FAILED to REMOVE object with id = %"PRIu64"", MSG_NORMAL, object->getId());
+		return(2);
+	}
+
+	_unfile(object);
+
+	return(1);
 }
 
 //======================================================================================================================
+//
+// moving inside the loose bounds of its leaf only changes the position
+//
+
+int32 QuadTree::updateObject(Object* object, const glm::vec3& newPosition)
+{
+	// Validate input. Should be interesting to see.
+	assert(object && "QuadTree::updateObject this method does not accept NULL objects");
+
+	object->mPosition = newPosition;
+
+	if(object->mQuadTree != this)
+	{
+		return(addObject(object));
+	}
+
+	uint32 leaf = object->mQuadTreeLeaf;
+
+	if(leaf != OutsideLeaf)
+	{
+		if(_inLooseBounds(leaf,newPosition.x,newPosition.z))
+		{
+			return(0);
+		}
+	}
+	else if(!_inLooseBounds(_getLeaf(newPosition.x,newPosition.z),newPosition.x,newPosition.z))
+	{
+		return(0);
+	}
+
+	_unfile(object);
+	_file(object);
+
+	return(0);
+}
+
+//======================================================================================================================
+
+void QuadTree::getObjectsInRange(Object* object,ObjectSet* resultSet,uint32 typeMask,Anh_Math::Shape* shape) const
+{
+	_query(object,resultSet,typeMask,shape);
+}
+
+//======================================================================================================================
+//
+// used by camps to get all contained objects
+//
+
+void QuadTree::getObjectsInRangeContains(Object* object,ObjectSet* resultSet,uint32 typeMask,Anh_Math::Shape* shape) const
+{
+	_query(object,resultSet,typeMask,shape);
+}
+
+//======================================================================================================================
+//
+// walks the nodes whose loose bounds touch the rectangle and still hold objects,
+// the leafs contents are tested one by one since the loose bounds reach past the rectangle
+//
+
+void QuadTree::_query(Object* object,ObjectSet* resultSet,uint32 typeMask,Anh_Math::Shape* shape) const
+{
+	Anh_Math::Rectangle* rectangle = dynamic_cast<Anh_Math::Rectangle*>(shape);
+
+	if(!rectangle)
+	{
+		return;
+	}
+
+	const glm::vec3&	rectPos	= rectangle->getPosition();
+	float				lowX	= rectPos.x;
+	float				lowZ	= rectPos.z;
+	float				highX	= rectPos.x + rectangle->getWidth();
+	float				highZ	= rectPos.z + rectangle->getHeight();
+
+	struct Visit
+	{
+		uint8	mLevel;
+		uint32	mX;
+		uint32	mZ;
+	};
+
+	// depth first, every step takes one and puts back four
+	Visit	stack[3 * MaxDepth + 2];
+	uint32	top		= 0;
+
+	const QuadTreeNode* outside = &mOutside;
+
+	stack[top].mLevel	= 0;
+	stack[top].mX		= 0;
+	stack[top].mZ		= 0;
+	top++;
+
+	while(top || outside)
+	{
+		const QuadTreeNode* node = outside;
+
+		outside = NULL;
+
+		if(!node)
+		{
+			Visit	visit		= stack[--top];
+			uint32	perSide		= 1 << visit.mLevel;
 
+			if(!mCounts[mLevelOffsets[visit.mLevel] + visit.mZ * perSide + visit.mX])
+			{
+				continue;
+			}
+
+			float	width		= mWidth / perSide;
+			float	height		= mHeight / perSide;
+			float	looseLowX	= mLowX + visit.mX * width - width * 0.5f;
+			float	looseLowZ	= mLowZ + visit.mZ * height - height * 0.5f;
+
+			if(looseLowX > highX || looseLowX + width * 2.0f < lowX
+			|| looseLowZ > highZ || looseLowZ + height * 2.0f < lowZ)
+			{
+				continue;
+			}
+
+			if(visit.mLevel < mDepth)
+			{
+				for(uint8 i = 0;i < 4;i++)
+				{
+					stack[top].mLevel	= visit.mLevel + 1;
+					stack[top].mX		= (visit.mX << 1) + (i & 1);
+					stack[top].mZ		= (visit.mZ << 1) + (i >> 1);
+					top++;
+				}
+
+				continue;
+			}
+
+			node = &mLeafs[visit.mZ * mLeafsPerSide + visit.mX];
+		}
+
+		const QuadTreeEntryList& entries = node->getEntries();
+
+		for(uint32 i = 0;i < entries.size();i++)
+		{
+			const QuadTreeEntry& entry = entries[i];
+
+			// don't add ourself
+			if(entry.mObject == object || (entry.mType & typeMask) != entry.mType)
+			{
+				continue;
+			}
+
+			const glm::vec3& position = entry.mObject->mPosition;
+
+			if(position.x >= lowX && position.x <= highX && position.z >= lowZ && position.z <= highZ)
+			{
+				resultSet->insert(entry.mObject);
+			}
+		}
+	}
+}
+
+//======================================================================================================================
+//
+// checks if a position lies in the region of the tree
+//
+
+bool QuadTree::checkBounds(float x, float z) const
+{
+	if(x >= mLowX && x < mLowX + mWidth
+	&& z >= mLowZ && z < mLowZ + mHeight)
+	{
+		return(true);
+	}
+
+	return(false);
+}
+
+//======================================================================================================================
+
+bool QuadTree::ObjectContained(Anh_Math::Shape* shape, Object* object) const
+{
+	// rectangular
+	if(Anh_Math::Rectangle* rectangle = dynamic_cast<Anh_Math::Rectangle*>(shape))
+	{
+		const glm::vec3& rectPos = rectangle->getPosition();
+
+		// check intersection
+		if(rectPos.x > object->mPosition.x   || rectPos.x + rectangle->getWidth()  < object->mPosition.x
+		|| rectPos.z > object->mPosition.z  || rectPos.z + rectangle->getHeight() < object->mPosition.z)
+		{
+			return(false);
+		}
+
+		return(true);
+	}
+
+	// circle TODO
+	return(false);
+}
+
+//======================================================================================================================
+//
+// the leaf a position belongs in, positions outside the region get the nearest one
+//
+
+uint32 QuadTree::_getLeaf(float x, float z) const
+{
+	float	fx	= (x - mLowX) / mLeafWidth;
+	float	fz	= (z - mLowZ) / mLeafHeight;
+	uint32	ix	= (fx <= 0.0f) ? 0 : (fx >= mLeafsPerSide) ? mLeafsPerSide - 1 : static_cast<uint32>(fx);
+	uint32	iz	= (fz <= 0.0f) ? 0 : (fz >= mLeafsPerSide) ? mLeafsPerSide - 1 : static_cast<uint32>(fz);
+
+	return(iz * mLeafsPerSide + ix);
+}
+
+//======================================================================================================================
+
+bool QuadTree::_inLooseBounds(uint32 leaf, float x, float z) const
+{
+	float looseLowX = mLowX + (leaf % mLeafsPerSide) * mLeafWidth - mLeafWidth * 0.5f;
+	float looseLowZ = mLowZ + (leaf / mLeafsPerSide) * mLeafHeight - mLeafHeight * 0.5f;
+
+	return(x >= looseLowX && x <= looseLowX + mLeafWidth * 2.0f
+		&& z >= looseLowZ && z <= looseLowZ + mLeafHeight * 2.0f);
+}
+
+//======================================================================================================================
+
+void QuadTree::_file(Object* object)
+{
+	uint32 leaf = _getLeaf(object->mPosition.x,object->mPosition.z);
+
+	if(_inLooseBounds(leaf,object->mPosition.x,object->mPosition.z))
+	{
+		object->mQuadTreeSlot = mLeafs[leaf].addEntry(object,static_cast<uint32>(object->getType()));
+		_count(leaf,1);
+	}
+	else
+	{
+		leaf = OutsideLeaf;
+		object->mQuadTreeSlot = mOutside.addEntry(object,static_cast<uint32>(object->getType()));
+	}
+
+	object->mQuadTree		= this;
+	object->mQuadTreeLeaf	= leaf;
+}
+
+//======================================================================================================================
+
+void QuadTree::_unfile(Object* object)
+{
+	uint32			leaf	= object->mQuadTreeLeaf;
+	QuadTreeNode&	node	= (leaf == OutsideLeaf) ? mOutside : mLeafs[leaf];
+
+	// the last entry took over the slot
+	if(Object* moved = node.removeEntry(object->mQuadTreeSlot))
+	{
+		moved->mQuadTreeSlot = object->mQuadTreeSlot;
+	}
+
+	if(leaf != OutsideLeaf)
+	{
+		_count(leaf,-1);
+	}
+
+	object->mQuadTree = NULL;
+}
+
+//======================================================================================================================
+//
+// keeps the object counts of the leaf and all nodes above it
+//
+
+void QuadTree::_count(uint32 leaf, int32 change)
+{
+	uint32 ix = leaf % mLeafsPerSide;
+	uint32 iz = leaf / mLeafsPerSide;
+
+	for(uint8 level = 0;level <= mDepth;level++)
+	{
+		uint8 shift = mDepth - level;
+
+		mCounts[mLevelOffsets[level] + (iz >> shift) * (1 << level) + (ix >> shift)] += change;
+	}
+}
+
+//======================================================================================================================
 
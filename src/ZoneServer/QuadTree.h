@@ -14,23 +14,77 @@ Copyright (c) 2006 - 2010 The swgANH Team
 
 #include "QuadTreeNode.h"
 #include "Utils/typedefs.h"
+#include <vector>
+#include <glm/glm.hpp>
 
+namespace Anh_Math
+{
+	class Shape;
+}
 
 //======================================================================================================================
+//
+// a loose quadtree of fixed depth, kept flat
+//
+// the branches are only object counts per level, so empty parts of the region are skipped in queries,
+// the leafs hold their objects in one array each
+// a leafs loose bounds reach half a leaf past its own, an object moving inside them stays where it is
+// and only leaving them refiles it, the object knows its leaf and slot so that needs no searching
+// objects too far outside the region go into a list every query looks at
+//
 
-class QuadTree : public QuadTreeNode
+class QuadTree
 {
 	public:
 
 		QuadTree(float lowX,float lowZ,float width,float height,uint8 depth);
-		virtual ~QuadTree();
+		~QuadTree();
+
+		int32	addObject(Object* object);
+		int32	removeObject(Object* object);
+		int32	updateObject(Object* object, const glm::vec3& newPosition);
+
+		void	getObjectsInRange(Object* object,ObjectSet* resultSet,uint32 typeMask,Anh_Math::Shape* shape) const;
+		void	getObjectsInRangeContains(Object* object,ObjectSet* resultSet,uint32 typeMask,Anh_Math::Shape* shape) const;
+
+		bool	checkBounds(float x, float z) const;
+		bool	ObjectContained(Anh_Math::Shape* shape, Object* object) const;
+
+		uint32	getObjectCount() const { return mCounts[0] + mOutside.getCount(); }
+
+		static const uint8	MaxDepth	= 10;
 
-	protected:
+	private:
 
+		// leaf id of the objects in mOutside
+		static const uint32	OutsideLeaf	= 0xffffffff;
+
+		uint32	_getLeaf(float x, float z) const;
+		bool	_inLooseBounds(uint32 leaf, float x, float z) const;
+
+		// every object in a rectangular shape, the circle is not supported
+		void	_query(Object* object,ObjectSet* resultSet,uint32 typeMask,Anh_Math::Shape* shape) const;
+
+		void	_file(Object* object);
+		void	_unfile(Object* object);
+		void	_count(uint32 leaf, int32 change);
+
+		float						mLowX;
+		float						mLowZ;
+		float						mWidth;
+		float						mHeight;
+		float						mLeafWidth;
+		float						mLeafHeight;
+		uint8						mDepth;
+		uint32						mLeafsPerSide;
+
+		std::vector<uint32>			mLevelOffsets;
+		std::vector<uint32>			mCounts;		// objects below each node, level by level, rows of x
+		std::vector<QuadTreeNode>	mLeafs;
+		QuadTreeNode				mOutside;
 };
 
 //======================================================================================================================
 
 #endif
 
-
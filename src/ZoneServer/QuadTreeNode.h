@@ -12,51 +12,49 @@ Copyright (c) 2006 - 2010 The swgANH Team
 #ifndef	ANH_ZONESERVER_QUADTREE_H
 #define	ANH_ZONESERVER_QUADTREE_H
 
-#include "MathLib/Rectangle.h"
 #include "Utils/typedefs.h"
-#include <map>
 #include <set>
-#include <glm/glm.hpp>
+#include <vector>
 
 class Object;
 
-namespace Anh_Math
+typedef std::set<Object*> ObjectSet;
+
+//======================================================================================================================
+
+struct QuadTreeEntry
 {
-    class Space;
-}
+	Object*	mObject;
+	uint32	mType;
+};
 
-typedef std::map<uint64,Object*> StdObjectMap;
-typedef std::set<Object*> ObjectSet;
+typedef std::vector<QuadTreeEntry> QuadTreeEntryList;
 
 //======================================================================================================================
+//
+// the objects of one leaf, kept in one array
+// removing swaps the last entry into the freed slot, the tree fixes that objects back pointer
+//
 
-class QuadTreeNode : public Anh_Math::Rectangle
+class QuadTreeNode
 {
 	public:
 
-		QuadTreeNode(float lowX,float lowZ,float width,float height);
-		virtual ~QuadTreeNode();
+		// returns the slot the object went to
+		uint32	addEntry(Object* object,uint32 type);
 
-		int32	addObject(Object* object);
-		int32	removeObject(Object* object);
-		int32	updateObject(Object* object, const glm::vec3& newPosition);
+		// returns the object that took over the slot, NULL if it was the last one
+		Object*	removeEntry(uint32 slot);
 
-		bool	checkBounds(Object* object);
-		bool	intersects(Anh_Math::Shape* shape);
-		bool	ObjectContained(Anh_Math::Shape* shape, Object* object);
-		void	getObjectsInRange(Object* object,ObjectSet* resultSet,uint32 typeMask,Anh_Math::Shape* shape);
-		void	getObjectsInRangeContains(Object* object,ObjectSet* resultSet,uint32 typeMask,Anh_Math::Shape* shape);
-		
-		void	subDivide();
+		uint32						getCount() const { return static_cast<uint32>(mEntries.size()); }
+		const QuadTreeEntryList&	getEntries() const { return mEntries; }
 
 	protected:
 
-		QuadTreeNode**	mSubNodes;
-		StdObjectMap	mObjects;
+		QuadTreeEntryList	mEntries;
 };
 
 //======================================================================================================================
 
 #endif
 
-
@@ -15,8 +15,21 @@ RegionObject::RegionObject() : Object()
 {
 	mType = ObjType_Region;
 	mActive = false;
+	mRegionQueried = false;
 }
 
 RegionObject::~RegionObject()
 {
 }
+
+ObjectSet& RegionObject::_getRegionObjects()
+{
+	if(!mRegionQueried)
+	{
+		queryRegion();
+	}
+
+	mRegionQueried = false;
+
+	return mRegionObjects;
+}
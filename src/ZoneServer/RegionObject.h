@@ -54,18 +54,25 @@ class RegionObject : public Object
 		bool				getActive(){ return mActive; }
 		void				setActive(bool a){ mActive = a; }
 
+		// read phase of an update, only looks up the objects in the region, may run on a job thread
+		virtual void		queryRegion(){}
 		virtual void		update(){}
 		virtual void		onObjectEnter(Object* object){}
 		virtual void		onObjectLeave(Object* object){}
 
 	protected:
 
+		// what queryRegion() found, it runs now if there was no read phase
+		ObjectSet&			_getRegionObjects();
+
 		RegionType			mRegionType;
 		float				mWidth;
 		float				mHeight;
 		string				mRegionName;
 		string				mNameFile;
 		bool				mActive;
+		ObjectSet			mRegionObjects;
+		bool				mRegionQueried;
 };
 
 
@@ -13,11 +13,13 @@ Copyright (c) 2006 - 2010 The swgANH Team
 #include "CurrentResource.h"
 #include "ResourceCategory.h"
 #include "ResourceType.h"
+#include "WorldManager.h"
 #include "LogManager/LogManager.h"
 #include "DatabaseManager/Database.h"
 #include "DatabaseManager/DatabaseResult.h"
 #include "DatabaseManager/DataBinding.h"
 #include "ConfigManager/ConfigManager.h"
+#include "Utils/JobSystem.h"
 
 //======================================================================================================================
 
@@ -42,7 +44,7 @@ mDBAsyncPool(sizeof(RMAsyncContainer))
 	_setupDatabindings();
 
 	// load resource types
-	mDatabase->ExecuteSqlAsync(this,new(mDBAsyncPool.ordered_malloc()) RMAsyncContainer(RMQuery_ResourceTypes),
+	mDatabase->ExecuteReferenceSqlAsync(this,new(mDBAsyncPool.ordered_malloc()) RMAsyncContainer(RMQuery_ResourceTypes),
 		"SELECT id,category_id,namefile_name,type_name,type_swg,tang,bazaar_catID,type FROM resource_template ORDER BY id");
 }
 
@@ -195,7 +197,7 @@ void ResourceManager::handleDatabaseJobComplete(void* ref,DatabaseResult* result
 			}
 
 			// query categories
-			mDatabase->ExecuteSqlAsync(this,new(mDBAsyncPool.ordered_malloc()) RMAsyncContainer(RMQuery_Categories),"SELECT * FROM resource_categories ORDER BY id");
+			mDatabase->ExecuteReferenceSqlAsync(this,new(mDBAsyncPool.ordered_malloc()) RMAsyncContainer(RMQuery_Categories),"SELECT * FROM resource_categories ORDER BY id");
 		}
 		break;
 
@@ -283,6 +285,11 @@ void ResourceManager::handleDatabaseJobComplete(void* ref,DatabaseResult* result
 
 			uint64 count = result->getRowCount();
 
+			Anh_Utils::JobSystem*			jobSystem = gWorldManager->getJobSystem();
+			std::vector<CurrentResource*>	resources;
+
+			CurrentResource::setDistributionCachePath(gConfig->read<std::string>("ResourceMapCachePath",""),mZoneId);
+
 			for(uint64 i = 0;i < count;i++)
 			{
 				resource = new CurrentResource();
@@ -290,12 +297,38 @@ void ResourceManager::handleDatabaseJobComplete(void* ref,DatabaseResult* result
 				result->GetNextRow(mCurrentResourceBinding,resource);
 				resource->mType = getResourceTypeById(resource->mTypeId);
 				resource->mCurrent = 1;
-				resource->buildDistributionMap();
+
+				// the maps are built on the job threads, when there are any
+				if(jobSystem)
+				{
+					jobSystem->addJob(fastdelegate::MakeDelegate(resource,&CurrentResource::buildDistributionMap));
+				}
+				else
+				{
+					resource->buildDistributionMap();
+				}
+
+				resources.push_back(resource);
 				mResourceIdMap.insert(std::make_pair(resource->mId,resource));
 				mResourceCRCNameMap.insert(std::make_pair(resource->mName.getCrc(),resource));
 				(getResourceCategoryById(resource->mType->mCatId))->insertResource(resource);
 			}
 
+			if(jobSystem)
+			{
+				jobSystem->runPhase();
+			}
+
+			CurrentResource::pruneDistributionCache(resources);
+
+			if(gConfig->read<int>("writeResourceMaps"))
+			{
+				for(uint32 i = 0;i < resources.size();i++)
+				{
+					resources[i]->writeDistributionMap();
+				}
+			}
+
 			if(result->getRowCount())
 				gLogger->logMsgLoadSuccess("ResourceManager::generating %u Maps...",MSG_NORMAL,result->getRowCount());
 			else
@@ -40,10 +40,10 @@ SchematicManager::SchematicManager(Database* database)
 	mSchematicGroupList.reserve(350);
 
 	// load skillschematicgroups
-	mDatabase->ExecuteSqlAsync(this,new(mDBAsyncPool.ordered_malloc()) ScMAsyncContainer(ScMQuery_SchematicGroups),"SELECT * FROM schematic_groups ORDER BY id");
+	mDatabase->ExecuteReferenceSqlAsync(this,new(mDBAsyncPool.ordered_malloc()) ScMAsyncContainer(ScMQuery_SchematicGroups),"SELECT * FROM schematic_groups ORDER BY id");
 
 	// load experimentation groups
-	mDatabase->ExecuteSqlAsync(this,new(mDBAsyncPool.ordered_malloc()) ScMAsyncContainer(ScMQuery_ExperimentationGroups),"SELECT * FROM draft_experiment_groups ORDER BY id");
+	mDatabase->ExecuteReferenceSqlAsync(this,new(mDBAsyncPool.ordered_malloc()) ScMAsyncContainer(ScMQuery_ExperimentationGroups),"SELECT * FROM draft_experiment_groups ORDER BY id");
 }
 
 //======================================================================================================================
@@ -123,7 +123,7 @@ void SchematicManager::handleDatabaseJobComplete(void* ref,DatabaseResult* resul
 
 				asContainer = new(mDBAsyncPool.ordered_malloc()) ScMAsyncContainer(ScMQuery_GroupSchematics);
 				asContainer->mGroupId = scGroup->mId - 1;
-				mDatabase->ExecuteSqlAsync(this,asContainer,"SELECT object_string,weightsbatch_id,complexity,datasize,subCategory,craftEnabled FROM draft_schematics WHERE group_id=%u",scGroup->mId);
+				mDatabase->ExecuteReferenceSqlAsync(this,asContainer,"SELECT object_string,weightsbatch_id,complexity,datasize,subCategory,craftEnabled FROM draft_schematics WHERE group_id=%u",scGroup->mId);
 			}
 
 			mDatabase->DestroyDataBinding(binding);
@@ -187,7 +187,7 @@ void SchematicManager::handleDatabaseJobComplete(void* ref,DatabaseResult* resul
 							" WHERE"
 							" (draft_schematics_slots.schematic_id = %"PRIu64")",schemId);
 
-				mDatabase->ExecuteSqlAsync(this,asContainer,sql);
+				mDatabase->ExecuteReferenceSqlAsync(this,asContainer,sql);
 
 
 				// assemblybatches
@@ -200,7 +200,7 @@ void SchematicManager::handleDatabaseJobComplete(void* ref,DatabaseResult* resul
 							" WHERE"
 							" (draft_weights.id = %u) ORDER BY draft_assembly_batches.list_id",schematic->mWeightsBatchId);
 
-				mDatabase->ExecuteSqlAsync(this,asContainer,sql);
+				mDatabase->ExecuteReferenceSqlAsync(this,asContainer,sql);
 
 				// experimentbatches
 				asContainer = new(mDBAsyncPool.ordered_malloc()) ScMAsyncContainer(ScMQuery_SchematicExperimentBatches);
@@ -212,7 +212,7 @@ void SchematicManager::handleDatabaseJobComplete(void* ref,DatabaseResult* resul
 							" WHERE"
 							" (draft_weights.id = %u) ORDER BY draft_experiment_batches.list_id",schematic->mWeightsBatchId);
 
-				mDatabase->ExecuteSqlAsync(this,asContainer,sql);
+				mDatabase->ExecuteReferenceSqlAsync(this,asContainer,sql);
 
 				// craftingbatches
 				asContainer = new(mDBAsyncPool.ordered_malloc()) ScMAsyncContainer(ScMQuery_SchematicCraftBatches);
@@ -236,7 +236,7 @@ void SchematicManager::handleDatabaseJobComplete(void* ref,DatabaseResult* resul
 							" WHERE"
 							" (draft_weights.id = %u) ORDER BY draft_craft_batches.list_id",schematic->mWeightsBatchId);
 				  */
-				mDatabase->ExecuteSqlAsync(this,asContainer,sql);
+				mDatabase->ExecuteReferenceSqlAsync(this,asContainer,sql);
 			}
 
 			mSchematicCount += static_cast<uint32>(count);
@@ -302,7 +302,7 @@ void SchematicManager::handleDatabaseJobComplete(void* ref,DatabaseResult* resul
 				asContainer->mSchematic = schematic;
 				asContainer->mBatchId = batch->getListId();
 
-				mDatabase->ExecuteSqlAsync(this,asContainer,"SELECT datatype,distribution FROM draft_assembly_lists WHERE id=%u",asContainer->mBatchId);
+				mDatabase->ExecuteReferenceSqlAsync(this,asContainer,"SELECT datatype,distribution FROM draft_assembly_lists WHERE id=%u",asContainer->mBatchId);
 			}
 
 			mDatabase->DestroyDataBinding(binding);
@@ -333,7 +333,7 @@ void SchematicManager::handleDatabaseJobComplete(void* ref,DatabaseResult* resul
 				asContainer->mSchematic = schematic;
 				asContainer->mBatchId = batch->getListId();
 
-				mDatabase->ExecuteSqlAsync(this,asContainer,"SELECT datatype,distribution FROM draft_experiment_lists WHERE id=%u",asContainer->mBatchId);
+				mDatabase->ExecuteReferenceSqlAsync(this,asContainer,"SELECT datatype,distribution FROM draft_experiment_lists WHERE id=%u",asContainer->mBatchId);
 			}
 
 			mDatabase->DestroyDataBinding(binding);
@@ -365,14 +365,14 @@ void SchematicManager::handleDatabaseJobComplete(void* ref,DatabaseResult* resul
 				asContainer->mSchematic = schematic;
 				asContainer->mBatchId = batch->getListId();
 
-				mDatabase->ExecuteSqlAsync(this,asContainer,"SELECT type,distribution FROM draft_craft_attribute_weights WHERE id=%u",asContainer->mBatchId);
+				mDatabase->ExecuteReferenceSqlAsync(this,asContainer,"SELECT type,distribution FROM draft_craft_attribute_weights WHERE id=%u",asContainer->mBatchId);
 
 				// query attribute links and ranges
 				asContainer = new(mDBAsyncPool.ordered_malloc()) ScMAsyncContainer(ScMQuery_SchematicCraftAttributeLinks);
 				asContainer->mSchematic = schematic;
 				asContainer->mBatchId = batch->getListId();
 
-				mDatabase->ExecuteSqlAsync(this,asContainer,"SELECT attributes.name,dcial.item_attribute,dcial.attribute_min,dcial.attribute_max,dcial.attribute_type"
+				mDatabase->ExecuteReferenceSqlAsync(this,asContainer,"SELECT attributes.name,dcial.item_attribute,dcial.attribute_min,dcial.attribute_max,dcial.attribute_type"
 															" FROM draft_craft_item_attribute_link as dcial"
 															" INNER JOIN attributes ON (dcial.item_attribute = attributes.id)"
 															" WHERE list_id=%u",asContainer->mBatchId);
@@ -383,7 +383,7 @@ void SchematicManager::handleDatabaseJobComplete(void* ref,DatabaseResult* resul
 				asContainer->mSchematic = schematic;
 				asContainer->mBatchId = batch->getListId();
 
-				mDatabase->ExecuteSqlAsync(this,asContainer,
+				mDatabase->ExecuteReferenceSqlAsync(this,asContainer,
 					"SELECT dsam.Attribute, dsam.AffectedAttribute, dsam.Manipulation, a.name, b.name "
 					" FROM draft_schematic_attribute_manipulation as dsam"
 					" INNER JOIN attributes as a ON (dsam.attribute = a.id)"
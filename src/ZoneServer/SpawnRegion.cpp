@@ -36,9 +36,8 @@ SpawnRegion::~SpawnRegion()
 
 //=============================================================================
 
-void SpawnRegion::update()
+void SpawnRegion::queryRegion()
 {
-	//run about every 4.5 seconds
 	if(!mSubZoneId)
 	{
 		mQTRegion	= mSI->getQTRegion(mPosition.x,mPosition.z);
@@ -46,19 +45,29 @@ void SpawnRegion::update()
 		mQueryRect	= Anh_Math::Rectangle(mPosition.x - mWidth,mPosition.z - mHeight,mWidth * 2,mHeight * 2);
 	}
 
-	Object*		object;
-	ObjectSet	objList;
+	mRegionObjects.clear();
 
 	if(mParentId)
 	{
-		mSI->getObjectsInRange(this,&objList,ObjType_Player,mWidth);
+		mSI->getObjectsInRange(this,&mRegionObjects,ObjType_Player,mWidth);
 	}
 
 	if(mQTRegion)
 	{
-		mQTRegion->mTree->getObjectsInRange(this,&objList,ObjType_Player,&mQueryRect);
+		mQTRegion->mTree->getObjectsInRange(this,&mRegionObjects,ObjType_Player,&mQueryRect);
 	}
 
+	mRegionQueried = true;
+}
+
+//=============================================================================
+
+void SpawnRegion::update()
+{
+	//run about every 4.5 seconds
+	Object*		object;
+	ObjectSet&	objList = _getRegionObjects();
+
 	ObjectSet::iterator objIt = objList.begin();
 
 	while(objIt != objList.end())
@@ -38,6 +38,7 @@ class SpawnRegion : public RegionObject
 		void			setSpawnType(uint32 type){ mSpawnType = type; }
 		bool			isMission(){return (mMission != 0);}
 
+		virtual void	queryRegion();
 		virtual void	update();
 		virtual void	onObjectEnter(Object* object);
 		virtual void	onObjectLeave(Object* object);
@@ -77,7 +77,7 @@ StructureManager::StructureManager(Database* database,MessageDispatch* dispatch)
 	//=========================
 	//check regularly the harvesters - they might have been turned off by the db, harvesters without condition might need to be deleted
 	//do so every hour if no other timeframe is set
-	gWorldManager->getPlayerScheduler()->addTask(fastdelegate::MakeDelegate(this,&StructureManager::_handleStructureDBCheck),7,structureCheckIntervall*1000,NULL);
+	gWorldManager->getPlayerScheduler()->addTask(fastdelegate::MakeDelegate(this,&StructureManager::_handleStructureDBCheck),7,structureCheckIntervall*1000,NULL,"StructureManager::_handleStructureDBCheck");
 }
 
 
@@ -93,7 +93,7 @@ void Trade::tradeInvitationAdded(PlayerObject* inviter)
 		asyncContainer->mToBeRemoved = inviter;
 		asyncContainer->mPlayer = this;
 		//30 second timer
-		(gWorldManager->getPlayerScheduler())->addTask(fastdelegate::MakeDelegate(this,&Trade::_handleCancelTradeInvitation),7,30000,asyncContainer);
+		(gWorldManager->getPlayerScheduler())->addTask(fastdelegate::MakeDelegate(this,&Trade::_handleCancelTradeInvitation),7,30000,asyncContainer,"Trade::_handleCancelTradeInvitation");
 	}
 
 }
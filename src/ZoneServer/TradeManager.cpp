@@ -364,15 +364,15 @@ void TradeManager::handleDatabaseJobComplete(void* ref,DatabaseResult* result)
 			asyncContainer->amountbank	= asynContainer->amountbank;
 
 			Transaction* mTransaction = mDatabase->startTransaction(this,asyncContainer);
-			int8 sql[200];
-
-			sprintf(sql,"UPDATE inventories SET credits=credits-%i WHERE id=%"PRIu64"",asyncContainer->amountcash, playerObject->getId()+1);
-			mTransaction->addQuery(sql);
-			sprintf(sql,"UPDATE banks SET credits=credits-%i WHERE id=%"PRIu64"",asyncContainer->amountbank, playerObject->getId()+4);
-			mTransaction->addQuery(sql);
-			int8 query[2000];
-			sprintf(query,"INSERT INTO commerce_auction SET auction_id = %"PRIu64", owner_id = %"PRIu64", bazaar_id = %"PRIu64", type = %u, start = %u ,premium = %u, category = 0, itemtype = %u, price = %u, name = '%s', description = '%s', region_id = 0, planet_id = 0, bidder_name = '', object_string = '%s'", asynContainer->tangible->getId(),playerObject->getId(),asynContainer->BazaarID,asynContainer->auctionType,asynContainer->time,asynContainer->premium,asynContainer->itemType,asynContainer->price, asynContainer->name.getAnsi(),asynContainer->description.getAnsi(),asynContainer->tang.getAnsi());
-			mTransaction->addQuery(query);
+
+			mTransaction->addStatement("UPDATE inventories SET credits=credits-? WHERE id=?").bindInt(asyncContainer->amountcash).bindUInt(playerObject->getId()+1);
+			mTransaction->addStatement("UPDATE banks SET credits=credits-? WHERE id=?").bindInt(asyncContainer->amountbank).bindUInt(playerObject->getId()+4);
+			mTransaction->addStatement("INSERT INTO commerce_auction SET auction_id = ?, owner_id = ?, bazaar_id = ?, type = ?, start = ? ,premium = ?, category = 0, itemtype = ?, price = ?, name = ?, description = ?, region_id = 0, planet_id = 0, bidder_name = '', object_string = ?")
+				.bindUInt(asynContainer->tangible->getId()).bindUInt(playerObject->getId()).bindUInt(asynContainer->BazaarID)
+				.bindUInt(asynContainer->auctionType).bindUInt(asynContainer->time).bindUInt(asynContainer->premium).bindUInt(asynContainer->itemType).bindUInt(asynContainer->price)
+				.bindString(asynContainer->name.getAnsi(),asynContainer->name.getLength())
+				.bindString(asynContainer->description.getAnsi(),asynContainer->description.getLength())
+				.bindString(asynContainer->tang.getAnsi(),asynContainer->tang.getLength());
 			mTransaction->execute();
 
 		}
@@ -610,16 +610,11 @@ void TradeManager::_processDeductMoneyMessage(Message* message,DispatchClient* c
 
 	//ok use transactions and see to the object in memory in the postransaction
 	Transaction* mTransaction = mDatabase->startTransaction(this,asyncContainer);
-	int8 sql[200];
-	sprintf(sql,"UPDATE inventories SET credits=credits-%i WHERE id=%"PRIu64"",asyncContainer->amountcash, buyerID+1);
-	mTransaction->addQuery(sql);
-	sprintf(sql,"UPDATE banks SET credits=credits-%i WHERE id=%"PRIu64"",asyncContainer->amountbank, buyerID+4);
-	mTransaction->addQuery(sql);
-	sprintf(sql,"UPDATE banks SET credits=credits+%i WHERE id=%"PRIu64"",amount, sellerID+4);
-	mTransaction->addQuery(sql);
+	mTransaction->addStatement("UPDATE inventories SET credits=credits-? WHERE id=?").bindInt(asyncContainer->amountcash).bindUInt(buyerID+1);
+	mTransaction->addStatement("UPDATE banks SET credits=credits-? WHERE id=?").bindInt(asyncContainer->amountbank).bindUInt(buyerID+4);
+	mTransaction->addStatement("UPDATE banks SET credits=credits+? WHERE id=?").bindInt(amount).bindUInt(sellerID+4);
 	//set owner id to new owner. the item will be taken out of the bazaar in the next step IF the buyer is near
-	sprintf(sql,"UPDATE commerce_auction SET owner_id = %"PRIu64", type = %u,start = %u WHERE auction_id = %"PRIu64"",buyerID,TRMVendor_Cancelled,time,itemID);
-	mTransaction->addQuery(sql);
+	mTransaction->addStatement("UPDATE commerce_auction SET owner_id = ?, type = ?,start = ? WHERE auction_id = ?").bindUInt(buyerID).bindUInt(TRMVendor_Cancelled).bindUInt(time).bindUInt(itemID);
 
 	mTransaction->execute();
 }
@@ -902,17 +897,14 @@ void TradeManager::TradeTransaction(DispatchClient* client,PlayerObject* player1
 	asyncContainer->player1 = player1;
 	asyncContainer->player2 = player2;
 
-	int8 sql[128];
 	//trade uses always cash (thats what the client checks)
 	asyncContainer->amount1 = player1->getTrade()->getTradeCredits();
 	asyncContainer->amount2 = player2->getTrade()->getTradeCredits();
 	Transaction* mTransaction = mDatabase->startTransaction(this,asyncContainer);
 
 	if (player1->testCash(asyncContainer->amount1) && player2->testCash(asyncContainer->amount2)){
-		sprintf(sql,"UPDATE inventories SET credits=credits+%i WHERE id=%"PRIu64"",-asyncContainer->amount1+asyncContainer->amount2, player1->getId()+1);
-		mTransaction->addQuery(sql);
-		sprintf(sql,"UPDATE inventories SET credits=credits+%i WHERE id=%"PRIu64"",-asyncContainer->amount2+asyncContainer->amount1, player2->getId()+1);
-		mTransaction->addQuery(sql);
+		mTransaction->addStatement("UPDATE inventories SET credits=credits+? WHERE id=?").bindInt(-asyncContainer->amount1+asyncContainer->amount2).bindUInt(player1->getId()+1);
+		mTransaction->addStatement("UPDATE inventories SET credits=credits+? WHERE id=?").bindInt(-asyncContainer->amount2+asyncContainer->amount1).bindUInt(player2->getId()+1);
 
 		//now we need to add the items
 
@@ -111,15 +111,9 @@ void TreasuryManager::bankDepositAll(PlayerObject* playerObject)
 			{
 				// bank credits = bank + inventory.
 				// inventory = 0
-				bank->setCredits(bank->getCredits() + credits);
-				inventory->setCredits(0);
-				// save to the db
-				mDatabase->DestroyResult(mDatabase->ExecuteSynchSql("UPDATE banks SET credits=%u WHERE id=%"PRIu64"",bank->getCredits(),bank->getId()));
-				mDatabase->DestroyResult(mDatabase->ExecuteSynchSql("UPDATE inventories SET credits=%u WHERE id=%"PRIu64"",inventory->getCredits(),inventory->getId()));
-
-				//send the appropriate deltas.
-				gMessageLib->sendInventoryCreditsUpdate(playerObject);
-				gMessageLib->sendBankCreditsUpdate(playerObject);
+				// the relative updates save async and send the appropriate deltas
+				bank->updateCredits(credits);
+				inventory->updateCredits(-credits);
 
 				gMessageLib->sendSystemMessage(playerObject,L"","base_player","prose_deposit_success","","",L"",credits);
 			}
@@ -141,17 +135,10 @@ void TreasuryManager::bankWithdrawAll(PlayerObject* playerObject)
 
 				// inventory credits = bank + inventory.
 				// bank = 0
-				inventory->setCredits(inventory->getCredits() + bank->getCredits());
-				bank->setCredits(0);
-
-				// save to the db
-				// FIXME: will need to replace (playerID+4) by the real bankID
-				mDatabase->DestroyResult(mDatabase->ExecuteSynchSql("UPDATE banks SET credits=%u WHERE id=%"PRIu64"",bank->getCredits(),bank->getId()));
-				mDatabase->DestroyResult(mDatabase->ExecuteSynchSql("UPDATE inventories SET credits=%u WHERE id=%"PRIu64"",inventory->getCredits(),inventory->getId()));
-
-				//send the appropriate deltas.
-				gMessageLib->sendInventoryCreditsUpdate(playerObject);
-				gMessageLib->sendBankCreditsUpdate(playerObject);
+				// the relative updates save async and send the appropriate deltas
+				int32 credits = bank->getCredits();
+				inventory->updateCredits(credits);
+				bank->updateCredits(-credits);
 			}
 		}
 	}
@@ -298,7 +285,7 @@ void TreasuryManager::bankJoin(PlayerObject* playerObject)
 
 void TreasuryManager::saveAndUpdateInventoryCredits(PlayerObject* playerObject)
 {
-	mDatabase->DestroyResult(mDatabase->ExecuteSynchSql("UPDATE inventories SET credits=%u WHERE id=%"PRIu64"",dynamic_cast<Inventory*>(playerObject->getEquipManager()->getEquippedObject(CreatureEquipSlot_Inventory))->getCredits(),playerObject->getId() + 1));
+	mDatabase->ExecuteSqlAsync(NULL,NULL,"UPDATE inventories SET credits=%u WHERE id=%"PRIu64"",dynamic_cast<Inventory*>(playerObject->getEquipManager()->getEquippedObject(CreatureEquipSlot_Inventory))->getCredits(),playerObject->getId() + 1);
 	gMessageLib->sendInventoryCreditsUpdate(playerObject);
 }
 
@@ -306,7 +293,7 @@ void TreasuryManager::saveAndUpdateInventoryCredits(PlayerObject* playerObject)
 
 void TreasuryManager::saveAndUpdateBankCredits(PlayerObject* playerObject)
 {
-	mDatabase->DestroyResult(mDatabase->ExecuteSynchSql("UPDATE banks SET credits=%u WHERE id=%"PRIu64"",dynamic_cast<Bank*>(playerObject->getEquipManager()->getEquippedObject(CreatureEquipSlot_Bank))->getCredits(), playerObject->getId() + 4));
+	mDatabase->ExecuteSqlAsync(NULL,NULL,"UPDATE banks SET credits=%u WHERE id=%"PRIu64"",dynamic_cast<Bank*>(playerObject->getEquipManager()->getEquippedObject(CreatureEquipSlot_Bank))->getCredits(), playerObject->getId() + 4);
 	gMessageLib->sendBankCreditsUpdate(playerObject);
 }
 
@@ -438,11 +425,8 @@ void TreasuryManager::handleDatabaseJobComplete(void* ref,DatabaseResult* result
 			asyncContainer->targetName = asynContainer->targetName;
 
 			Transaction* mTransaction = mDatabase->startTransaction(this,asyncContainer);
-			int8 sql[256];
-			sprintf(sql,"UPDATE banks SET credits=credits-%i WHERE id=%"PRIu64"",asynContainer->amount, asynContainer->player->getId()+4);
-			mTransaction->addQuery(sql);
-			sprintf(sql,"UPDATE banks SET credits=credits+%i WHERE id=%"PRIu64"",asynContainer->amount, id+4);
-			mTransaction->addQuery(sql);
+			mTransaction->addStatement("UPDATE banks SET credits=credits-? WHERE id=?").bindInt(asynContainer->amount).bindUInt(asynContainer->player->getId()+4);
+			mTransaction->addStatement("UPDATE banks SET credits=credits+? WHERE id=?").bindInt(asynContainer->amount).bindUInt(id+4);
 
 			mTransaction->execute();
 
@@ -42,6 +42,38 @@ mInstanceEnabled(false)
 	
 
 
+//======================================================================================================================
+
+void WorldConfig::_verifyTransformTier(TransformTier& tier)
+{
+	if(tier.mNearRange < 8.0f)
+		tier.mNearRange = 8.0f;
+
+	if(tier.mMidRange < tier.mNearRange)
+		tier.mMidRange = tier.mNearRange;
+
+	if(tier.mMidInterval < 1)
+		tier.mMidInterval = 1;
+	else if(tier.mMidInterval > 10)
+		tier.mMidInterval = 10;
+
+	if(tier.mFarDistance < 0.5f)
+		tier.mFarDistance = 0.5f;
+	else if(tier.mFarDistance > 32.0f)
+		tier.mFarDistance = 32.0f;
+
+	// 0 turns dead reckoning off
+	if(tier.mPredictionError < 0.0f)
+		tier.mPredictionError = 0.0f;
+	else if(tier.mPredictionError > 8.0f)
+		tier.mPredictionError = 8.0f;
+
+	if(tier.mKeyframeInterval < 250)
+		tier.mKeyframeInterval = 250;
+	else if(tier.mKeyframeInterval > 10000)
+		tier.mKeyframeInterval = 10000;
+}
+
 //======================================================================================================================
 
 WorldConfig* WorldConfig::Init(uint32 zoneId,Database* database, string zoneName)
@@ -99,6 +131,35 @@ void WorldConfig::handleDatabaseJobComplete(void* ref,DatabaseResult* result)
 		mPlayerChatRange = 32;
 
 
+	// Player area of interest cells
+	mPlayerAoiCellSize = gWorldConfig->getConfiguration("Zone_Player_AoiCellSize",(uint16)32);
+
+	if(mPlayerAoiCellSize > 128)
+		mPlayerAoiCellSize = 128;
+	else if(mPlayerAoiCellSize && mPlayerAoiCellSize < 8)
+		mPlayerAoiCellSize = 8;
+
+	// movement broadcast tiers
+	bool transformTiers = (gWorldConfig->getConfiguration("Zone_Transform_Tiers",(uint16)1) != 0);
+
+	mPlayerTransformTier.mEnabled		= transformTiers;
+	mPlayerTransformTier.mNearRange		= gWorldConfig->getConfiguration("Zone_Transform_Player_NearRange",48.0f);
+	mPlayerTransformTier.mMidRange		= gWorldConfig->getConfiguration("Zone_Transform_Player_MidRange",96.0f);
+	mPlayerTransformTier.mMidInterval	= gWorldConfig->getConfiguration("Zone_Transform_Player_MidInterval",(uint32)2);
+	mPlayerTransformTier.mFarDistance	= gWorldConfig->getConfiguration("Zone_Transform_Player_FarDistance",4.0f);
+	mPlayerTransformTier.mPredictionError	= gWorldConfig->getConfiguration("Zone_Transform_Player_PredictionError",0.5f);
+	mPlayerTransformTier.mKeyframeInterval	= gWorldConfig->getConfiguration("Zone_Transform_Player_KeyframeInterval",(uint64)2000);
+	_verifyTransformTier(mPlayerTransformTier);
+
+	mNpcTransformTier.mEnabled			= transformTiers;
+	mNpcTransformTier.mNearRange		= gWorldConfig->getConfiguration("Zone_Transform_Npc_NearRange",32.0f);
+	mNpcTransformTier.mMidRange			= gWorldConfig->getConfiguration("Zone_Transform_Npc_MidRange",80.0f);
+	mNpcTransformTier.mMidInterval		= gWorldConfig->getConfiguration("Zone_Transform_Npc_MidInterval",(uint32)3);
+	mNpcTransformTier.mFarDistance		= gWorldConfig->getConfiguration("Zone_Transform_Npc_FarDistance",8.0f);
+	mNpcTransformTier.mPredictionError	= gWorldConfig->getConfiguration("Zone_Transform_Npc_PredictionError",1.0f);
+	mNpcTransformTier.mKeyframeInterval	= gWorldConfig->getConfiguration("Zone_Transform_Npc_KeyframeInterval",(uint64)3000);
+	_verifyTransformTier(mNpcTransformTier);
+
 	// Server Time Update Frequency
 	
 	mServerTimeInterval = gWorldConfig->getConfiguration("Server_Time_Interval",30);
@@ -31,6 +31,31 @@ class DatabaseResult;
 
 typedef std::map<uint32,std::string>	 ConfigurationMap;
 
+//======================================================================================================================
+//
+// distance tiers for movement broadcasts
+// observers within mNearRange get every update, within mMidRange every mMidInterval th one,
+// further away only when the object moved mFarDistance or turned noticeably since
+//
+// updates predicted by the last one sent within mPredictionError are not broadcast at all,
+// at least one every mKeyframeInterval ms is
+//
+
+class TransformTier
+{
+	public:
+
+		TransformTier() : mNearRange(0.0f),mMidRange(0.0f),mFarDistance(0.0f),mPredictionError(0.0f),mMidInterval(1),mKeyframeInterval(0),mEnabled(false){}
+
+		float	mNearRange;
+		float	mMidRange;
+		float	mFarDistance;
+		float	mPredictionError;
+		uint32	mMidInterval;
+		uint64	mKeyframeInterval;
+		bool	mEnabled;
+};
+
 class Configuration_QueryContainer
 {
 	public:
@@ -79,6 +104,11 @@ class WorldConfig : public DatabaseCallback
 
 		uint16				getPlayerViewingRange(){ return mPlayerViewingRange; }
 		uint16				getPlayerChatRange(){ return mPlayerChatRange; }
+		uint16				getPlayerAoiCellSize(){ return mPlayerAoiCellSize; }
+
+		// movement broadcast tiers, players and their mounts or everything else
+		const TransformTier&	getPlayerTransformTier() const { return mPlayerTransformTier; }
+		const TransformTier&	getNpcTransformTier() const { return mNpcTransformTier; }
 		
 		uint32				getServerTimeInterval(){ return mServerTimeInterval; }
 		uint32				getServerTimeSpeed(){ return mServerTimeSpeed; }
@@ -103,6 +133,8 @@ class WorldConfig : public DatabaseCallback
 
 		WorldConfig(uint32 zoneId,Database* database, string zoneName);
 
+		void				_verifyTransformTier(TransformTier& tier);
+
 		ConfigurationMap		mConfigurationMap;
 		static WorldConfig*		mSingleton;
 		bool					mLoadComplete;
@@ -124,6 +156,13 @@ class WorldConfig : public DatabaseCallback
 		// Player chat range
 		uint16				mPlayerChatRange;
 
+		// Player area of interest cell size, static objects are tracked per cell around the player, 0 queries the full range every update
+		uint16				mPlayerAoiCellSize;
+
+		// movement broadcast tiers
+		TransformTier		mPlayerTransformTier;
+		TransformTier		mNpcTransformTier;
+
 		// Logged Timeout, time until a disconnected player gets removed from the world
 		uint32				mLoggedTime;
 
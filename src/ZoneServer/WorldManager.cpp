@@ -25,6 +25,7 @@ Copyright (c) 2006 - 2010 The swgANH Team
 #include "CreatureSpawnRegion.h"
 #include "GroupManager.h"
 #include "GroupObject.h"
+#include "HamRegenEngine.h"
 #include "Heightmap.h"
 #include "MissionManager.h"
 #include "NpcManager.h"
@@ -57,10 +58,12 @@ Copyright (c) 2006 - 2010 The swgANH Team
 #include "MessageLib/MessageLib.h"
 #include "ScriptEngine/ScriptEngine.h"
 #include "ScriptEngine/ScriptSupport.h"
+#include "Utils/JobSystem.h"
 #include "Utils/Scheduler.h"
 #include "Utils/VariableTimeScheduler.h"
 #include "Utils/utils.h"
 
+#include <algorithm>
 #include <cassert>
 
 //======================================================================================================================
@@ -88,6 +91,27 @@ WorldManager::WorldManager(uint32 zoneId,ZoneServer* zoneServer,Database* databa
 						2,
 						gConfig->read<float>("Horizon"));
 
+	// rtree or grid, the grid keeps points in uniform cells, regions always stay in the tree
+	if(gConfig->read<std::string>("SpatialIndexPoints","rtree") == "grid")
+	{
+		mSpatialIndex->InitPointGrid(gConfig->read<float>("SpatialGridCellSize",64.0f),gConfig->read<float>("SpatialGridExtent",8192.0f));
+	}
+
+	std::string spatialRecord = gConfig->read<std::string>("SpatialIndexRecord","");
+	if(!spatialRecord.empty())
+	{
+		mSpatialIndex->StartRecording(spatialRecord);
+	}
+
+	// read phases (world update queries, region queries) run as jobs on workers, the main thread works along
+	mJobSystem = NULL;
+
+	if(uint32 jobThreads = std::min<uint32>(gConfig->read<uint32>("JobThreads",0),32))
+	{
+		mJobSystem = new Anh_Utils::JobSystem(jobThreads);
+		gLogger->logMsgF("WorldManager::StartUp: %u job threads",MSG_NORMAL,jobThreads);
+	}
+
 	try
 	{
 		mDebug = gConfig->read<bool>("LoadReduceDebug");
@@ -101,7 +125,7 @@ WorldManager::WorldManager(uint32 zoneId,ZoneServer* zoneServer,Database* databa
 	// create schedulers
 	mSubsystemScheduler		= new Anh_Utils::Scheduler();
 	mObjControllerScheduler = new Anh_Utils::Scheduler();
-	mHamRegenScheduler		= new Anh_Utils::Scheduler();
+	mHamRegenEngine			= new HamRegenEngine();
 	mPlayerScheduler		= new Anh_Utils::Scheduler();
 	mEntertainerScheduler	= new Anh_Utils::Scheduler();
 	mBuffScheduler			= new Anh_Utils::VariableTimeScheduler(100, 100);
@@ -109,6 +133,22 @@ WorldManager::WorldManager(uint32 zoneId,ZoneServer* zoneServer,Database* databa
 	mNpcManagerScheduler	= new Anh_Utils::Scheduler();
 	mAdminScheduler			= new Anh_Utils::Scheduler();
 
+	// runtime figures of every task, logged and cleared every SchedulerStatsInterval seconds
+	if(uint32 statsInterval = gConfig->read<uint32>("SchedulerStatsInterval",0))
+	{
+		mSubsystemScheduler->enableStats("Subsystem");
+		mObjControllerScheduler->enableStats("ObjController");
+		mHamRegenEngine->enableStats("HamRegen");
+		mPlayerScheduler->enableStats("Player");
+		mEntertainerScheduler->enableStats("Entertainer");
+		mBuffScheduler->enableStats("Buff");
+		mMissionScheduler->enableStats("Mission");
+		mNpcManagerScheduler->enableStats("NpcManager");
+		mAdminScheduler->enableStats("Admin");
+
+		mSubsystemScheduler->addTask(fastdelegate::MakeDelegate(this,&WorldManager::_handleSchedulerStats),9,statsInterval * 1000,NULL,"WorldManager::_handleSchedulerStats");
+	}
+
 	LoadCurrentGlobalTick();
 
 
@@ -189,7 +229,7 @@ void WorldManager::Shutdown()
 	delete(mAdminScheduler);
 	delete(mNpcManagerScheduler);
 	delete(mObjControllerScheduler);
-	delete(mHamRegenScheduler);
+	delete(mHamRegenEngine);
 	delete(mMissionScheduler);
 	delete(mPlayerScheduler);
 	delete(mEntertainerScheduler);
@@ -201,6 +241,9 @@ void WorldManager::Shutdown()
 	// as the playerobjects try to remove the Objectcontroller scheduler and crash us if the scheduler isnt existent anymore
 	delete(mSubsystemScheduler);
 
+	delete(mJobSystem);
+	mJobSystem = NULL;
+
 	mPlayersToRemove.clear();
 	mRegionMap.clear();
 
@@ -272,6 +315,7 @@ void WorldManager::Shutdown()
 	// shutdown SI
 	mSpatialIndex->ShutDown();
 	delete(mSpatialIndex);
+	mSpatialIndex = NULL;
 
 	// finally delete them
 	mQTRegionMap.clear();
@@ -350,6 +394,8 @@ uint64 WorldManager::GetCurrentGlobalTick()
 
 //======================================================================================================================
 //still synch issues to adress with other servers
+//only called once from the constructor, before any client can connect. The query stays synchronous
+//since buffs restored with the first players are timed against mTick and must not see it unset
 //
 
 void WorldManager::LoadCurrentGlobalTick()
@@ -368,7 +414,7 @@ void WorldManager::LoadCurrentGlobalTick()
 	sprintf(strtemp, "Current Global Tick Count = %"PRIu64"\n",Tick);
 	gLogger->logMsg(strtemp, FOREGROUND_GREEN);
 	mTick = Tick;
-	mSubsystemScheduler->addTask(fastdelegate::MakeDelegate(this,&WorldManager::_handleTick),7,1000,NULL);
+	mSubsystemScheduler->addTask(fastdelegate::MakeDelegate(this,&WorldManager::_handleTick),7,1000,NULL,"WorldManager::_handleTick");
 }
 
 //======================================================================================================================
@@ -381,6 +427,35 @@ bool	WorldManager::_handleTick(uint64 callTime,void* ref)
 	return true;
 }
 
+//======================================================================================================================
+//
+// logs the busiest tasks of every scheduler and how far behind it fell, then starts counting again
+//
+
+bool	WorldManager::_handleSchedulerStats(uint64 callTime,void* ref)
+{
+	Anh_Utils::SchedulerStats* stats[] =
+	{
+		mSubsystemScheduler->getStats(),
+		mObjControllerScheduler->getStats(),
+		mHamRegenEngine->getStats(),
+		mPlayerScheduler->getStats(),
+		mEntertainerScheduler->getStats(),
+		mBuffScheduler->getStats(),
+		mMissionScheduler->getStats(),
+		mNpcManagerScheduler->getStats(),
+		mAdminScheduler->getStats()
+	};
+
+	for(uint32 i = 0; i < sizeof(stats) / sizeof(stats[0]); i++)
+	{
+		gLogger->logMsgF("%s",MSG_NORMAL,stats[i]->getReport().c_str());
+		stats[i]->reset();
+	}
+
+	return true;
+}
+
 //======================================================================================================================
 //
 //
@@ -410,7 +485,7 @@ void WorldManager::Process()
 
 void WorldManager::_processSchedulers()
 {
-	mHamRegenScheduler->process();
+	mHamRegenEngine->process(Anh_Utils::Clock::getSingleton()->getLocalTime());
 	mSubsystemScheduler->process();
 	mObjControllerScheduler->process();
 	mPlayerScheduler->process();
@@ -699,23 +774,14 @@ void WorldManager::addCreatureObjectForTimedDeletion(uint64 creatureId, uint64 w
 
 	// gLogger->logMsgF("WorldManager::addCreatureObjectForTimedDeletion Adding new at %"PRIu64"",MSG_NORMAL, expireTime + when);
 
-	CreatureObjectDeletionMap::iterator it = mCreatureObjectDeletionMap.find(creatureId);
-	if (it != mCreatureObjectDeletionMap.end())
+	// Only move the deletion if the new expire time is earlier than old. (else people can use "lootall" to add 10 new seconds to a corpse forever).
+	if (mCreatureObjectDeletionMap.contains(creatureId) && (expireTime + when >= mCreatureObjectDeletionMap.getDeadline(creatureId)))
 	{
-		// Only remove object if new expire time is earlier than old. (else people can use "lootall" to add 10 new seconds to a corpse forever).
-		if (expireTime + when < (*it).second)
-		{
-			// gLogger->logMsgF("Removing object with id %"PRIu64"",MSG_NORMAL, creatureId);
-			mCreatureObjectDeletionMap.erase(it);
-		}
-		else
-		{
-			return;
-		}
-
+		return;
 	}
+
 	// gLogger->logMsgF("Adding new object with id %"PRIu64"",MSG_NORMAL, creatureId);
-	mCreatureObjectDeletionMap.insert(std::make_pair(creatureId, expireTime + when));
+	mCreatureObjectDeletionMap.schedule(creatureId, expireTime + when);
 }
 
 
@@ -777,7 +843,7 @@ void WorldManager::addAdminRequest(uint64 requestId, uint64 when)
 	gLogger->logMsgF("Adding admin request %d for schedule in %"PRIu64" minutes(s) and %"PRIu64" second(s)", MSG_NORMAL, requestId, when/60000, when % 60000);
 
 	uint64 expireTime = Anh_Utils::Clock::getSingleton()->getLocalTime();
-	mAdminRequestHandlers.insert(std::make_pair(requestId, expireTime + when));
+	mAdminRequestHandlers.insert(requestId, expireTime + when);
 
 }
 
@@ -788,13 +854,8 @@ void WorldManager::addAdminRequest(uint64 requestId, uint64 when)
 
 void WorldManager::cancelAdminRequest(int32 requestId)
 {
-	AdminRequestHandlers::iterator it = mAdminRequestHandlers.find(requestId);
-
-	if (it != mAdminRequestHandlers.end())
-	{
-		// Cancel shutdown.
-		mAdminRequestHandlers.erase(it);
-	}
+	// Cancel shutdown.
+	mAdminRequestHandlers.remove(requestId);
 }
 
 //======================================================================================================================
@@ -806,30 +867,24 @@ bool WorldManager::_handleAdminRequests(uint64 callTime, void* ref)
 {
 
 	// callTime = callTime - (callTime % 1000)
-	AdminRequestHandlers::iterator it = mAdminRequestHandlers.begin();
-	while (it != mAdminRequestHandlers.end())
-	{
-		//  The timer has expired?
-		if (callTime >= ((*it).second))
-		{
-			// Yes, handle it.
-			uint64 waitTime = AdminManager::Instance()->handleAdminRequest(((*it).first), callTime - ((*it).second));
+	uint64 requestId;
+	uint64 deadline;
 
-			if (waitTime)
-			{
-				// Set next execution time.
-				(*it).second = callTime + waitTime;
-			}
-			else
-			{
-				gLogger->logMsgF("Removed expired handler for admin request %d", MSG_NORMAL, (*it).first);
+	// Only the expired requests come out.
+	while (mAdminRequestHandlers.popExpired(callTime, requestId, deadline))
+	{
+		// Handle it.
+		uint64 waitTime = AdminManager::Instance()->handleAdminRequest(requestId, callTime - deadline);
 
-				// Requested to remove the handler.
-				mAdminRequestHandlers.erase(it++);
-				continue;
-			}
+		if (waitTime)
+		{
+			// Set next execution time.
+			mAdminRequestHandlers.schedule(requestId, callTime + waitTime);
+		}
+		else
+		{
+			gLogger->logMsgF("Removed expired handler for admin request %d", MSG_NORMAL, requestId);
 		}
-		++it;
 	}
 
 	return true;
@@ -894,31 +949,31 @@ void WorldManager::_handleLoadComplete()
 	mTotalObjectCount = 0;
 
 	// initialize timers
-	mSubsystemScheduler->addTask(fastdelegate::MakeDelegate(this,&WorldManager::_handleShuttleUpdate),7,1000,NULL);
-	mSubsystemScheduler->addTask(fastdelegate::MakeDelegate(this,&WorldManager::_handleServerTimeUpdate),9,gWorldConfig->getServerTimeInterval()*1000,NULL);
-	mSubsystemScheduler->addTask(fastdelegate::MakeDelegate(this,&WorldManager::_handleDisconnectUpdate),1,1000,NULL);
-	mSubsystemScheduler->addTask(fastdelegate::MakeDelegate(this,&WorldManager::_handleRegionUpdate),2,2000,NULL);
-	mSubsystemScheduler->addTask(fastdelegate::MakeDelegate(this,&WorldManager::_handleCraftToolTimers),3,1000,NULL);
-	mSubsystemScheduler->addTask(fastdelegate::MakeDelegate(this,&WorldManager::_handleNpcConversionTimers),8,1000,NULL);
+	mSubsystemScheduler->addTask(fastdelegate::MakeDelegate(this,&WorldManager::_handleShuttleUpdate),7,1000,NULL,"WorldManager::_handleShuttleUpdate");
+	mSubsystemScheduler->addTask(fastdelegate::MakeDelegate(this,&WorldManager::_handleServerTimeUpdate),9,gWorldConfig->getServerTimeInterval()*1000,NULL,"WorldManager::_handleServerTimeUpdate");
+	mSubsystemScheduler->addTask(fastdelegate::MakeDelegate(this,&WorldManager::_handleDisconnectUpdate),1,1000,NULL,"WorldManager::_handleDisconnectUpdate");
+	mSubsystemScheduler->addTask(fastdelegate::MakeDelegate(this,&WorldManager::_handleRegionUpdate),2,2000,NULL,"WorldManager::_handleRegionUpdate");
+	mSubsystemScheduler->addTask(fastdelegate::MakeDelegate(this,&WorldManager::_handleCraftToolTimers),3,1000,NULL,"WorldManager::_handleCraftToolTimers");
+	mSubsystemScheduler->addTask(fastdelegate::MakeDelegate(this,&WorldManager::_handleNpcConversionTimers),8,1000,NULL,"WorldManager::_handleNpcConversionTimers");
 	
 	//is this really necessary ?
 	//whenever someone creates something near us were updated on it anyway ... ?
-	mSubsystemScheduler->addTask(fastdelegate::MakeDelegate(this,&WorldManager::_handlePlayerMovementUpdateTimers),4,5000,NULL);
+	mSubsystemScheduler->addTask(fastdelegate::MakeDelegate(this,&WorldManager::_handlePlayerMovementUpdateTimers),4,5000,NULL,"WorldManager::_handlePlayerMovementUpdateTimers");
 	
-	mSubsystemScheduler->addTask(fastdelegate::MakeDelegate(this,&WorldManager::_handleGeneralObjectTimers),5,2000,NULL);
-	mSubsystemScheduler->addTask(fastdelegate::MakeDelegate(this,&WorldManager::_handleGroupObjectTimers),5,gWorldConfig->getGroupMissionUpdateTime(),NULL);
-	mSubsystemScheduler->addTask(fastdelegate::MakeDelegate(this,&WorldManager::_handleVariousUpdates),7,2000, NULL);
+	mSubsystemScheduler->addTask(fastdelegate::MakeDelegate(this,&WorldManager::_handleGeneralObjectTimers),5,2000,NULL,"WorldManager::_handleGeneralObjectTimers");
+	mSubsystemScheduler->addTask(fastdelegate::MakeDelegate(this,&WorldManager::_handleGroupObjectTimers),5,gWorldConfig->getGroupMissionUpdateTime(),NULL,"WorldManager::_handleGroupObjectTimers");
+	mSubsystemScheduler->addTask(fastdelegate::MakeDelegate(this,&WorldManager::_handleVariousUpdates),7,2000,NULL,"WorldManager::_handleVariousUpdates");
 
 	// Init NPC Manager, will load lairs from the DB.
 	(void)NpcManager::Instance();
 
 	// Initialize the queues for NPC-Manager.
-	mNpcManagerScheduler->addTask(fastdelegate::MakeDelegate(this,&WorldManager::_handleDormantNpcs),5,2500,NULL);
-	mNpcManagerScheduler->addTask(fastdelegate::MakeDelegate(this,&WorldManager::_handleReadyNpcs),5,1000,NULL);
-	mNpcManagerScheduler->addTask(fastdelegate::MakeDelegate(this,&WorldManager::_handleActiveNpcs),5,250,NULL);
+	mNpcManagerScheduler->addTask(fastdelegate::MakeDelegate(this,&WorldManager::_handleDormantNpcs),5,2500,NULL,"WorldManager::_handleDormantNpcs");
+	mNpcManagerScheduler->addTask(fastdelegate::MakeDelegate(this,&WorldManager::_handleReadyNpcs),5,1000,NULL,"WorldManager::_handleReadyNpcs");
+	mNpcManagerScheduler->addTask(fastdelegate::MakeDelegate(this,&WorldManager::_handleActiveNpcs),5,250,NULL,"WorldManager::_handleActiveNpcs");
 
 	// Initialize static creature lairs.
-	mAdminScheduler->addTask(fastdelegate::MakeDelegate(this,&WorldManager::_handleAdminRequests),5,5000,NULL);
+	mAdminScheduler->addTask(fastdelegate::MakeDelegate(this,&WorldManager::_handleAdminRequests),5,5000,NULL,"WorldManager::_handleAdminRequests");
 }
 
 //======================================================================================================================
@@ -945,6 +1000,20 @@ bool WorldManager::_handleRegionUpdate(uint64 callTime,void* ref)
 {
 	ActiveRegions::iterator it = mActiveRegions.begin();
 
+	// the regions look up who is inside them in parallel, entering and leaving is handled after
+	if(mJobSystem)
+	{
+		while(it != mActiveRegions.end())
+		{
+			mJobSystem->addJob(fastdelegate::MakeDelegate(*it,&RegionObject::queryRegion));
+			++it;
+		}
+
+		mJobSystem->runPhase();
+
+		it = mActiveRegions.begin();
+	}
+
 	while(it != mActiveRegions.end())
 	{
 		(*it)->update();
@@ -1027,22 +1096,22 @@ void WorldManager::removeEntertainerToProcess(uint64 taskId)
 
 //======================================================================================================================
 //
-// add a creature from the ham regeneration scheduler
+// add a creature to the ham regeneration
 //
 uint64 WorldManager::addCreatureHamToProccess(Ham* ham)
 {
-    return((mHamRegenScheduler->addTask(fastdelegate::MakeDelegate(ham,&Ham::regenerate),1,1000,NULL)));
+    return(mHamRegenEngine->add(ham));
 }
 
 
 //======================================================================================================================
 //
-// remove a creature from the ham regeneration scheduler
+// remove a creature from the ham regeneration
 //
 
 void WorldManager::removeCreatureHamToProcess(uint64 taskId)
 {
-	mHamRegenScheduler->removeTask(taskId);
+	mHamRegenEngine->remove(taskId);
 }
 
 
@@ -1050,7 +1119,7 @@ void WorldManager::removeCreatureHamToProcess(uint64 taskId)
 
 bool WorldManager::checkTask(uint64 id)
 {
-    return mHamRegenScheduler->checkTask(id);
+    return mHamRegenEngine->contains(id);
 }
 
 
@@ -1061,7 +1130,7 @@ bool WorldManager::checkTask(uint64 id)
 
 uint64 WorldManager::addObjControllerToProcess(ObjectController* objController)
 {
-    return((mObjControllerScheduler->addTask(fastdelegate::MakeDelegate(objController,&ObjectController::process),1,125,NULL)));
+    return((mObjControllerScheduler->addTask(fastdelegate::MakeDelegate(objController,&ObjectController::process),1,125,NULL,"ObjectController::process")));
 }
 
 
@@ -1080,7 +1149,7 @@ void WorldManager::removeObjControllerToProcess(uint64 taskId)
 
 uint64 WorldManager::addMissionToProcess(MissionObject* mission)
 {
-    return mMissionScheduler->addTask(fastdelegate::MakeDelegate(mission,&MissionObject::check),1,10000,NULL);
+    return mMissionScheduler->addTask(fastdelegate::MakeDelegate(mission,&MissionObject::check),1,10000,NULL,"MissionObject::check");
 }
 
 
@@ -1104,7 +1173,7 @@ bool WorldManager::checkForMissionProcess(uint64 taskId)
 
 uint64 WorldManager::addEntertainerToProccess(CreatureObject* entertainerObject,uint32 tick)
 {
-    return((mEntertainerScheduler->addTask(fastdelegate::MakeDelegate(entertainerObject,&CreatureObject::handlePerformanceTick),1,tick,NULL)));
+    return((mEntertainerScheduler->addTask(fastdelegate::MakeDelegate(entertainerObject,&CreatureObject::handlePerformanceTick),1,tick,NULL,"CreatureObject::handlePerformanceTick")));
 }
 
 //======================================================================================================================
@@ -1280,7 +1349,7 @@ uint64 WorldManager::addBuffToProcess(Buff* buff)
 	VariableTimeCallback callback = fastdelegate::MakeDelegate(DestructibleBuff,&Buff::Update);
 
 	//Add Callback to Scheduler
-	uint64 temp = mBuffScheduler->addTask(callback,1,buff->GetTickLength(),NULL);
+	uint64 temp = mBuffScheduler->addTask(callback,1,buff->GetTickLength(),NULL,"Buff::Update");
 
 	//Give Buff the ID from Scheduler
 	buff->SetID(temp);
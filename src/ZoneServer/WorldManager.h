@@ -23,6 +23,7 @@ Copyright (c) 2006 - 2010 The swgANH Team
 
 #include "MathLib/Rectangle.h"
 
+#include "Utils/DeadlineQueue.h"
 #include "Utils/TimerCallback.h"
 #include "Utils/typedefs.h"
 
@@ -52,6 +53,7 @@ class NpcConversionTime;
 class CharacterLoadingContainer;
 class ZoneServer;
 class Ham;
+class HamRegenEngine;
 class Buff;
 class MissionObject;
 
@@ -60,6 +62,7 @@ class MissionObject;
 namespace Anh_Utils
 {
     class Clock;
+    class JobSystem;
     class Scheduler;
     class VariableTimeScheduler;
 }
@@ -82,8 +85,8 @@ typedef std::vector<RegionObject*>				ActiveRegions;
 typedef std::list<CreatureObject*>				CreatureQueue;
 typedef std::vector<std::pair<uint64, NpcConversionTime*> >	NpcConversionTimers;
 typedef std::map<uint64, uint64>				PlayerMovementUpdateMap;
-typedef std::map<uint64, uint64>				CreatureObjectDeletionMap;
-typedef std::map<uint64, uint64>				PlayerObjectReviveMap;
+typedef Anh_Utils::DeadlineQueue				CreatureObjectDeletionMap;
+typedef Anh_Utils::DeadlineQueue				PlayerObjectReviveMap;
 
 // a list of busy craft tools needing regular updates
 typedef std::vector<uint64>						CraftTools;
@@ -95,10 +98,11 @@ typedef std::map<uint64, const CreatureSpawnRegion*>	CreatureSpawnRegionMap;
 // The active container will be the most often checked, and the Dormant the less checked container.
 
 // And yes. Handlers... handlers... no object refs that will be invalid all the time.
-typedef std::map<uint64, uint64>				NpcDormantHandlers;
-typedef std::map<uint64, uint64>				NpcReadyHandlers;
-typedef std::map<uint64, uint64>				NpcActiveHandlers;
-typedef std::map<uint64, uint64>				AdminRequestHandlers;
+// They are kept by deadline, so a tick only looks at the ones that are due.
+typedef Anh_Utils::DeadlineQueue				NpcDormantHandlers;
+typedef Anh_Utils::DeadlineQueue				NpcReadyHandlers;
+typedef Anh_Utils::DeadlineQueue				NpcActiveHandlers;
+typedef Anh_Utils::DeadlineQueue				AdminRequestHandlers;
 
 // AttributeKey map
 typedef std::map<uint32,string>					AttributeKeyMap;
@@ -212,9 +216,6 @@ class WorldManager : public ObjectFactoryCallback, public DatabaseCallback, publ
 		// saves a player asyncronously to the database
 		void					savePlayer(uint32 accId,bool remove, WMLogOut mLogout, CharacterLoadingContainer* clContainer = NULL);
 
-		// saves a player synched to the database
-		void					savePlayerSync(uint32 accId,bool remove);
-
 		// find a player, returns NULL if not found
 		PlayerObject*			getPlayerByAccId(uint32 accId);
 
@@ -282,6 +283,9 @@ class WorldManager : public ObjectFactoryCallback, public DatabaseCallback, publ
 		// retrieve spatial index for this zone
 		ZoneTree*				getSI(){ return mSpatialIndex; }
 
+		// NULL if the zone runs without job threads
+		Anh_Utils::JobSystem*	getJobSystem(){ return mJobSystem; }
+
 		// removes player from the current scene, and starts a new one after updating his position
 		void					warpPlanet(PlayerObject* playerObject, const glm::vec3& destination,uint64 parentId, const glm::quat& direction = glm::quat());
 
@@ -379,6 +383,7 @@ class WorldManager : public ObjectFactoryCallback, public DatabaseCallback, publ
 		bool	_handleNpcConversionTimers(uint64 callTime,void* ref);
 		bool	_handleFireworkLaunchTimers(uint64 callTime,void* ref);
 		bool	_handleVariousUpdates(uint64 callTime, void* ref);
+		bool	_handleSchedulerStats(uint64 callTime,void* ref);
 
 		bool	_handlePlayerMovementUpdateTimers(uint64 callTime, void* ref);
 
@@ -446,11 +451,12 @@ class WorldManager : public ObjectFactoryCallback, public DatabaseCallback, publ
 		Database*								mDatabase;
 		Anh_Utils::Scheduler*		mEntertainerScheduler;
 		Anh_Utils::Scheduler*		mScoutScheduler;
-		Anh_Utils::Scheduler*		mHamRegenScheduler;
+		HamRegenEngine*				mHamRegenEngine;
 		Anh_Utils::Scheduler*		mMissionScheduler;
 		Anh_Utils::Scheduler*		mNpcManagerScheduler;
 		Anh_Utils::Scheduler*		mObjControllerScheduler;
 		Anh_Utils::Scheduler*		mPlayerScheduler;
+		Anh_Utils::JobSystem*		mJobSystem;
 		ZoneTree*								mSpatialIndex;
 		Anh_Utils::Scheduler*		mSubsystemScheduler;
 		ZoneServer*					mZoneServer;
@@ -32,7 +32,7 @@ void WorldManager::addDormantNpc(uint64 creature, uint64 when)
 	// gLogger->logMsgF("Adding dormant NPC handler... %"PRIu64"", MSG_NORMAL, creature);
 
 	uint64 expireTime = Anh_Utils::Clock::getSingleton()->getLocalTime();
-	mNpcDormantHandlers.insert(std::make_pair(creature, expireTime + when));
+	mNpcDormantHandlers.insert(creature, expireTime + when);
 }
 
 //======================================================================================================================
@@ -42,12 +42,7 @@ void WorldManager::addDormantNpc(uint64 creature, uint64 when)
 
 void WorldManager::removeDormantNpc(uint64 creature)
 {
-	NpcDormantHandlers::iterator it = mNpcDormantHandlers.find(creature);
-	if (it != mNpcDormantHandlers.end())
-	{
-		// Remove creature.
-		mNpcDormantHandlers.erase(it);
-	}
+	mNpcDormantHandlers.remove(creature);
 }
 
 //======================================================================================================================
@@ -57,12 +52,11 @@ void WorldManager::removeDormantNpc(uint64 creature)
 
 void WorldManager::forceHandlingOfDormantNpc(uint64 creature)
 {
-	NpcDormantHandlers::iterator it = mNpcDormantHandlers.find(creature);
-	if (it != mNpcDormantHandlers.end())
+	if (mNpcDormantHandlers.contains(creature))
 	{
 		// Change the event time to NOW.
 		uint64 now = Anh_Utils::Clock::getSingleton()->getLocalTime();
-		(*it).second = now;
+		mNpcDormantHandlers.schedule(creature, now);
 	}
 }
 //======================================================================================================================
@@ -72,43 +66,29 @@ void WorldManager::forceHandlingOfDormantNpc(uint64 creature)
 
 bool WorldManager::_handleDormantNpcs(uint64 callTime, void* ref)
 {
-	NpcDormantHandlers::iterator it = mNpcDormantHandlers.begin();
-	while (it != mNpcDormantHandlers.end())
+	uint64 creature;
+	uint64 deadline;
+
+	// Only the expired timers come out, earliest first.
+	while (mNpcDormantHandlers.popExpired(callTime, creature, deadline))
 	{
-		//  The timer has expired?
-		if (callTime >= ((*it).second))
+		// Handle it.
+		NPCObject* npc = dynamic_cast<NPCObject*>(this->getObjectById(creature));
+		if (npc)
 		{
-			// Yes, handle it.
-			NPCObject* npc = dynamic_cast<NPCObject*>(this->getObjectById((*it).first));
-			if (npc)
-			{
-				// uint64 waitTime = NpcManager::Instance()->handleDormantNpc(creature, callTime - (*it).second);
-				// gLogger->logMsgF("Dormant... ID = %"PRIu64"", MSG_NORMAL, (*it).first);
-				uint64 waitTime = NpcManager::Instance()->handleNpc(npc, callTime - (*it).second);
-
-				if (waitTime)
-				{
-					// Set next execution time.
-					(*it).second = callTime + waitTime;
-				}
-				else
-				{
-					// gLogger->logMsgF("Removed dormant NPC handler... %"PRIu64"", MSG_NORMAL, (*it).first);
+			uint64 waitTime = NpcManager::Instance()->handleNpc(npc, callTime - deadline);
 
-					// Requested to remove the handler.
-					mNpcDormantHandlers.erase(it++);
-				}
-			}
-			else
+			if (waitTime)
 			{
-				// Remove the expired object...
-				mNpcDormantHandlers.erase(it++);
-				gLogger->logMsg("Removed expired dormant NPC handler...");
+				// Set next execution time.
+				mNpcDormantHandlers.schedule(creature, callTime + waitTime);
 			}
+			// else requested to remove the handler, its already out.
 		}
 		else
 		{
-			++it;
+			// The expired object is already removed...
+			gLogger->logMsg("Removed expired dormant NPC handler...");
 		}
 	}
 	return true;
@@ -123,7 +103,7 @@ void WorldManager::addReadyNpc(uint64 creature, uint64 when)
 {
 	uint64 expireTime = Anh_Utils::Clock::getSingleton()->getLocalTime();
 
-	mNpcReadyHandlers.insert(std::make_pair(creature, expireTime + when));
+	mNpcReadyHandlers.insert(creature, expireTime + when);
 }
 
 //======================================================================================================================
@@ -133,12 +113,7 @@ void WorldManager::addReadyNpc(uint64 creature, uint64 when)
 
 void WorldManager::removeReadyNpc(uint64 creature)
 {
-	NpcReadyHandlers::iterator it = mNpcReadyHandlers.find(creature);
-	if (it != mNpcReadyHandlers.end())
-	{
-		// Remove creature.
-		mNpcReadyHandlers.erase(it);
-	}
+	mNpcReadyHandlers.remove(creature);
 }
 
 //======================================================================================================================
@@ -148,12 +123,11 @@ void WorldManager::removeReadyNpc(uint64 creature)
 
 void WorldManager::forceHandlingOfReadyNpc(uint64 creature)
 {
-	NpcReadyHandlers::iterator it = mNpcReadyHandlers.find(creature);
-	if (it != mNpcReadyHandlers.end())
+	if (mNpcReadyHandlers.contains(creature))
 	{
 		// Change the event time to NOW.
 		uint64 now = Anh_Utils::Clock::getSingleton()->getLocalTime();
-		(*it).second = now;
+		mNpcReadyHandlers.schedule(creature, now);
 	}
 }
 
@@ -164,42 +138,28 @@ void WorldManager::forceHandlingOfReadyNpc(uint64 creature)
 
 bool WorldManager::_handleReadyNpcs(uint64 callTime, void* ref)
 {
-	NpcReadyHandlers::iterator it = mNpcReadyHandlers.begin();
-	while (it != mNpcReadyHandlers.end())
+	uint64 creature;
+	uint64 deadline;
+
+	// Only the expired timers come out, earliest first.
+	while (mNpcReadyHandlers.popExpired(callTime, creature, deadline))
 	{
-		//  The timer has expired?
-		if (callTime >= ((*it).second))
+		// Handle it.
+		NPCObject* npc = dynamic_cast<NPCObject*>(this->getObjectById(creature));
+		if (npc)
 		{
-			// Yes, handle it.
-			NPCObject* npc = dynamic_cast<NPCObject*>(this->getObjectById((*it).first));
-			if (npc)
-			{
-				// uint64 waitTime = NpcManager::Instance()->handleReadyNpc(creature, callTime - (*it).second);
-				// gLogger->logMsg("Ready...");
-				// gLogger->logMsgF("Ready... ID = %"PRIu64"", MSG_NORMAL, (*it).first);
-				uint64 waitTime = NpcManager::Instance()->handleNpc(npc, callTime - (*it).second);
-				if (waitTime)
-				{
-					// Set next execution time.
-					(*it).second = callTime + waitTime;
-				}
-				else
-				{
-					// Requested to remove the handler.
-					mNpcReadyHandlers.erase(it++);
-					// gLogger->logMsg("Removed ready NPC handler...");
-				}
-			}
-			else
+			uint64 waitTime = NpcManager::Instance()->handleNpc(npc, callTime - deadline);
+
+			if (waitTime)
 			{
-				// Remove the expired object...
-				mNpcReadyHandlers.erase(it++);
-				// gLogger->logMsg("Removed ready NPC handler...");
+				// Set next execution time.
+				mNpcReadyHandlers.schedule(creature, callTime + waitTime);
 			}
+			// else requested to remove the handler, its already out.
 		}
 		else
 		{
-			++it;
+			// The expired object is already removed...
 		}
 	}
 	return true;
@@ -214,7 +174,7 @@ void WorldManager::addActiveNpc(uint64 creature, uint64 when)
 {
 	uint64 expireTime = Anh_Utils::Clock::getSingleton()->getLocalTime();
 
-	mNpcActiveHandlers.insert(std::make_pair(creature, expireTime + when));
+	mNpcActiveHandlers.insert(creature, expireTime + when);
 }
 
 //======================================================================================================================
@@ -224,12 +184,7 @@ void WorldManager::addActiveNpc(uint64 creature, uint64 when)
 
 void WorldManager::removeActiveNpc(uint64 creature)
 {
-	NpcActiveHandlers::iterator it = mNpcActiveHandlers.find(creature);
-	if (it != mNpcActiveHandlers.end())
-	{
-		// Remove creature.
-		mNpcActiveHandlers.erase(it);
-	}
+	mNpcActiveHandlers.remove(creature);
 }
 
 //======================================================================================================================
@@ -238,42 +193,28 @@ void WorldManager::removeActiveNpc(uint64 creature)
 //
 bool WorldManager::_handleActiveNpcs(uint64 callTime, void* ref)
 {
-	NpcActiveHandlers::iterator it = mNpcActiveHandlers.begin();
-	while (it != mNpcActiveHandlers.end())
+	uint64 creature;
+	uint64 deadline;
+
+	// Only the expired timers come out, earliest first.
+	while (mNpcActiveHandlers.popExpired(callTime, creature, deadline))
 	{
-		//  The timer has expired?
-		if (callTime >= ((*it).second))
+		// Handle it.
+		NPCObject* npc = dynamic_cast<NPCObject*>(this->getObjectById(creature));
+		if (npc)
 		{
-			// Yes, handle it.
-			NPCObject* npc = dynamic_cast<NPCObject*>(this->getObjectById((*it).first));
-			if (npc)
-			{
-				// uint64 waitTime = NpcManager::Instance()->handleActiveNpc(creature, callTime - (*it).second);
-				// gLogger->logMsg("Active...");
-				// gLogger->logMsgF("Active... ID = %"PRIu64"", MSG_NORMAL, (*it).first);
-				uint64 waitTime = NpcManager::Instance()->handleNpc(npc, callTime - (*it).second);
-				if (waitTime)
-				{
-					// Set next execution time.
-					(*it).second = callTime + waitTime;
-				}
-				else
-				{
-					// Requested to remove the handler.
-					mNpcActiveHandlers.erase(it++);
-					// gLogger->logMsg("Removed active NPC handler...");
-				}
-			}
-			else
+			uint64 waitTime = NpcManager::Instance()->handleNpc(npc, callTime - deadline);
+
+			if (waitTime)
 			{
-				// Remove the expired object...
-				mNpcActiveHandlers.erase(it++);
-				// gLogger->logMsg("Removed active NPC handler...");
+				// Set next execution time.
+				mNpcActiveHandlers.schedule(creature, callTime + waitTime);
 			}
+			// else requested to remove the handler, its already out.
 		}
 		else
 		{
-			++it;
+			// The expired object is already removed...
 		}
 	}
 	return true;
@@ -892,60 +892,34 @@ void WorldManager::_loadAllObjects(uint64 parentId)
 
 bool WorldManager::_handleGeneralObjectTimers(uint64 callTime, void* ref)
 {
-	CreatureObjectDeletionMap::iterator it = mCreatureObjectDeletionMap.begin();
-	while (it != mCreatureObjectDeletionMap.end())
+	uint64 objectId;
+	uint64 deadline;
+
+	// Only the expired timers come out.
+	while (mCreatureObjectDeletionMap.popExpired(callTime, objectId, deadline))
 	{
-		//  The timer has expired?
-		if (callTime >= ((*it).second))
-		{
-			// Is it a valid object?
-			CreatureObject* creature = dynamic_cast<CreatureObject*>(getObjectById((*it).first));
-			if (creature)
-			{
-				// Yes, handle it. We may put up a copy of this npc...
-				NpcManager::Instance()->handleExpiredCreature((*it).first);
-				this->destroyObject(creature);
-				mCreatureObjectDeletionMap.erase(it++);
-			}
-			else
-			{
-				// Remove the invalid object...from this list.
-				mCreatureObjectDeletionMap.erase(it++);
-			}
-		}
-		else
+		// Is it a valid object?
+		CreatureObject* creature = dynamic_cast<CreatureObject*>(getObjectById(objectId));
+		if (creature)
 		{
-			++it;
+			// Yes, handle it. We may put up a copy of this npc...
+			NpcManager::Instance()->handleExpiredCreature(objectId);
+			this->destroyObject(creature);
 		}
+		// else the invalid object is already out of this list.
 	}
 
-	PlayerObjectReviveMap::iterator reviveIt = mPlayerObjectReviveMap.begin();
-	while (reviveIt != mPlayerObjectReviveMap.end())
+	while (mPlayerObjectReviveMap.popExpired(callTime, objectId, deadline))
 	{
-		//  The timer has expired?
-		if (callTime >= ((*reviveIt).second))
-		{
-
-			PlayerObject* player = dynamic_cast<PlayerObject*>(getObjectById((*reviveIt).first));
-			if (player)
-			{
-				// Yes, handle it.
-				// Send the player to closest cloning facility.
-				player->cloneAtNearestCloningFacility();
-
-				// The cloning request removes itself from here, have to restart the iteration.
-				reviveIt = mPlayerObjectReviveMap.begin();
-			}
-			else
-			{
-				// Remove the invalid object...
-				mPlayerObjectReviveMap.erase(reviveIt++);
-			}
-		}
-		else
+		PlayerObject* player = dynamic_cast<PlayerObject*>(getObjectById(objectId));
+		if (player)
 		{
-			++reviveIt;
+			// Yes, handle it.
+			// Send the player to closest cloning facility.
+			// The cloning request would remove itself from here, its already out.
+			player->cloneAtNearestCloningFacility();
 		}
+		// else the invalid object is already out of this list.
 	}
 	return (true);
 }
@@ -58,6 +58,7 @@ Copyright (c) 2006 - 2010 The swgANH Team
 #include "MessageLib/MessageLib.h"
 #include "ScriptEngine/ScriptEngine.h"
 #include "ScriptEngine/ScriptSupport.h"
+#include "Utils/JobSystem.h"
 #include "Utils/Scheduler.h"
 #include "Utils/VariableTimeScheduler.h"
 #include "Utils/utils.h"
@@ -158,51 +159,6 @@ void WorldManager::savePlayer(uint32 accId,bool remove, WMLogOut mLogout, Charac
 
 //======================================================================================================================
 
-void WorldManager::savePlayerSync(uint32 accId,bool remove)
-{
-	PlayerObject* playerObject = getPlayerByAccId(accId);
-	Ham* ham = playerObject->getHam();
-
-	mDatabase->DestroyResult(mDatabase->ExecuteSynchSql("UPDATE characters SET parent_id=%"PRIu64",oX=%f,oY=%f,oZ=%f,oW=%f,x=%f,y=%f,z=%f,planet_id=%u WHERE id=%"PRIu64"",playerObject->getParentId()
-						,playerObject->mDirection.x,playerObject->mDirection.y,playerObject->mDirection.z,playerObject->mDirection.w
-						,playerObject->mPosition.x,playerObject->mPosition.y,playerObject->mPosition.z
-						,mZoneId,playerObject->getId()));
-
-	mDatabase->DestroyResult(mDatabase->ExecuteSynchSql("UPDATE character_attributes SET health_current=%u,action_current=%u,mind_current=%u"
-								",health_wounds=%u,strength_wounds=%u,constitution_wounds=%u,action_wounds=%u,quickness_wounds=%u"
-								",stamina_wounds=%u,mind_wounds=%u,focus_wounds=%u,willpower_wounds=%u,battlefatigue=%u,posture=%u,moodId=%u,title=\'%s\'"
-								",character_flags=%u,states=%"PRIu64",language=%u, group_id=%"PRIu64" WHERE character_id=%"PRIu64"",
-								ham->mHealth.getCurrentHitPoints() - ham->mHealth.getModifier(), //Llloydyboy Added the -Modifier so that when buffs are reinitialised, it doesn't screw up HAM
-								ham->mAction.getCurrentHitPoints() - ham->mAction.getModifier(), //Llloydyboy Added the -Modifier so that when buffs are reinitialised, it doesn't screw up HAM
-								ham->mMind.getCurrentHitPoints() - ham->mMind.getModifier(),	 //Llloydyboy Added the -Modifier so that when buffs are reinitialised, it doesn't screw up HAM
-								ham->mHealth.getWounds(),
-								ham->mStrength.getWounds(),
-								ham->mConstitution.getWounds(),
-								ham->mAction.getWounds(),
-								ham->mQuickness.getWounds(),
-								ham->mStamina.getWounds(),
-								ham->mMind.getWounds(),
-								ham->mFocus.getWounds(),
-								ham->mWillpower.getWounds(),
-								ham->getBattleFatigue(),
-								playerObject->getPosture(),
-								playerObject->getMoodId(),
-								playerObject->getTitle().getAnsi(),
-								playerObject->getPlayerFlags(),
-								playerObject->getState(),
-								playerObject->getLanguage(),
-								playerObject->getGroupId(),
-								playerObject->getId()));
-
-
-	gBuffManager->SaveBuffs(playerObject, GetCurrentGlobalTick());
-
-	if(remove)
-		destroyObject(playerObject);
-}
-
-//======================================================================================================================
-
 PlayerObject*	WorldManager::getPlayerByAccId(uint32 accId)
 {
  	PlayerAccMap::iterator it = mPlayerAccMap.find(accId);
@@ -432,6 +388,10 @@ void WorldManager::warpPlanet(PlayerObject* playerObject, const glm::vec3& desti
 
 bool WorldManager::_handlePlayerMovementUpdateTimers(uint64 callTime, void* ref)
 {
+	// with workers the due updates are split up, the queries run in parallel in between
+	std::vector<ObjectController*>	dueControllers;
+	std::vector<PlayerObject*>	duePlayers;
+
 	PlayerMovementUpdateMap::iterator it = mPlayerMovementUpdateMap.begin();
 
 	while (it != mPlayerMovementUpdateMap.end())
@@ -450,6 +410,18 @@ bool WorldManager::_handlePlayerMovementUpdateTimers(uint64 callTime, void* ref)
 
 					ObjectController* ObjCtl = player->getController();
 
+					if (mJobSystem)
+					{
+						ObjCtl->prepareWorldUpdate(false);
+						mJobSystem->addJob(fastdelegate::MakeDelegate(ObjCtl,&ObjectController::runWorldQuery));
+
+						dueControllers.push_back(ObjCtl);
+						duePlayers.push_back(player);
+
+						mPlayerMovementUpdateMap.erase(it++);
+						continue;
+					}
+
 					uint64 next = ObjCtl->playerWorldUpdate(false);
 					mPlayerMovementUpdateMap.erase(it++);
 					if (next)
@@ -475,6 +447,21 @@ bool WorldManager::_handlePlayerMovementUpdateTimers(uint64 callTime, void* ref)
 			mPlayerMovementUpdateMap.erase(it++);
 		}
 	}
+
+	if (!dueControllers.empty())
+	{
+		mJobSystem->runPhase();
+
+		// creates and destroys go out in the order the timers came due
+		for (uint32 i = 0; i < dueControllers.size(); i++)
+		{
+			if (uint64 next = dueControllers[i]->finishWorldUpdate())
+			{
+				addPlayerMovementUpdateTime(duePlayers[i], next);
+			}
+		}
+	}
+
 	return (true);
 }
 
@@ -519,7 +506,7 @@ void WorldManager::addPlayerObjectForTimedCloning(uint64 playerId, uint64 when)
 {
 	uint64 expireTime = Anh_Utils::Clock::getSingleton()->getLocalTime();
 
-	mPlayerObjectReviveMap.insert(std::make_pair(playerId, expireTime + when));
+	mPlayerObjectReviveMap.insert(playerId, expireTime + when);
 }
 
 //======================================================================================================================
@@ -529,10 +516,6 @@ void WorldManager::addPlayerObjectForTimedCloning(uint64 playerId, uint64 when)
 
 void WorldManager::removePlayerObjectForTimedCloning(uint64 playerId)
 {
-	PlayerObjectReviveMap::iterator it = mPlayerObjectReviveMap.find(playerId);
-	if (it != mPlayerObjectReviveMap.end())
-	{
-		// Remove player.
-		mPlayerObjectReviveMap.erase(it);
-	}
+	// Remove player.
+	mPlayerObjectReviveMap.remove(playerId);
 }
\ No newline at end of file
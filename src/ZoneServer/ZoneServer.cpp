@@ -85,8 +85,11 @@ mDatabase(0)
 
 	mNetworkManager = new NetworkManager();
 
+	// sqlite runs the zone on an embedded database file instead of the server, see DBScripts
+	DBType dbType = (gConfig->read<std::string>("DBType","mysql") == "sqlite") ? DBTYPE_SQLITE : DBTYPE_MYSQL;
+
 	// Connect to the DB and start listening for the RouterServer.
-	mDatabase = mDatabaseManager->Connect(DBTYPE_MYSQL,
+	mDatabase = mDatabaseManager->Connect(dbType,
 										   (int8*)(gConfig->read<std::string>("DBServer")).c_str(),
 										   gConfig->read<int>("DBPort"),
 										   (int8*)(gConfig->read<std::string>("DBUser")).c_str(),
@@ -248,6 +251,19 @@ void ZoneServer::handleWMReady()
 
 	// Connect to the ConnectionServer;
 	_connectToConnectionServer();
+
+	// from now on the game loop must not wait on the db
+	mDatabase->setStartupComplete();
+}
+
+//======================================================================================================================
+
+void ZoneServer::dumpDatabaseStatistics()
+{
+	int8 fileName[64];
+	sprintf(fileName,"%s_querystats.txt",getZoneName().getAnsi());
+
+	mDatabase->dumpQueryStatistics(fileName);
 }
 
 //======================================================================================================================
@@ -369,10 +385,17 @@ int main(int argc, char* argv[])
 		}
 		else if (Anh_Utils::kbhit())
 		{
-			if(std::cin.get() == 'q')
+			int key = std::cin.get();
+
+			if(key == 'q')
 			{
 				break;
 			}
+			// dump the latencies of our queries
+			else if(key == 'd')
+			{
+				gZoneServer->dumpDatabaseStatistics();
+			}
 		}
 
 		gZoneServer->Process();
@@ -51,6 +51,8 @@ class ZoneServer
 
 		void	handleWMReady();
 
+		void	dumpDatabaseStatistics();
+
 		string  getZoneName()  { return mZoneName; }
 
 	private:
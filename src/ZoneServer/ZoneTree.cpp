@@ -16,16 +16,36 @@ Copyright (c) 2006 - 2010 The swgANH Team
 #include "CellObject.h"
 #include "WorldManager.h"
 
+#include "Utils/SpatialGrid.h"
+
+#include <cmath>
+
 
 using namespace SpatialIndex;
 
+// edge of the cells changes are tracked in
+static const double ChangeCellSize = 64.0;
+
+static inline int32 changeCell(double coordinate)
+{
+	return static_cast<int32>(floor(coordinate / ChangeCellSize));
+}
+
+static inline uint64 changeCellKey(int32 column,int32 row)
+{
+	return (static_cast<uint64>(static_cast<uint32>(column)) << 32) | static_cast<uint32>(row);
+}
+
 //=============================================================================
 
 ZoneTree::ZoneTree(void) :
 mStorageManager(NULL),
 mStorageBuffer(NULL),
 mTree(NULL),
-mIndexIdentifier(0)
+mIndexIdentifier(0),
+mPointGrid(NULL),
+mRecord(NULL),
+mGeneration(0)
 {
 	// We do have a global clock object, don't use seperate clock and times for every process.
 	// mClock = new Anh_Utils::Clock();
@@ -65,10 +85,64 @@ void ZoneTree::Init(double fillFactor,uint32 indexCap,uint32 leafCap,uint32 dime
 	}
 }
 
+//=============================================================================
+//
+// the r*-tree rebalances on every point insert and remove, the grid only moves an entry between two arrays
+//
+
+void ZoneTree::InitPointGrid(float cellSize,float extent)
+{
+	gLogger->logMsgF("SpatialIndex points in a uniform grid, CellSize:%.2f, Extent:%.2f",MSG_NORMAL,cellSize,extent);
+
+	delete(mPointGrid);
+	mPointGrid = new Anh_Utils::SpatialGrid(cellSize,extent);
+}
+
+//=============================================================================
+//
+// one operation per line
+//   i id x z       insert point
+//   r id x z       remove point
+//   m id x z       move point
+//   q xl zl xh zh  range query
+//
+
+void ZoneTree::StartRecording(const std::string& fileName)
+{
+	delete(mRecord);
+	mRecord = new std::ofstream(fileName.c_str(),std::ios::out | std::ios::trunc);
+
+	if(!mRecord->is_open())
+	{
+		gLogger->logMsgF("SpatialIndex could not open %s for recording",MSG_HIGH,fileName.c_str());
+
+		delete(mRecord);
+		mRecord = NULL;
+		return;
+	}
+
+	gLogger->logMsgF("SpatialIndex recording to %s",MSG_NORMAL,fileName.c_str());
+}
+
 //=============================================================================
 
 void ZoneTree::InsertPoint(int64 objId,double x,double z)
 {
+	if(mRecord)
+		*mRecord << "i " << objId << " " << x << " " << z << "\n";
+
+	_touch(x,z,x,z);
+
+	if(mPointGrid)
+	{
+		// keep type and object alongside the position, so typed queries need no lookup
+		// the object takes itself out of the grid when it gets deleted, see forgetPoint
+		Object* object = gWorldManager->getObjectById(objId);
+
+		mPointGrid->insert(objId,static_cast<float>(x),static_cast<float>(z),object ? static_cast<uint32>(object->getType()) : 0,object);
+		return;
+	}
+
 	double coords[2];
 	coords[0] = x;
 	coords[1] = z;
@@ -93,6 +167,8 @@ void ZoneTree::InsertRegion(int64 objId,double x,double z,double width,double he
 	high[0] = x + width;
 	high[1] = z + height;
 
+	_touch(low[0],low[1],high[0],high[1]);
+
 	Region r = Region(low,high,2);
 
 	mTree->insertData(0,0,r,objId);
@@ -113,6 +189,8 @@ void ZoneTree::insertQTRegion(int64 objId,double x,double z,double width,double
 	high[0] = x + width;
 	high[1] = z + height;
 
+	_touch(low[0],low[1],high[0],high[1]);
+
 	Region r = Region(low,high,2);
 
 	mTree->insertData(0,0,r,objId);
@@ -137,7 +215,10 @@ QTRegion* ZoneTree::getQTRegion(double x,double z)
 
 	Region r = Region(dP,dP,2);
 
-	mTree->intersectsWithQuery(r,vis);
+	{
+		boost::mutex::scoped_lock lock(mQueryMutex);
+		mTree->intersectsWithQuery(r,vis);
+	}
 
 	// find the region
 	ObjectIdList::iterator it = resultIdList.begin();
@@ -177,10 +258,7 @@ void ZoneTree::getObjectsInRangeIntersection(Object* object,ObjectSet* resultSet
 		phigh[0] = object->mPosition.x + range;
 		phigh[1] = object->mPosition.z + range;
 
-		Region r = Region(plow,phigh,2);
-		MyVisitor vis(&resultIdList);
-
-		mTree->intersectsWithQuery(r,vis);
+		_intersectsWithQuery(plow,phigh,&resultIdList);
 
 		// filter needed objects
 		ObjectIdList::iterator it = resultIdList.begin();
@@ -204,23 +282,7 @@ void ZoneTree::getObjectsInRangeIntersection(Object* object,ObjectSet* resultSet
 					{
 						// gLogger->logMsg("Found a building");
 
-						ObjectList cellChilds = (dynamic_cast<BuildingObject*>(tmpObject))->getAllCellChilds();
-						ObjectList::iterator cellChildsIt = cellChilds.begin();
-
-						while(cellChildsIt != cellChilds.end())
-						{
-							Object* cellChild = (*cellChildsIt);
-
-							tmpType = cellChild->getType();
-
-							if((tmpType & objTypes) == static_cast<uint32>(tmpType))
-							{
-								// TODO: We could add a range check to every object...
-								resultSet->insert(cellChild);
-							}
-
-							++cellChildsIt;
-						}
+						static_cast<BuildingObject*>(tmpObject)->getInteriorObjects(resultSet,objTypes);
 					}
 				}
 			}
@@ -285,10 +347,7 @@ void ZoneTree::getObjectsInRangeIntersection(Object* object,ObjectSet* resultSet
 		phigh[0] = buildingObject->mPosition.x + queryWidth;
 		phigh[1] = buildingObject->mPosition.z + queryHeight;
 
-		Region r = Region(plow,phigh,2);
-		MyVisitor vis(&resultIdList);
-
-		mTree->intersectsWithQuery(r,vis);
+		_intersectsWithQuery(plow,phigh,&resultIdList);
 
 		ObjectIdList::iterator it = resultIdList.begin();
 		while(it != resultIdList.end())
@@ -306,23 +365,7 @@ void ZoneTree::getObjectsInRangeIntersection(Object* object,ObjectSet* resultSet
 				// if its a building, add objects of our types it contains
 				if(tmpType == ObjType_Building)
 				{
-					ObjectList cellChilds = (dynamic_cast<BuildingObject*>(tmpObject))->getAllCellChilds();
-					ObjectList::iterator cellChildsIt = cellChilds.begin();
-
-					while(cellChildsIt != cellChilds.end())
-					{
-						Object* cellChild = (*cellChildsIt);
-
-						tmpType = cellChild->getType();
-
-						if(((tmpType & objTypes) == static_cast<uint32>(tmpType)) && cellChild->getId() != object->getId())
-						{
-							// TODO: We could add a range check to every object...
-							resultSet->insert(cellChild);
-						}
-
-						++cellChildsIt;
-					}
+					static_cast<BuildingObject*>(tmpObject)->getInteriorObjects(resultSet,objTypes,objectId);
 				}
 			}
 			++it;
@@ -333,12 +376,12 @@ void ZoneTree::getObjectsInRangeIntersection(Object* object,ObjectSet* resultSet
 
 void ZoneTree::getObjectsInRange(const Object* const object,ObjectSet* resultSet,uint32 objTypes,float range, bool cellContent)
 {
-	ObjectIdList	resultIdList;
-	Object*			tmpObject;
-	ObjectType		tmpType;
-	uint64			objectId = object->getId();
+	std::vector<Object*>	resultList;
+	Object*					tmpObject;
+	ObjectType				tmpType;
+	uint64					objectId = object->getId();
 
-	resultIdList.reserve(100);
+	resultList.reserve(100);
 
 	double plow[2],phigh[2];
 
@@ -350,19 +393,16 @@ void ZoneTree::getObjectsInRange(const Object* const object,ObjectSet* resultSet
 		phigh[0] = object->mPosition.x + range;
 		phigh[1] = object->mPosition.z + range;
 
-		Region r = Region(plow,phigh,2);
-		MyVisitor vis(&resultIdList);
-
 		//please note that the containsWhatQuery regularly fails to find objects were standing next to - 
 		//mTree->containsWhatQuery(r,vis);
 
-		mTree->intersectsWithQuery(r,vis);
+		_intersectsWithQuery(plow,phigh,objTypes | ObjType_Building,&resultList);
 		// filter needed objects
-		ObjectIdList::iterator it = resultIdList.begin();
-		while(it != resultIdList.end())
+		std::vector<Object*>::iterator it = resultList.begin();
+		while(it != resultList.end())
 		{
-			// check if its us and the object still exists
-			if((static_cast<uint64>(*it) != objectId) && ((tmpObject = gWorldManager->getObjectById((*it))) != NULL))
+			// check if its us
+			if((tmpObject = (*it))->getId() != objectId)
 			{
 				// if we are in same parent	   (world)
 				if(!tmpObject->getParentId())
@@ -380,23 +420,7 @@ void ZoneTree::getObjectsInRange(const Object* const object,ObjectSet* resultSet
 					{
 						// gLogger->logMsg("Found a building");
 
-						ObjectList cellChilds = (dynamic_cast<BuildingObject*>(tmpObject))->getAllCellChilds();
-						ObjectList::iterator cellChildsIt = cellChilds.begin();
-
-						while(cellChildsIt != cellChilds.end())
-						{
-							Object* cellChild = (*cellChildsIt);
-
-							tmpType = cellChild->getType();
-
-							if((tmpType & objTypes) == static_cast<uint32>(tmpType))
-							{
-								// TODO: We could add a range check to every object...
-								resultSet->insert(cellChild);
-							}
-
-							++cellChildsIt;
-						}
+						static_cast<BuildingObject*>(tmpObject)->getInteriorObjects(resultSet,objTypes);
 					}
 				}
 			}
@@ -461,20 +485,17 @@ void ZoneTree::getObjectsInRange(const Object* const object,ObjectSet* resultSet
 		phigh[0] = buildingObject->mPosition.x + queryWidth;
 		phigh[1] = buildingObject->mPosition.z + queryHeight;
 
-		Region r = Region(plow,phigh,2);
-		MyVisitor vis(&resultIdList);
-
-		mTree->intersectsWithQuery(r,vis);
+		_intersectsWithQuery(plow,phigh,objTypes | ObjType_Building,&resultList);
 
 		//containswhat query regularly misses objects we stand next to - do *not* use it
 		//this might have been because the width and height of buildings was set by default to 128 (ie our viewing range)
 		//mTree->containsWhatQuery(r,vis);
 
-		ObjectIdList::iterator it = resultIdList.begin();
-		while(it != resultIdList.end())
+		std::vector<Object*>::iterator it = resultList.begin();
+		while(it != resultList.end())
 		{
-			// check if its us and the object still exists
-			if(static_cast<uint64>(*it) != objectId && ((tmpObject = gWorldManager->getObjectById((*it))) != NULL))
+			// check if its us
+			if((tmpObject = (*it))->getId() != objectId)
 			{
 				tmpType = tmpObject->getType();
 
@@ -489,24 +510,7 @@ void ZoneTree::getObjectsInRange(const Object* const object,ObjectSet* resultSet
 				if(tmpType == ObjType_Building)
 				{
 
-					ObjectList cellChilds = (dynamic_cast<BuildingObject*>(tmpObject))->getAllCellChilds();
-					ObjectList::iterator cellChildsIt = cellChilds.begin();
-
-					while(cellChildsIt != cellChilds.end())
-					{
-						Object* cellChild = (*cellChildsIt);
-
-						tmpType = cellChild->getType();
-
-						if(((tmpType & objTypes) == static_cast<uint32>(tmpType)) && cellChild->getId() != object->getId())
-						{
-							// TODO: We could add a range check to every object...
-							resultSet->insert(cellChild);
-							//gLogger->logMsgF("inserted cellchild %"PRIu64"",MSG_HIGH,cellChild->getId());
-						}
-						
-						++cellChildsIt;
-					}
+					static_cast<BuildingObject*>(tmpObject)->getInteriorObjects(resultSet,objTypes,objectId);
 				}
 			}
 			++it;
@@ -517,8 +521,61 @@ void ZoneTree::getObjectsInRange(const Object* const object,ObjectSet* resultSet
 
 //=============================================================================
 
+void ZoneTree::getObjectIdsInRect(uint64 excludeId,ObjectIdList* resultList,uint32 objTypes,float xLow,float zLow,float xHigh,float zHigh)
+{
+	std::vector<Object*>	candidates;
+	Object*					tmpObject;
+	ObjectType				tmpType;
+
+	candidates.reserve(32);
+
+	double plow[2],phigh[2];
+
+	plow[0]		= xLow;
+	plow[1]		= zLow;
+	phigh[0]	= xHigh;
+	phigh[1]	= zHigh;
+
+	_intersectsWithQuery(plow,phigh,objTypes,&candidates);
+
+	std::vector<Object*>::iterator it = candidates.begin();
+	while(it != candidates.end())
+	{
+		if(((tmpObject = (*it))->getId() != excludeId) && !tmpObject->getParentId())
+		{
+			tmpType = tmpObject->getType();
+
+			if((tmpType & objTypes) == static_cast<uint32>(tmpType))
+			{
+				resultList->push_back(static_cast<int64>(tmpObject->getId()));
+			}
+		}
+
+		++it;
+	}
+}
+
+//=============================================================================
+
 void ZoneTree::RemovePoint(int64 objId,double x,double z)
 {
+	if(mRecord)
+		*mRecord << "r " << objId << " " << x << " " << z << "\n";
+
+	_touch(x,z,x,z);
+
+	if(mPointGrid)
+	{
+		if(!mPointGrid->remove(objId))
+		{
+			std::ostringstream ss;
+			ss << "ZoneTree::RemovePoint *** ERROR: Cannot delete id: " << objId << std::endl;
+			gLogger->logMsg(ss.str());
+		}
+
+		return;
+	}
+
 	double coords[2];
 	coords[0] = x;
 	coords[1] = z;
@@ -539,6 +596,120 @@ void ZoneTree::RemovePoint(int64 objId,double x,double z)
 	}
 }
 
+//=============================================================================
+//
+// the grid keeps object pointers, a deleted object must not stay in it whichever way it was removed from the world
+//
+
+void ZoneTree::forgetPoint(int64 objId)
+{
+	if(mPointGrid)
+	{
+		mPointGrid->remove(objId);
+	}
+}
+
+//=============================================================================
+
+void ZoneTree::MovePoint(int64 objId,double oldX,double oldZ,double x,double z)
+{
+	if(mPointGrid)
+	{
+		if(mRecord)
+			*mRecord << "m " << objId << " " << x << " " << z << "\n";
+
+		_touch(oldX,oldZ,oldX,oldZ);
+		_touch(x,z,x,z);
+
+		if(!mPointGrid->move(objId,static_cast<float>(x),static_cast<float>(z)))
+		{
+			InsertPoint(objId,x,z);
+		}
+
+		return;
+	}
+
+	RemovePoint(objId,oldX,oldZ);
+	InsertPoint(objId,x,z);
+}
+
+//=============================================================================
+//
+// regions always come from the tree, points from wherever they are kept
+//
+
+void ZoneTree::_intersectsWithQuery(double* low,double* high,ObjectIdList* resultList)
+{
+	Region		r = Region(low,high,2);
+	MyVisitor	vis(resultList);
+
+	{
+		boost::mutex::scoped_lock lock(mQueryMutex);
+
+		if(mRecord)
+			*mRecord << "q " << low[0] << " " << low[1] << " " << high[0] << " " << high[1] << "\n";
+
+		mTree->intersectsWithQuery(r,vis);
+	}
+
+	if(mPointGrid)
+	{
+		mPointGrid->query(static_cast<float>(low[0]),static_cast<float>(low[1]),static_cast<float>(high[0]),static_cast<float>(high[1]),*resultList);
+	}
+}
+
+//=============================================================================
+//
+// tree hits are looked up by id, anything destroyed since it was filed drops out
+// grid points come with their object and are already filtered by type, a deleted object is no longer in the grid
+//
+
+void ZoneTree::_intersectsWithQuery(double* low,double* high,uint32 pointTypes,std::vector<Object*>* resultList)
+{
+	ObjectIdList	resultIdList;
+	Region			r = Region(low,high,2);
+	MyVisitor		vis(&resultIdList);
+
+	{
+		boost::mutex::scoped_lock lock(mQueryMutex);
+
+		if(mRecord)
+			*mRecord << "q " << low[0] << " " << low[1] << " " << high[0] << " " << high[1] << "\n";
+
+		mTree->intersectsWithQuery(r,vis);
+	}
+
+	ObjectIdList::iterator it = resultIdList.begin();
+	while(it != resultIdList.end())
+	{
+		if(Object* object = gWorldManager->getObjectById(*it))
+		{
+			resultList->push_back(object);
+		}
+
+		++it;
+	}
+
+	if(mPointGrid)
+	{
+		std::vector<void*> points;
+
+		points.reserve(64);
+		mPointGrid->query(static_cast<float>(low[0]),static_cast<float>(low[1]),static_cast<float>(high[0]),static_cast<float>(high[1]),pointTypes,points);
+
+		std::vector<void*>::iterator pointIt = points.begin();
+		while(pointIt != points.end())
+		{
+			if(*pointIt)
+			{
+				resultList->push_back(static_cast<Object*>(*pointIt));
+			}
+
+			++pointIt;
+		}
+	}
+}
+
 //=============================================================================
 
 void ZoneTree::RemoveRegion(int64 objId,double xLow,double zLow,double xHigh,double zHigh)
@@ -550,6 +721,8 @@ void ZoneTree::RemoveRegion(int64 objId,double xLow,double zLow,double xHigh,dou
 	high[0] = xHigh;
 	high[1] = zHigh;
 
+	_touch(xLow,zLow,xHigh,zHigh);
+
 	Region r = Region(low,high,2);
 
 	if(mTree->deleteData(r,objId) == false)
@@ -568,6 +741,64 @@ void ZoneTree::RemoveRegion(int64 objId,double xLow,double zLow,double xHigh,dou
 
 //=============================================================================
 
+//=============================================================================
+//
+// stamps the change cells under the rectangle with a new generation
+//
+
+void ZoneTree::_touch(double xLow,double zLow,double xHigh,double zHigh)
+{
+	boost::mutex::scoped_lock lock(mQueryMutex);
+
+	++mGeneration;
+
+	for(int32 row = changeCell(zLow); row <= changeCell(zHigh); row++)
+	{
+		for(int32 column = changeCell(xLow); column <= changeCell(xHigh); column++)
+		{
+			mCellGenerations[changeCellKey(column,row)] = mGeneration;
+		}
+	}
+}
+
+//=============================================================================
+
+uint32 ZoneTree::getGeneration()
+{
+	boost::mutex::scoped_lock lock(mQueryMutex);
+
+	return(mGeneration);
+}
+
+//=============================================================================
+//
+// the newest stamp of the change cells under the rectangle, 0 if nothing changed there yet
+//
+
+uint32 ZoneTree::getGeneration(float xLow,float zLow,float xHigh,float zHigh)
+{
+	boost::mutex::scoped_lock lock(mQueryMutex);
+
+	uint32 generation = 0;
+
+	for(int32 row = changeCell(zLow); row <= changeCell(zHigh); row++)
+	{
+		for(int32 column = changeCell(xLow); column <= changeCell(xHigh); column++)
+		{
+			GenerationMap::const_iterator it = mCellGenerations.find(changeCellKey(column,row));
+
+			if(it != mCellGenerations.end() && (*it).second > generation)
+			{
+				generation = (*it).second;
+			}
+		}
+	}
+
+	return(generation);
+}
+
+//=============================================================================
+
 void ZoneTree::DumpStats()
 {
 	std::ostringstream ss;
@@ -575,6 +806,12 @@ void ZoneTree::DumpStats()
 	ss << *mTree;
 	ss << "Buffer Hits: " << mStorageBuffer->getHits() << std::endl;
 	ss << "IndexIdentifier: " << mIndexIdentifier << std::endl;
+
+	if(mPointGrid)
+	{
+		ss << "PointGrid: " << mPointGrid->getCount() << " points in " << mPointGrid->getCellCount() << " cells of "
+		   << mPointGrid->getCellSize() << "m, max " << mPointGrid->getMaxCellLoad() << " per cell" << std::endl;
+	}
 	gLogger->logMsg(ss.str());
 }
 
@@ -600,6 +837,11 @@ void ZoneTree::ShutDown()
 	delete(mTree);
 	delete(mStorageBuffer);
 	delete(mStorageManager);
+	delete(mPointGrid);
+	delete(mRecord);
+
+	mPointGrid	= NULL;
+	mRecord		= NULL;
 
 	mIndexIdentifier = 0;
 
@@ -628,10 +870,7 @@ void ZoneTree::getObjectsInRangeEx(Object* object,ObjectSet* resultSet,uint32 ob
 		phigh[0] = object->mPosition.x + range;
 		phigh[1] = object->mPosition.z + range;
 
-		Region r = Region(plow,phigh,2);
-		MyVisitor vis(&resultIdList);
-
-		mTree->intersectsWithQuery(r,vis);
+		_intersectsWithQuery(plow,phigh,&resultIdList);
 		// mTree->containsWhatQuery(r,vis);
 
 		// filter needed objects
@@ -655,24 +894,7 @@ void ZoneTree::getObjectsInRangeEx(Object* object,ObjectSet* resultSet,uint32 ob
 					{
 						// gLogger->logMsg("Found a building");
 
-						ObjectList cellChilds = (dynamic_cast<BuildingObject*>(tmpObject))->getAllCellChilds();
-						ObjectList::iterator cellChildsIt = cellChilds.begin();
-
-						while(cellChildsIt != cellChilds.end())
-						{
-							Object* cellChild = (*cellChildsIt);
-
-							tmpType = cellChild->getType();
-
-							if((tmpType & objTypes) == static_cast<uint32>(tmpType))
-							{
-								// TODO: We could add a range check to every object...
-								// gLogger->logMsgF("Found object PRId32",MSG_NORMAL,cellChild->getId());
-								resultSet->insert(cellChild);
-							}
-
-							++cellChildsIt;
-						}
+						static_cast<BuildingObject*>(tmpObject)->getInteriorObjects(resultSet,objTypes);
 					}
 				}
 			}
@@ -749,10 +971,7 @@ void ZoneTree::getObjectsInRangeEx(Object* object,ObjectSet* resultSet,uint32 ob
 		phigh[0] = buildingObject->mPosition.x + queryWidth;
 		phigh[1] = buildingObject->mPosition.z + queryHeight;
 
-		Region r = Region(plow,phigh,2);
-		MyVisitor vis(&resultIdList);
-
-		mTree->intersectsWithQuery(r,vis);
+		_intersectsWithQuery(plow,phigh,&resultIdList);
 
 		ObjectIdList::iterator it = resultIdList.begin();
 		while(it != resultIdList.end())
@@ -770,23 +989,7 @@ void ZoneTree::getObjectsInRangeEx(Object* object,ObjectSet* resultSet,uint32 ob
 				// if its a building, add objects of our types it contains
 				if(tmpType == ObjType_Building)
 				{
-					ObjectList cellChilds = (dynamic_cast<BuildingObject*>(tmpObject))->getAllCellChilds();
-					ObjectList::iterator cellChildsIt = cellChilds.begin();
-
-					while(cellChildsIt != cellChilds.end())
-					{
-						Object* cellChild = (*cellChildsIt);
-
-						tmpType = cellChild->getType();
-
-						if(((tmpType & objTypes) == static_cast<uint32>(tmpType)) && cellChild->getId() != object->getId())
-						{
-							// TODO: We could add a range check to every object...
-							resultSet->insert(cellChild);
-						}
-
-						++cellChildsIt;
-					}
+					static_cast<BuildingObject*>(tmpObject)->getInteriorObjects(resultSet,objTypes,objectId);
 				}
 			}
 			++it;
@@ -13,6 +13,9 @@ Copyright (c) 2006 - 2010 The swgANH Team
 #define ANH_ZONESERVER_ZONETREE_H
 
 #include "Utils/typedefs.h"
+#include <boost/thread/mutex.hpp>
+#include <boost/unordered_map.hpp>
+#include <fstream>
 #include <vector>
 #include <SpatialIndex.h>
 #include "ObjectController.h"
@@ -22,6 +25,11 @@ Copyright (c) 2006 - 2010 The swgANH Team
 class Object;
 class QTRegion;
 
+namespace Anh_Utils
+{
+	class SpatialGrid;
+}
+
 typedef std::vector<int64>		ObjectIdList;
 typedef std::list<Object*>	ObjectList;
 
@@ -58,26 +66,60 @@ class ZoneTree
 		void			Init(double fillFactor, uint32 indexCap, uint32 leafCap, uint32 dimensions, double horizon);
 		void			ShutDown();
 
+		// points go into a uniform grid instead of the r*-tree, regions stay in the tree
+		void			InitPointGrid(float cellSize, float extent);
+
+		// writes every point update and query to the file, for replaying it in the spatial index benchmark
+		void			StartRecording(const std::string& fileName);
+
 		void			DumpStats();
 
 		void			insertQTRegion(int64 objId, double x, double z, double width, double height);
 		void			InsertPoint(int64 objId, double x, double z);
 		void			InsertRegion(int64 objId, double x, double z, double width, double height);
 		void			RemovePoint(int64 objId, double x, double z);
+		void			MovePoint(int64 objId, double oldX, double oldZ, double x, double z);
 		void			RemoveRegion(int64 objId, double xLow, double zLow, double xHigh, double zHigh);
 
+		// drops the point from the grid if it is still there, called by the object being deleted
+		void			forgetPoint(int64 objId);
+
 		void			getObjectsInRange(const Object* const object, ObjectSet* resultSet, uint32 objTypes, float range, bool cellContent = false);
 		void			getObjectsInRangeIntersection(Object* object, ObjectSet* resultSet, uint32 objTypes, float range);
 		void			getObjectsInRangeEx(Object* object, ObjectSet* resultSet, uint32 objTypes, float range);
+
+		// ids of the world space objects of the given types intersecting the rectangle
+		void			getObjectIdsInRect(uint64 excludeId, ObjectIdList* resultList, uint32 objTypes, float xLow, float zLow, float xHigh, float zHigh);
 		QTRegion*		getQTRegion(double x, double z);
 
+		// every insert, move and remove bumps the generation and stamps it on the change cells it touches
+		// a cached query result is stale once the newest stamp over its rectangle is above the generation it was taken at
+		uint32			getGeneration();
+		uint32			getGeneration(float xLow, float zLow, float xHigh, float zHigh);
+
 	private:
 
+		typedef boost::unordered_map<uint64,uint32>	GenerationMap;
+
+		void			_touch(double xLow, double zLow, double xHigh, double zHigh);
+
+		void			_intersectsWithQuery(double* low, double* high, ObjectIdList* resultList);
+
+		// resolved objects intersecting the rectangle, points of other types than pointTypes may already be left out
+		void			_intersectsWithQuery(double* low, double* high, uint32 pointTypes, std::vector<Object*>* resultList);
+
         SpatialIndex::IStorageManager*			mStorageManager;
         SpatialIndex::StorageManager::IBuffer*	mStorageBuffer;
         SpatialIndex::ISpatialIndex*			mTree;
 		int64						            mIndexIdentifier;
 		Tools::ResourceUsage 		            mResourceUsage;
+		Anh_Utils::SpatialGrid*					mPointGrid;
+		std::ofstream*							mRecord;
+		GenerationMap							mCellGenerations;
+		uint32									mGeneration;
+
+		// the r*-tree buffer changes on reads too, queries from the world update workers take turns
+		boost::mutex							mQueryMutex;
 };
 
 //======================================================================================================================
@@ -24,7 +24,9 @@
 
 #include "interp.h"
 #include "mathconsts.h"
+#include "vectortable.h"
 #include <fstream>
+#include <vector>
 
 
 using namespace noise;
@@ -887,6 +889,206 @@ void NoiseMapBuilderPlane::Build ()
   }
 }
 
+/////////////////////////////////////////////////////////////////////////////
+// NoiseMapBuilderPlanePerlin class
+
+// The lattice hash of the coherent-noise functions in noisegen.cpp.
+const int X_NOISE_GEN = 1619;
+const int Y_NOISE_GEN = 31337;
+const int Z_NOISE_GEN = 6971;
+const int SEED_NOISE_GEN = 1013;
+const int SHIFT_NOISE_GEN = 8;
+
+// The s-curve GradientCoherentNoise3D() applies to a lattice offset.
+static inline double LatticeCurve (double a, NoiseQuality noiseQuality)
+{
+  switch (noiseQuality) {
+    case QUALITY_FAST:
+      return a;
+    case QUALITY_STD:
+      return SCurve3 (a);
+    case QUALITY_BEST:
+      return SCurve5 (a);
+  }
+  return a;
+}
+
+// GradientNoise3D() with the y, z and seed part of the hash worked out by the
+// caller.  The hash is done unsigned, it wraps like the int one in noisegen.cpp
+// and only its low 16 bits are used.
+static inline double LatticeGradient (double fx, double fy, double fz,
+  int ix, int iy, int iz, unsigned int yzSeedHash)
+{
+  unsigned int vectorIndex = (unsigned int)X_NOISE_GEN * (unsigned int)ix
+    + yzSeedHash;
+  vectorIndex ^= (vectorIndex >> SHIFT_NOISE_GEN);
+  vectorIndex &= 0xff;
+
+  const double* pGradient = &g_randomVectors[vectorIndex << 2];
+
+  return ((pGradient[0] * (fx - (double)ix))
+        + (pGradient[1] * (fy - (double)iy))
+        + (pGradient[2] * (fz - (double)iz))) * 2.12;
+}
+
+NoiseMapBuilderPlanePerlin::NoiseMapBuilderPlanePerlin ()
+{
+}
+
+void NoiseMapBuilderPlanePerlin::Build ()
+{
+  const Perlin* pPerlin = dynamic_cast<const Perlin*> (m_pSourceModule);
+  double scale = 1.0;
+  double bias  = 0.0;
+
+  const ScaleBias* pScaleBias = dynamic_cast<const ScaleBias*> (
+    m_pSourceModule);
+  if (pScaleBias != NULL) {
+    pPerlin = dynamic_cast<const Perlin*> (&pScaleBias->GetSourceModule (0));
+    scale   = pScaleBias->GetScale ();
+    bias    = pScaleBias->GetBias  ();
+  }
+
+  if (pPerlin == NULL || IsSeamlessEnabled ()) {
+    NoiseMapBuilderPlane::Build ();
+    return;
+  }
+
+  double lowerXBound = GetLowerXBound ();
+  double lowerZBound = GetLowerZBound ();
+
+  if ( GetUpperXBound () <= lowerXBound
+    || GetUpperZBound () <= lowerZBound
+    || m_destWidth <= 0
+    || m_destHeight <= 0
+    || m_pDestNoiseMap == NULL) {
+    throw noise::ExceptionInvalidParam ();
+  }
+
+  // Resize the destination noise map so that it can store the new output
+  // values from the source model.
+  m_pDestNoiseMap->SetSize (m_destWidth, m_destHeight);
+
+  double xDelta = (GetUpperXBound () - lowerXBound) / (double)m_destWidth ;
+  double zDelta = (GetUpperZBound () - lowerZBound) / (double)m_destHeight;
+  double zCur   = lowerZBound;
+
+  double frequency   = pPerlin->GetFrequency ();
+  double lacunarity  = pPerlin->GetLacunarity ();
+  double persistence = pPerlin->GetPersistence ();
+  int octaveCount    = pPerlin->GetOctaveCount ();
+  int baseSeed       = pPerlin->GetSeed ();
+  NoiseQuality noiseQuality = pPerlin->GetNoiseQuality ();
+
+  int width = m_destWidth;
+
+  // The x coordinates of a row, accumulated like NoiseMapBuilderPlane does.
+  std::vector<double> rowX (width);
+  double xCur = lowerXBound;
+  for (int x = 0; x < width; x++) {
+    rowX[x] = xCur;
+    xCur += xDelta;
+  }
+
+  std::vector<double> octaveX (width);
+  std::vector<double> noiseX  (width);
+  std::vector<double> curveX  (width);
+  std::vector<int>    cellX   (width);
+  std::vector<double> value   (width);
+
+  // The gradient noise of the eight cell corners, (x0, y0, z0), (x1, y0, z0),
+  // (x0, y1, z0), (x1, y1, z0), then the same four at z1.
+  std::vector<double> corners (8 * width);
+
+  for (int z = 0; z < m_destHeight; z++) {
+    // The plane model samples the module at y = 0.
+    double octaveY = 0.0;
+    double octaveZ = zCur * frequency;
+    double curPersistence = 1.0;
+
+    for (int x = 0; x < width; x++) {
+      octaveX[x] = rowX[x] * frequency;
+      value[x]   = 0.0;
+    }
+
+    for (int curOctave = 0; curOctave < octaveCount; curOctave++) {
+      int seed = (baseSeed + curOctave) & 0xffffffff;
+
+      double ny = MakeInt32Range (octaveY);
+      double nz = MakeInt32Range (octaveZ);
+      int y0 = (ny > 0.0? (int)ny: (int)ny - 1);
+      int z0 = (nz > 0.0? (int)nz: (int)nz - 1);
+      double ys = LatticeCurve (ny - (double)y0, noiseQuality);
+      double zs = LatticeCurve (nz - (double)z0, noiseQuality);
+
+      unsigned int yzSeedHash[4];
+      for (int corner = 0; corner < 4; corner++) {
+        yzSeedHash[corner] = (unsigned int)Y_NOISE_GEN * (unsigned int)(y0 + (corner & 1))
+          + (unsigned int)Z_NOISE_GEN * (unsigned int)(z0 + (corner >> 1))
+          + (unsigned int)SEED_NOISE_GEN * (unsigned int)seed;
+      }
+
+      // The lattice cells and s-curves of the row.
+      for (int x = 0; x < width; x++) {
+        double nx  = MakeInt32Range (octaveX[x]);
+        int x0     = (nx > 0.0? (int)nx: (int)nx - 1);
+        noiseX[x]  = nx;
+        cellX[x]   = x0;
+        curveX[x]  = LatticeCurve (nx - (double)x0, noiseQuality);
+      }
+
+      // The gradients of the cell corners.
+      for (int x = 0; x < width; x++) {
+        double nx = noiseX[x];
+        int x0    = cellX[x];
+        for (int corner = 0; corner < 4; corner++) {
+          int iy = y0 + (corner & 1);
+          int iz = z0 + (corner >> 1);
+          corners[(2 * corner    ) * width + x] = LatticeGradient (nx, ny, nz,
+            x0    , iy, iz, yzSeedHash[corner]);
+          corners[(2 * corner + 1) * width + x] = LatticeGradient (nx, ny, nz,
+            x0 + 1, iy, iz, yzSeedHash[corner]);
+        }
+      }
+
+      // The blend, in the order GradientCoherentNoise3D() does it.
+      const double* n000 = &corners[0 * width];
+      const double* n100 = &corners[1 * width];
+      const double* n010 = &corners[2 * width];
+      const double* n110 = &corners[3 * width];
+      const double* n001 = &corners[4 * width];
+      const double* n101 = &corners[5 * width];
+      const double* n011 = &corners[6 * width];
+      const double* n111 = &corners[7 * width];
+      for (int x = 0; x < width; x++) {
+        double xs  = curveX[x];
+        double ix0 = LinearInterp (n000[x], n100[x], xs);
+        double ix1 = LinearInterp (n010[x], n110[x], xs);
+        double iy0 = LinearInterp (ix0, ix1, ys);
+        ix0 = LinearInterp (n001[x], n101[x], xs);
+        ix1 = LinearInterp (n011[x], n111[x], xs);
+        double iy1 = LinearInterp (ix0, ix1, ys);
+        value[x] += LinearInterp (iy0, iy1, zs) * curPersistence;
+        octaveX[x] *= lacunarity;
+      }
+
+      octaveY *= lacunarity;
+      octaveZ *= lacunarity;
+      curPersistence *= persistence;
+    }
+
+    float* pDest = m_pDestNoiseMap->GetSlabPtr (z);
+    for (int x = 0; x < width; x++) {
+      pDest[x] = (float)(value[x] * scale + bias);
+    }
+
+    zCur += zDelta;
+    if (m_pCallback != NULL) {
+      m_pCallback (z);
+    }
+  }
+}
+
 /////////////////////////////////////////////////////////////////////////////
 // NoiseMapBuilderSphere class
 
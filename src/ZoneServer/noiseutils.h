@@ -1708,6 +1708,36 @@ namespace noise
 
     };
 
+    /// Builds a planar noise map from a Perlin module a row at a time.
+    ///
+    /// This class builds the same noise map as NoiseMapBuilderPlane when the
+    /// source module is a Perlin module, or a ScaleBias module whose source
+    /// module is a Perlin module.  The values are the ones the modules
+    /// return, within 1e-6; the arithmetic is the same, only a compiler
+    /// contracting multiply-adds can tell them apart.
+    ///
+    /// Instead of one virtual GetValue() call per module and value, each
+    /// octave of a row is evaluated in three passes over the row: the first
+    /// finds the lattice cells and the s-curves, the second looks up the
+    /// gradients of the cell corners, the third blends them into the value.
+    /// The blend is a plain loop over arrays that the compiler vectorizes;
+    /// everything that only depends on the row is worked out once per
+    /// octave.
+    ///
+    /// Any other source module, and seamless noise maps, are built by
+    /// NoiseMapBuilderPlane::Build().
+    class NoiseMapBuilderPlanePerlin: public NoiseMapBuilderPlane
+    {
+
+      public:
+
+        /// Constructor.
+        NoiseMapBuilderPlanePerlin ();
+
+        virtual void Build ();
+
+    };
+
 
     /// Builds a spherical noise map.
     ///
@@ -0,0 +1,190 @@
+/*
+---------------------------------------------------------------------------------------
+This source file is part of swgANH (Star Wars Galaxies - A New Hope - Server Emulator)
+For more information, see http://www.swganh.org
+
+
+Copyright (c) 2006 - 2010 The swgANH Team
+
+---------------------------------------------------------------------------------------
+*/
+
+//======================================================================================================================
+//
+// compares std::set and flat_set as known object sets
+//
+//   flatset_benchmark [ticks]
+//
+// for every crowd size a set of objects is known, each tick a tenth of them leaves and as many new ones come in
+// the way the in range update does it (find every in range object, erase the leavers, insert the new ones),
+// then the set is walked once per broadcast, eight broadcasts per tick
+//
+
+#include "Utils/FlatSet.h"
+#include "Utils/typedefs.h"
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <set>
+#include <vector>
+
+//======================================================================================================================
+
+struct FakeObject
+{
+	uint64	mId;
+	char	mPayload[248];
+};
+
+typedef std::vector<FakeObject*> FakeObjectList;
+
+//======================================================================================================================
+
+static uint64 getTime()
+{
+	static const boost::posix_time::ptime epoch(boost::gregorian::date(1970,1,1));
+
+	return (boost::posix_time::microsec_clock::universal_time() - epoch).total_microseconds();
+}
+
+//======================================================================================================================
+//
+// the in range object lists of every tick, every list keeps 90% of the previous one
+//
+
+static void generateTicks(uint32 crowdSize,uint32 tickCount,FakeObjectList& pool,std::vector<FakeObjectList>& ticks)
+{
+	FakeObjectList inRange;
+
+	srand(crowdSize);
+
+	for(uint32 i = 0; i < crowdSize; i++)
+	{
+		inRange.push_back(pool[rand() % pool.size()]);
+	}
+
+	for(uint32 tick = 0; tick < tickCount; tick++)
+	{
+		uint32 changes = std::max<uint32>(1,crowdSize / 10);
+
+		for(uint32 i = 0; i < changes; i++)
+		{
+			inRange[rand() % inRange.size()] = pool[rand() % pool.size()];
+		}
+
+		ticks.push_back(inRange);
+	}
+}
+
+//======================================================================================================================
+
+template<class Set>
+static uint64 runTicks(const std::vector<FakeObjectList>& ticks,uint64& checksum)
+{
+	const uint32	broadcasts	= 8;
+	Set				known;
+	Set				current;
+	uint64			start		= getTime();
+
+	for(uint32 tick = 0; tick < ticks.size(); tick++)
+	{
+		const FakeObjectList& inRange = ticks[tick];
+
+		current.clear();
+		current.insert(inRange.begin(),inRange.end());
+
+		// new ones
+		for(FakeObjectList::const_iterator it = inRange.begin(); it != inRange.end(); ++it)
+		{
+			if(known.find(*it) == known.end())
+			{
+				known.insert(*it);
+			}
+		}
+
+		// leavers
+		typename Set::iterator knownIt = known.begin();
+
+		while(knownIt != known.end())
+		{
+			if(current.find(*knownIt) == current.end())
+			{
+				knownIt = known.erase(knownIt);
+				continue;
+			}
+
+			++knownIt;
+		}
+
+		// broadcasts
+		for(uint32 b = 0; b < broadcasts; b++)
+		{
+			for(typename Set::const_iterator it = known.begin(); it != known.end(); ++it)
+			{
+				checksum += (*it)->mId;
+			}
+		}
+	}
+
+	return getTime() - start;
+}
+
+//======================================================================================================================
+
+int main(int argc,char* argv[])
+{
+	const uint32	crowdSizes[]	= { 8, 32, 100, 250, 500 };
+	const uint32	poolSize		= 5000;
+	uint32			tickCount		= (argc > 1) ? static_cast<uint32>(atoi(argv[1])) : 2000;
+
+	// allocated one by one, so the pointers are spread over the heap like real objects
+	FakeObjectList pool;
+
+	for(uint32 i = 0; i < poolSize; i++)
+	{
+		FakeObject* object = new FakeObject();
+
+		object->mId = i;
+		pool.push_back(object);
+	}
+
+	std::random_shuffle(pool.begin(),pool.end());
+
+	printf("%u ticks per crowd size, 8 broadcasts per tick\n",tickCount);
+
+	int result = 0;
+
+	for(uint32 i = 0; i < sizeof(crowdSizes) / sizeof(crowdSizes[0]); i++)
+	{
+		std::vector<FakeObjectList> ticks;
+
+		generateTicks(crowdSizes[i],tickCount,pool,ticks);
+
+		uint64 setChecksum	= 0;
+		uint64 flatChecksum	= 0;
+		uint64 setTime		= runTicks<std::set<FakeObject*> >(ticks,setChecksum);
+		uint64 flatTime		= runTicks<Anh_Utils::flat_set<FakeObject*> >(ticks,flatChecksum);
+
+		printf("crowd %4u   std::set %8llu us (%7.3f us/tick)   flat_set %8llu us (%7.3f us/tick)   %.2fx\n",
+			   crowdSizes[i],
+			   (unsigned long long)setTime,(double)setTime / tickCount,
+			   (unsigned long long)flatTime,(double)flatTime / tickCount,
+			   flatTime ? (double)setTime / flatTime : 0.0);
+
+		if(setChecksum != flatChecksum)
+		{
+			printf("crowd %u: the sets disagree\n",crowdSizes[i]);
+			result = 1;
+		}
+	}
+
+	for(uint32 i = 0; i < poolSize; i++)
+	{
+		delete(pool[i]);
+	}
+
+	return result;
+}
@@ -0,0 +1,177 @@
+/*
+---------------------------------------------------------------------------------------
+This source file is part of swgANH (Star Wars Galaxies - A New Hope - Server Emulator)
+For more information, see http://www.swganh.org
+
+
+Copyright (c) 2006 - 2010 The swgANH Team
+
+---------------------------------------------------------------------------------------
+*/
+
+//======================================================================================================================
+//
+// compares the plane builder and the row kernel on resource distribution maps
+//
+//   perlin_benchmark [maps]
+//
+// every map is a 512x512 ScaleBias over Perlin build like CurrentResource::buildDistributionMap does it,
+// the settings are spread over the ranges CurrentResource accepts, both builders get the same ones
+// the kernel has to stay within 1e-6 of the plane builder, the exit code is 1 when it does not
+//
+
+#include "Utils/typedefs.h"
+#include "ZoneServer/noiseutils.h"
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+//======================================================================================================================
+
+struct MapSettings
+{
+	double	mBoundsX1,mBoundsX2;
+	double	mBoundsY1,mBoundsY2;
+	int		mOctaves;
+	double	mFrequency;
+	double	mPersistence;
+	double	mScale;
+	double	mBias;
+	int		mSeed;
+};
+
+static const int	MapSize		= 512;
+static const double	Tolerance	= 1e-6;
+
+//======================================================================================================================
+
+static uint64 getTime()
+{
+	static const boost::posix_time::ptime epoch(boost::gregorian::date(1970,1,1));
+
+	return (boost::posix_time::microsec_clock::universal_time() - epoch).total_microseconds();
+}
+
+//======================================================================================================================
+
+static double randomRange(double low,double high)
+{
+	return low + (high - low) * ((double)rand() / RAND_MAX);
+}
+
+//======================================================================================================================
+
+static void generateSettings(uint32 count,std::vector<MapSettings>& settings)
+{
+	srand(count);
+
+	for(uint32 i = 0; i < count; i++)
+	{
+		MapSettings map;
+
+		map.mBoundsX1		= randomRange(0.0,20.0);
+		map.mBoundsX2		= map.mBoundsX1 + randomRange(0.5,4.0);
+		map.mBoundsY1		= randomRange(0.0,20.0);
+		map.mBoundsY2		= map.mBoundsY1 + randomRange(0.5,4.0);
+		map.mOctaves		= 1 + (i % 6);
+		map.mFrequency		= randomRange(1.0,32.0);
+		map.mPersistence	= randomRange(0.0,1.0);
+		map.mScale			= randomRange(0.0,1.0);
+		map.mBias			= randomRange(-1.0,1.0);
+		map.mSeed			= rand();
+
+		settings.push_back(map);
+	}
+}
+
+//======================================================================================================================
+
+template<class Builder>
+static uint64 buildMap(const MapSettings& map,noise::utils::NoiseMap& noiseMap)
+{
+	noise::module::Perlin		perlin;
+	noise::module::ScaleBias	flatten;
+	Builder						builder;
+
+	perlin.SetSeed(map.mSeed);
+	perlin.SetOctaveCount(map.mOctaves);
+	perlin.SetFrequency(map.mFrequency);
+	perlin.SetPersistence(map.mPersistence);
+
+	flatten.SetSourceModule(0,perlin);
+	flatten.SetScale(map.mScale);
+	flatten.SetBias(map.mBias);
+
+	builder.SetSourceModule(flatten);
+	builder.SetDestNoiseMap(noiseMap);
+	builder.SetDestSize(MapSize,MapSize);
+	builder.SetBounds(map.mBoundsX1,map.mBoundsX2,map.mBoundsY1,map.mBoundsY2);
+
+	uint64 start = getTime();
+
+	builder.Build();
+
+	return getTime() - start;
+}
+
+//======================================================================================================================
+
+int main(int argc,char* argv[])
+{
+	uint32 mapCount = (argc > 1) ? static_cast<uint32>(atoi(argv[1])) : 24;
+
+	std::vector<MapSettings> settings;
+
+	generateSettings(mapCount,settings);
+
+	printf("%u maps of %dx%d\n",mapCount,MapSize,MapSize);
+
+	uint64	planeTotal	= 0;
+	uint64	rowTotal	= 0;
+	double	worst		= 0.0;
+
+	for(uint32 i = 0; i < settings.size(); i++)
+	{
+		noise::utils::NoiseMap planeMap;
+		noise::utils::NoiseMap rowMap;
+
+		uint64 planeTime	= buildMap<noise::utils::NoiseMapBuilderPlane>(settings[i],planeMap);
+		uint64 rowTime		= buildMap<noise::utils::NoiseMapBuilderPlanePerlin>(settings[i],rowMap);
+		double difference	= 0.0;
+
+		for(int z = 0; z < MapSize; z++)
+		{
+			for(int x = 0; x < MapSize; x++)
+			{
+				double d = fabs((double)planeMap.GetValue(x,z) - (double)rowMap.GetValue(x,z));
+
+				difference = (d > difference) ? d : difference;
+			}
+		}
+
+		printf("map %3u  octaves %d   plane %8llu us   rows %8llu us   %.2fx   max difference %g\n",
+			   i,settings[i].mOctaves,
+			   (unsigned long long)planeTime,(unsigned long long)rowTime,
+			   rowTime ? (double)planeTime / rowTime : 0.0,difference);
+
+		planeTotal	+= planeTime;
+		rowTotal	+= rowTime;
+		worst		= (difference > worst) ? difference : worst;
+	}
+
+	printf("total        plane %8llu us   rows %8llu us   %.2fx   max difference %g\n",
+		   (unsigned long long)planeTotal,(unsigned long long)rowTotal,
+		   rowTotal ? (double)planeTotal / rowTotal : 0.0,worst);
+
+	if(worst > Tolerance)
+	{
+		printf("the row kernel is off by more than %g\n",Tolerance);
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,331 @@
+/*
+---------------------------------------------------------------------------------------
+This source file is part of swgANH (Star Wars Galaxies - A New Hope - Server Emulator)
+For more information, see http://www.swganh.org
+
+
+Copyright (c) 2006 - 2010 The swgANH Team
+
+---------------------------------------------------------------------------------------
+*/
+
+//======================================================================================================================
+//
+// replays spatial index traffic through the uniform grid and a brute force reference
+//
+//   spatialgrid_benchmark [recording] [cellsize]
+//
+// the recording is written by the zone with SpatialIndexRecord set, one operation per line
+//   i id x z       insert point
+//   r id x z       remove point
+//   m id x z       move point
+//   q xl zl xh zh  range query
+//
+// without a recording 20000 objects random walk over 240 ticks (one minute), with one query of 128m per 20 objects and tick
+// the query results of both are compared, the times are reported per operation type
+//
+
+#include "Utils/SpatialGrid.h"
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+//======================================================================================================================
+
+struct Operation
+{
+	char	mType;
+	int64	mId;
+	float	mX;
+	float	mZ;
+	float	mXHigh;
+	float	mZHigh;
+};
+
+typedef std::vector<Operation> OperationList;
+
+//======================================================================================================================
+
+static uint64 getTime()
+{
+	static const boost::posix_time::ptime epoch(boost::gregorian::date(1970,1,1));
+
+	return (boost::posix_time::microsec_clock::universal_time() - epoch).total_microseconds();
+}
+
+//======================================================================================================================
+
+static bool loadRecording(const char* fileName,OperationList& operations)
+{
+	std::ifstream file(fileName);
+
+	if(!file.is_open())
+		return false;
+
+	std::string line;
+
+	while(std::getline(file,line))
+	{
+		std::istringstream	ss(line);
+		Operation			op;
+
+		if(!(ss >> op.mType))
+			continue;
+
+		if(op.mType == 'q')
+		{
+			op.mId = 0;
+			ss >> op.mX >> op.mZ >> op.mXHigh >> op.mZHigh;
+		}
+		else
+		{
+			ss >> op.mId >> op.mX >> op.mZ;
+		}
+
+		if(ss)
+			operations.push_back(op);
+	}
+
+	return true;
+}
+
+//======================================================================================================================
+
+static float randomFloat(float low,float high)
+{
+	return low + (high - low) * (static_cast<float>(rand()) / RAND_MAX);
+}
+
+static void generateMovement(OperationList& operations)
+{
+	const uint32	objectCount	= 20000;
+	const uint32	tickCount	= 240;
+	const float		extent		= 8000.0f;
+	const float		range		= 128.0f;
+
+	std::vector<float> x(objectCount),z(objectCount);
+
+	srand(42);
+
+	for(uint32 i = 0; i < objectCount; i++)
+	{
+		// clustered like players around the cities
+		float cx = static_cast<float>((i % 16) * 1000) - extent;
+		float cz = static_cast<float>(((i / 16) % 16) * 1000) - extent;
+
+		x[i] = cx + randomFloat(-300.0f,300.0f);
+		z[i] = cz + randomFloat(-300.0f,300.0f);
+
+		Operation op = { 'i', static_cast<int64>(i), x[i], z[i], 0.0f, 0.0f };
+		operations.push_back(op);
+	}
+
+	for(uint32 tick = 0; tick < tickCount; tick++)
+	{
+		for(uint32 i = 0; i < objectCount; i++)
+		{
+			// running speed, a transform every 250ms
+			x[i] = std::max(-extent,std::min(extent,x[i] + randomFloat(-2.0f,2.0f)));
+			z[i] = std::max(-extent,std::min(extent,z[i] + randomFloat(-2.0f,2.0f)));
+
+			Operation op = { 'm', static_cast<int64>(i), x[i], z[i], 0.0f, 0.0f };
+			operations.push_back(op);
+
+			if(i % 20 == 0)
+			{
+				Operation query = { 'q', 0, x[i] - range, z[i] - range, x[i] + range, z[i] + range };
+				operations.push_back(query);
+			}
+		}
+	}
+}
+
+//======================================================================================================================
+
+struct Times
+{
+	Times() : mUpdate(0),mQuery(0),mUpdates(0),mQueries(0),mResults(0){}
+
+	uint64	mUpdate;
+	uint64	mQuery;
+	uint64	mUpdates;
+	uint64	mQueries;
+	uint64	mResults;
+};
+
+static void report(const char* name,const Times& times)
+{
+	printf("%-12s updates %9llu in %8llu us (%6.3f us/op)   queries %8llu in %8llu us (%7.3f us/op)   results %llu\n",
+		   name,
+		   (unsigned long long)times.mUpdates,(unsigned long long)times.mUpdate,times.mUpdates ? (double)times.mUpdate / times.mUpdates : 0.0,
+		   (unsigned long long)times.mQueries,(unsigned long long)times.mQuery,times.mQueries ? (double)times.mQuery / times.mQueries : 0.0,
+		   (unsigned long long)times.mResults);
+}
+
+//======================================================================================================================
+
+int main(int argc,char* argv[])
+{
+	OperationList operations;
+
+	if(argc > 1)
+	{
+		if(!loadRecording(argv[1],operations))
+		{
+			printf("could not open %s\n",argv[1]);
+			return 1;
+		}
+
+		printf("replaying %u operations from %s\n",(uint32)operations.size(),argv[1]);
+	}
+	else
+	{
+		generateMovement(operations);
+		printf("replaying %u generated operations\n",(uint32)operations.size());
+	}
+
+	float cellSize = (argc > 2) ? static_cast<float>(atof(argv[2])) : 64.0f;
+
+	// grid
+	Anh_Utils::SpatialGrid	grid(cellSize,8192.0f);
+	std::vector<int64>		result;
+	std::vector<uint64>		gridResultCounts;
+	Times					gridTimes;
+
+	result.reserve(1024);
+
+	for(uint32 i = 0; i < operations.size(); i++)
+	{
+		const Operation& op		= operations[i];
+		uint64			 start	= getTime();
+
+		switch(op.mType)
+		{
+			case 'i': grid.insert(op.mId,op.mX,op.mZ);	break;
+			case 'r': grid.remove(op.mId);				break;
+			case 'm': grid.move(op.mId,op.mX,op.mZ);	break;
+
+			case 'q':
+			{
+				result.clear();
+				grid.query(op.mX,op.mZ,op.mXHigh,op.mZHigh,result);
+
+				gridTimes.mQuery += getTime() - start;
+				gridTimes.mQueries++;
+				gridTimes.mResults += result.size();
+				gridResultCounts.push_back(result.size());
+				continue;
+			}
+		}
+
+		gridTimes.mUpdate += getTime() - start;
+		gridTimes.mUpdates++;
+	}
+
+	// brute force reference, positions in a flat array
+	std::map<int64,uint32>	slots;
+	std::vector<float>		xs,zs;
+	std::vector<int64>		ids;
+	Times					bruteTimes;
+	uint32					mismatches = 0;
+
+	for(uint32 i = 0; i < operations.size(); i++)
+	{
+		const Operation& op		= operations[i];
+		uint64			 start	= getTime();
+
+		switch(op.mType)
+		{
+			case 'i':
+			case 'm':
+			{
+				std::map<int64,uint32>::iterator it = slots.find(op.mId);
+
+				if(it == slots.end())
+				{
+					slots.insert(std::make_pair(op.mId,static_cast<uint32>(ids.size())));
+					ids.push_back(op.mId);
+					xs.push_back(op.mX);
+					zs.push_back(op.mZ);
+				}
+				else
+				{
+					xs[(*it).second] = op.mX;
+					zs[(*it).second] = op.mZ;
+				}
+			}
+			break;
+
+			case 'r':
+			{
+				std::map<int64,uint32>::iterator it = slots.find(op.mId);
+
+				if(it != slots.end())
+				{
+					uint32 slot = (*it).second;
+
+					slots.erase(it);
+
+					if(slot != ids.size() - 1)
+					{
+						ids[slot]	= ids.back();
+						xs[slot]	= xs.back();
+						zs[slot]	= zs.back();
+						slots[ids[slot]] = slot;
+					}
+
+					ids.pop_back();
+					xs.pop_back();
+					zs.pop_back();
+				}
+			}
+			break;
+
+			case 'q':
+			{
+				uint64 count = 0;
+
+				for(uint32 s = 0; s < ids.size(); s++)
+				{
+					if(xs[s] >= op.mX && xs[s] <= op.mXHigh && zs[s] >= op.mZ && zs[s] <= op.mZHigh)
+						count++;
+				}
+
+				bruteTimes.mQuery += getTime() - start;
+
+				if(count != gridResultCounts[bruteTimes.mQueries])
+					mismatches++;
+
+				bruteTimes.mQueries++;
+				bruteTimes.mResults += count;
+				continue;
+			}
+		}
+
+		bruteTimes.mUpdate += getTime() - start;
+		bruteTimes.mUpdates++;
+	}
+
+	printf("grid of %u x %u cells of %.1fm, %u points at the end, max %u per cell\n",
+		   grid.getCellsPerSide(),grid.getCellsPerSide(),grid.getCellSize(),grid.getCount(),grid.getMaxCellLoad());
+
+	report("grid",gridTimes);
+	report("brute force",bruteTimes);
+
+	if(mismatches)
+	{
+		printf("%u queries differ from the reference\n",mismatches);
+		return 1;
+	}
+
+	return 0;
+}
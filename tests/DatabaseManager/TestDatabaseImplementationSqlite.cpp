@@ -0,0 +1,214 @@
+/*! SWGANH MMOServer - Tests
+ *
+ * @copyright Copyright (c) 2006-2010 The swgANH Team
+ */
+
+#if defined(ANH_WITH_SQLITE)
+
+#include <gtest/gtest.h>
+
+#include "DatabaseManager/DatabaseCallback.h"
+#include "DatabaseManager/DatabaseImplementationSqlite.h"
+#include "DatabaseManager/DatabaseResult.h"
+#include "DatabaseManager/DataBinding.h"
+#include "DatabaseManager/Transaction.h"
+#include "DatabaseManager/TransactionResult.h"
+#include "LogManager/LogManager.h"
+#include "Utils/typedefs.h"
+
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+
+// set by the build, the schema the sqlite zone database is created from
+#ifndef ANH_SQLITE_SCHEMA
+#define ANH_SQLITE_SCHEMA "../data/sqlite/zone_schema.sql"
+#endif
+
+namespace {
+
+struct GalaxyRow
+{
+	uint32	mId;
+	BString	mName;
+	uint64	mTick;
+};
+
+// keeps what a transaction reports to its callback
+class TransactionCallback : public DatabaseCallback
+{
+public:
+
+	TransactionCallback() : mError(0),mFailedStatement(0){}
+
+	virtual void handleDatabaseJobComplete(void* ref,DatabaseResult* result)
+	{
+		TransactionResult* transactionResult = static_cast<TransactionResult*>(result);
+
+		mError				= transactionResult->getError();
+		mFailedStatement	= transactionResult->getFailedStatement();
+	}
+
+	uint32	mError;
+	uint32	mFailedStatement;
+};
+
+class DatabaseImplementationSqliteTests : public ::testing::Test
+{
+protected:
+
+	virtual void SetUp()
+	{
+		// the implementation reports its errors through the logger
+		if(!gLogger)
+			LogManager::Init(G_LEVEL_NORMAL,"tests.log",LEVEL_NORMAL,false,false);
+
+		char host[] = ":memory:";
+		char none[] = "";
+
+		mDatabase = new DatabaseImplementationSqlite(host,0,none,none,none);
+	}
+
+	virtual void TearDown()
+	{
+		delete mDatabase;
+	}
+
+	uint64 countRows(const char* table)
+	{
+		char sql[128];
+		sprintf(sql,"SELECT COUNT(*) FROM %s;",table);
+
+		DatabaseResult*	result = mDatabase->ExecuteSql(sql);
+		DataBinding		binding(1);
+		uint64			count = 0;
+
+		binding.addField(DFT_uint64,0,8,0);
+		result->GetNextRow(&binding,&count);
+		mDatabase->DestroyResult(result);
+
+		return count;
+	}
+
+	DatabaseImplementationSqlite* mDatabase;
+};
+
+}
+
+TEST_F(DatabaseImplementationSqliteTests, SchemaScriptCreatesTheZoneTables)
+{
+	EXPECT_TRUE(mDatabase->isEmpty());
+
+	ASSERT_TRUE(mDatabase->ExecuteScript(ANH_SQLITE_SCHEMA));
+
+	EXPECT_FALSE(mDatabase->isEmpty());
+	EXPECT_EQ(0u, countRows("galaxy"));
+	EXPECT_EQ(0u, countRows("planet"));
+}
+
+TEST_F(DatabaseImplementationSqliteTests, QueryRowsAreReadThroughTheBinding)
+{
+	ASSERT_TRUE(mDatabase->ExecuteScript(ANH_SQLITE_SCHEMA));
+	ASSERT_TRUE(mDatabase->ExecuteCommand("INSERT INTO galaxy VALUES (2,'Bria',8589934592000);"
+										  "INSERT INTO galaxy VALUES (3,'Corbantis',1000);"));
+
+	char sql[] = "SELECT galaxy_id,name,Global_Tick_Count FROM galaxy ORDER BY galaxy_id;";
+	DatabaseResult* result = mDatabase->ExecuteSql(sql);
+
+	ASSERT_EQ(2u, result->getRowCount());
+
+	DataBinding binding(3);
+	binding.addField(DFT_uint32,offsetof(GalaxyRow,mId),4,0);
+	binding.addField(DFT_bstring,offsetof(GalaxyRow,mName),64,1);
+	binding.addField(DFT_uint64,offsetof(GalaxyRow,mTick),8,2);
+
+	GalaxyRow row;
+
+	result->GetNextRow(&binding,&row);
+	EXPECT_EQ(2u, row.mId);
+	EXPECT_STREQ("Bria", row.mName.getAnsi());
+	EXPECT_EQ(8589934592000ull, row.mTick);	// beyond 32 bits
+
+	result->GetNextRow(&binding,&row);
+	EXPECT_EQ(3u, row.mId);
+	EXPECT_STREQ("Corbantis", row.mName.getAnsi());
+	EXPECT_EQ(1000u, row.mTick);
+
+	// reading again from the start
+	result->ResetRowIndex();
+	result->GetNextRow(&binding,&row);
+	EXPECT_EQ(2u, row.mId);
+
+	mDatabase->DestroyResult(result);
+}
+
+TEST_F(DatabaseImplementationSqliteTests, EscapedStringsSurviveTheQuery)
+{
+	ASSERT_TRUE(mDatabase->ExecuteScript(ANH_SQLITE_SCHEMA));
+
+	const char*	name = "Tal'Ko";
+	char		escaped[32];
+	char		sql[128];
+
+	mDatabase->Escape_String(escaped,name,static_cast<uint32>(strlen(name)));
+	sprintf(sql,"INSERT INTO planet (planet_id,name) VALUES (1,'%s');",escaped);
+	ASSERT_TRUE(mDatabase->ExecuteCommand(sql));
+
+	char select[] = "SELECT name FROM planet WHERE planet_id = 1;";
+	DatabaseResult*	result = mDatabase->ExecuteSql(select);
+	DataBinding		binding(1);
+	BString			stored;
+
+	binding.addField(DFT_bstring,0,64,0);
+	result->GetNextRow(&binding,&stored);
+	mDatabase->DestroyResult(result);
+
+	EXPECT_STREQ(name, stored.getAnsi());
+}
+
+TEST_F(DatabaseImplementationSqliteTests, FailingTransactionOnlyRollsBackToItsSavepoint)
+{
+	ASSERT_TRUE(mDatabase->ExecuteScript(ANH_SQLITE_SCHEMA));
+
+	TransactionCallback firstResult;
+	TransactionCallback secondResult;
+
+	Transaction* first	= new Transaction(NULL,&firstResult,NULL);
+	Transaction* second	= new Transaction(NULL,&secondResult,NULL);
+
+	first->addStatement("INSERT INTO planet (planet_id,name) VALUES (?,?);").bindUInt(1).bindString("corellia");
+	first->addStatement("INSERT INTO planet (planet_id,name) VALUES (?,?);").bindUInt(2).bindString("dantooine");
+
+	// the second insert collides with the first one, everything of the second transaction is undone
+	second->addStatement("INSERT INTO planet (planet_id,name) VALUES (?,?);").bindUInt(3).bindString("dathomir");
+	second->addStatement("INSERT INTO planet (planet_id,name) VALUES (?,?);").bindUInt(3).bindString("endor");
+
+	TransactionList group;
+	group.push_back(first);
+	group.push_back(second);
+
+	Transaction::executeGroup(mDatabase,group);
+
+	first->complete();
+	second->complete();
+
+	EXPECT_EQ(0u, firstResult.mError);
+	EXPECT_NE(0u, secondResult.mError);
+	EXPECT_EQ(1u, secondResult.mFailedStatement);
+
+	EXPECT_EQ(2u, countRows("planet"));
+
+	char sql[] = "SELECT planet_id FROM planet WHERE planet_id = 3;";
+	DatabaseResult* result = mDatabase->ExecuteSql(sql);
+	EXPECT_EQ(0u, result->getRowCount());
+	mDatabase->DestroyResult(result);
+
+	// the group was committed, nothing is left open
+	EXPECT_TRUE(mDatabase->BeginTransaction());
+	EXPECT_TRUE(mDatabase->RollbackTransaction());
+
+	delete first;
+	delete second;
+}
+
+#endif
@@ -0,0 +1,130 @@
+/*! SWGANH MMOServer - Tests
+ *
+ * @copyright Copyright (c) 2006-2010 The swgANH Team
+ */
+
+#include <gtest/gtest.h>
+
+#include "Utils/DeadlineQueue.h"
+
+#include <cstdlib>
+#include <map>
+
+using Anh_Utils::DeadlineQueue;
+
+TEST(DeadlineQueueTests, PopsOnlyExpiredEntriesEarliestFirst)
+{
+	DeadlineQueue queue;
+	uint64 id, deadline;
+
+	queue.insert(1, 300);
+	queue.insert(2, 100);
+	queue.insert(3, 200);
+
+	EXPECT_TRUE(queue.popExpired(250, id, deadline));
+	EXPECT_EQ(2u, id);
+	EXPECT_EQ(100u, deadline);
+
+	EXPECT_TRUE(queue.popExpired(250, id, deadline));
+	EXPECT_EQ(3u, id);
+
+	EXPECT_FALSE(queue.popExpired(250, id, deadline));
+	EXPECT_EQ(1u, queue.size());
+	EXPECT_EQ(300u, queue.getNextDeadline());
+}
+
+TEST(DeadlineQueueTests, InsertKeepsAnExistingDeadline)
+{
+	DeadlineQueue queue;
+
+	EXPECT_TRUE(queue.insert(7, 500));
+	EXPECT_FALSE(queue.insert(7, 100));
+	EXPECT_EQ(500u, queue.getDeadline(7));
+}
+
+TEST(DeadlineQueueTests, ScheduleMovesTheDeadlineBothWays)
+{
+	DeadlineQueue queue;
+	uint64 id, deadline;
+
+	queue.insert(1, 100);
+	queue.insert(2, 200);
+
+	queue.schedule(1, 300);
+	EXPECT_TRUE(queue.popExpired(250, id, deadline));
+	EXPECT_EQ(2u, id);
+
+	queue.schedule(1, 50);
+	EXPECT_TRUE(queue.popExpired(60, id, deadline));
+	EXPECT_EQ(1u, id);
+	EXPECT_TRUE(queue.empty());
+}
+
+TEST(DeadlineQueueTests, RemovedEntriesAreGone)
+{
+	DeadlineQueue queue;
+	uint64 id, deadline;
+
+	queue.insert(1, 10);
+	queue.insert(2, 20);
+
+	EXPECT_TRUE(queue.remove(1));
+	EXPECT_FALSE(queue.remove(1));
+	EXPECT_FALSE(queue.contains(1));
+	EXPECT_EQ(0u, queue.getDeadline(1));
+
+	EXPECT_TRUE(queue.popExpired(100, id, deadline));
+	EXPECT_EQ(2u, id);
+	EXPECT_FALSE(queue.popExpired(100, id, deadline));
+}
+
+// random inserts, reschedules and removes against a map, every pop has to be the earliest deadline
+TEST(DeadlineQueueTests, MatchesAMapUnderRandomUse)
+{
+	DeadlineQueue queue;
+	std::map<uint64, uint64> reference;
+
+	srand(3);
+
+	for(uint32 i = 0; i < 20000; i++)
+	{
+		uint64 id = rand() % 500;
+
+		switch(rand() % 4)
+		{
+			case 0:
+			case 1:
+			{
+				uint64 when = rand() % 10000;
+				queue.schedule(id, when);
+				reference[id] = when;
+			}
+			break;
+
+			case 2:
+				EXPECT_EQ(reference.erase(id) == 1, queue.remove(id));
+			break;
+
+			default:
+			{
+				uint64 popped, deadline;
+
+				if(queue.popExpired(5000, popped, deadline))
+				{
+					ASSERT_EQ(1u, reference.count(popped));
+					EXPECT_EQ(reference[popped], deadline);
+
+					for(std::map<uint64, uint64>::iterator it = reference.begin(); it != reference.end(); ++it)
+					{
+						EXPECT_LE(deadline, (*it).second);
+					}
+
+					reference.erase(popped);
+				}
+			}
+			break;
+		}
+
+		ASSERT_EQ(reference.size(), queue.size());
+	}
+}
@@ -0,0 +1,85 @@
+/*! SWGANH MMOServer - Tests
+ *
+ * @copyright Copyright (c) 2006-2010 The swgANH Team
+ */
+
+#include <gtest/gtest.h>
+
+#include "Utils/FlatSet.h"
+#include "Utils/typedefs.h"
+
+#include <set>
+#include <vector>
+
+using Anh_Utils::flat_set;
+
+TEST(FlatSetTests, InsertKeepsElementsSortedAndUnique)
+{
+	flat_set<uint64> set;
+
+	EXPECT_TRUE(set.insert(30).second);
+	EXPECT_TRUE(set.insert(10).second);
+	EXPECT_TRUE(set.insert(20).second);
+	EXPECT_FALSE(set.insert(10).second);
+
+	ASSERT_EQ(3u, set.size());
+
+	std::vector<uint64> values(set.begin(), set.end());
+	EXPECT_EQ(10u, values[0]);
+	EXPECT_EQ(20u, values[1]);
+	EXPECT_EQ(30u, values[2]);
+}
+
+TEST(FlatSetTests, FindAndCountOnlyMatchContainedValues)
+{
+	flat_set<uint64> set;
+
+	set.insert(5);
+	set.insert(15);
+
+	EXPECT_TRUE(set.find(5) != set.end());
+	EXPECT_TRUE(set.find(10) == set.end());
+	EXPECT_EQ(1u, set.count(15));
+	EXPECT_EQ(0u, set.count(20));
+}
+
+TEST(FlatSetTests, EraseWhileIteratingVisitsEveryElement)
+{
+	flat_set<uint64> set;
+
+	for(uint64 i = 0; i < 10; i++)
+		set.insert(i);
+
+	uint32 visited = 0;
+	flat_set<uint64>::iterator it = set.begin();
+
+	while(it != set.end())
+	{
+		visited++;
+
+		if((*it % 2) == 0)
+			it = set.erase(it);
+		else
+			++it;
+	}
+
+	EXPECT_EQ(10u, visited);
+	EXPECT_EQ(5u, set.size());
+	EXPECT_EQ(0u, set.erase(4));
+	EXPECT_EQ(1u, set.erase(5));
+}
+
+TEST(FlatSetTests, RangeInsertMatchesStdSet)
+{
+	uint64 values[] = { 7, 3, 9, 3, 1, 7, 12, 0 };
+
+	flat_set<uint64>	set;
+	std::set<uint64>	reference(values, values + 8);
+
+	set.insert(20);
+	set.insert(values, values + 8);
+	reference.insert(20);
+
+	ASSERT_EQ(reference.size(), set.size());
+	EXPECT_TRUE(std::equal(reference.begin(), reference.end(), set.begin()));
+}
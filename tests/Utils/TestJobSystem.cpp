@@ -0,0 +1,146 @@
+/*! SWGANH MMOServer - Tests
+ *
+ * @copyright Copyright (c) 2006-2010 The swgANH Team
+ */
+
+#include <gtest/gtest.h>
+
+#include "Utils/JobSystem.h"
+
+#include <boost/thread/mutex.hpp>
+#include <set>
+
+using Anh_Utils::JobSystem;
+
+namespace {
+
+// counts the jobs that ran and the threads they ran on
+class JobCounter
+{
+public:
+	JobCounter(JobSystem& jobs) : mJobs(jobs), mCount(0) {}
+
+	void run()
+	{
+		boost::mutex::scoped_lock lock(mMutex);
+
+		mCount++;
+		mThreads.insert(boost::this_thread::get_id());
+	}
+
+	// runs and adds two more jobs
+	void spawn()
+	{
+		run();
+
+		mJobs.addJob(fastdelegate::MakeDelegate(this, &JobCounter::run));
+		mJobs.addJob(fastdelegate::MakeDelegate(this, &JobCounter::run));
+	}
+
+	JobSystem&						mJobs;
+	boost::mutex					mMutex;
+	uint32							mCount;
+	std::set<boost::thread::id>		mThreads;
+};
+
+}
+
+TEST(JobSystemTests, RunsEveryJobWithoutThreads)
+{
+	JobSystem jobs(0);
+	JobCounter counter(jobs);
+
+	for(uint32 i = 0; i < 100; i++)
+	{
+		jobs.addJob(fastdelegate::MakeDelegate(&counter, &JobCounter::run));
+	}
+
+	jobs.runPhase();
+
+	EXPECT_EQ(100u, counter.mCount);
+	EXPECT_EQ(1u, counter.mThreads.size());
+}
+
+TEST(JobSystemTests, RunsEveryJobOnWorkers)
+{
+	JobSystem jobs(4);
+	JobCounter counter(jobs);
+
+	for(uint32 phase = 0; phase < 50; phase++)
+	{
+		for(uint32 i = 0; i < 200; i++)
+		{
+			jobs.addJob(fastdelegate::MakeDelegate(&counter, &JobCounter::run));
+		}
+
+		jobs.runPhase();
+
+		// the phase is over, everything it queued has run
+		EXPECT_EQ((phase + 1) * 200, counter.mCount);
+	}
+}
+
+TEST(JobSystemTests, JobsAddedByJobsRunInTheSamePhase)
+{
+	JobSystem jobs(3);
+	JobCounter counter(jobs);
+
+	for(uint32 i = 0; i < 64; i++)
+	{
+		jobs.addJob(fastdelegate::MakeDelegate(&counter, &JobCounter::spawn));
+	}
+
+	jobs.runPhase();
+
+	EXPECT_EQ(64u * 3, counter.mCount);
+}
+
+TEST(JobSystemTests, JobsQueuedBetweenPhasesWaitForTheNextPhase)
+{
+	JobSystem jobs(4);
+	JobCounter counter(jobs);
+
+	uint32 expected = 0;
+
+	for(uint32 phase = 0; phase < 200; phase++)
+	{
+		for(uint32 i = 0; i < 32; i++)
+		{
+			jobs.addJob(fastdelegate::MakeDelegate(&counter, &JobCounter::run));
+		}
+
+		expected += 32;
+
+		jobs.runPhase();
+
+		// queued for the next phase, workers still waking up from this one must leave them alone
+		for(uint32 i = 0; i < 32; i++)
+		{
+			jobs.addJob(fastdelegate::MakeDelegate(&counter, &JobCounter::run));
+		}
+
+		boost::this_thread::sleep(boost::posix_time::microseconds(200));
+
+		{
+			boost::mutex::scoped_lock lock(counter.mMutex);
+
+			ASSERT_EQ(expected, counter.mCount);
+		}
+
+		jobs.runPhase();
+
+		expected += 32;
+
+		EXPECT_EQ(expected, counter.mCount);
+	}
+}
+
+TEST(JobSystemTests, AnEmptyPhaseReturns)
+{
+	JobSystem jobs(2);
+
+	jobs.runPhase();
+	jobs.runPhase();
+
+	EXPECT_EQ(2u, jobs.getThreadCount());
+}
@@ -0,0 +1,77 @@
+/*! SWGANH MMOServer - Tests
+ *
+ * @copyright Copyright (c) 2006-2010 The swgANH Team
+ */
+
+#include <gtest/gtest.h>
+
+#include "Utils/SchedulerStats.h"
+
+#include <string>
+
+using Anh_Utils::SchedulerStats;
+
+TEST(SchedulerStatsTests, KeepsCallsRuntimeAndLatenessPerLabel)
+{
+	SchedulerStats stats("Test");
+
+	stats.recordCall("Ham::regenerate", 100, 0);
+	stats.recordCall("Ham::regenerate", 300, 20);
+	stats.recordCall("MissionObject::check", 50, 5);
+
+	SchedulerStats::Entry entry = stats.getEntry("Ham::regenerate");
+
+	EXPECT_EQ(2u, entry.mCalls);
+	EXPECT_EQ(400u, entry.mTotalTime);
+	EXPECT_EQ(300u, entry.mMaxTime);
+	EXPECT_EQ(20u, entry.mTotalLateness);
+	EXPECT_EQ(20u, entry.mMaxLateness);
+
+	EXPECT_EQ(1u, stats.getEntry("MissionObject::check").mCalls);
+	EXPECT_EQ(0u, stats.getEntry("Buff::Update").mCalls);
+}
+
+TEST(SchedulerStatsTests, UnlabelledTasksAreCountedTogether)
+{
+	SchedulerStats stats("Test");
+
+	stats.recordCall(NULL, 10, 0);
+	stats.recordCall(NULL, 10, 0);
+
+	EXPECT_EQ(2u, stats.getEntry("unnamed").mCalls);
+}
+
+TEST(SchedulerStatsTests, PassesWithABacklogAreOverBudget)
+{
+	SchedulerStats stats("Test");
+
+	stats.recordPass(5, 0);
+	stats.recordPass(120, 40);
+	stats.recordPass(110, 12);
+
+	EXPECT_EQ(3u, stats.getPasses());
+	EXPECT_EQ(2u, stats.getOverruns());
+	EXPECT_EQ(40u, stats.getMaxBacklog());
+
+	stats.reset();
+
+	EXPECT_EQ(0u, stats.getPasses());
+	EXPECT_EQ(0u, stats.getOverruns());
+}
+
+TEST(SchedulerStatsTests, ReportListsTheWorstTasksFirst)
+{
+	SchedulerStats stats("HamRegen");
+
+	stats.recordCall("cheap", 10, 0);
+	stats.recordCall("expensive", 5000, 0);
+	stats.recordCall("middle", 500, 0);
+
+	std::string report = stats.getReport(2);
+
+	EXPECT_NE(std::string::npos, report.find("HamRegen"));
+	EXPECT_NE(std::string::npos, report.find("expensive"));
+	EXPECT_NE(std::string::npos, report.find("middle"));
+	EXPECT_EQ(std::string::npos, report.find("cheap"));
+	EXPECT_LT(report.find("expensive"), report.find("middle"));
+}
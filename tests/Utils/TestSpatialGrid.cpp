@@ -0,0 +1,142 @@
+/*! SWGANH MMOServer - Tests
+ *
+ * @copyright Copyright (c) 2006-2010 The swgANH Team
+ */
+
+#include <gtest/gtest.h>
+
+#include "Utils/SpatialGrid.h"
+
+#include <algorithm>
+#include <vector>
+
+using Anh_Utils::SpatialGrid;
+
+static std::vector<int64> queryGrid(const SpatialGrid& grid, float xLow, float zLow, float xHigh, float zHigh)
+{
+	std::vector<int64> result;
+	grid.query(xLow, zLow, xHigh, zHigh, result);
+	std::sort(result.begin(), result.end());
+	return result;
+}
+
+TEST(SpatialGridTests, FindsPointsInsideTheQueryOnly)
+{
+	SpatialGrid grid(64.0f, 8192.0f);
+
+	grid.insert(1, 10.0f, 10.0f);
+	grid.insert(2, 100.0f, -40.0f);
+	grid.insert(3, 5000.0f, 5000.0f);
+
+	std::vector<int64> result = queryGrid(grid, -50.0f, -50.0f, 150.0f, 50.0f);
+
+	ASSERT_EQ(2u, result.size());
+	EXPECT_EQ(1, result[0]);
+	EXPECT_EQ(2, result[1]);
+}
+
+TEST(SpatialGridTests, QueryBoundsAreInclusive)
+{
+	SpatialGrid grid(64.0f, 8192.0f);
+
+	grid.insert(1, 64.0f, 0.0f);
+
+	EXPECT_EQ(1u, queryGrid(grid, 0.0f, 0.0f, 64.0f, 0.0f).size());
+}
+
+TEST(SpatialGridTests, MovedPointIsOnlyFoundAtItsNewPosition)
+{
+	SpatialGrid grid(64.0f, 8192.0f);
+
+	grid.insert(1, 0.0f, 0.0f);
+	grid.insert(2, 1.0f, 1.0f);
+
+	EXPECT_TRUE(grid.move(1, 1000.0f, 1000.0f));
+
+	std::vector<int64> result = queryGrid(grid, -10.0f, -10.0f, 10.0f, 10.0f);
+	ASSERT_EQ(1u, result.size());
+	EXPECT_EQ(2, result[0]);
+
+	result = queryGrid(grid, 990.0f, 990.0f, 1010.0f, 1010.0f);
+	ASSERT_EQ(1u, result.size());
+	EXPECT_EQ(1, result[0]);
+}
+
+TEST(SpatialGridTests, RemoveKeepsTheOtherPointsOfTheCell)
+{
+	SpatialGrid grid(64.0f, 8192.0f);
+
+	grid.insert(1, 1.0f, 1.0f);
+	grid.insert(2, 2.0f, 2.0f);
+	grid.insert(3, 3.0f, 3.0f);
+
+	EXPECT_TRUE(grid.remove(1));
+	EXPECT_FALSE(grid.remove(1));
+
+	// 3 got swapped into the slot of 1, it has to stay movable
+	EXPECT_TRUE(grid.move(3, 4.0f, 4.0f));
+	EXPECT_TRUE(grid.remove(3));
+
+	std::vector<int64> result = queryGrid(grid, 0.0f, 0.0f, 10.0f, 10.0f);
+	ASSERT_EQ(1u, result.size());
+	EXPECT_EQ(2, result[0]);
+	EXPECT_EQ(1u, grid.getCount());
+}
+
+TEST(SpatialGridTests, InsertingAnIdAgainMovesIt)
+{
+	SpatialGrid grid(64.0f, 8192.0f);
+
+	grid.insert(1, 0.0f, 0.0f);
+	grid.insert(1, 500.0f, 500.0f);
+
+	EXPECT_EQ(1u, grid.getCount());
+	EXPECT_EQ(0u, queryGrid(grid, -10.0f, -10.0f, 10.0f, 10.0f).size());
+}
+
+TEST(SpatialGridTests, PointsOutsideTheExtentAreStillFound)
+{
+	SpatialGrid grid(64.0f, 1024.0f);
+
+	grid.insert(1, 5000.0f, -5000.0f);
+
+	std::vector<int64> result = queryGrid(grid, 4000.0f, -6000.0f, 6000.0f, -4000.0f);
+	ASSERT_EQ(1u, result.size());
+	EXPECT_EQ(1, result[0]);
+}
+
+TEST(SpatialGridTests, TypedQueryFiltersByMaskAndReturnsData)
+{
+	SpatialGrid grid(64.0f, 8192.0f);
+
+	// enough points in one cell to fill the 4 wide lanes and leave a tail
+	int values[11];
+
+	for(int i = 0; i < 11; i++)
+	{
+		values[i] = i;
+		grid.insert(i + 1, static_cast<float>(i), 1.0f, (i % 2) ? 0x2u : 0x1u, &values[i]);
+	}
+
+	std::vector<void*> result;
+	grid.query(0.0f, 0.0f, 8.5f, 2.0f, 0x1u, result);
+
+	std::vector<int> found;
+	for(size_t i = 0; i < result.size(); i++)
+	{
+		found.push_back(*static_cast<int*>(result[i]));
+	}
+	std::sort(found.begin(), found.end());
+
+	ASSERT_EQ(5u, found.size());
+	EXPECT_EQ(0, found[0]);
+	EXPECT_EQ(2, found[1]);
+	EXPECT_EQ(4, found[2]);
+	EXPECT_EQ(6, found[3]);
+	EXPECT_EQ(8, found[4]);
+
+	// a type with bits outside the mask does not pass
+	result.clear();
+	grid.query(0.0f, 0.0f, 20.0f, 2.0f, 0x4u, result);
+	EXPECT_EQ(0u, result.size());
+}
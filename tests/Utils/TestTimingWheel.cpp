@@ -0,0 +1,149 @@
+/*! SWGANH MMOServer - Tests
+ *
+ * @copyright Copyright (c) 2006-2010 The swgANH Team
+ */
+
+#include <gtest/gtest.h>
+
+#include "Utils/TimingWheel.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+using Anh_Utils::TimingWheel;
+
+TEST(TimingWheelTests, ExpiresAtTheDueTimeOnly)
+{
+	TimingWheel wheel(1000);
+	std::vector<uint32> expired;
+
+	wheel.insert(1, 1010);
+
+	wheel.advance(1009, expired);
+	EXPECT_EQ(0u, expired.size());
+	EXPECT_TRUE(wheel.contains(1));
+
+	wheel.advance(1010, expired);
+	ASSERT_EQ(1u, expired.size());
+	EXPECT_EQ(1u, expired[0]);
+	EXPECT_FALSE(wheel.contains(1));
+	EXPECT_TRUE(wheel.empty());
+}
+
+TEST(TimingWheelTests, RemovedEntriesDoNotExpire)
+{
+	TimingWheel wheel(0);
+	std::vector<uint32> expired;
+
+	wheel.insert(1, 50);
+	wheel.insert(2, 50);
+	wheel.insert(3, 50);
+
+	EXPECT_TRUE(wheel.remove(2));
+	EXPECT_FALSE(wheel.remove(2));
+
+	wheel.advance(100, expired);
+	std::sort(expired.begin(), expired.end());
+
+	ASSERT_EQ(2u, expired.size());
+	EXPECT_EQ(1u, expired[0]);
+	EXPECT_EQ(3u, expired[1]);
+}
+
+TEST(TimingWheelTests, PastDueTimesExpireOnTheNextAdvance)
+{
+	TimingWheel wheel(500);
+	std::vector<uint32> expired;
+
+	wheel.insert(4, 10);
+	EXPECT_EQ(501u, wheel.getDueTime(4));
+
+	wheel.advance(501, expired);
+	ASSERT_EQ(1u, expired.size());
+	EXPECT_EQ(4u, expired[0]);
+}
+
+TEST(TimingWheelTests, InsertingAgainReschedules)
+{
+	TimingWheel wheel(0);
+	std::vector<uint32> expired;
+
+	wheel.insert(1, 100);
+	wheel.insert(1, 300);
+	EXPECT_EQ(1u, wheel.size());
+
+	wheel.advance(299, expired);
+	EXPECT_EQ(0u, expired.size());
+
+	wheel.advance(300, expired);
+	EXPECT_EQ(1u, expired.size());
+}
+
+TEST(TimingWheelTests, ClockGoingBackKeepsTheRemainingDelay)
+{
+	TimingWheel wheel(10000);
+	std::vector<uint32> expired;
+
+	wheel.insert(1, 10500);
+
+	wheel.advance(100, expired);
+	EXPECT_EQ(0u, expired.size());
+	EXPECT_EQ(600u, wheel.getDueTime(1));
+
+	wheel.advance(600, expired);
+	EXPECT_EQ(1u, expired.size());
+}
+
+// random due times across all wheels, advanced in uneven steps, everything has to come out in order and on time
+TEST(TimingWheelTests, ExpiresEveryEntryOnTimeAcrossTheWheels)
+{
+	const uint64	start	= 123456789;
+	const uint32	count	= 2000;
+	TimingWheel		wheel(start);
+	std::vector<uint64>	dueTimes;
+
+	srand(7);
+
+	for(uint32 i = 0; i < count; i++)
+	{
+		uint64 delay;
+
+		switch(i % 4)
+		{
+			case 0:	 delay = rand() % 256;				break;
+			case 1:	 delay = rand() % 65536;			break;
+			case 2:	 delay = (rand() % 4096) * 4096;	break;
+			default: delay = (static_cast<uint64>(rand() % 64) << 26) + rand() % 1000; break;
+		}
+
+		dueTimes.push_back(start + 1 + delay);
+		wheel.insert(i, start + 1 + delay);
+	}
+
+	uint64 last	= *std::max_element(dueTimes.begin(), dueTimes.end());
+	uint64 now	= start;
+	uint32 found	= 0;
+	std::vector<uint32> expired;
+
+	while(now < last)
+	{
+		uint64 previous = now;
+
+		now = std::min(last, now + 1 + rand() % 5000);
+
+		expired.clear();
+		wheel.advance(now, expired);
+
+		for(uint32 i = 0; i < expired.size(); i++)
+		{
+			EXPECT_GT(dueTimes[expired[i]], previous);
+			EXPECT_LE(dueTimes[expired[i]], now);
+		}
+
+		found += static_cast<uint32>(expired.size());
+	}
+
+	EXPECT_EQ(count, found);
+	EXPECT_TRUE(wheel.empty());
+}